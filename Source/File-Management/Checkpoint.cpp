@@ -0,0 +1,340 @@
+#include "Checkpoint.h"
+#include "Commons.h"
+
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+
+#ifdef CXX11_ENABLED
+#include <utility>
+#endif /* CXX11_ENABLED */
+
+/**
+ * Magic string in the beginning of checkpoint file
+ */
+static const char checkpointMagic[8] = {'F', 'D', 'T', 'D', 'C', 'K', 'P', 'T'};
+
+CheckpointWriter::CheckpointWriter ()
+#ifdef CXX11_ENABLED
+  : doWriteInBackground (false)
+#endif /* CXX11_ENABLED */
+{
+}
+
+CheckpointWriter::~CheckpointWriter ()
+{
+  waitForWriter ();
+}
+
+/**
+ * Set whether to write files in background thread, while caller continues
+ */
+void
+CheckpointWriter::setWriteInBackground (bool background) /**< flag whether to write in background */
+{
+#ifdef CXX11_ENABLED
+  doWriteInBackground = background;
+#else /* CXX11_ENABLED */
+  if (background)
+  {
+    ALWAYS_ASSERT_MESSAGE ("Solver is not compiled with support of C++11. Recompile it with -DCXX11_ENABLED=ON.");
+  }
+#endif /* !CXX11_ENABLED */
+}
+
+/**
+ * Wait until background thread finishes writing of last image
+ */
+void
+CheckpointWriter::waitForWriter ()
+{
+#ifdef CXX11_ENABLED
+  if (writerThread.joinable ())
+  {
+    writerThread.join ();
+  }
+#endif /* CXX11_ENABLED */
+}
+
+/**
+ * Start new image of checkpoint file
+ */
+void
+CheckpointWriter::begin (time_step t) /**< time step, after which checkpoint is saved */
+{
+  blocks.clear ();
+
+  image.clear ();
+  image.resize (CHECKPOINT_ALIGNMENT, 0);
+
+  CheckpointHeader *header = (CheckpointHeader *) image.data ();
+  memcpy (header->magic, checkpointMagic, sizeof (checkpointMagic));
+  header->version = CHECKPOINT_VERSION;
+  header->valueSize = sizeof (FieldValue);
+  header->timeStep = t;
+}
+
+/**
+ * Copy block to the end of image of checkpoint file
+ */
+void
+CheckpointWriter::addBlock (const std::string &name, /**< name of block */
+                            const void *data, /**< values of block */
+                            uint64_t size) /**< size of block in bytes */
+{
+  ASSERT (!image.empty ());
+  ALWAYS_ASSERT (name.length () < CHECKPOINT_NAME_LENGTH);
+
+  CheckpointBlock block;
+  memset (&block, 0, sizeof (block));
+  strncpy (block.name, name.c_str (), CHECKPOINT_NAME_LENGTH - 1);
+  block.offset = image.size ();
+  block.size = size;
+  blocks.push_back (block);
+
+  uint64_t alignedSize = ((size + CHECKPOINT_ALIGNMENT - 1) / CHECKPOINT_ALIGNMENT) * CHECKPOINT_ALIGNMENT;
+  image.resize (image.size () + alignedSize, 0);
+
+  if (size > 0)
+  {
+    memcpy (image.data () + block.offset, data, size);
+  }
+}
+
+/**
+ * Write all data to temporary file and replace file with it
+ */
+void
+CheckpointWriter::writeData (const std::string &fileName, /**< name of file */
+                             const std::vector<char> &data) /**< image of file */
+{
+  std::string tmpName = fileName + std::string (".tmp");
+
+  std::ofstream file;
+  file.open (tmpName.c_str (), std::ios::out | std::ios::binary);
+  ALWAYS_ASSERT (file.is_open ());
+
+  file.write (data.data (), data.size ());
+  ALWAYS_ASSERT (file.good ());
+
+  file.close ();
+
+  ALWAYS_ASSERT (rename (tmpName.c_str (), fileName.c_str ()) == 0);
+}
+
+/**
+ * Finish image of checkpoint file and write it (in background thread, if enabled)
+ */
+void
+CheckpointWriter::write (const std::string &fileName) /**< name of file */
+{
+  ASSERT (!image.empty ());
+
+  uint64_t tableOffset = image.size ();
+  image.resize (tableOffset + blocks.size () * sizeof (CheckpointBlock));
+  if (!blocks.empty ())
+  {
+    memcpy (image.data () + tableOffset, blocks.data (), blocks.size () * sizeof (CheckpointBlock));
+  }
+
+  CheckpointHeader *header = (CheckpointHeader *) image.data ();
+  header->blockCount = blocks.size ();
+  header->tableOffset = tableOffset;
+
+  /*
+   * Previous image might still be written
+   */
+  waitForWriter ();
+
+#ifdef CXX11_ENABLED
+  if (doWriteInBackground)
+  {
+    writerThread = std::thread (&CheckpointWriter::writeData, fileName, std::move (image));
+    image.clear ();
+    return;
+  }
+#endif /* CXX11_ENABLED */
+
+  writeData (fileName, image);
+  image.clear ();
+}
+
+/**
+ * Get name of checkpoint file of process
+ *
+ * @return name of checkpoint file
+ */
+std::string
+CheckpointWriter::getFileName (const std::string &dir, /**< directory with checkpoints */
+                               time_step t, /**< time step, after which checkpoint is saved */
+                               int processId) /**< id of process */
+{
+  return dir + std::string ("/checkpoint_[timestep=") + int64_to_string (t)
+         + std::string ("]_[pid=") + int64_to_string (processId) + std::string ("].bin");
+}
+
+/**
+ * Get name of index file, which contains time step of the last checkpoint, completely saved by all processes
+ *
+ * @return name of index file
+ */
+std::string
+CheckpointWriter::getIndexFileName (const std::string &dir) /**< directory with checkpoints */
+{
+  return dir + std::string ("/checkpoint.txt");
+}
+
+/**
+ * Create directory for checkpoints, if it does not exist yet
+ */
+void
+CheckpointWriter::makeDirectory (const std::string &dir) /**< directory with checkpoints */
+{
+  /*
+   * Directory might be already created by this or another process
+   */
+  mkdir (dir.c_str (), 0755);
+}
+
+/**
+ * Replace index file with the one, which points to checkpoint at specified time step
+ */
+void
+CheckpointWriter::writeIndex (const std::string &dir, /**< directory with checkpoints */
+                              time_step t) /**< time step of the last complete checkpoint */
+{
+  std::string index = int64_to_string (t) + std::string ("\n");
+  writeData (getIndexFileName (dir), std::vector<char> (index.begin (), index.end ()));
+}
+
+/**
+ * Open checkpoint file and read its header and table of blocks
+ */
+CheckpointReader::CheckpointReader (const std::string &fileName) /**< name of file */
+{
+  file.open (fileName.c_str (), std::ios::in | std::ios::binary);
+  if (!file.is_open ())
+  {
+    ALWAYS_ASSERT_MESSAGE ("Checkpoint file could not be opened.");
+  }
+
+  file.read ((char *) &header, sizeof (header));
+  ALWAYS_ASSERT (file.good ());
+
+  if (memcmp (header.magic, checkpointMagic, sizeof (checkpointMagic)) != 0
+      || header.version != CHECKPOINT_VERSION)
+  {
+    ALWAYS_ASSERT_MESSAGE ("File is not a checkpoint of this version of solver.");
+  }
+
+  if (header.valueSize != sizeof (FieldValue))
+  {
+    ALWAYS_ASSERT_MESSAGE ("Checkpoint was saved with different type of values (float/double, real/complex).");
+  }
+
+  blocks.resize (header.blockCount);
+  file.seekg (header.tableOffset);
+  if (!blocks.empty ())
+  {
+    file.read ((char *) blocks.data (), blocks.size () * sizeof (CheckpointBlock));
+  }
+  ALWAYS_ASSERT (file.good ());
+}
+
+/**
+ * Find block with specified name
+ *
+ * @return block or NULLPTR, if there is no such block
+ */
+const CheckpointBlock *
+CheckpointReader::findBlock (const std::string &name) const /**< name of block */
+{
+  for (size_t i = 0; i < blocks.size (); ++i)
+  {
+    if (strncmp (blocks[i].name, name.c_str (), CHECKPOINT_NAME_LENGTH) == 0)
+    {
+      return &blocks[i];
+    }
+  }
+
+  return NULLPTR;
+}
+
+/**
+ * Check whether block is present in checkpoint
+ *
+ * @return true if block is present
+ */
+bool
+CheckpointReader::hasBlock (const std::string &name) const /**< name of block */
+{
+  return findBlock (name) != NULLPTR;
+}
+
+/**
+ * Get size of block
+ *
+ * @return size of block in bytes
+ */
+uint64_t
+CheckpointReader::getBlockSize (const std::string &name) const /**< name of block */
+{
+  const CheckpointBlock *block = findBlock (name);
+  ALWAYS_ASSERT (block != NULLPTR);
+
+  return block->size;
+}
+
+/**
+ * Read time step of the last checkpoint, completely saved by all processes, from index file
+ *
+ * @return time step of checkpoint
+ */
+time_step
+CheckpointReader::readIndex (const std::string &dir) /**< directory with checkpoints */
+{
+  std::ifstream file;
+  file.open (CheckpointWriter::getIndexFileName (dir).c_str ());
+  if (!file.is_open ())
+  {
+    ALWAYS_ASSERT_MESSAGE ("Directory does not contain complete checkpoint.");
+  }
+
+  uint64_t t = 0;
+  file >> t;
+  ALWAYS_ASSERT (!file.fail () && t > 0);
+
+  return (time_step) t;
+}
+
+/**
+ * Read values of block
+ */
+void
+CheckpointReader::readBlock (const std::string &name, /**< name of block */
+                             void *data, /**< out: values of block */
+                             uint64_t size) /**< expected size of block in bytes */
+{
+  const CheckpointBlock *block = findBlock (name);
+  if (block == NULLPTR)
+  {
+    DPRINTF (LOG_LEVEL_NONE, "Block '%s' is missing in checkpoint.\n", name.c_str ());
+    ALWAYS_ASSERT_MESSAGE ("Checkpoint does not match current setup.");
+  }
+
+  if (block->size != size)
+  {
+    DPRINTF (LOG_LEVEL_NONE, "Block '%s' in checkpoint has size %llu, while %llu is expected.\n",
+             name.c_str (), (unsigned long long) block->size, (unsigned long long) size);
+    ALWAYS_ASSERT_MESSAGE ("Checkpoint does not match current setup.");
+  }
+
+  if (size == 0)
+  {
+    return;
+  }
+
+  file.seekg (block->offset);
+  file.read ((char *) data, size);
+  ALWAYS_ASSERT (file.good ());
+}
@@ -0,0 +1,150 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef CXX11_ENABLED
+#include <thread>
+#endif /* CXX11_ENABLED */
+
+#include "Assert.h"
+#include "FieldValue.h"
+
+/**
+ * Version of checkpoint file format
+ */
+#define CHECKPOINT_VERSION 1
+
+/**
+ * Alignment (in bytes) of start of each block in checkpoint file, equal to page size, so that any block could be
+ * mapped to memory directly
+ */
+#define CHECKPOINT_ALIGNMENT 4096
+
+/**
+ * Maximum length of block name (including terminating zero)
+ */
+#define CHECKPOINT_NAME_LENGTH 48
+
+/**
+ * Header, which is placed in the beginning of checkpoint file
+ */
+struct CheckpointHeader
+{
+  char magic[8]; /**< "FDTDCKPT" */
+  uint32_t version; /**< version of format */
+  uint32_t valueSize; /**< size of FieldValue, with which checkpoint was saved */
+  uint64_t timeStep; /**< time step, after which checkpoint was saved */
+  uint64_t blockCount; /**< number of blocks in file */
+  uint64_t tableOffset; /**< offset of table of blocks from the beginning of file */
+  uint8_t reserved[24];
+};
+
+/**
+ * Entry of table of blocks, which is placed in the end of checkpoint file
+ */
+struct CheckpointBlock
+{
+  char name[CHECKPOINT_NAME_LENGTH]; /**< name of block */
+  uint64_t offset; /**< offset of block from the beginning of file (multiple of CHECKPOINT_ALIGNMENT) */
+  uint64_t size; /**< size of block in bytes */
+};
+
+/**
+ * Writer of checkpoint file of single process. Checkpoint file consists of header, named raw blocks, each starting at
+ * CHECKPOINT_ALIGNMENT boundary, and table of blocks in the end of file.
+ *
+ * Blocks are copied to memory image of file, when they are added, so that computations could continue while image is
+ * written. Image is first written to temporary file, which is then renamed, so previous checkpoint with the same name
+ * stays valid until the new one is completely written.
+ */
+class CheckpointWriter
+{
+  /**
+   * Memory image of checkpoint file
+   */
+  std::vector<char> image;
+
+  /**
+   * Table of added blocks
+   */
+  std::vector<CheckpointBlock> blocks;
+
+#ifdef CXX11_ENABLED
+  /**
+   * Whether to write files in background thread
+   */
+  bool doWriteInBackground;
+
+  /**
+   * Background thread, which writes last image to file
+   */
+  std::thread writerThread;
+#endif /* CXX11_ENABLED */
+
+  static void writeData (const std::string &, const std::vector<char> &);
+
+public:
+
+  CheckpointWriter ();
+  ~CheckpointWriter ();
+
+  void setWriteInBackground (bool);
+  void waitForWriter ();
+
+  void begin (time_step);
+  void addBlock (const std::string &, const void *, uint64_t);
+  void write (const std::string &);
+
+  static std::string getFileName (const std::string &, time_step, int);
+  static std::string getIndexFileName (const std::string &);
+  static void makeDirectory (const std::string &);
+  static void writeIndex (const std::string &, time_step);
+};
+
+/**
+ * Reader of checkpoint file of single process (see CheckpointWriter)
+ */
+class CheckpointReader
+{
+  /**
+   * Checkpoint file
+   */
+  std::ifstream file;
+
+  /**
+   * Header of file
+   */
+  CheckpointHeader header;
+
+  /**
+   * Table of blocks of file
+   */
+  std::vector<CheckpointBlock> blocks;
+
+  const CheckpointBlock * findBlock (const std::string &) const;
+
+public:
+
+  CheckpointReader (const std::string &);
+
+  /**
+   * Get time step, after which checkpoint was saved
+   *
+   * @return time step
+   */
+  time_step getTimeStep () const
+  {
+    return (time_step) header.timeStep;
+  }
+
+  bool hasBlock (const std::string &) const;
+  uint64_t getBlockSize (const std::string &) const;
+  void readBlock (const std::string &, void *, uint64_t);
+
+  static time_step readIndex (const std::string &);
+};
+
+#endif /* CHECKPOINT_H */
@@ -54,41 +54,7 @@ protected:
 
     for (int i = 0; i < names.size (); ++i)
     {
-      if (singleName)
-      {
-        names[i] = std::string ("previous");
-      }
-      else
-      {
-        names[i] = std::string ("previous-") + int64_to_string (i);
-      }
-      
-      names[i] += std::string ("_[timestep=") + int64_to_string (step)
-                  + std::string ("]_[pid=") + int64_to_string (processId) + std::string ("]_[name=") + customName
-                  + std::string ("]");
-
-      switch (ftype)
-      {
-        case FILE_TYPE_BMP:
-        {
-          names[i] += std::string (".bmp");
-          break;
-        }
-        case FILE_TYPE_DAT:
-        {
-          names[i] += std::string (".dat");
-          break;
-        }
-        case FILE_TYPE_TXT:
-        {
-          names[i] += std::string (".txt");
-          break;
-        }
-        default:
-        {
-          UNREACHABLE;
-        }
-      }
+      names[i] = getFileName (singleName ? -1 : i, step, processId, customName, ftype);
     }
   }
   
@@ -112,6 +78,58 @@ public:
   virtual ~GridFileManager () {}
 
   static FileType getFileType (const std::string &);
+
+  /**
+   * Get name of file, which is used to save/load grid time step:
+   *   -1:  single file for all time steps
+   *   >=0: file for specific time step
+   */
+  static std::string getFileName (int index,
+                                  time_step step,
+                                  int processId,
+                                  const std::string & customName,
+                                  FileType ftype)
+  {
+    std::string name;
+
+    if (index == -1)
+    {
+      name = std::string ("previous");
+    }
+    else
+    {
+      name = std::string ("previous-") + int64_to_string (index);
+    }
+
+    name += std::string ("_[timestep=") + int64_to_string (step)
+            + std::string ("]_[pid=") + int64_to_string (processId) + std::string ("]_[name=") + customName
+            + std::string ("]");
+
+    switch (ftype)
+    {
+      case FILE_TYPE_BMP:
+      {
+        name += std::string (".bmp");
+        break;
+      }
+      case FILE_TYPE_DAT:
+      {
+        name += std::string (".dat");
+        break;
+      }
+      case FILE_TYPE_TXT:
+      {
+        name += std::string (".txt");
+        break;
+      }
+      default:
+      {
+        UNREACHABLE;
+      }
+    }
+
+    return name;
+  }
 };
 
 #endif /* COMMONS_H */
@@ -3,16 +3,48 @@
 
 #include <iostream>
 #include <fstream>
+#include <cstring>
+
+#ifdef CXX11_ENABLED
+#include <thread>
+#include <utility>
+#endif /* CXX11_ENABLED */
 
 #include "Dumper.h"
 
+/**
+ * Size (in bytes) of buffer, which is filled with values before write to file.
+ */
+#define DAT_DUMPER_BUFFER_SIZE (16 * 1024 * 1024)
+
 /**
  * Grid saver to binary files.
  * Template class with coordinate parameter.
+ *
+ * Values are written row by row (row is a set of values, which are consecutive in memory of grid, i.e. along the last
+ * coordinate), so file contains values in the same order as grid memory.
  */
 template <class TCoord>
 class DATDumper: public Dumper<TCoord>
 {
+#ifdef CXX11_ENABLED
+  // Whether to write files in background thread.
+  bool doWriteInBackground;
+
+  // Background thread, which writes last dumped values to file.
+  std::thread writerThread;
+#endif /* CXX11_ENABLED */
+
+  static void expandInStorageOrder (const TCoord &, grid_coord, grid_coord &, grid_coord &, grid_coord &);
+
+  // Copy values of row of grid to the end of buffer.
+  static void appendRow (Grid<TCoord> *grid, grid_coord, grid_coord, int, std::vector<char> &);
+
+  // Copy values from box of grid to buffer, flushing buffer to file when it is filled.
+  static void collectValues (Grid<TCoord> *grid, TCoord, TCoord, int, std::vector<char> &, std::ofstream *);
+
+  static void writeData (const std::string &, const std::vector<char> &);
+
   // Save grid to file for specific layer.
   void writeToFile (Grid<TCoord> *grid, TCoord, TCoord, int);
 
@@ -20,7 +52,34 @@ class DATDumper: public Dumper<TCoord>
 
 public:
 
+#ifdef CXX11_ENABLED
+  DATDumper ()
+    : doWriteInBackground (false)
+  {
+  }
+
+  virtual ~DATDumper ()
+  {
+    waitForWriter ();
+  }
+
+  // Set whether to write files in background thread, while caller continues.
+  void setWriteInBackground (bool background)
+  {
+    doWriteInBackground = background;
+  }
+
+  // Wait until background thread finishes writing of last dumped values.
+  void waitForWriter ()
+  {
+    if (writerThread.joinable ())
+    {
+      writerThread.join ();
+    }
+  }
+#else /* CXX11_ENABLED */
   virtual ~DATDumper () {}
+#endif /* !CXX11_ENABLED */
 
   // Virtual method for grid saving.
   virtual void dumpGrid (Grid<TCoord> *grid, TCoord, TCoord, time_step, int, int) CXX11_OVERRIDE;
@@ -32,6 +91,158 @@ public:
  * ======== Template implementation ========
  */
 
+/**
+ * Get components of coordinate in the order of placement of values in memory, i.e. third component is the innermost.
+ * Components, which are missing for grids with less than three dimensions, are set to specified value.
+ */
+template <class TCoord>
+void
+DATDumper<TCoord>::expandInStorageOrder (const TCoord &coord,
+                                         grid_coord missing,
+                                         grid_coord &coord1,
+                                         grid_coord &coord2,
+                                         grid_coord &coord3)
+{
+  coord1 = missing;
+  coord2 = missing;
+
+  if (TCoord::dimension == Dimension::Dim1)
+  {
+    coord3 = coord.get1 ();
+  }
+  else if (TCoord::dimension == Dimension::Dim2)
+  {
+    coord2 = coord.get1 ();
+    coord3 = coord.get2 ();
+  }
+  else
+  {
+    coord1 = coord.get1 ();
+    coord2 = coord.get2 ();
+    coord3 = coord.get3 ();
+  }
+}
+
+/**
+ * Copy values of row of grid to the end of buffer. For all time steps values of each point are placed together.
+ * Only active lane of batched grid is copied.
+ */
+template <class TCoord>
+void
+DATDumper<TCoord>::appendRow (Grid<TCoord> *grid,
+                              grid_coord rowStart,
+                              grid_coord rowLength,
+                              int time_step_back,
+                              std::vector<char> &buffer)
+{
+  size_t offset = buffer.size ();
+
+  /*
+   * Distance between values of consecutive points of the same lane
+   */
+  grid_coord lanes = grid->getBatchSize ();
+
+  if (time_step_back == -1)
+  {
+    int steps = grid->getCountStoredSteps ();
+    buffer.resize (offset + rowLength * steps * sizeof (FieldValue));
+
+    FieldValue *values = (FieldValue *) (buffer.data () + offset);
+    for (int i = 0; i < steps; ++i)
+    {
+      const FieldValue *layer = grid->getFieldValue (rowStart, i);
+      for (grid_coord index = 0; index < rowLength; ++index)
+      {
+        values[index * steps + i] = layer[index * lanes];
+      }
+    }
+  }
+  else if (lanes > 1)
+  {
+    buffer.resize (offset + rowLength * sizeof (FieldValue));
+
+    FieldValue *values = (FieldValue *) (buffer.data () + offset);
+    const FieldValue *layer = grid->getFieldValue (rowStart, time_step_back);
+    for (grid_coord index = 0; index < rowLength; ++index)
+    {
+      values[index] = layer[index * lanes];
+    }
+  }
+  else
+  {
+    buffer.resize (offset + rowLength * sizeof (FieldValue));
+    memcpy (buffer.data () + offset, grid->getFieldValue (rowStart, time_step_back), rowLength * sizeof (FieldValue));
+  }
+}
+
+/**
+ * Copy values from box of grid to buffer row by row. If file is specified, buffer is written to it each time it is
+ * filled, otherwise all values are collected in buffer.
+ */
+template <class TCoord>
+void
+DATDumper<TCoord>::collectValues (Grid<TCoord> *grid,
+                                  TCoord startCoord,
+                                  TCoord endCoord,
+                                  int time_step_back,
+                                  std::vector<char> &buffer,
+                                  std::ofstream *file)
+{
+  grid_coord start1, start2, start3;
+  grid_coord end1, end2, end3;
+  grid_coord size1, size2, size3;
+
+  expandInStorageOrder (startCoord, 0, start1, start2, start3);
+  expandInStorageOrder (endCoord, 1, end1, end2, end3);
+  expandInStorageOrder (grid->getSize (), 1, size1, size2, size3);
+
+  grid_coord rowLength = end3 - start3;
+
+  if (file == NULLPTR)
+  {
+    int steps = time_step_back == -1 ? grid->getCountStoredSteps () : 1;
+    buffer.reserve (buffer.size () + (end1 - start1) * (end2 - start2) * rowLength * steps * sizeof (FieldValue));
+  }
+
+  for (grid_coord i = start1; i < end1; ++i)
+  {
+    for (grid_coord j = start2; j < end2; ++j)
+    {
+      appendRow (grid, (i * size2 + j) * size3 + start3, rowLength, time_step_back, buffer);
+
+      if (file != NULLPTR
+          && buffer.size () >= DAT_DUMPER_BUFFER_SIZE)
+      {
+        file->write (buffer.data (), buffer.size ());
+        buffer.clear ();
+      }
+    }
+  }
+
+  if (file != NULLPTR)
+  {
+    file->write (buffer.data (), buffer.size ());
+    buffer.clear ();
+  }
+}
+
+/**
+ * Write all data to file.
+ */
+template <class TCoord>
+void
+DATDumper<TCoord>::writeData (const std::string &fileName,
+                              const std::vector<char> &data)
+{
+  std::ofstream file;
+  file.open (fileName.c_str (), std::ios::out | std::ios::binary);
+  ASSERT (file.is_open());
+
+  file.write (data.data (), data.size ());
+
+  file.close();
+}
+
 /**
  * Save grid to file for specific layer.
  */
@@ -49,32 +260,31 @@ DATDumper<TCoord>::writeToFile (Grid<TCoord> *grid,
   ASSERT (endCoord > zero && endCoord <= grid->getSize ());
 #endif /* DEBUG_INFO */
 
-  std::ofstream file;
-  file.open (this->GridFileManager::names[time_step_back == -1 ? 0 : time_step_back].c_str (), std::ios::out | std::ios::binary);
-  ASSERT (file.is_open());
+  const std::string &fileName = this->GridFileManager::names[time_step_back == -1 ? 0 : time_step_back];
 
-  // Go through all values and write to file.
-  grid_coord end = grid->getSize().calculateTotalCoord ();
-  for (grid_coord iter = 0; iter < end; ++iter)
+#ifdef CXX11_ENABLED
+  if (doWriteInBackground)
   {
-    TCoord pos = grid->calculatePositionFromIndex (iter);
-    if (!(pos >= startCoord && pos < endCoord))
-    {
-      continue;
-    }
+    /*
+     * Values are copied, because grid might be changed or deleted, while they are being written
+     */
+    std::vector<char> data;
+    collectValues (grid, startCoord, endCoord, time_step_back, data, NULLPTR);
 
-    if (time_step_back == -1)
-    {
-      for (int i = 0; i < grid->getCountStoredSteps (); ++i)
-      {
-        file.write ((char*) (grid->getFieldValue (iter, i)), sizeof (FieldValue));
-      }
-    }
-    else
-    {
-      file.write ((char*) (grid->getFieldValue (iter, time_step_back)), sizeof (FieldValue));
-    }
+    waitForWriter ();
+    writerThread = std::thread (&DATDumper<TCoord>::writeData, fileName, std::move (data));
+    return;
   }
+#endif /* CXX11_ENABLED */
+
+  std::ofstream file;
+  file.open (fileName.c_str (), std::ios::out | std::ios::binary);
+  ASSERT (file.is_open());
+
+  std::vector<char> buffer;
+  buffer.reserve (DAT_DUMPER_BUFFER_SIZE);
+
+  collectValues (grid, startCoord, endCoord, time_step_back, buffer, &file);
 
   file.close();
 }
@@ -110,7 +320,7 @@ void
 DATDumper<TCoord>::dumpGrid (Grid<TCoord> *grid, TCoord startCoord, TCoord endCoord,
                              time_step timeStep, int time_step_back, int pid)
 {
-  GridFileManager::setFileNames (time_step_back, timeStep, pid, std::string (grid->getName ()), FILE_TYPE_DAT);
+  GridFileManager::setFileNames (time_step_back == -1 ? -1 : grid->getCountStoredSteps (), timeStep, pid, std::string (grid->getName ()), FILE_TYPE_DAT);
 
   dumpGridInternal (grid, startCoord, endCoord, timeStep, time_step_back);
 }
@@ -3,25 +3,50 @@
 
 #include <iostream>
 #include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "Loader.h"
 
 /**
  * Grid loader from binary files.
  * Template class with coordinate parameter.
+ *
+ * With memory mapping mode file is mapped to memory instead of reading it with stream. If whole grid with single stored
+ * time step is loaded, mapping itself becomes storage of grid (pages are shared with page cache until they are
+ * changed), otherwise values are copied from mapping.
  */
 template <class TCoord>
 class DATLoader: public Loader<TCoord>
 {
+  // Whether to load files through memory mapping.
+  bool doUseMmap;
+
   // Load grid from file for specific layer.
   void loadFromFile (Grid<TCoord> *grid, TCoord, TCoord, int);
 
+  // Load grid from memory mapping of file for specific layer.
+  void loadFromMapping (Grid<TCoord> *grid, TCoord, TCoord, int);
+
   void loadGridInternal (Grid<TCoord> *grid, TCoord, TCoord, time_step, int);
 
 public:
 
+  DATLoader ()
+    : doUseMmap (false)
+  {
+  }
+
   virtual ~DATLoader () {}
 
+  // Set whether to load files through memory mapping.
+  void setUseMmap (bool useMmap)
+  {
+    doUseMmap = useMmap;
+  }
+
   // Virtual method for grid loading.
   virtual void loadGrid (Grid<TCoord> *grid, TCoord, TCoord, time_step, int, int) CXX11_OVERRIDE;
   virtual void loadGrid (Grid<TCoord> *grid, TCoord, TCoord, time_step, int,
@@ -90,6 +115,78 @@ DATLoader<TCoord>::loadFromFile (Grid<TCoord> *grid,
   file.close();
 }
 
+/**
+ * Load grid from memory mapping of file for specific layer.
+ */
+template <class TCoord>
+void
+DATLoader<TCoord>::loadFromMapping (Grid<TCoord> *grid,
+                                    TCoord startCoord,
+                                    TCoord endCoord,
+                                    int time_step_back)
+{
+  ASSERT ((time_step_back == -1) || (time_step_back >= 0 && time_step_back < grid->getCountStoredSteps ()));
+
+  TCoord zero = startCoord - startCoord;
+  int storedSteps = time_step_back == -1 ? grid->getCountStoredSteps () : 1;
+
+  int fd = open (this->GridFileManager::names[time_step_back == -1 ? 0 : time_step_back].c_str (), O_RDONLY);
+  ALWAYS_ASSERT (fd != -1);
+
+  struct stat fileStat;
+  ALWAYS_ASSERT (fstat (fd, &fileStat) == 0);
+
+  size_t fileSize = (size_t) fileStat.st_size;
+  ALWAYS_ASSERT (fileSize == (endCoord - startCoord).calculateTotalCoord () * storedSteps * sizeof (FieldValue));
+
+  /*
+   * Mapping is private, so that values of grid could be changed after load without changing file
+   */
+  void *mapping = mmap (NULLPTR, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  ALWAYS_ASSERT (mapping != MAP_FAILED);
+
+  close (fd);
+
+  if (grid->getCountStoredSteps () == 1
+      && startCoord == zero
+      && endCoord == grid->getSize ())
+  {
+    grid->adoptMappedValues ((FieldValue *) mapping, fileSize);
+    return;
+  }
+
+  const FieldValue *values = (const FieldValue *) mapping;
+
+  /*
+   * Points of box follow in file in the same order as in grid, so mapping is read sequentially
+   */
+  grid_coord end = grid->getSize().calculateTotalCoord ();
+  for (grid_coord iter = 0; iter < end; ++iter)
+  {
+    TCoord pos = grid->calculatePositionFromIndex (iter);
+    if (!(pos >= startCoord && pos < endCoord))
+    {
+      continue;
+    }
+
+    if (time_step_back == -1)
+    {
+      for (int i = 0; i < storedSteps; ++i)
+      {
+        grid->setFieldValue (*values++, iter, i);
+      }
+    }
+    else
+    {
+      grid->setFieldValue (*values++, iter, time_step_back);
+    }
+  }
+
+  ASSERT ((const char *) values == (const char *) mapping + fileSize);
+
+  munmap (mapping, fileSize);
+}
+
 template <class TCoord>
 void
 DATLoader<TCoord>::loadGridInternal (Grid<TCoord> *grid, TCoord startCoord, TCoord endCoord,
@@ -108,7 +205,14 @@ DATLoader<TCoord>::loadGridInternal (Grid<TCoord> *grid, TCoord startCoord, TCoo
               << ". Size: " << size.calculateTotalCoord () << " (from startCoord to endCoord). " << std::endl;
   }
 
-  loadFromFile (grid, startCoord, endCoord, time_step_back);
+  if (doUseMmap)
+  {
+    loadFromMapping (grid, startCoord, endCoord, time_step_back);
+  }
+  else
+  {
+    loadFromFile (grid, startCoord, endCoord, time_step_back);
+  }
 
   std::cout << "Loaded. " << std::endl;
 }
@@ -121,7 +225,7 @@ void
 DATLoader<TCoord>::loadGrid (Grid<TCoord> *grid, TCoord startCoord, TCoord endCoord,
                              time_step timeStep, int time_step_back, int pid)
 {
-  GridFileManager::setFileNames (time_step_back, timeStep, pid, std::string (grid->getName ()), FILE_TYPE_DAT);
+  GridFileManager::setFileNames (time_step_back == -1 ? -1 : grid->getCountStoredSteps (), timeStep, pid, std::string (grid->getName ()), FILE_TYPE_DAT);
 
   loadGridInternal (grid, startCoord, endCoord, timeStep, time_step_back);
 }
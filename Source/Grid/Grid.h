@@ -2,9 +2,12 @@
 #define GRID_H
 
 #include <cstdlib>
+#include <cstdio>
 #include <vector>
 #include <string>
 #include <cstring>
+#include <new>
+#include <sys/mman.h>
 
 #include "Assert.h"
 #include "FieldValue.h"
@@ -16,6 +19,12 @@
  */
 typedef std::vector<FieldValue> VectorFieldValues;
 
+/**
+ * Alignment (in bytes) of each time step layer in grid storage, when ALIGNED_GRID_VALUES is enabled.
+ * Equals to size of cache line on most CPUs and to widest vector register size (AVX-512).
+ */
+#define GRID_VALUES_ALIGNMENT (64)
+
 /**
  * Non-parallel grid class.
  */
@@ -30,15 +39,55 @@ protected:
   TCoord size;
 
   /**
-   * Vector of points in grid.
+   * Single slab of memory with points of all stored time steps.
+   * Time step layers are placed one after another with stride of stepStride values.
+   */
+  FieldValue *rawValues;
+
+  /**
+   * Number of values between starts of consecutive time step layers in rawValues
+   * (equal to number of values in grid, possibly rounded up to alignment).
+   */
+  grid_coord stepStride;
+
+  /**
+   * Number of values stored for each point (lanes of batched independent simulations). Values of all lanes of point
+   * are placed together, i.e. value of lane l of point with index i is at i * batchSize + l. Without
+   * BATCHED_GRID_VALUES this is always 1.
+   */
+  int batchSize;
+
+  /**
+   * Lane, values of which are accessed by point accessors (getFieldValue, setFieldValue) and name of which is returned
+   * by getName. Grid with single lane always has zero active lane.
+   */
+  int activeLane;
+
+  /**
+   * Pointers to time step layers in rawValues (0 is current, 1 is previous, etc.).
+   */
+  std::vector<FieldValue *> gridValues;
+
+  /**
+   * Size in bytes of memory mapping, which is used as rawValues instead of allocated slab (0 if slab is allocated).
    */
-  std::vector<VectorFieldValues *> gridValues;
+  size_t mappedSize;
+
+  /**
+   * Whether rawValues is memory, which is owned by someone else (e.g. shared memory window), and is not freed by grid.
+   */
+  bool isExternalValues;
 
   /**
    * Name of the grid.
    */
   std::string gridName;
 
+  /**
+   * Names of lanes of the grid (empty for grid with single lane).
+   */
+  std::vector<std::string> laneNames;
+
   /*
    * TODO: add debug uninitialized flag
    */
@@ -57,6 +106,11 @@ protected:
 
   bool isLegitIndex (const TCoord &) const;
 
+  int getStoredLayer (int) const;
+
+  void allocateValues ();
+  void freeValues ();
+
 public:
 
   Grid (const TCoord&, int, const char * = "unnamed");
@@ -70,6 +124,8 @@ public:
 
   virtual TCoord getComputationStart (const TCoord &) const;
   virtual TCoord getComputationEnd (const TCoord &) const;
+  virtual TCoord getComputationInnerStart (const TCoord &) const;
+  virtual TCoord getComputationInnerEnd (const TCoord &) const;
   TCoord calculatePositionFromIndex (grid_coord) const;
   grid_coord calculateIndexFromPosition (const TCoord &) const;
 
@@ -106,6 +162,23 @@ public:
 
   FieldValue * getRaw (int);
 
+  void adoptMappedValues (FieldValue *, size_t);
+  void adoptExternalValues (FieldValue *);
+
+  void setBatchSize (int);
+
+  int getBatchSize () const
+  {
+    return batchSize;
+  }
+
+  void setActiveLane (int);
+
+  int getActiveLane () const
+  {
+    return activeLane;
+  }
+
   int getCountStoredSteps () const
   {
     return gridValues.size ();
@@ -114,14 +187,14 @@ public:
   void copy (const Grid<TCoord> *grid)
   {
     ASSERT (size == grid->size);
+    ASSERT (batchSize == grid->batchSize);
     ASSERT (gridValues.size () == grid->gridValues.size ());
 
     for (int i = 0; i < gridValues.size (); ++i)
     {
-      ASSERT (gridValues[i]->size () == grid->gridValues[i]->size ());
-      ASSERT (gridValues[i]->capacity () == grid->gridValues[i]->capacity ())
+      ASSERT (gridValues[i] != NULLPTR && grid->gridValues[i] != NULLPTR);
 
-      memcpy (&(*gridValues[i])[0], &(*grid->gridValues[i])[0], grid->gridValues[i]->size () * sizeof (FieldValue));
+      memcpy (gridValues[i], grid->gridValues[i], size.calculateTotalCoord () * batchSize * sizeof (FieldValue));
     }
   }
 }; /* Grid */
@@ -134,15 +207,18 @@ Grid<TCoord>::Grid (const TCoord &s, /**< size of grid */
                     int storedSteps, /**< number of steps in time for which to store grid values */
                     const char *name) /**< name of grid */
   : size (s)
+  , rawValues (NULLPTR)
+  , stepStride (0)
+  , batchSize (1)
+  , activeLane (0)
   , gridValues (storedSteps)
+  , mappedSize (0)
+  , isExternalValues (false)
   , gridName (name)
 {
   ASSERT (storedSteps > 0);
 
-  for (int i = 0; i < gridValues.size (); ++i)
-  {
-    gridValues[i] = new VectorFieldValues (size.calculateTotalCoord ());
-  }
+  allocateValues ();
 
   DPRINTF (LOG_LEVEL_STAGES_AND_DUMP, "New grid '%s' with %lu stored steps and raw size: %llu.\n",
     gridName.data (), gridValues.size (), (unsigned long long)size.calculateTotalCoord ());
@@ -154,7 +230,13 @@ Grid<TCoord>::Grid (const TCoord &s, /**< size of grid */
 template <class TCoord>
 Grid<TCoord>::Grid (int storedSteps, /**< number of steps in time for which to store grid values */
                     const char *name) /**< name of grid */
-  : gridValues (storedSteps)
+  : rawValues (NULLPTR)
+  , stepStride (0)
+  , batchSize (1)
+  , activeLane (0)
+  , gridValues (storedSteps)
+  , mappedSize (0)
+  , isExternalValues (false)
   , gridName (name)
 {
   ASSERT (storedSteps > 0);
@@ -174,12 +256,87 @@ Grid<TCoord>::Grid (int storedSteps, /**< number of steps in time for which to s
 template <class TCoord>
 Grid<TCoord>::~Grid ()
 {
+  freeValues ();
+} /* Grid<TCoord>::~Grid */
+
+/**
+ * Allocate single slab for all stored time steps of grid with current size and zero it.
+ *
+ * With ALIGNED_GRID_VALUES each time step layer starts at GRID_VALUES_ALIGNMENT boundary,
+ * so that vectorized loops over raw layers have aligned loads and stores.
+ *
+ * NOTE: complex values are stored interleaved (real and imaginary parts of each value are placed together), there is
+ *       no layout with separate planes of real and imaginary parts, because all users of grid (schemes, share buffers,
+ *       dumpers, Cuda grids) access values through FieldValue pointers.
+ */
+template <class TCoord>
+void
+Grid<TCoord>::allocateValues ()
+{
+  ASSERT (rawValues == NULLPTR);
+  ASSERT (gridValues.size () > 0);
+
+  stepStride = size.calculateTotalCoord () * batchSize;
+
+#ifdef ALIGNED_GRID_VALUES
+  const grid_coord valuesInAlignment = GRID_VALUES_ALIGNMENT / sizeof (FieldValue);
+  if (valuesInAlignment > 1)
+  {
+    stepStride = ((stepStride + valuesInAlignment - 1) / valuesInAlignment) * valuesInAlignment;
+  }
+
+  void *ptr = NULLPTR;
+  int retCode = posix_memalign (&ptr, GRID_VALUES_ALIGNMENT, gridValues.size () * stepStride * sizeof (FieldValue));
+  ALWAYS_ASSERT (retCode == 0 && ptr != NULLPTR);
+  rawValues = (FieldValue *) ptr;
+#else /* ALIGNED_GRID_VALUES */
+  rawValues = (FieldValue *) malloc (gridValues.size () * stepStride * sizeof (FieldValue));
+  ALWAYS_ASSERT (rawValues != NULLPTR);
+#endif /* !ALIGNED_GRID_VALUES */
+
+  grid_coord total = gridValues.size () * stepStride;
+  for (grid_coord i = 0; i < total; ++i)
+  {
+    new (rawValues + i) FieldValue (FIELDVALUE (0, 0));
+  }
+
+  for (int i = 0; i < gridValues.size (); ++i)
+  {
+    gridValues[i] = rawValues + i * stepStride;
+  }
+} /* Grid<TCoord>::allocateValues */
+
+/**
+ * Free slab with all stored time steps of grid
+ */
+template <class TCoord>
+void
+Grid<TCoord>::freeValues ()
+{
+  /*
+   * FieldValue is trivially destructible, so memory could be freed right away
+   */
+  if (isExternalValues)
+  {
+    isExternalValues = false;
+  }
+  else if (mappedSize > 0)
+  {
+    munmap (rawValues, mappedSize);
+    mappedSize = 0;
+  }
+  else
+  {
+    free (rawValues);
+  }
+  rawValues = NULLPTR;
+  stepStride = 0;
+
   for (int i = 0; i < gridValues.size (); ++i)
   {
-    delete gridValues[i];
     gridValues[i] = NULLPTR;
   }
-} /* Grid<TCoord>::~Grid */
+} /* Grid<TCoord>::freeValues */
 
 /**
  * Check whether position is appropriate to get/set value from
@@ -193,6 +350,22 @@ Grid<TCoord>::isLegitIndex (const TCoord& position) const /**< coordinate in gri
   return isLegitIndex (position, size);
 } /* Grid<TCoord>::isLegitIndex */
 
+/**
+ * Get index of stored time step layer, which corresponds to time step.
+ * Grid with single stored time step is updated in-place, so all time steps resolve to the same layer.
+ *
+ * @return index of stored time step layer
+ */
+template <class TCoord>
+int
+Grid<TCoord>::getStoredLayer (int time_step_back) const /**< index of previous time step, starting from current (0) */
+{
+  ASSERT (time_step_back >= 0);
+  ASSERT (time_step_back < gridValues.size () || gridValues.size () == 1);
+
+  return gridValues.size () == 1 ? 0 : time_step_back;
+} /* Grid<TCoord>::getStoredLayer */
+
 /**
  * Calculate one-dimensional coordinate from N-dimensional position
  *
@@ -229,6 +402,34 @@ Grid<TCoord>::getComputationEnd (const TCoord & diffPosEnd) const
   return getSize () - diffPosEnd;
 } /* Grid<TCoord>::getComputationEnd () */
 
+/**
+ * Get first coordinate of inner part of chunk, computations for which do not depend on values in buffers
+ *
+ * NOTE: grid without buffers has only inner part
+ *
+ * @return first coordinate of inner part of chunk
+ */
+template <class TCoord>
+TCoord
+Grid<TCoord>::getComputationInnerStart (const TCoord & start) const /**< first coordinate of chunk */
+{
+  return start;
+} /* Grid<TCoord>::getComputationInnerStart () */
+
+/**
+ * Get last coordinate of inner part of chunk, computations for which do not depend on values in buffers
+ *
+ * NOTE: grid without buffers has only inner part
+ *
+ * @return last coordinate of inner part of chunk
+ */
+template <class TCoord>
+TCoord
+Grid<TCoord>::getComputationInnerEnd (const TCoord & end) const /**< last coordinate of chunk */
+{
+  return end;
+} /* Grid<TCoord>::getComputationInnerEnd () */
+
 /**
  * Set field value at coordinate in grid
  */
@@ -239,7 +440,6 @@ Grid<TCoord>::setFieldValue (const FieldValue & value, /**< field point value */
                              int time_step_back) /**< index of previous time step, starting from current (0) */
 {
   ASSERT (isLegitIndex (position));
-  ASSERT (time_step_back < gridValues.size ());
 
   grid_coord coord = calculateIndexFromPosition (position);
 
@@ -256,9 +456,12 @@ Grid<TCoord>::setFieldValue (const FieldValue & value, /**< field point value */
                              int time_step_back) /**< index of previous time step, starting from current (0) */
 {
   ASSERT (coord >= 0 && coord < size.calculateTotalCoord ());
-  ASSERT (time_step_back < gridValues.size ());
 
-  (*gridValues[time_step_back])[coord] = value;
+#ifdef BATCHED_GRID_VALUES
+  gridValues[getStoredLayer (time_step_back)][coord * batchSize + activeLane] = value;
+#else /* BATCHED_GRID_VALUES */
+  gridValues[getStoredLayer (time_step_back)][coord] = value;
+#endif /* !BATCHED_GRID_VALUES */
 } /* Grid<TCoord>::setFieldValue */
 
 /**
@@ -272,7 +475,6 @@ Grid<TCoord>::getFieldValue (const TCoord &position, /**< coordinate in grid */
                              int time_step_back) /**< index of previous time step, starting from current (0) */
 {
   ASSERT (isLegitIndex (position));
-  ASSERT (time_step_back < gridValues.size ());
 
   grid_coord coord = calculateIndexFromPosition (position);
 
@@ -290,9 +492,12 @@ Grid<TCoord>::getFieldValue (grid_coord coord, /**< index in grid */
                              int time_step_back) /**< index of previous time step, starting from current (0) */
 {
   ASSERT (coord >= 0 && coord < size.calculateTotalCoord ());
-  ASSERT (time_step_back < gridValues.size ());
 
-  return &(*gridValues[time_step_back])[coord];
+#ifdef BATCHED_GRID_VALUES
+  return &gridValues[getStoredLayer (time_step_back)][coord * batchSize + activeLane];
+#else /* BATCHED_GRID_VALUES */
+  return &gridValues[getStoredLayer (time_step_back)][coord];
+#endif /* !BATCHED_GRID_VALUES */
 } /* Grid<TCoord>::getFieldValue */
 
 /**
@@ -393,7 +598,7 @@ Grid<TCoord>::getRelativePosition (const TCoord & pos) const /**< position in gr
 } /* gGrid<TCoord>::getRelativePosition */
 
 /**
- * Get name of grid
+ * Get name of grid (name of active lane for grid with multiple lanes)
  *
  * @return name of grid
  */
@@ -401,11 +606,16 @@ template <class TCoord>
 const char *
 Grid<TCoord>::getName () const
 {
+  if (batchSize > 1)
+  {
+    return laneNames[activeLane].c_str ();
+  }
+
   return gridName.c_str ();
 } /* Grid<TCoord>::getName */
 
 /**
- * Initialize current grid field values with default values
+ * Initialize current grid field values of all lanes with default values
  */
 template <class TCoord>
 void
@@ -413,21 +623,115 @@ Grid<TCoord>::initialize (const FieldValue & cur)
 {
   ASSERT (gridValues.size () > 0);
 
-  for (grid_coord i = 0; i < gridValues[0]->size (); ++i)
+  for (grid_coord i = 0; i < size.calculateTotalCoord () * batchSize; ++i)
   {
-    (*gridValues[0])[i] = cur;
+    gridValues[0][i] = cur;
   }
 } /* Grid<TCoord>::initialize */
 
+/**
+ * Get time step layer with values of all lanes of all points (see Grid::batchSize for placement of lanes)
+ *
+ * @return start of time step layer
+ */
 template <class TCoord>
 FieldValue *
 Grid<TCoord>::getRaw (int time_step_back)
 {
-  ASSERT (time_step_back < gridValues.size ());
-
-  return &(*gridValues[time_step_back])[0];
+  return gridValues[getStoredLayer (time_step_back)];
 }
 
+/**
+ * Set number of values stored for each point. Storage is reallocated and all values are set to zero, so this should
+ * be done right after creation of grid. Lane l of grid with multiple lanes is named <name>_lane<l>. Multiple lanes
+ * require BATCHED_GRID_VALUES, otherwise point accessors do not compute index of lane at all.
+ */
+template <class TCoord>
+void
+Grid<TCoord>::setBatchSize (int lanes) /**< number of lanes */
+{
+  ASSERT (lanes > 0);
+#ifndef BATCHED_GRID_VALUES
+  ALWAYS_ASSERT (lanes == 1);
+#endif /* !BATCHED_GRID_VALUES */
+  ASSERT (!isExternalValues && mappedSize == 0);
+
+  freeValues ();
+
+  batchSize = lanes;
+  activeLane = 0;
+
+  laneNames.clear ();
+  if (batchSize > 1)
+  {
+    for (int lane = 0; lane < batchSize; ++lane)
+    {
+      char laneSuffix[32];
+      snprintf (laneSuffix, sizeof (laneSuffix), "_lane%d", lane);
+      laneNames.push_back (gridName + std::string (laneSuffix));
+    }
+  }
+
+  allocateValues ();
+} /* Grid<TCoord>::setBatchSize */
+
+/**
+ * Set lane, which is accessed by point accessors. Grid with single lane ignores this, so that lane could be set for
+ * all grids at once.
+ */
+template <class TCoord>
+void
+Grid<TCoord>::setActiveLane (int lane) /**< lane */
+{
+  ASSERT (lane >= 0);
+  ASSERT (batchSize == 1 || lane < batchSize);
+
+  activeLane = batchSize > 1 ? lane : 0;
+} /* Grid<TCoord>::setActiveLane */
+
+/**
+ * Replace storage of grid with single stored time step with memory mapping of file, which contains all values of grid
+ * in the order of their placement in memory (e.g. .dat file). Grid takes ownership of mapping and unmaps it when
+ * storage is freed. Mapping should be private, if values of grid are changed after that.
+ */
+template <class TCoord>
+void
+Grid<TCoord>::adoptMappedValues (FieldValue *mapping, /**< start of mapping */
+                                 size_t mappingSize) /**< size of mapping in bytes */
+{
+  ASSERT (gridValues.size () == 1);
+  ASSERT (batchSize == 1);
+  ASSERT (mapping != NULLPTR);
+  ALWAYS_ASSERT (mappingSize == size.calculateTotalCoord () * sizeof (FieldValue));
+
+  freeValues ();
+
+  rawValues = mapping;
+  mappedSize = mappingSize;
+  stepStride = size.calculateTotalCoord ();
+  gridValues[0] = rawValues;
+} /* Grid<TCoord>::adoptMappedValues */
+
+/**
+ * Replace storage of grid with single stored time step with external memory, which contains all values of grid in the
+ * order of their placement in memory. Grid doesn't free this memory, so it should stay valid while grid exists.
+ */
+template <class TCoord>
+void
+Grid<TCoord>::adoptExternalValues (FieldValue *values) /**< start of values */
+{
+  ASSERT (gridValues.size () == 1);
+  ASSERT (batchSize == 1);
+  ASSERT (values != NULLPTR);
+
+  freeValues ();
+
+  rawValues = values;
+  isExternalValues = true;
+  stepStride = size.calculateTotalCoord ();
+  gridValues[0] = rawValues;
+} /* Grid<TCoord>::adoptExternalValues */
+
 /**
  * Replace previous time layer with current and so on
  */
@@ -440,7 +744,7 @@ Grid<TCoord>::shiftInTime ()
    */
   ASSERT (gridValues.size () > 0);
 
-  VectorFieldValues *oldest = gridValues[gridValues.size () - 1];
+  FieldValue *oldest = gridValues[gridValues.size () - 1];
 
   for (int i = gridValues.size () - 1; i >= 1; --i)
   {
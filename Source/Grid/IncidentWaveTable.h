@@ -0,0 +1,192 @@
+#ifndef INCIDENT_WAVE_TABLE_H
+#define INCIDENT_WAVE_TABLE_H
+
+#include <vector>
+
+#include "Assert.h"
+#include "FieldValue.h"
+#include "Grid.h"
+
+/**
+ * Index of incident wave, which means sum of all incident waves
+ */
+#define ALL_INCIDENT_WAVES (-1)
+
+/**
+ * Precomputed projection of one field component of TF/SF incident waves.
+ *
+ * Incident wave value at some point of 3D grid is interpolated from auxiliary 1D grid by distance d from zero point
+ * of auxiliary grid, projected on direction of incident wave, i.e. d = x * sin(a1) * cos(a2) + y * sin(a1) * sin(a2)
+ * + z * cos(a1) - shift. Distance is separable over axes, so contributions of each coordinate on each axis are
+ * computed once and stored in three small tables (total size is sum of grid sizes over axes). Afterwards, value of
+ * incident wave at any point of TF/SF border is obtained with two additions, two reads from auxiliary grid and
+ * linear interpolation, without any trigonometry.
+ *
+ * Component of field is obtained from scalar incident wave with constant factor, which is also stored in table.
+ *
+ * Several incident waves might be launched simultaneously. Auxiliary grids of all waves are stored one after another
+ * in a single 1D grid, and tables of all waves are stored one after another in the same arrays. Value of field
+ * component is the sum of values of all incident waves, or value of single wave, when waves excite separate lanes of
+ * batched grids.
+ */
+class IncidentWaveTable
+{
+  /**
+   * Number of incident waves
+   */
+  int wavesCount;
+
+  /**
+   * Size of auxiliary grid of one incident wave
+   */
+  grid_coord waveSize;
+
+  /**
+   * Sizes of grid of field component by each axis
+   */
+  GridCoordinate3D size;
+
+  /**
+   * Contributions of coordinates on each axis to distance (for all waves, one after another)
+   */
+  std::vector<FPValue> offsetX;
+  std::vector<FPValue> offsetY;
+  std::vector<FPValue> offsetZ;
+
+  /**
+   * Shift of distance (position of component in auxiliary grid relative to E incident wave)
+   */
+  FPValue shift;
+
+  /**
+   * Factors to obtain field component from scalar incident wave (for all waves)
+   */
+  std::vector<FPValue> projection;
+
+public:
+
+  /**
+   * Constructor, which sets contributions of all coordinates and projection factors to zero
+   */
+  IncidentWaveTable (GridCoordinate3D gridSize, /**< size of grid of field component (1 for absent axes) */
+                     FPValue distanceShift, /**< shift of distance */
+                     int count, /**< number of incident waves */
+                     grid_coord countPerWave) /**< size of auxiliary grid of one incident wave */
+    : wavesCount (count)
+    , waveSize (countPerWave)
+    , size (gridSize)
+    , offsetX (count * gridSize.get1 (), FPValue (0))
+    , offsetY (count * gridSize.get2 (), FPValue (0))
+    , offsetZ (count * gridSize.get3 (), FPValue (0))
+    , shift (distanceShift)
+    , projection (count, FPValue (0))
+  {
+    ASSERT (size.get1 () > 0 && size.get2 () > 0 && size.get3 () > 0);
+    ASSERT (wavesCount > 0 && waveSize > 0);
+  }
+
+  /**
+   * Set factor to obtain field component from scalar incident wave
+   */
+  void setProjection (int wave, /**< index of incident wave */
+                      FPValue projectionFactor) /**< factor to obtain field component from incident wave */
+  {
+    ASSERT (wave >= 0 && wave < wavesCount);
+    projection[wave] = projectionFactor;
+  }
+
+  /**
+   * Set contribution of coordinate on axis to distance
+   */
+  void setOffset (int wave, /**< index of incident wave */
+                  CoordinateType axis, /**< axis */
+                  grid_coord coord, /**< coordinate on axis */
+                  FPValue offset) /**< contribution to distance */
+  {
+    ASSERT (wave >= 0 && wave < wavesCount);
+
+    switch (axis)
+    {
+      case CoordinateType::X:
+      {
+        ASSERT (coord >= 0 && coord < size.get1 ());
+        offsetX[wave * size.get1 () + coord] = offset;
+        break;
+      }
+      case CoordinateType::Y:
+      {
+        ASSERT (coord >= 0 && coord < size.get2 ());
+        offsetY[wave * size.get2 () + coord] = offset;
+        break;
+      }
+      case CoordinateType::Z:
+      {
+        ASSERT (coord >= 0 && coord < size.get3 ());
+        offsetZ[wave * size.get3 () + coord] = offset;
+        break;
+      }
+      default:
+      {
+        UNREACHABLE;
+      }
+    }
+  }
+
+  /**
+   * Get value of field component of incident waves at point
+   *
+   * @return value of field component of single incident wave or sum of values of all incident waves
+   */
+  FieldValue approximate (const GridCoordinate3D &pos, /**< total position of point (0 for absent axes) */
+                          Grid<GridCoordinate1D> *FieldInc, /**< auxiliary grid of incident waves */
+                          int wave) const /**< index of incident wave or ALL_INCIDENT_WAVES */
+  {
+    ASSERT (pos.get1 () >= 0 && pos.get1 () < size.get1 ());
+    ASSERT (pos.get2 () >= 0 && pos.get2 () < size.get2 ());
+    ASSERT (pos.get3 () >= 0 && pos.get3 () < size.get3 ());
+    ASSERT (FieldInc->getSize ().get1 () == wavesCount * waveSize);
+
+    if (wave != ALL_INCIDENT_WAVES)
+    {
+      ASSERT (wave >= 0 && wave < wavesCount);
+      return approximateWave (pos, FieldInc, wave);
+    }
+
+    FieldValue res = getFieldValueRealOnly (FPValue (0));
+
+    for (int i = 0; i < wavesCount; ++i)
+    {
+      res += approximateWave (pos, FieldInc, i);
+    }
+
+    return res;
+  }
+
+private:
+
+  /**
+   * Get value of field component of single incident wave at point
+   *
+   * @return value of field component
+   */
+  FieldValue approximateWave (const GridCoordinate3D &pos, /**< total position of point (0 for absent axes) */
+                              Grid<GridCoordinate1D> *FieldInc, /**< auxiliary grid of incident waves */
+                              int wave) const /**< index of incident wave */
+  {
+    FPValue d = offsetX[wave * size.get1 () + pos.get1 ()]
+                + offsetY[wave * size.get2 () + pos.get2 ()]
+                + offsetZ[wave * size.get3 () + pos.get3 ()] - shift;
+    ASSERT (d > 0 && d < waveSize - 1);
+
+    grid_coord coord1 = (grid_coord) d;
+    FPValue proportionD2 = d - FPValue (coord1);
+    FPValue proportionD1 = 1 - proportionD2;
+
+    FieldValue val1 = *FieldInc->getFieldValue (wave * waveSize + coord1, 1);
+    FieldValue val2 = *FieldInc->getFieldValue (wave * waveSize + coord1 + 1, 1);
+
+    return (val1 * proportionD1 + val2 * proportionD2) * projection[wave];
+  }
+}; /* IncidentWaveTable */
+
+#endif /* INCIDENT_WAVE_TABLE_H */
@@ -0,0 +1,151 @@
+#ifndef MATERIAL_ID_GRID_H
+#define MATERIAL_ID_GRID_H
+
+#include <map>
+#include <vector>
+#include <utility>
+
+#include "Assert.h"
+#include "FieldValue.h"
+
+/**
+ * Type of material identifier. Each point of grid stores identifier of its material instead of precomputed values.
+ */
+typedef uint16_t material_id;
+
+/**
+ * Maximum number of distinct materials, which could be stored in material identifier grid
+ */
+#define MATERIAL_ID_MAX_COUNT (1 << (8 * sizeof (material_id)))
+
+/**
+ * Compact replacement for pair of precomputed grids of update coefficients (Ca and Cb, or Da and Db).
+ *
+ * Coefficients of each point are classified once, i.e. equal pairs of coefficients get the same identifier. Grid
+ * stores only identifier for each point (in the same linear order as the corresponding field grid), and coefficients
+ * themselves are stored in small table, indexed by identifier. Table stores coefficients with precision, in which
+ * updates are computed (FieldComputeValue), so in mixed precision mode they are not rounded to precision of grids.
+ */
+class MaterialIdGrid
+{
+  /**
+   * Identifiers of materials for all points of grid
+   */
+  std::vector<material_id> ids;
+
+  /**
+   * Tables of coefficients for each identifier
+   */
+  std::vector<FieldComputeValue> tableCa;
+  std::vector<FieldComputeValue> tableCb;
+
+  /**
+   * Identifiers of already classified pairs of coefficients
+   */
+  std::map< std::pair<FPComputeValue, FPComputeValue>, material_id > classified;
+
+public:
+
+  /**
+   * Constructor, which sets identifiers of all points to identifier of pair of zero coefficients
+   */
+  MaterialIdGrid (grid_coord size) /**< total number of points in grid */
+    : ids (size, 0)
+  {
+    ASSERT (size > 0);
+    getId (FPComputeValue (0), FPComputeValue (0));
+  }
+
+  /**
+   * Get identifier of pair of coefficients, adding pair to table if it is encountered for the first time
+   *
+   * @return identifier of pair of coefficients
+   */
+  material_id getId (FPComputeValue ca, /**< value of first coefficient */
+                     FPComputeValue cb) /**< value of second coefficient */
+  {
+    std::pair<FPComputeValue, FPComputeValue> key (ca, cb);
+
+    std::map< std::pair<FPComputeValue, FPComputeValue>, material_id >::iterator it = classified.find (key);
+    if (it != classified.end ())
+    {
+      return it->second;
+    }
+
+    if (tableCa.size () == MATERIAL_ID_MAX_COUNT)
+    {
+      ALWAYS_ASSERT_MESSAGE ("Too many distinct materials for material identifier grid. Use --use-ca-cb instead.");
+    }
+
+    material_id id = (material_id) tableCa.size ();
+
+    tableCa.push_back (FIELDCOMPUTEVALUE (ca, 0));
+    tableCb.push_back (FIELDCOMPUTEVALUE (cb, 0));
+    classified[key] = id;
+
+    return id;
+  }
+
+  /**
+   * Set coefficients of point
+   */
+  void setCoefficients (grid_coord index, /**< linear index of point */
+                        FPComputeValue ca, /**< value of first coefficient */
+                        FPComputeValue cb) /**< value of second coefficient */
+  {
+    ASSERT (index >= 0 && index < (grid_coord) ids.size ());
+    ids[index] = getId (ca, cb);
+  }
+
+  /**
+   * Get number of points in grid
+   *
+   * @return number of points in grid
+   */
+  grid_coord getSize () const
+  {
+    return ids.size ();
+  }
+
+  /**
+   * Get number of distinct materials (including pair of zero coefficients)
+   *
+   * @return number of distinct materials
+   */
+  size_t getMaterialsCount () const
+  {
+    return tableCa.size ();
+  }
+
+  /**
+   * Get raw array of identifiers of all points
+   *
+   * @return raw array of identifiers
+   */
+  const material_id *getRawIds () const
+  {
+    return &ids[0];
+  }
+
+  /**
+   * Get raw table of first coefficient
+   *
+   * @return raw table of first coefficient
+   */
+  const FieldComputeValue *getRawCa () const
+  {
+    return &tableCa[0];
+  }
+
+  /**
+   * Get raw table of second coefficient
+   *
+   * @return raw table of second coefficient
+   */
+  const FieldComputeValue *getRawCb () const
+  {
+    return &tableCb[0];
+  }
+}; /* MaterialIdGrid */
+
+#endif /* MATERIAL_ID_GRID_H */
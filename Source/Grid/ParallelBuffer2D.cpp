@@ -1,7 +1,5 @@
 #include "ParallelGrid.h"
 
-#include <cmath>
-
 #ifdef PARALLEL_GRID
 
 #if defined (PARALLEL_BUFFER_DIMENSION_2D_XY) \
@@ -9,99 +7,48 @@
     || defined (PARALLEL_BUFFER_DIMENSION_2D_XZ)
 
 /**
- * Helper struct for pairs
- */
-struct Pair
-{
-  grid_coord n; /**< first axis nodes grid size */
-  grid_coord m; /**< second axis nodes grid size */
-
-  /**
-   * Constructor with nodes grid sizes
-   */
-  Pair (grid_coord newN = 0, /**< first axis nodes grid size */
-        grid_coord newM = 0) /**< second axis nodes grid size */
-    : n (newN)
-  , m (newM)
-  {
-  } /* Pair */
-}; /* Pair */
-
-/**
- * Initialize parallel grid virtual topology as optimal for current number of processes and specified grid sizes
+ * Initialize parallel grid virtual topology as optimal for current number of processes and specified grid sizes.
+ *
+ * All pairs of node grid sizes are considered, including the ones with single node by some axis (i.e. 1D virtual
+ * topologies), and the one with the least estimated time of time step is chosen (see estimateTopologyTime). In case
+ * of equal estimates split by the first axis is preferred, because its buffers are contiguous in memory.
  */
 void
 ParallelGridCore::initOptimal (grid_coord size1, /**< grid size by first axis */
                                grid_coord size2, /**< grid size by second axis */
+                               grid_coord size3, /**< grid size by axis, which is not split (1 for 2D grids) */
                                int &nodeGridSize1, /**< out: first axis nodes grid size */
                                int &nodeGridSize2) /**< out: second axis nodes grid size */
 {
-  /*
-   * Find allowed pairs of node grid sizes
-   */
-  std::vector<Pair> allowedPairs;
-
-  grid_coord gcd1 = ParallelGridCore::greatestCommonDivider (size1, (grid_coord) totalProcCount);
+  DOUBLE minTime = DOUBLE (0);
+  bool isFound = false;
 
-  for (grid_coord n = 1; n <= gcd1; ++n)
+  for (int n = totalProcCount; n >= 1; --n)
   {
-    if (gcd1 % n != 0)
+    if (totalProcCount % n != 0)
     {
       continue;
     }
 
-    DOUBLE m_fp = ((DOUBLE) totalProcCount) / ((DOUBLE) n);
-    grid_coord m = (grid_coord) m_fp;
-
-    DOUBLE b1_fp = ((DOUBLE) size2) / ((DOUBLE)m);
-    grid_coord b1 = (grid_coord) b1_fp;
+    int m = totalProcCount / n;
 
-    if (m == m_fp && b1 == b1_fp)
+    if (n > size1 || m > size2)
     {
-      allowedPairs.push_back (Pair (n, m));
+      continue;
     }
-  }
 
-  ASSERT (allowedPairs.size () > 0);
+    DOUBLE time = estimateTopologyTime (size1, size2, size3, n, m, 1);
 
-  DOUBLE optimal_n = sqrt (((DOUBLE) size1 * totalProcCount) / ((DOUBLE) size2));
-
-  Pair pair_left = allowedPairs[0];
-  Pair pair_right = allowedPairs[0];
-
-  for (std::vector<Pair>::iterator it = allowedPairs.begin ();
-       it != allowedPairs.end ();
-       ++it)
-  {
-    if (it->n < optimal_n)
+    if (!isFound || time < minTime)
     {
-      pair_left = *it;
+      minTime = time;
+      nodeGridSize1 = n;
+      nodeGridSize2 = m;
+      isFound = true;
     }
-    else
-    {
-      pair_right = *it;
-      break;
-    }
-  }
-
-  /*
-   * This heavily depends on the parallel grid sharing scheme
-   */
-#define func(pair) \
-  ((size1) / (pair.n) + (size2) / (pair.m))
-
-  if (func (pair_left) < func (pair_right))
-  {
-    nodeGridSize1 = pair_left.n;
-    nodeGridSize2 = pair_left.m;
-  }
-  else
-  {
-    nodeGridSize1 = pair_right.n;
-    nodeGridSize2 = pair_right.m;
   }
 
-#undef func
+  ASSERT (isFound);
 } /* ParallelGridCore::initOptimal */
 
 #endif /* PARALLEL_BUFFER_DIMENSION_2D_XY || PARALLEL_BUFFER_DIMENSION_2D_YZ) ||
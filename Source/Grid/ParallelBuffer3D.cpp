@@ -1,36 +1,15 @@
 #include "ParallelGrid.h"
 
-#include <cmath>
-#include <set>
-
 #ifdef PARALLEL_GRID
 
 #ifdef PARALLEL_BUFFER_DIMENSION_3D_XYZ
 
 /**
- * Helper struct for triples
- */
-struct Triple
-{
-  grid_coord n; /**< first axis nodes grid size */
-  grid_coord m; /**< second axis nodes grid size */
-  grid_coord k; /**< third axis nodes grid size */
-
-  /**
-   * Constructor with nodes grid sizes
-   */
-  Triple (grid_coord newN = 0, /**< first axis nodes grid size */
-          grid_coord newM = 0, /**< second axis nodes grid size */
-          grid_coord newK = 0) /**< third axis nodes grid size */
-    : n (newN)
-  , m (newM)
-  , k (newK)
-  {
-  } /* Triple */
-}; /* Triple */
-
-/**
- * Initialize parallel grid virtual topology as optimal for current number of processes and specified grid sizes
+ * Initialize parallel grid virtual topology as optimal for current number of processes and specified grid sizes.
+ *
+ * All triples of node grid sizes are considered, including the ones with single node by some axes (i.e. 1D and 2D
+ * virtual topologies), and the one with the least estimated time of time step is chosen (see estimateTopologyTime).
+ * In case of equal estimates split by the first axes is preferred, because their buffers are contiguous in memory.
  */
 void
 ParallelGridCore::initOptimal (grid_coord size1, /**< grid size by first axis */
@@ -40,119 +19,44 @@ ParallelGridCore::initOptimal (grid_coord size1, /**< grid size by first axis */
                                int &nodeGridSize2, /**< out: second axis nodes grid size */
                                int &nodeGridSize3) /**< out: third axis nodes grid size */
 {
-  /*
-   * Find allowed triples of node grid sizes
-   */
-
-  std::vector<Triple> allowedTriples;
-
-  grid_coord gcd1 = ParallelGridCore::greatestCommonDivider (size1, (grid_coord) totalProcCount);
-  grid_coord gcd2 = ParallelGridCore::greatestCommonDivider (size2, (grid_coord) totalProcCount);
-
-  std::set<grid_coord> allowedM;
+  DOUBLE minTime = DOUBLE (0);
+  bool isFound = false;
 
-  for (grid_coord n = 1; n <= gcd1; ++n)
+  for (int n = totalProcCount; n >= 1; --n)
   {
-    if (gcd1 % n != 0)
+    if (totalProcCount % n != 0)
     {
       continue;
     }
 
-    for (grid_coord m = 1; m <= gcd2; ++m)
+    for (int m = totalProcCount / n; m >= 1; --m)
     {
-      if (gcd2 % m != 0)
+      if ((totalProcCount / n) % m != 0)
       {
         continue;
       }
 
-      DOUBLE k_fp = ((DOUBLE) totalProcCount) / ((DOUBLE) n * m);
-      grid_coord k = (grid_coord) k_fp;
-
-      DOUBLE c1_fp = ((DOUBLE) size3) / k_fp;
-      grid_coord c1 = (grid_coord) c1_fp;
-
-      if (k == k_fp && c1 == c1_fp)
-      {
-        allowedTriples.push_back (Triple (n, m, k));
-
-        allowedM.insert (m);
-      }
-    }
-  }
-
-  /*
-   * allowedTriples are sorted in ascending order for n, m, k
-   */
-
-  ASSERT (allowedTriples.size () > 0);
-
-  Triple min = allowedTriples[0];
+      int k = totalProcCount / (n * m);
 
-  for (std::set<grid_coord>::iterator it = allowedM.begin ();
-       it != allowedM.end ();
-       ++it)
-  {
-    grid_coord m = *it;
-
-    DOUBLE optimal_n = sqrt (((DOUBLE) size1 * totalProcCount) / ((DOUBLE) m * size3));
-
-    Triple left = allowedTriples[0];
-    Triple right = allowedTriples[0];
-
-    for (std::vector<Triple>::iterator iter = allowedTriples.begin ();
-         iter != allowedTriples.end ();
-         ++iter)
-    {
-      grid_coord n_iter = iter->n;
-      grid_coord m_iter = iter->m;
-
-      if (m != m_iter)
+      if (n > size1 || m > size2 || k > size3)
       {
         continue;
       }
 
-      if (n_iter < optimal_n)
-      {
-        left = *iter;
-      }
-      else
+      DOUBLE time = estimateTopologyTime (size1, size2, size3, n, m, k);
+
+      if (!isFound || time < minTime)
       {
-        right = *iter;
-        break;
+        minTime = time;
+        nodeGridSize1 = n;
+        nodeGridSize2 = m;
+        nodeGridSize3 = k;
+        isFound = true;
       }
     }
-
-  /*
-   * This heavily depends on the parallel grid sharing scheme
-   */
-#define func(triple) \
-  ((size1)*(size2) / (triple.n * triple.m) + \
-   (size2)*(size3) / (triple.m * triple.k) + \
-   (size1)*(size3) / (triple.n * triple.k) + \
-   4*((size1) / triple.n + (size2) / triple.n + (size3) / triple.k))
-
-    Triple min_cur;
-
-    if (func (left) < func (right))
-    {
-      min_cur = left;
-    }
-    else
-    {
-      min_cur = right;
-    }
-
-    if (func (min_cur) < func (min))
-    {
-      min = min_cur;
-    }
-
-#undef func
   }
 
-  nodeGridSize1 = min.n;
-  nodeGridSize2 = min.m;
-  nodeGridSize3 = min.k;
+  ASSERT (isFound);
 } /* ParallelGridCore::initOptimal */
 
 #endif /* PARALLEL_BUFFER_DIMENSION_3D_XYZ */
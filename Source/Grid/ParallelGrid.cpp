@@ -2,6 +2,10 @@
 
 #ifdef PARALLEL_GRID
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #if PRINT_MESSAGE
 /**
  * Names of buffers of parallel grid for debug purposes.
@@ -46,6 +50,7 @@ ParallelGrid::ParallelGrid (const ParallelGridCoordinate &totSize, /**< total si
                             int timeOffset, /**< offset of time step in form t+timeOffset/2, at which grid should be shared */
                             const char * name) /**< name of grid */
   : ParallelGridBase (storedSteps, name)
+  , nodeWindow (MPI_WIN_NULL)
 {
   /*
    * These are required here to properly setup bufferSize, because ParallelGridGroup does not exist yet
@@ -156,10 +161,18 @@ ParallelGrid::ParallelGrid (const ParallelGridCoordinate &totSize, /**< total si
 
   size = getGroup ()->getSize ();
 
-  for (int i = 0; i < gridValues.size (); ++i)
+#ifdef DYNAMIC_GRID
+  resizeCount = getGroup ()->getResizeCount ();
+#endif /* DYNAMIC_GRID */
+
+  allocateValues ();
+
+#ifdef ZERO_COPY_SHARE
+  if (isNodeUsedForShare ())
   {
-    gridValues[i] = new VectorFieldValues (size.calculateTotalCoord ());
+    getGroup ()->initShareDatatypes (stepStride);
   }
+#endif /* ZERO_COPY_SHARE */
 
   DPRINTF (LOG_LEVEL_STAGES_AND_DUMP, "New grid '%s' for proc: %d (of %d) with %lu stored steps with raw size: %llu.\n",
            gridName.data (),
@@ -169,6 +182,142 @@ ParallelGrid::ParallelGrid (const ParallelGridCoordinate &totSize, /**< total si
            (unsigned long long)size.calculateTotalCoord ());
 } /* ParallelGrid::ParallelGrid */
 
+/**
+ * Check whether computational node takes part in share operations
+ *
+ * @return true if computational node takes part in share operations
+ */
+bool
+ParallelGrid::isNodeUsedForShare () const
+{
+#ifdef PARALLEL_BUFFER_DIMENSION_3D_XYZ
+  if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeXYZ ())
+  {
+    return false;
+  }
+#endif /* PARALLEL_BUFFER_DIMENSION_3D_XYZ */
+
+#ifdef PARALLEL_BUFFER_DIMENSION_2D_XY
+  if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeXY ())
+  {
+    return false;
+  }
+#endif /* PARALLEL_BUFFER_DIMENSION_2D_XY */
+
+#ifdef PARALLEL_BUFFER_DIMENSION_2D_YZ
+  if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeYZ ())
+  {
+    return false;
+  }
+#endif /* PARALLEL_BUFFER_DIMENSION_2D_YZ */
+
+#ifdef PARALLEL_BUFFER_DIMENSION_2D_XZ
+  if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeXZ ())
+  {
+    return false;
+  }
+#endif /* PARALLEL_BUFFER_DIMENSION_2D_XZ */
+
+  return true;
+} /* ParallelGrid::isNodeUsedForShare */
+
+/**
+ * Copy values of all time steps from send region for direction to buffer
+ */
+void
+ParallelGrid::copyToSendBuffer (BufferPosition bufferDirection, /**< buffer direction to send data to */
+                                VectorBufferValues &buffer) /**< out: buffer to copy values to */
+{
+  ParallelGridCoordinate sendStart = getSendStart (bufferDirection);
+  ParallelGridCoordinate sendEnd = getSendEnd (bufferDirection);
+
+  grid_coord index = 0;
+
+#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
+  for (grid_coord i = sendStart.get1 (); i < sendEnd.get1 (); ++i)
+#endif /* GRID_1D || GRID_2D || GRID_3D */
+  {
+#if defined (GRID_2D) || defined (GRID_3D)
+    for (grid_coord j = sendStart.get2 (); j < sendEnd.get2 (); ++j)
+#endif /* GRID_2D || GRID_3D */
+    {
+#if defined (GRID_3D)
+      for (grid_coord k = sendStart.get3 (); k < sendEnd.get3 (); ++k)
+#endif /* GRID_3D */
+      {
+
+#if defined (GRID_1D)
+        ParallelGridCoordinate pos (i COORD_TYPES);
+#endif /* GRID_1D */
+#if defined (GRID_2D)
+        ParallelGridCoordinate pos (i, j COORD_TYPES);
+#endif /* GRID_2D */
+#if defined (GRID_3D)
+        ParallelGridCoordinate pos (i, j, k COORD_TYPES);
+#endif /* GRID_3D */
+
+        grid_coord coord = calculateIndexFromPosition (pos);
+        for (int t = 0; t < gridValues.size (); ++t)
+        {
+          buffer[index++] = *getFieldValue (coord, t);
+        }
+      }
+    }
+  }
+
+  ASSERT (index == (grid_coord) buffer.size ());
+} /* ParallelGrid::copyToSendBuffer */
+
+/**
+ * Copy values of all time steps from buffer to receive region for direction
+ */
+void
+ParallelGrid::copyFromReceiveBuffer (BufferPosition bufferDirection, /**< buffer direction, data from the opposite
+                                                                      *   direction of which is received */
+                                     const VectorBufferValues &buffer) /**< buffer to copy values from */
+{
+  ParallelGridCoordinate recvStart = getRecvStart (bufferDirection);
+  ParallelGridCoordinate recvEnd = getRecvEnd (bufferDirection);
+
+  grid_coord index = 0;
+
+#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
+  for (grid_coord i = recvStart.get1 (); i < recvEnd.get1 (); ++i)
+#endif /* GRID_1D || GRID_2D || GRID_3D */
+  {
+
+#if defined (GRID_2D) || defined (GRID_3D)
+    for (grid_coord j = recvStart.get2 (); j < recvEnd.get2 (); ++j)
+#endif /* GRID_2D || GRID_3D */
+    {
+
+#if defined (GRID_3D)
+      for (grid_coord k = recvStart.get3 (); k < recvEnd.get3 (); ++k)
+#endif /* GRID_3D */
+      {
+
+#if defined (GRID_1D)
+        ParallelGridCoordinate pos (i COORD_TYPES);
+#endif /* GRID_1D */
+#if defined (GRID_2D)
+        ParallelGridCoordinate pos (i, j COORD_TYPES);
+#endif /* GRID_2D */
+#if defined (GRID_3D)
+        ParallelGridCoordinate pos (i, j, k COORD_TYPES);
+#endif /* GRID_3D */
+
+        grid_coord coord = calculateIndexFromPosition (pos);
+        for (int t = 0; t < gridValues.size (); ++t)
+        {
+          setFieldValue (buffer[index++], coord, t);
+        }
+      }
+    }
+  }
+
+  ASSERT (index == (grid_coord) buffer.size ());
+} /* ParallelGrid::copyFromReceiveBuffer */
+
 /**
  * Send raw buffer with data
  */
@@ -183,11 +332,22 @@ ParallelGrid::SendRawBuffer (BufferPosition buffer, /**< buffer's position to se
            BufferPositionNames[buffer],
            buffersSend[buffer].size ());
 
-  FieldValue* rawBuffer = buffersSend[buffer].data ();
+#ifdef ZERO_COPY_SHARE
+  /*
+   * Values are sent directly from grid
+   */
+  void *rawBuffer = rawValues;
+  int count = 1;
+  MPI_Datatype datatype = getGroupConst ()->getDatatypesSend ()[buffer];
+#else /* ZERO_COPY_SHARE */
+  void *rawBuffer = buffersSend[buffer].data ();
+  int count = buffersSend[buffer].size ();
+  MPI_Datatype datatype = MPI_FPVALUE;
+#endif /* !ZERO_COPY_SHARE */
 
   int retCode = MPI_Send (rawBuffer,
-                          buffersSend[buffer].size (),
-                          MPI_FPVALUE,
+                          count,
+                          datatype,
                           processTo,
                           parallelGridCore->getProcessId (),
                           ParallelGrid::getParallelCore ()->getCommunicator ());
@@ -211,11 +371,22 @@ ParallelGrid::ReceiveRawBuffer (BufferPosition buffer, /**< buffer's position to
 
   MPI_Status status;
 
-  FieldValue* rawBuffer = buffersReceive[buffer].data ();
+#ifdef ZERO_COPY_SHARE
+  /*
+   * Values are received directly to grid
+   */
+  void *rawBuffer = rawValues;
+  int count = 1;
+  MPI_Datatype datatype = getGroupConst ()->getDatatypesReceive ()[buffer];
+#else /* ZERO_COPY_SHARE */
+  void *rawBuffer = buffersReceive[buffer].data ();
+  int count = buffersReceive[buffer].size ();
+  MPI_Datatype datatype = MPI_FPVALUE;
+#endif /* !ZERO_COPY_SHARE */
 
   int retCode = MPI_Recv (rawBuffer,
-                          buffersReceive[buffer].size (),
-                          MPI_FPVALUE,
+                          count,
+                          datatype,
                           processFrom,
                           processFrom,
                           ParallelGrid::getParallelCore ()->getCommunicator (),
@@ -245,17 +416,33 @@ ParallelGrid::SendReceiveRawBuffer (BufferPosition bufferSend, /**< buffer's pos
 
   MPI_Status status;
 
-  FieldValue* rawBufferSend = buffersSend[bufferSend].data ();
-  FieldValue* rawBufferReceive = buffersReceive[bufferReceive].data ();
+#ifdef ZERO_COPY_SHARE
+  /*
+   * Values are sent directly from grid and received directly to grid (send and receive regions do not intersect)
+   */
+  void *rawBufferSend = rawValues;
+  void *rawBufferReceive = rawValues;
+  int countSend = 1;
+  int countReceive = 1;
+  MPI_Datatype datatypeSend = getGroupConst ()->getDatatypesSend ()[bufferSend];
+  MPI_Datatype datatypeReceive = getGroupConst ()->getDatatypesReceive ()[bufferReceive];
+#else /* ZERO_COPY_SHARE */
+  void *rawBufferSend = buffersSend[bufferSend].data ();
+  void *rawBufferReceive = buffersReceive[bufferReceive].data ();
+  int countSend = buffersSend[bufferSend].size ();
+  int countReceive = buffersReceive[bufferReceive].size ();
+  MPI_Datatype datatypeSend = MPI_FPVALUE;
+  MPI_Datatype datatypeReceive = MPI_FPVALUE;
+#endif /* !ZERO_COPY_SHARE */
 
   int retCode = MPI_Sendrecv (rawBufferSend,
-                              buffersSend[bufferSend].size (),
-                              MPI_FPVALUE,
+                              countSend,
+                              datatypeSend,
                               processTo,
                               parallelGridCore->getProcessId (),
                               rawBufferReceive,
-                              buffersReceive[bufferReceive].size (),
-                              MPI_FPVALUE,
+                              countReceive,
+                              datatypeReceive,
                               processFrom,
                               processFrom,
                               ParallelGrid::getParallelCore ()->getCommunicator (),
@@ -274,45 +461,17 @@ ParallelGrid::SendReceiveBuffer (BufferPosition bufferDirection) /**< buffer dir
   /*
    * Return if node not used.
    */
-#ifdef PARALLEL_BUFFER_DIMENSION_3D_XYZ
-  if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeXYZ ())
+  if (!isNodeUsedForShare ())
   {
     return;
   }
-#endif /* PARALLEL_BUFFER_DIMENSION_3D_XYZ */
-
-#ifdef PARALLEL_BUFFER_DIMENSION_2D_XY
-  if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeXY ())
-  {
-    return;
-  }
-#endif /* PARALLEL_BUFFER_DIMENSION_2D_XY */
-
-#ifdef PARALLEL_BUFFER_DIMENSION_2D_YZ
-  if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeYZ ())
-  {
-    return;
-  }
-#endif /* PARALLEL_BUFFER_DIMENSION_2D_YZ */
-
-#ifdef PARALLEL_BUFFER_DIMENSION_2D_XZ
-  if (parallelGridCore->getProcessId () >= parallelGridCore->getNodeGridSizeXZ ())
-  {
-    return;
-  }
-#endif /* PARALLEL_BUFFER_DIMENSION_2D_XZ */
 
   BufferPosition opposite = parallelGridCore->getOppositeDirections ()[bufferDirection];
 
   int processTo = parallelGridCore->getNodeForDirection (bufferDirection);
   int processFrom = parallelGridCore->getNodeForDirection (opposite);
 
-  ParallelGridCoordinate sendStart = getSendStart (bufferDirection);
-  ParallelGridCoordinate sendEnd = getSendEnd (bufferDirection);
-
-  ParallelGridCoordinate recvStart = getRecvStart (bufferDirection);
-  ParallelGridCoordinate recvEnd = getRecvEnd (bufferDirection);
-
+#ifndef ZERO_COPY_SHARE
   VectorBuffers &buffersSend = getGroup ()->getBuffersSend ();
   VectorBuffers &buffersReceive = getGroup ()->getBuffersReceive ();
 
@@ -321,40 +480,9 @@ ParallelGrid::SendReceiveBuffer (BufferPosition bufferDirection) /**< buffer dir
    */
   if (processTo != PID_NONE)
   {
-    grid_coord index = 0;
-
-#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
-    for (grid_coord i = sendStart.get1 (); i < sendEnd.get1 (); ++i)
-#endif /* GRID_1D || GRID_2D || GRID_3D */
-    {
-#if defined (GRID_2D) || defined (GRID_3D)
-      for (grid_coord j = sendStart.get2 (); j < sendEnd.get2 (); ++j)
-#endif /* GRID_2D || GRID_3D */
-      {
-#if defined (GRID_3D)
-        for (grid_coord k = sendStart.get3 (); k < sendEnd.get3 (); ++k)
-#endif /* GRID_3D */
-        {
-
-#if defined (GRID_1D)
-          ParallelGridCoordinate pos (i COORD_TYPES);
-#endif /* GRID_1D */
-#if defined (GRID_2D)
-          ParallelGridCoordinate pos (i, j COORD_TYPES);
-#endif /* GRID_2D */
-#if defined (GRID_3D)
-          ParallelGridCoordinate pos (i, j, k COORD_TYPES);
-#endif /* GRID_3D */
-
-          grid_coord coord = calculateIndexFromPosition (pos);
-          for (int t = 0; t < gridValues.size (); ++t)
-          {
-            buffersSend[bufferDirection][index++] = *getFieldValue (coord, t);
-          }
-        }
-      }
-    }
+    copyToSendBuffer (bufferDirection, buffersSend[bufferDirection]);
   }
+#endif /* !ZERO_COPY_SHARE */
 
   DPRINTF (LOG_LEVEL_FULL, "\tSHARE RAW. PID=#%d. Directions TO(%s=#%d), FROM(%s=#%d).\n",
            parallelGridCore->getProcessId (),
@@ -451,45 +579,15 @@ ParallelGrid::SendReceiveBuffer (BufferPosition bufferDirection) /**< buffer dir
      */
   }
 
+#ifndef ZERO_COPY_SHARE
   /*
    * Copy from receive buffer
    */
   if (processFrom != PID_NONE)
   {
-#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
-    for (grid_coord index = 0, i = recvStart.get1 (); i < recvEnd.get1 (); ++i)
-#endif /* GRID_1D || GRID_2D || GRID_3D */
-    {
-
-#if defined (GRID_2D) || defined (GRID_3D)
-      for (grid_coord j = recvStart.get2 (); j < recvEnd.get2 (); ++j)
-#endif /* GRID_2D || GRID_3D */
-      {
-
-#if defined (GRID_3D)
-        for (grid_coord k = recvStart.get3 (); k < recvEnd.get3 (); ++k)
-#endif /* GRID_3D */
-        {
-
-#if defined (GRID_1D)
-          ParallelGridCoordinate pos (i COORD_TYPES);
-#endif /* GRID_1D */
-#if defined (GRID_2D)
-          ParallelGridCoordinate pos (i, j COORD_TYPES);
-#endif /* GRID_2D */
-#if defined (GRID_3D)
-          ParallelGridCoordinate pos (i, j, k COORD_TYPES);
-#endif /* GRID_3D */
-
-          grid_coord coord = calculateIndexFromPosition (pos);
-          for (int t = 0; t < gridValues.size (); ++t)
-          {
-            setFieldValue (buffersReceive[opposite][index++], coord, t);
-          }
-        }
-      }
-    }
+    copyFromReceiveBuffer (bufferDirection, buffersReceive[opposite]);
   }
+#endif /* !ZERO_COPY_SHARE */
 } /* ParallelGrid::SendReceiveBuffer */
 
 /**
@@ -526,9 +624,155 @@ void
 ParallelGrid::share ()
 {
   SendReceive ();
-  MPI_Barrier (ParallelGrid::getParallelCore ()->getCommunicator ());
+
+  /*
+   * Send/receive operations already synchronize computational node with all its neighbors, global barrier only makes
+   * all computational nodes wait for the slowest one
+   */
+  if (!parallelGridCore->getDoUseNeighborShareSync ())
+  {
+    MPI_Barrier (ParallelGrid::getParallelCore ()->getCommunicator ());
+  }
 } /* ParallelGrid::share */
 
+/**
+ * Start non-blocking share operations for grid: values are copied to send buffers and send/receive operations for
+ * all directions are posted at once. Values in buffers of grid are updated only in ParallelGrid::finishShare, so grid
+ * values, which are not in buffers, could be used in computations meanwhile.
+ *
+ * NOTE: each grid has its own send/receive buffers for non-blocking share operations, because buffers of parallel
+ *       group are shared between all grids of the group. With ZERO_COPY_SHARE no buffers are used and values are
+ *       sent/received directly from/to grid memory.
+ */
+void
+ParallelGrid::startShare ()
+{
+  ASSERT (shareRequests.empty ());
+
+#ifdef DYNAMIC_GRID
+  /*
+   * No sharing for disabled nodes
+   */
+  if (parallelGridCore->getNodeState ()[parallelGridCore->getProcessId ()] == 0)
+  {
+    return;
+  }
+#endif /* DYNAMIC_GRID */
+
+  if (!isNodeUsedForShare ())
+  {
+    return;
+  }
+
+#ifndef ZERO_COPY_SHARE
+  if (buffersSendAsync.empty ())
+  {
+    buffersSendAsync = getGroup ()->getBuffersSend ();
+    buffersReceiveAsync = getGroup ()->getBuffersReceive ();
+  }
+#endif /* !ZERO_COPY_SHARE */
+
+  DPRINTF (LOG_LEVEL_FULL, "Start Send/Receive PID=%d\n", parallelGridCore->getProcessId ());
+
+  /*
+   * Receives are posted first, so that incoming messages do not have to be buffered by MPI.
+   *
+   * Tag of message is its direction, because several directions might correspond to the same neighbor
+   * (e.g. in case of two computational nodes).
+   */
+  for (int buf = 0; buf < BUFFER_COUNT; ++buf)
+  {
+    BufferPosition bufferDirection = (BufferPosition) buf;
+    BufferPosition opposite = parallelGridCore->getOppositeDirections ()[bufferDirection];
+    int processFrom = parallelGridCore->getNodeForDirection (opposite);
+
+    if (processFrom == PID_NONE)
+    {
+      continue;
+    }
+
+    MPI_Request request;
+#ifdef ZERO_COPY_SHARE
+    int retCode = MPI_Irecv (rawValues,
+                             1,
+                             getGroupConst ()->getDatatypesReceive ()[opposite],
+#else /* ZERO_COPY_SHARE */
+    int retCode = MPI_Irecv (buffersReceiveAsync[opposite].data (),
+                             buffersReceiveAsync[opposite].size (),
+                             MPI_FPVALUE,
+#endif /* !ZERO_COPY_SHARE */
+                             processFrom,
+                             buf,
+                             ParallelGrid::getParallelCore ()->getCommunicator (),
+                             &request);
+    ASSERT (retCode == MPI_SUCCESS);
+
+    shareRequests.push_back (request);
+  }
+
+  for (int buf = 0; buf < BUFFER_COUNT; ++buf)
+  {
+    BufferPosition bufferDirection = (BufferPosition) buf;
+    int processTo = parallelGridCore->getNodeForDirection (bufferDirection);
+
+    if (processTo == PID_NONE)
+    {
+      continue;
+    }
+
+    MPI_Request request;
+#ifdef ZERO_COPY_SHARE
+    int retCode = MPI_Isend (rawValues,
+                             1,
+                             getGroupConst ()->getDatatypesSend ()[bufferDirection],
+#else /* ZERO_COPY_SHARE */
+    copyToSendBuffer (bufferDirection, buffersSendAsync[bufferDirection]);
+
+    int retCode = MPI_Isend (buffersSendAsync[bufferDirection].data (),
+                             buffersSendAsync[bufferDirection].size (),
+                             MPI_FPVALUE,
+#endif /* !ZERO_COPY_SHARE */
+                             processTo,
+                             buf,
+                             ParallelGrid::getParallelCore ()->getCommunicator (),
+                             &request);
+    ASSERT (retCode == MPI_SUCCESS);
+
+    shareRequests.push_back (request);
+  }
+} /* ParallelGrid::startShare */
+
+/**
+ * Finish non-blocking share operations for grid, started by ParallelGrid::startShare: wait for completion of
+ * send/receive operations and copy received values to buffers of grid
+ */
+void
+ParallelGrid::finishShare ()
+{
+  if (shareRequests.empty ())
+  {
+    return;
+  }
+
+  int retCode = MPI_Waitall (shareRequests.size (), shareRequests.data (), MPI_STATUSES_IGNORE);
+  ASSERT (retCode == MPI_SUCCESS);
+
+  shareRequests.clear ();
+
+#ifndef ZERO_COPY_SHARE
+  for (int buf = 0; buf < BUFFER_COUNT; ++buf)
+  {
+    BufferPosition bufferDirection = (BufferPosition) buf;
+    BufferPosition opposite = parallelGridCore->getOppositeDirections ()[bufferDirection];
+
+    if (parallelGridCore->getNodeForDirection (opposite) != PID_NONE)
+    {
+      copyFromReceiveBuffer (bufferDirection, buffersReceiveAsync[opposite]);
+    }
+  }
+#endif /* !ZERO_COPY_SHARE */
+} /* ParallelGrid::finishShare */
+
 /**
  * Allocate and gather full grid from all nodes to one non-parallel grid on each node
  *
@@ -663,7 +907,7 @@ ParallelGrid::gatherFullGridPlacement (ParallelGridBase *placementGrid) const
 
               grid_coord coord = calculateIndexFromPosition (pos);
 
-              values[index] = (*gridValues[t])[coord];
+              values[index] = gridValues[t][coord];
 
               ++index;
 
@@ -732,6 +976,463 @@ ParallelGrid::gatherFullGridPlacement (ParallelGridBase *placementGrid) const
   return grid;
 } /* ParallelGrid::gatherFullGridPlacement */
 
+/**
+ * Get components of coordinate in the order of placement of values in memory
+ *
+ * @return number of components
+ */
+static int
+expandCoordinate (const ParallelGridCoordinate &coord, /**< coordinate */
+                  int *values) /**< out: components of coordinate */
+{
+  int dims = 0;
+
+#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
+  values[dims++] = (int) coord.get1 ();
+#endif /* GRID_1D || GRID_2D || GRID_3D */
+
+#if defined (GRID_2D) || defined (GRID_3D)
+  values[dims++] = (int) coord.get2 ();
+#endif /* GRID_2D || GRID_3D */
+
+#if defined (GRID_3D)
+  values[dims++] = (int) coord.get3 ();
+#endif /* GRID_3D */
+
+  return dims;
+} /* expandCoordinate */
+
+/**
+ * Intersect part of grid, which is accessed by this node, with box [start, end) of full grid, which is placed in binary
+ * file in the same format as file saved by DATDumper for single time step of full grid. When writing, part of grid is
+ * the chunk of node (without buffers), when reading, it is the whole local grid, so buffers are filled too.
+ *
+ * @return number of components of coordinates
+ */
+int
+ParallelGrid::intersectFileBox (ParallelGridCoordinate start, /**< absolute start coordinate of box in file */
+                                ParallelGridCoordinate end, /**< absolute end coordinate of box in file */
+                                bool isWrite, /**< flag, whether to write or to read */
+                                int *gridSize, /**< out: size of local grid */
+                                int *fileSizes, /**< out: size of box in file */
+                                int *fileStarts, /**< out: start of intersection in box in file */
+                                int *memStarts, /**< out: start of intersection in local grid */
+                                int *subsizes, /**< out: size of intersection (non-positive if it is empty) */
+                                MPI_Offset &totalCount) const /**< out: number of values in file */
+{
+  int boxStart[3];
+  int boxEnd[3];
+  int gridStart[3];
+  int localStart[3] = {0, 0, 0};
+  int localSize[3];
+
+  int dims = expandCoordinate (start, boxStart);
+  expandCoordinate (end, boxEnd);
+  expandCoordinate (getGroupConst ()->getStartPosition (), gridStart);
+  expandCoordinate (getSize (), gridSize);
+
+  if (isWrite)
+  {
+    expandCoordinate (getGroupConst ()->getChunkStartPosition () - getGroupConst ()->getStartPosition (), localStart);
+    expandCoordinate (getGroupConst ()->getCurrentSize (), localSize);
+  }
+  else
+  {
+    expandCoordinate (getSize (), localSize);
+  }
+
+  totalCount = 1;
+
+  for (int i = 0; i < dims; ++i)
+  {
+    int first = gridStart[i] + localStart[i];
+    int last = first + localSize[i];
+
+    first = first > boxStart[i] ? first : boxStart[i];
+    last = last < boxEnd[i] ? last : boxEnd[i];
+
+    fileSizes[i] = boxEnd[i] - boxStart[i];
+    fileStarts[i] = first - boxStart[i];
+    memStarts[i] = first - gridStart[i];
+    subsizes[i] = last - first;
+
+    totalCount *= fileSizes[i];
+  }
+
+  return dims;
+} /* ParallelGrid::intersectFileBox */
+
+/**
+ * Collectively write/read box [start, end) of full grid to/from binary file, which has the same format as file saved
+ * by DATDumper for single time step of full grid. Each computational node accesses only those values of box, which it
+ * has locally, at the corresponding offsets in file, so full grid is not allocated on any node.
+ *
+ * When writing, each node writes values of its chunk (without buffers). When reading, each node reads values for the
+ * whole local grid, so buffers are filled too.
+ */
+void
+ParallelGrid::accessFileCollective (const std::string &fileName, /**< name of file */
+                                    ParallelGridCoordinate start, /**< absolute start coordinate of box in file */
+                                    ParallelGridCoordinate end, /**< absolute end coordinate of box in file */
+                                    int time_step_back, /**< index of time step to write/read */
+                                    bool isWrite) /**< flag, whether to write or to read */
+{
+  ASSERT (time_step_back >= 0);
+
+  int gridSize[3];
+  int fileSizes[3];
+  int fileStarts[3];
+  int memStarts[3];
+  int subsizes[3];
+
+  MPI_Offset totalCount;
+
+  int dims = intersectFileBox (start, end, isWrite, gridSize, fileSizes, fileStarts, memStarts, subsizes, totalCount);
+
+  bool isEmpty = false;
+  for (int i = 0; i < dims; ++i)
+  {
+    isEmpty = isEmpty || subsizes[i] <= 0;
+  }
+
+  MPI_Comm comm = ParallelGrid::getParallelCore ()->getCommunicator ();
+
+  MPI_Datatype fileType = MPI_FPVALUE;
+  MPI_Datatype memType = MPI_FPVALUE;
+  int count = 0;
+
+  int retCode;
+
+  if (!isEmpty)
+  {
+    retCode = MPI_Type_create_subarray (dims, fileSizes, subsizes, fileStarts, MPI_ORDER_C, MPI_FPVALUE, &fileType);
+    ASSERT (retCode == MPI_SUCCESS);
+    retCode = MPI_Type_commit (&fileType);
+    ASSERT (retCode == MPI_SUCCESS);
+
+    retCode = MPI_Type_create_subarray (dims, gridSize, subsizes, memStarts, MPI_ORDER_C, MPI_FPVALUE, &memType);
+    ASSERT (retCode == MPI_SUCCESS);
+    retCode = MPI_Type_commit (&memType);
+    ASSERT (retCode == MPI_SUCCESS);
+
+    count = 1;
+  }
+
+  MPI_File file;
+  retCode = MPI_File_open (comm,
+                           (char *) fileName.c_str (),
+                           isWrite ? MPI_MODE_CREATE | MPI_MODE_WRONLY : MPI_MODE_RDONLY,
+                           MPI_INFO_NULL,
+                           &file);
+  ALWAYS_ASSERT (retCode == MPI_SUCCESS);
+
+  if (isWrite)
+  {
+    /*
+     * Truncate previous contents of file, if any
+     */
+    retCode = MPI_File_set_size (file, totalCount * sizeof (FieldValue));
+    ASSERT (retCode == MPI_SUCCESS);
+  }
+  else
+  {
+    MPI_Offset fileSize;
+    retCode = MPI_File_get_size (file, &fileSize);
+    ASSERT (retCode == MPI_SUCCESS);
+    ALWAYS_ASSERT (fileSize == totalCount * (MPI_Offset) sizeof (FieldValue));
+  }
+
+  retCode = MPI_File_set_view (file, 0, MPI_FPVALUE, fileType, (char *) "native", MPI_INFO_NULL);
+  ASSERT (retCode == MPI_SUCCESS);
+
+  MPI_Status status;
+  if (isWrite)
+  {
+    retCode = MPI_File_write_all (file, getRaw (time_step_back), count, memType, &status);
+  }
+  else
+  {
+    retCode = MPI_File_read_all (file, getRaw (time_step_back), count, memType, &status);
+  }
+  ALWAYS_ASSERT (retCode == MPI_SUCCESS);
+
+  retCode = MPI_File_close (&file);
+  ASSERT (retCode == MPI_SUCCESS);
+
+  if (!isEmpty)
+  {
+    retCode = MPI_Type_free (&fileType);
+    ASSERT (retCode == MPI_SUCCESS);
+    retCode = MPI_Type_free (&memType);
+    ASSERT (retCode == MPI_SUCCESS);
+  }
+} /* ParallelGrid::accessFileCollective */
+
+/**
+ * Collectively save box [start, end) of full grid to binary file for specific time step. Must be called on all
+ * computational nodes.
+ */
+void
+ParallelGrid::dumpCollective (const std::string &fileName, /**< name of file */
+                              ParallelGridCoordinate start, /**< absolute start coordinate of box */
+                              ParallelGridCoordinate end, /**< absolute end coordinate of box */
+                              int time_step_back) /**< index of time step to save */
+{
+  DPRINTF (LOG_LEVEL_STAGES_AND_DUMP, "Collectively saving grid '%s' to '%s' for proc: %d (of %d).\n",
+           getName (),
+           fileName.c_str (),
+           ParallelGrid::getParallelCore ()->getProcessId (),
+           ParallelGrid::getParallelCore ()->getTotalProcCount ());
+
+  accessFileCollective (fileName, start, end, time_step_back, true);
+} /* ParallelGrid::dumpCollective */
+
+/**
+ * Collectively load box [start, end) of full grid from binary file for specific time step. Values outside of box are
+ * not changed. Must be called on all computational nodes.
+ */
+void
+ParallelGrid::loadCollective (const std::string &fileName, /**< name of file */
+                              ParallelGridCoordinate start, /**< absolute start coordinate of box */
+                              ParallelGridCoordinate end, /**< absolute end coordinate of box */
+                              int time_step_back) /**< index of time step to load */
+{
+  DPRINTF (LOG_LEVEL_STAGES_AND_DUMP, "Collectively loading grid '%s' from '%s' for proc: %d (of %d).\n",
+           getName (),
+           fileName.c_str (),
+           ParallelGrid::getParallelCore ()->getProcessId (),
+           ParallelGrid::getParallelCore ()->getTotalProcCount ());
+
+  accessFileCollective (fileName, start, end, time_step_back, false);
+} /* ParallelGrid::loadCollective */
+
+/**
+ * Load box [start, end) of full grid from binary file for specific time step through memory mapping of file. Each
+ * computational node copies rows of values, which it has locally, from mapping, so pages of file are shared through
+ * page cache between all nodes on the same machine and full grid is not allocated on any node. Values outside of box
+ * are not changed. Unlike loadCollective, doesn't require synchronization of nodes.
+ */
+void
+ParallelGrid::loadMapped (const std::string &fileName, /**< name of file */
+                          ParallelGridCoordinate start, /**< absolute start coordinate of box */
+                          ParallelGridCoordinate end, /**< absolute end coordinate of box */
+                          int time_step_back) /**< index of time step to load */
+{
+  DPRINTF (LOG_LEVEL_STAGES_AND_DUMP, "Loading grid '%s' from mapping of '%s' for proc: %d (of %d).\n",
+           getName (),
+           fileName.c_str (),
+           ParallelGrid::getParallelCore ()->getProcessId (),
+           ParallelGrid::getParallelCore ()->getTotalProcCount ());
+
+  ASSERT (time_step_back >= 0);
+
+  /*
+   * Missing outer components are treated as components of size 1
+   */
+  int gridSize[3] = {1, 1, 1};
+  int fileSizes[3] = {1, 1, 1};
+  int fileStarts[3] = {0, 0, 0};
+  int memStarts[3] = {0, 0, 0};
+  int subsizes[3] = {1, 1, 1};
+
+  MPI_Offset totalCount;
+
+  int dims = intersectFileBox (start, end, false, gridSize, fileSizes, fileStarts, memStarts, subsizes, totalCount);
+  int shift = 3 - dims;
+  for (int i = dims - 1; i >= 0 && shift > 0; --i)
+  {
+    gridSize[i + shift] = gridSize[i];
+    fileSizes[i + shift] = fileSizes[i];
+    fileStarts[i + shift] = fileStarts[i];
+    memStarts[i + shift] = memStarts[i];
+    subsizes[i + shift] = subsizes[i];
+
+    gridSize[i] = 1;
+    fileSizes[i] = 1;
+    fileStarts[i] = 0;
+    memStarts[i] = 0;
+    subsizes[i] = 1;
+  }
+
+  int fd = open (fileName.c_str (), O_RDONLY);
+  ALWAYS_ASSERT (fd != -1);
+
+  struct stat fileStat;
+  ALWAYS_ASSERT (fstat (fd, &fileStat) == 0);
+
+  size_t fileSize = (size_t) fileStat.st_size;
+  ALWAYS_ASSERT (fileSize == totalCount * sizeof (FieldValue));
+
+  void *mapping = mmap (NULLPTR, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+  ALWAYS_ASSERT (mapping != MAP_FAILED);
+
+  close (fd);
+
+  if (subsizes[0] > 0 && subsizes[1] > 0 && subsizes[2] > 0)
+  {
+    const FieldValue *fileValues = (const FieldValue *) mapping;
+    FieldValue *values = getRaw (time_step_back);
+
+    for (int i = 0; i < subsizes[0]; ++i)
+    {
+      for (int j = 0; j < subsizes[1]; ++j)
+      {
+        grid_coord fileIndex = ((grid_coord) (fileStarts[0] + i) * fileSizes[1] + fileStarts[1] + j) * fileSizes[2]
+                               + fileStarts[2];
+        grid_coord index = ((grid_coord) (memStarts[0] + i) * gridSize[1] + memStarts[1] + j) * gridSize[2]
+                           + memStarts[2];
+
+        memcpy (values + index, fileValues + fileIndex, subsizes[2] * sizeof (FieldValue));
+      }
+    }
+  }
+
+  munmap (mapping, fileSize);
+} /* ParallelGrid::loadMapped */
+
+/**
+ * Destructor of parallel grid. Must be called on all processes of the same shared memory node, if values of grid are
+ * shared on node.
+ */
+ParallelGrid::~ParallelGrid ()
+{
+  if (nodeWindow != MPI_WIN_NULL)
+  {
+    /*
+     * Values are not freed by Grid, as they belong to window
+     */
+    int retCode = MPI_Win_free (&nodeWindow);
+    ASSERT (retCode == MPI_SUCCESS);
+  }
+} /* ParallelGrid::~ParallelGrid */
+
+/**
+ * Move values of read-only grid with single stored time step to shared memory window, which is allocated once for all
+ * processes on the same shared memory node, so that these processes share single copy of values. Must be called on all
+ * processes of node after grid is fully initialized (including buffers) and before it is read by other processes.
+ *
+ * Local grids of all processes must be slabs along the first coordinate, i.e. along the outermost coordinate in memory
+ * (virtual topology is split only along this axis), and local grids of processes on the same node must form
+ * continuous slab. Then local grid of each process (with buffers) is a part of window with the same placement of values
+ * in memory, and buffers of process are the same values as chunks of its neighbors on the same node.
+ */
+void
+ParallelGrid::shareValuesOnNode ()
+{
+  ASSERT (getCountStoredSteps () == 1);
+  ASSERT (nodeWindow == MPI_WIN_NULL);
+
+  int localStart[3];
+  int localSize[3];
+  int chunkStart[3];
+  int chunkSize[3];
+  int totalSize[3];
+
+  int dims = expandCoordinate (getGroupConst ()->getStartPosition (), localStart);
+  expandCoordinate (getSize (), localSize);
+  expandCoordinate (getGroupConst ()->getChunkStartPosition (), chunkStart);
+  expandCoordinate (getGroupConst ()->getCurrentSize (), chunkSize);
+  expandCoordinate (getTotalSize (), totalSize);
+
+  grid_coord rowSize = 1;
+  for (int i = 1; i < dims; ++i)
+  {
+    if (localSize[i] != totalSize[i])
+    {
+      ALWAYS_ASSERT_MESSAGE ("Grids could be shared on node only if virtual topology is split along the first axis.");
+    }
+    rowSize *= localSize[i];
+  }
+
+  MPI_Comm nodeComm = ParallelGrid::getParallelCore ()->getNodeCommunicator ();
+
+  int nodeRank;
+  int nodeSize;
+  MPI_Comm_rank (nodeComm, &nodeRank);
+  MPI_Comm_size (nodeComm, &nodeSize);
+
+  /*
+   * Ranges of local grids and chunks along the first axis for all processes of node
+   */
+  int range[4] = {localStart[0], localStart[0] + localSize[0], chunkStart[0], chunkStart[0] + chunkSize[0]};
+  std::vector<int> ranges (4 * nodeSize);
+  int retCode = MPI_Allgather (range, 4, MPI_INT, ranges.data (), 4, MPI_INT, nodeComm);
+  ASSERT (retCode == MPI_SUCCESS);
+
+  int slabStart = range[0];
+  int slabEnd = range[1];
+  grid_coord coveredSize = 0;
+  for (int x = 0; x < totalSize[0]; ++x)
+  {
+    bool isCovered = false;
+    for (int r = 0; r < nodeSize && !isCovered; ++r)
+    {
+      isCovered = x >= ranges[4 * r] && x < ranges[4 * r + 1];
+    }
+
+    if (isCovered)
+    {
+      slabStart = x < slabStart ? x : slabStart;
+      slabEnd = x + 1 > slabEnd ? x + 1 : slabEnd;
+      ++coveredSize;
+    }
+  }
+  if (coveredSize != slabEnd - slabStart)
+  {
+    ALWAYS_ASSERT_MESSAGE ("Grids could be shared on node only if local grids of processes on node form continuous slab.");
+  }
+
+  /*
+   * Whole slab is allocated by the first process of node, other processes access it directly
+   */
+  MPI_Aint slabBytes = nodeRank == 0 ? (MPI_Aint) ((slabEnd - slabStart) * rowSize * sizeof (FieldValue)) : 0;
+  FieldValue *slab = NULLPTR;
+  retCode = MPI_Win_allocate_shared (slabBytes, sizeof (FieldValue), MPI_INFO_NULL, nodeComm, &slab, &nodeWindow);
+  ALWAYS_ASSERT (retCode == MPI_SUCCESS);
+
+  MPI_Aint querySize;
+  int queryDispUnit;
+  retCode = MPI_Win_shared_query (nodeWindow, 0, &querySize, &queryDispUnit, &slab);
+  ASSERT (retCode == MPI_SUCCESS);
+
+  retCode = MPI_Win_fence (0, nodeWindow);
+  ASSERT (retCode == MPI_SUCCESS);
+
+  /*
+   * Each row of slab is written by single process: by the one, which has it in its chunk, or otherwise (for buffers on
+   * the border of node) by the first process, which has it in its local grid
+   */
+  FieldValue *values = getRaw (0);
+  for (int x = localStart[0]; x < localStart[0] + localSize[0]; ++x)
+  {
+    int owner = -1;
+    for (int r = 0; r < nodeSize && owner == -1; ++r)
+    {
+      if (x >= ranges[4 * r + 2] && x < ranges[4 * r + 3])
+      {
+        owner = r;
+      }
+    }
+    for (int r = 0; r < nodeSize && owner == -1; ++r)
+    {
+      if (x >= ranges[4 * r] && x < ranges[4 * r + 1])
+      {
+        owner = r;
+      }
+    }
+
+    if (owner == nodeRank)
+    {
+      memcpy (slab + (x - slabStart) * rowSize, values + (x - localStart[0]) * rowSize, rowSize * sizeof (FieldValue));
+    }
+  }
+
+  retCode = MPI_Win_fence (0, nodeWindow);
+  ASSERT (retCode == MPI_SUCCESS);
+
+  adoptExternalValues (slab + (localStart[0] - slabStart) * rowSize);
+} /* ParallelGrid::shareValuesOnNode */
+
 /**
  * Identify buffer to which position corresponds to. In case coordinate is not in buffer, BUFFER_NONE is returned
  *
@@ -222,14 +222,55 @@ private:
    */
   int groupId;
 
+  /**
+   * Send buffers for non-blocking share operations
+   */
+  VectorBuffers buffersSendAsync;
+
+  /**
+   * Receive buffers for non-blocking share operations
+   */
+  VectorBuffers buffersReceiveAsync;
+
+  /**
+   * Requests of non-blocking share operations, which are in progress
+   */
+  std::vector<MPI_Request> shareRequests;
+
+  /**
+   * Shared memory window, which stores values of this grid for all processes on the same shared memory node
+   * (MPI_WIN_NULL if values are stored privately, see ParallelGrid::shareValuesOnNode)
+   */
+  MPI_Win nodeWindow;
+
+#ifdef DYNAMIC_GRID
+  /**
+   * Number of resizes of parallel group, after which values of grid were migrated
+   */
+  int resizeCount;
+#endif /* DYNAMIC_GRID */
+
 private:
 
+  bool isNodeUsedForShare () const;
+  void copyToSendBuffer (BufferPosition, VectorBufferValues &);
+  void copyFromReceiveBuffer (BufferPosition, const VectorBufferValues &);
+
   void SendRawBuffer (BufferPosition, int);
   void ReceiveRawBuffer (BufferPosition, int);
   void SendReceiveRawBuffer (BufferPosition, int, BufferPosition, int);
   void SendReceiveBuffer (BufferPosition);
   void SendReceive ();
 
+  int intersectFileBox (ParallelGridCoordinate, ParallelGridCoordinate, bool, int *, int *, int *, int *, int *,
+                        MPI_Offset &) const;
+  void accessFileCollective (const std::string &, ParallelGridCoordinate, ParallelGridCoordinate, int, bool);
+
+#ifdef DYNAMIC_GRID
+  void copyChunkBox (const grid_coord *, const ParallelGridCoordinate &, const ParallelGridCoordinate &,
+                     const std::vector<FieldValue *> &, VectorBufferValues &, bool);
+#endif /* DYNAMIC_GRID */
+
 public:
 
   ParallelGrid (const ParallelGridCoordinate &,
@@ -240,7 +281,7 @@ public:
                 int,
                 const char * = "unnamed");
 
-  virtual ~ParallelGrid () {}
+  virtual ~ParallelGrid ();
 
   /**
    * Get parallel group constant
@@ -263,6 +304,8 @@ public:
   } /* getGroup */
 
   void share ();
+  void startShare ();
+  void finishShare ();
 
   /**
    * Get share step
@@ -296,6 +339,28 @@ public:
     return getGroupConst ()->getComputationEnd (diffPosEnd, ParallelGridBase::getSize ());
   } /* ParallelGrid::getComputationEnd */
 
+  /**
+   * Get first coordinate of inner part of chunk, computations for which do not depend on values in buffers
+   *
+   * @return first coordinate of inner part of chunk
+   */
+  virtual ParallelGridCoordinate getComputationInnerStart
+    (const ParallelGridCoordinate & start) const CXX11_OVERRIDE /**< first coordinate of chunk */
+  {
+    return getGroupConst ()->getComputationInnerStart (start);
+  } /* ParallelGrid::getComputationInnerStart */
+
+  /**
+   * Get last coordinate of inner part of chunk, computations for which do not depend on values in buffers
+   *
+   * @return last coordinate of inner part of chunk
+   */
+  virtual ParallelGridCoordinate getComputationInnerEnd
+    (const ParallelGridCoordinate & end) const CXX11_OVERRIDE /**< last coordinate of chunk */
+  {
+    return getGroupConst ()->getComputationInnerEnd (end, ParallelGridBase::getSize ());
+  } /* ParallelGrid::getComputationInnerEnd */
+
   /**
    * Get total position in grid from relative position for current computational node
    *
@@ -430,6 +495,22 @@ public:
   ParallelGridBase *gatherFullGrid () const;
   ParallelGridBase *gatherFullGridPlacement (ParallelGridBase *) const;
 
+  void dumpCollective (const std::string &, ParallelGridCoordinate, ParallelGridCoordinate, int);
+  void loadCollective (const std::string &, ParallelGridCoordinate, ParallelGridCoordinate, int);
+  void loadMapped (const std::string &, ParallelGridCoordinate, ParallelGridCoordinate, int);
+
+  void shareValuesOnNode ();
+
+  /**
+   * Check whether values of grid are stored in shared memory window of node
+   *
+   * @return true if values of grid are stored in shared memory window of node
+   */
+  bool isSharedOnNode () const
+  {
+    return nodeWindow != MPI_WIN_NULL;
+  } /* isSharedOnNode */
+
 #ifdef DYNAMIC_GRID
   void Resize (ParallelGridCoordinate);
 #endif /* DYNAMIC_GRID */
@@ -599,6 +680,19 @@ public:
     groups.push_back (newgroup);
     return index;
   } /* addGroup */
+
+  /**
+   * Delete all parallel grid groups. Must be called after all parallel grids are deleted and before MPI_Finalize.
+   */
+  static void deleteGroups ()
+  {
+    for (int i = 0; i < groups.size (); ++i)
+    {
+      delete groups[i];
+    }
+
+    groups.clear ();
+  } /* deleteGroups */
 }; /* ParallelGrid */
 
 #endif /* PARALLEL_GRID */
@@ -97,14 +97,14 @@ ParallelGridCore::NodeGridInit (ParallelGridCoordinate size) /**< size of grid *
 void
 ParallelGridCore::NodeGridInit (ParallelGridCoordinate size) /**< size of grid */
 {
-  if (totalProcCount < 4)
+  if (totalProcCount < 2)
   {
-    ASSERT_MESSAGE ("Unsupported number of nodes for 2D parallel buffers. Use 1D ones.");
+    ASSERT_MESSAGE ("Unsupported number of nodes for parallel buffers. Use without parallel grid.");
   }
 
   int nodeGridSizeXOptimal;
   int nodeGridSizeYOptimal;
-  initOptimal (size.get1 (), size.get2 (), nodeGridSizeXOptimal, nodeGridSizeYOptimal);
+  initOptimal (size.get1 (), size.get2 (), 1, nodeGridSizeXOptimal, nodeGridSizeYOptimal);
 
   if (!doUseManualTopology)
   {
@@ -119,11 +119,10 @@ ParallelGridCore::NodeGridInit (ParallelGridCoordinate size) /**< size of grid *
 
   nodeGridSizeXY = nodeGridSizeX * nodeGridSizeY;
 
-  if (nodeGridSizeX <= 1 || nodeGridSizeY <= 1)
+  if (nodeGridSizeXY <= 1)
   {
-    ASSERT_MESSAGE ("2D-XY virtual topology could be used only with number of processes > 1 by Ox and Oy axis. "
-                    "Recompile with `-DPARALLEL_BUFFER_DIMENSION=x`, or `-DPARALLEL_BUFFER_DIMENSION=y`, or "
-                    "use without parallel grid");
+    ASSERT_MESSAGE ("2D-XY virtual topology could be used only with number of processes > 1. "
+                    "Use without parallel grid");
   }
 
   if (getProcessId () == 0)
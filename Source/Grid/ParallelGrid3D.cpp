@@ -134,9 +134,9 @@ ParallelGridCore::NodeGridInit (ParallelGridCoordinate size) /**< size of grid *
 void
 ParallelGridCore::NodeGridInit (ParallelGridCoordinate size) /**< desired relation values */
 {
-  if (totalProcCount < 4)
+  if (totalProcCount < 2)
   {
-    ASSERT_MESSAGE ("Unsupported number of nodes for 2D parallel buffers. Use 1D ones.");
+    ASSERT_MESSAGE ("Unsupported number of nodes for parallel buffers. Use without parallel grid.");
   }
 
   int nodeGridSizeXOptimal;
@@ -144,7 +144,7 @@ ParallelGridCore::NodeGridInit (ParallelGridCoordinate size) /**< desired relati
   int nodeGridSizeZOptimal;
 
 #ifdef PARALLEL_BUFFER_DIMENSION_2D_XY
-  initOptimal (size.get1 (), size.get2 (), nodeGridSizeXOptimal, nodeGridSizeYOptimal);
+  initOptimal (size.get1 (), size.get2 (), size.get3 (), nodeGridSizeXOptimal, nodeGridSizeYOptimal);
   nodeGridSizeZOptimal = 1;
 
   if (!doUseManualTopology)
@@ -161,15 +161,14 @@ ParallelGridCore::NodeGridInit (ParallelGridCoordinate size) /**< desired relati
 
   nodeGridSizeXY = nodeGridSizeX * nodeGridSizeY;
 
-  if (nodeGridSizeX <= 1 || nodeGridSizeY <= 1)
+  if (nodeGridSizeXY <= 1)
   {
-    ASSERT_MESSAGE ("3D-XY virtual topology could be used only with number of processes > 1 by Ox and Oy axis. "
-                    "Recompile with `-DPARALLEL_BUFFER_DIMENSION=x`, or `-DPARALLEL_BUFFER_DIMENSION=y`, or "
-                    "use without parallel grid");
+    ASSERT_MESSAGE ("3D-XY virtual topology could be used only with number of processes > 1. "
+                    "Use without parallel grid");
   }
 #endif /* PARALLEL_BUFFER_DIMENSION_2D_XY */
 #ifdef PARALLEL_BUFFER_DIMENSION_2D_YZ
-  initOptimal (size.get2 (), size.get3 (), nodeGridSizeYOptimal, nodeGridSizeZOptimal);
+  initOptimal (size.get2 (), size.get3 (), size.get1 (), nodeGridSizeYOptimal, nodeGridSizeZOptimal);
   nodeGridSizeXOptimal = 1;
 
   if (!doUseManualTopology)
@@ -186,15 +185,14 @@ ParallelGridCore::NodeGridInit (ParallelGridCoordinate size) /**< desired relati
 
   nodeGridSizeYZ = nodeGridSizeY * nodeGridSizeZ;
 
-  if (nodeGridSizeY <= 1 || nodeGridSizeZ <= 1)
+  if (nodeGridSizeYZ <= 1)
   {
-    ASSERT_MESSAGE ("3D-YZ virtual topology could be used only with number of processes > 1 by Oy and Oz axis. "
-                    "Recompile with `-DPARALLEL_BUFFER_DIMENSION=y`, or `-DPARALLEL_BUFFER_DIMENSION=z`, or "
-                    "use without parallel grid");
+    ASSERT_MESSAGE ("3D-YZ virtual topology could be used only with number of processes > 1. "
+                    "Use without parallel grid");
   }
 #endif /* PARALLEL_BUFFER_DIMENSION_2D_YZ */
 #ifdef PARALLEL_BUFFER_DIMENSION_2D_XZ
-  initOptimal (size.get1 (), size.get3 (), nodeGridSizeXOptimal, nodeGridSizeZOptimal);
+  initOptimal (size.get1 (), size.get3 (), size.get2 (), nodeGridSizeXOptimal, nodeGridSizeZOptimal);
   nodeGridSizeYOptimal = 1;
 
   if (!doUseManualTopology)
@@ -211,11 +209,10 @@ ParallelGridCore::NodeGridInit (ParallelGridCoordinate size) /**< desired relati
 
   nodeGridSizeXZ = nodeGridSizeX * nodeGridSizeZ;
 
-  if (nodeGridSizeX <= 1 || nodeGridSizeZ <= 1)
+  if (nodeGridSizeXZ <= 1)
   {
-    ASSERT_MESSAGE ("3D-XZ virtual topology could be used only with number of processes > 1 by Ox and Oz axis. "
-                    "Recompile with `-DPARALLEL_BUFFER_DIMENSION=x`, or `-DPARALLEL_BUFFER_DIMENSION=z`, or "
-                    "use without parallel grid");
+    ASSERT_MESSAGE ("3D-XZ virtual topology could be used only with number of processes > 1. "
+                    "Use without parallel grid");
   }
 #endif /* PARALLEL_BUFFER_DIMENSION_2D_XZ */
 
@@ -262,9 +259,9 @@ ParallelGridCore::NodeGridInit (ParallelGridCoordinate size) /**< desired relati
 void
 ParallelGridCore::NodeGridInit (ParallelGridCoordinate size) /**< size of grid */
 {
-  if (totalProcCount < 8)
+  if (totalProcCount < 2)
   {
-    ASSERT_MESSAGE ("Unsupported number of nodes for 3D parallel buffers. Use 2D or 1D ones.");
+    ASSERT_MESSAGE ("Unsupported number of nodes for parallel buffers. Use without parallel grid.");
   }
 
   int nodeGridSizeXOptimal;
@@ -288,13 +285,10 @@ ParallelGridCore::NodeGridInit (ParallelGridCoordinate size) /**< size of grid *
   nodeGridSizeXYZ = nodeGridSizeX * nodeGridSizeY * nodeGridSizeZ;
   nodeGridSizeXY = nodeGridSizeX * nodeGridSizeY;
 
-  if (nodeGridSizeX <= 1 || nodeGridSizeY <= 1 || nodeGridSizeZ <= 1)
+  if (nodeGridSizeXYZ <= 1)
   {
-    ASSERT_MESSAGE ("3D-XYZ virtual topology could be used only with number of processes > 1 by Ox and Oy axis. "
-                    "Recompile with `-DPARALLEL_BUFFER_DIMENSION=x`, or `-DPARALLEL_BUFFER_DIMENSION=y`, or "
-                    "`-DPARALLEL_BUFFER_DIMENSION=z`, or `-DPARALLEL_BUFFER_DIMENSION=xy`, or "
-                    "`-DPARALLEL_BUFFER_DIMENSION=yz`, or `-DPARALLEL_BUFFER_DIMENSION=xz`, or "
-                    "use without parallel grid");
+    ASSERT_MESSAGE ("3D-XYZ virtual topology could be used only with number of processes > 1. "
+                    "Use without parallel grid");
   }
 
   if (getProcessId () == 0)
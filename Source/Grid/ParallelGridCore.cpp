@@ -508,6 +508,130 @@ ParallelGridCore::getNodeGridZ (int process) const /**< process id */
 #endif /* PARALLEL_BUFFER_DIMENSION_1D_Z || PARALLEL_BUFFER_DIMENSION_2D_YZ ||
           PARALLEL_BUFFER_DIMENSION_2D_XZ || PARALLEL_BUFFER_DIMENSION_3D_XYZ */
 
+/**
+ * Find shared memory nodes, on which processes are placed. Communicator of processes on the same node is created here
+ * for all processes, and is later reduced to processes, which are used in computations.
+ */
+void
+ParallelGridCore::initNodeOfProcess ()
+{
+  int retCode = MPI_Comm_split_type (MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, processId, MPI_INFO_NULL, &nodeCommunicator);
+  ASSERT (retCode == MPI_SUCCESS);
+
+  /*
+   * Node is identified by the rank of its first process
+   */
+  int node = processId;
+  retCode = MPI_Allreduce (&processId, &node, 1, MPI_INT, MPI_MIN, nodeCommunicator);
+  ASSERT (retCode == MPI_SUCCESS);
+
+  nodeOfProcess.resize (totalProcCount);
+  retCode = MPI_Allgather (&node, 1, MPI_INT, &nodeOfProcess[0], 1, MPI_INT, MPI_COMM_WORLD);
+  ASSERT (retCode == MPI_SUCCESS);
+} /* ParallelGridCore::initNodeOfProcess */
+
+/**
+ * Estimate time of single time step for virtual topology with cost model.
+ *
+ * Time of time step is the maximum over all processes of time of computations for chunk of process and of time of
+ * share operations with all its neighbors (including diagonal ones), which is latency plus size of shared buffer
+ * divided by bandwidth. Share operations are performed once per bufferSize time steps. Latency and bandwidth depend
+ * on whether neighbors are placed on the same shared memory node. Processes are numbered along the first axis first.
+ *
+ * @return estimated time of single time step
+ */
+DOUBLE
+ParallelGridCore::estimateTopologyTime (grid_coord size1, /**< grid size by first axis */
+                                        grid_coord size2, /**< grid size by second axis */
+                                        grid_coord size3, /**< grid size by third axis */
+                                        int nodeGridSize1, /**< nodes grid size by first axis */
+                                        int nodeGridSize2, /**< nodes grid size by second axis */
+                                        int nodeGridSize3) const /**< nodes grid size by third axis */
+{
+  ASSERT (nodeGridSize1 * nodeGridSize2 * nodeGridSize3 <= totalProcCount);
+
+  grid_coord sizes[3] = { size1, size2, size3 };
+  int nodeGridSizes[3] = { nodeGridSize1, nodeGridSize2, nodeGridSize3 };
+
+  DOUBLE maxTime = DOUBLE (0);
+
+  for (int pid = 0; pid < nodeGridSize1 * nodeGridSize2 * nodeGridSize3; ++pid)
+  {
+    int coords[3] = { pid % nodeGridSize1,
+                      (pid / nodeGridSize1) % nodeGridSize2,
+                      pid / (nodeGridSize1 * nodeGridSize2) };
+
+    /*
+     * The last process by each axis gets the remainder of grid, see CalculateGridSizeForNode
+     */
+    grid_coord chunk[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      chunk[axis] = sizes[axis] / nodeGridSizes[axis];
+      if (coords[axis] == nodeGridSizes[axis] - 1)
+      {
+        chunk[axis] = sizes[axis] - (nodeGridSizes[axis] - 1) * chunk[axis];
+      }
+    }
+
+    DOUBLE computeTime = DOUBLE (chunk[0]) * DOUBLE (chunk[1]) * DOUBLE (chunk[2])
+                         * costModel.pointTime / DOUBLE (costModel.threadsPerProcess);
+    DOUBLE shareTime = DOUBLE (0);
+
+    for (int dir = 0; dir < 27; ++dir)
+    {
+      int diff[3] = { dir % 3 - 1, (dir / 3) % 3 - 1, dir / 9 - 1 };
+
+      if (diff[0] == 0 && diff[1] == 0 && diff[2] == 0)
+      {
+        continue;
+      }
+
+      int neighbor = 0;
+      int neighborStride = 1;
+      DOUBLE bufSize = DOUBLE (1);
+      bool isNeighbor = true;
+
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        int coord = coords[axis] + diff[axis];
+        if (coord < 0 || coord >= nodeGridSizes[axis])
+        {
+          isNeighbor = false;
+          break;
+        }
+
+        neighbor += coord * neighborStride;
+        neighborStride *= nodeGridSizes[axis];
+
+        bufSize *= diff[axis] == 0 ? DOUBLE (chunk[axis]) : DOUBLE (costModel.bufferSize);
+      }
+
+      if (!isNeighbor)
+      {
+        continue;
+      }
+
+      if (nodeOfProcess[pid] == nodeOfProcess[neighbor])
+      {
+        shareTime += costModel.latencyIntraNode + bufSize / costModel.bandwidthIntraNode;
+      }
+      else
+      {
+        shareTime += costModel.latencyInterNode + bufSize / costModel.bandwidthInterNode;
+      }
+    }
+
+    DOUBLE time = computeTime + shareTime / DOUBLE (costModel.bufferSize);
+    if (time > maxTime)
+    {
+      maxTime = time;
+    }
+  }
+
+  return maxTime;
+} /* ParallelGridCore::estimateTopologyTime */
+
 /**
  * Initialize parallel data common for all parallel grids on a single computational node
  */
@@ -570,11 +694,17 @@ ParallelGridCore::ParallelGridCore (int process, /**< id of computational node *
                                     ParallelGridCoordinate size, /**< size of grid (not used
                                                                   *   for 1D buffer dimensions) */
                                     bool useManualTopology, /**< flag whether to use manual virtual topology */
-                                    ParallelGridCoordinate topology) /**< topology size, specified manually */
+                                    ParallelGridCoordinate topology, /**< topology size, specified manually */
+                                    bool useNeighborShareSync, /**< flag whether to synchronize computational nodes
+                                                                *   after share operations only with neighbors */
+                                    TopologyCostModel topologyCostModel) /**< cost model of time step, which is used
+                                                                          *   to choose optimal virtual topology */
   : processId (process)
   , totalProcCount (totalProc)
   , doUseManualTopology (useManualTopology)
   , topologySize (topology)
+  , doUseNeighborShareSync (useNeighborShareSync)
+  , costModel (topologyCostModel)
 {
   /*
    * Set default values for flags whether computational node has neighbors
@@ -600,6 +730,8 @@ ParallelGridCore::ParallelGridCore (int process, /**< id of computational node *
 
   initOppositeDirections ();
 
+  initNodeOfProcess ();
+
   ParallelGridCoreConstructor (size);
 
 #ifndef COMBINED_SENDRECV
@@ -654,6 +786,20 @@ ParallelGridCore::ParallelGridCore (int process, /**< id of computational node *
   int retCode = MPI_Comm_split (MPI_COMM_WORLD, process < totalProcCount ? 0 : MPI_UNDEFINED, process, &communicator);
   ASSERT (retCode == MPI_SUCCESS);
 
+  /*
+   * Exclude processes, which are not used in computations, from communicator of node
+   */
+  if (totalProcCount < totalProc)
+  {
+    MPI_Comm allNodeCommunicator = nodeCommunicator;
+
+    retCode = MPI_Comm_split (allNodeCommunicator, process < totalProcCount ? 0 : MPI_UNDEFINED, process, &nodeCommunicator);
+    ASSERT (retCode == MPI_SUCCESS);
+
+    retCode = MPI_Comm_free (&allNodeCommunicator);
+    ASSERT (retCode == MPI_SUCCESS);
+  }
+
 #ifdef DYNAMIC_GRID
   dynamicInfo.calcClockSumBetweenRebalance.resize (totalProcCount);
   dynamicInfo.calcClockCountBetweenRebalance.resize (totalProcCount);
@@ -684,6 +830,12 @@ ParallelGridCore::ParallelGridCore (int process, /**< id of computational node *
 
 ParallelGridCore::~ParallelGridCore ()
 {
+  if (nodeCommunicator != MPI_COMM_NULL)
+  {
+    int retCode = MPI_Comm_free (&nodeCommunicator);
+    ASSERT (retCode == MPI_SUCCESS);
+  }
+
 #ifdef DYNAMIC_GRID
   delete[] dynamicInfo.shareClockSec_buf;
 
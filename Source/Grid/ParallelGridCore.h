@@ -7,6 +7,43 @@
 
 #ifdef PARALLEL_GRID
 
+/**
+ * Parameters of cost model of time step, which is used to choose optimal virtual topology.
+ *
+ * Latency is measured in seconds and bandwidth in grid points per second, the same as latency and bandwidth measured
+ * by dynamic grid. Time of computations for single grid point is the inverse of performance of single thread.
+ */
+struct TopologyCostModel
+{
+  DOUBLE pointTime; /**< time of computations for single grid point on single thread */
+  int threadsPerProcess; /**< number of threads of each computational node */
+  DOUBLE latencyIntraNode; /**< latency of share operations between processes on the same shared memory node */
+  DOUBLE bandwidthIntraNode; /**< bandwidth of share operations between processes on the same shared memory node */
+  DOUBLE latencyInterNode; /**< latency of share operations between processes on different nodes */
+  DOUBLE bandwidthInterNode; /**< bandwidth of share operations between processes on different nodes */
+  int bufferSize; /**< size of buffers of parallel grid */
+
+  /**
+   * Constructor with parameters of cost model
+   */
+  TopologyCostModel (DOUBLE newPointTime = DOUBLE (5e-8), /**< time of computations for single grid point */
+                     int newThreadsPerProcess = 1, /**< number of threads of each computational node */
+                     DOUBLE newLatencyIntraNode = DOUBLE (1e-6), /**< latency inside shared memory node */
+                     DOUBLE newBandwidthIntraNode = DOUBLE (5e8), /**< bandwidth inside shared memory node */
+                     DOUBLE newLatencyInterNode = DOUBLE (5e-6), /**< latency between nodes */
+                     DOUBLE newBandwidthInterNode = DOUBLE (1e8), /**< bandwidth between nodes */
+                     int newBufferSize = 1) /**< size of buffers of parallel grid */
+    : pointTime (newPointTime)
+    , threadsPerProcess (newThreadsPerProcess)
+    , latencyIntraNode (newLatencyIntraNode)
+    , bandwidthIntraNode (newBandwidthIntraNode)
+    , latencyInterNode (newLatencyInterNode)
+    , bandwidthInterNode (newBandwidthInterNode)
+    , bufferSize (newBufferSize)
+  {
+  } /* TopologyCostModel */
+}; /* TopologyCostModel */
+
 /**
  * Class with data shared between all parallel grids on a single computational node
  */
@@ -160,12 +197,35 @@ private:
    */
   ParallelGridCoordinate topologySize;
 
+  /**
+   * Flag whether to synchronize computational nodes after share operations only through send/receive operations
+   * with neighbors, i.e. without global barrier
+   */
+  bool doUseNeighborShareSync;
+
+  /**
+   * Cost model of time step, which is used to choose optimal virtual topology (with dynamic grid latency and
+   * bandwidth are updated with measured ones on each rebalance)
+   */
+  TopologyCostModel costModel;
+
+  /**
+   * Identifiers of shared memory nodes, on which processes are placed (rank of the first process on the same node)
+   */
+  std::vector<int> nodeOfProcess;
+
   /**
    * Communicator for all processes, used in computations
    * (could differ from MPI_COMM_WORLD on the processes, which are not used in computations)
    */
   MPI_Comm communicator;
 
+  /**
+   * Communicator for processes of communicator above, which are placed on the same shared memory node (it is created
+   * before virtual topology is chosen, so that placement of processes on nodes is known to cost model)
+   */
+  MPI_Comm nodeCommunicator;
+
 #ifndef COMBINED_SENDRECV
   std::vector<bool> isEvenForDirection;
 #endif /* !COMBINED_SENDRECV */
@@ -183,15 +243,29 @@ private:
   void InitBufferFlags ();
   void InitDirections ();
 
+  void initNodeOfProcess ();
+  DOUBLE estimateTopologyTime (grid_coord, grid_coord, grid_coord, int, int, int) const;
+
 #ifdef DYNAMIC_GRID
   void SetNodesForDirections (int);
 #endif /* DYNAMIC_GRID */
 
 public:
 
-  ParallelGridCore (int, int, ParallelGridCoordinate, bool, ParallelGridCoordinate);
+  ParallelGridCore (int, int, ParallelGridCoordinate, bool, ParallelGridCoordinate, bool,
+                    TopologyCostModel = TopologyCostModel ());
   ~ParallelGridCore ();
 
+  /**
+   * Getter for flag whether to synchronize computational nodes after share operations only with neighbors
+   *
+   * @return flag whether to synchronize computational nodes after share operations only with neighbors
+   */
+  bool getDoUseNeighborShareSync () const
+  {
+    return doUseNeighborShareSync;
+  } /* getDoUseNeighborShareSync */
+
   /**
    * Getter for communicator for all processes, used in computations
    *
@@ -202,6 +276,26 @@ public:
     return communicator;
   } /* getCommunicator */
 
+  /**
+   * Getter for communicator for processes, used in computations, which are placed on the same shared memory node
+   *
+   * @return communicator for processes, which are placed on the same shared memory node
+   */
+  MPI_Comm getNodeCommunicator () const
+  {
+    return nodeCommunicator;
+  } /* getNodeCommunicator */
+
+  /**
+   * Getter for cost model of time step
+   *
+   * @return cost model of time step
+   */
+  const TopologyCostModel &getCostModel () const
+  {
+    return costModel;
+  } /* getCostModel */
+
 #ifndef COMBINED_SENDRECV
   const std::vector<bool> &getIsEvenForDirection () const
   {
@@ -538,7 +632,7 @@ public:
 
 #if defined (PARALLEL_BUFFER_DIMENSION_2D_XY) || defined (PARALLEL_BUFFER_DIMENSION_2D_YZ) || defined (PARALLEL_BUFFER_DIMENSION_2D_XZ)
 
-  void initOptimal (grid_coord, grid_coord, int &, int &);
+  void initOptimal (grid_coord, grid_coord, grid_coord, int &, int &);
 
 #endif /* PARALLEL_BUFFER_DIMENSION_2D_XY || PARALLEL_BUFFER_DIMENSION_2D_YZ || PARALLEL_BUFFER_DIMENSION_2D_XZ */
 
@@ -899,6 +993,7 @@ public:
   void initializeIterationCounters (time_step);
   DOUBLE calcTotalPerf (time_step);
   void calcTotalLatencyAndBandwidth (time_step);
+  void updateCostModel ();
 #endif /* DYNAMIC_GRID */
 }; /* ParallelGridCore */
 
@@ -534,7 +534,7 @@ void ParallelGridCore::ShareShareClocks ()
           dynamicInfo.shareClockSec_buf[j] = value;
 #else /* MPI_CLOCK */
           dynamicInfo.shareClockSec_buf[j] = value.tv_sec;
-          dynamicInfo.shareClockNSec_buf[j] = value.tv_sec;
+          dynamicInfo.shareClockNSec_buf[j] = value.tv_nsec;
 #endif /* !MPI_CLOCK */
 
           j++;
@@ -820,6 +820,18 @@ ParallelGridCore::updateCurrentShareValues ()
       ASSERT (clockMap.size () == CLOCK_BUF_SIZE
               || clockMap.empty ());
 
+      if (clockMap.empty ())
+      {
+        /*
+         * Nodes are not neighbors and have not performed share operations
+         */
+        dynamicInfo.curShareLatency[i][j] = DOUBLE (0);
+        dynamicInfo.curShareBandwidth[i][j] = DOUBLE (0);
+        dynamicInfo.skipCurShareMeasurement[i][j] = 1;
+
+        continue;
+      }
+
       approximateWithLinearRegression (dynamicInfo.curShareLatency[i][j], dynamicInfo.curShareBandwidth[i][j], clockMap);
 
       if (dynamicInfo.curShareBandwidth[i][j] <= DOUBLE (0) || dynamicInfo.curShareLatency[i][j] < DOUBLE (0))
@@ -1102,8 +1114,55 @@ ParallelGridCore::calcTotalLatencyAndBandwidth (time_step difft) /**< elapsed nu
       dynamicInfo.bandwidth[process][i] = calcBandwidthForConnection (process, i);
     }
   }
+
+  updateCostModel ();
 }
 
+/**
+ * Update latency and bandwidth of cost model of time step with average of the measured ones, separately for
+ * connections between processes on the same shared memory node and on different nodes. Parameters, for which there
+ * are no measurements yet (e.g. all processes are placed on single node), keep values passed at launch.
+ */
+void
+ParallelGridCore::updateCostModel ()
+{
+  /*
+   * Index 0 is for connections inside node, index 1 is for connections between nodes
+   */
+  DOUBLE sumLatency[2] = { DOUBLE (0), DOUBLE (0) };
+  DOUBLE sumBandwidth[2] = { DOUBLE (0), DOUBLE (0) };
+  int count[2] = { 0, 0 };
+
+  for (int i = 0; i < getTotalProcCount (); ++i)
+  {
+    for (int j = i + 1; j < getTotalProcCount (); ++j)
+    {
+      if (dynamicInfo.bandwidth[i][j] <= DOUBLE (0) || dynamicInfo.latency[i][j] < DOUBLE (0))
+      {
+        continue;
+      }
+
+      int type = nodeOfProcess[i] == nodeOfProcess[j] ? 0 : 1;
+
+      sumLatency[type] += dynamicInfo.latency[i][j];
+      sumBandwidth[type] += dynamicInfo.bandwidth[i][j];
+      ++count[type];
+    }
+  }
+
+  if (count[0] > 0)
+  {
+    costModel.latencyIntraNode = sumLatency[0] / DOUBLE (count[0]);
+    costModel.bandwidthIntraNode = sumBandwidth[0] / DOUBLE (count[0]);
+  }
+
+  if (count[1] > 0)
+  {
+    costModel.latencyInterNode = sumLatency[1] / DOUBLE (count[1]);
+    costModel.bandwidthInterNode = sumBandwidth[1] / DOUBLE (count[1]);
+  }
+} /* ParallelGridCore::updateCostModel */
+
 #endif /* DYNAMIC_GRID */
 
 #endif /* PARALLEL_GRID */
@@ -6,15 +6,15 @@
 #ifdef DEBUG_INFO
 
 #ifdef GRID_1D
-#define COORD_TYPES ,ct1
+#define COORD_TYPES , getGroupConst()->get_ct1 ()
 #endif /* GRID_1D */
 
 #ifdef GRID_2D
-#define COORD_TYPES ,ct1,ct2
+#define COORD_TYPES , getGroupConst()->get_ct1 (), getGroupConst()->get_ct2 ()
 #endif /* GRID_2D */
 
 #ifdef GRID_3D
-#define COORD_TYPES ,ct1,ct2,ct3
+#define COORD_TYPES , getGroupConst()->get_ct1 (), getGroupConst()->get_ct2 (), getGroupConst()->get_ct3 ()
 #endif /* GRID_3D */
 
 #else /* DEBUG_INFO */
@@ -22,133 +22,278 @@
 #endif /* !DEBUG_INFO */
 
 /**
- * Resize parallel grid for current process at a new size
+ * Gather chunks (not considering buffers) of all computational nodes. Chunk of each node is described with
+ * CHUNK_BOX_SIZE values: start coordinates by three axes, followed by end coordinates by three axes (absent axes have
+ * start 0 and end 1). Chunk of disabled node is empty.
  */
 void
-ParallelGrid::Resize (ParallelGridCoordinate newCurrentNodeSize) /**< new size of chunk assigned to current process */
+ParallelGridGroup::gatherChunks (std::vector<grid_coord> &allChunks) const /**< out: chunks of all nodes */
 {
-  /*
-   * TODO: do not allocate each time
-   */
-  ParallelGridBase *totalGrid = gatherFullGrid ();
+  grid_coord box[CHUNK_BOX_SIZE] = {0, 0, 0, 1, 1, 1};
+
+  if (getParallelCore ()->getNodeState ()[getParallelCore ()->getProcessId ()])
+  {
+    ParallelGridCoordinate chunkStart = getChunkStartPosition ();
+    ParallelGridCoordinate chunkEnd = chunkStart + currentSize;
+
+#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
+    box[0] = chunkStart.get1 ();
+    box[3] = chunkEnd.get1 ();
+#endif /* GRID_1D || GRID_2D || GRID_3D */
+#if defined (GRID_2D) || defined (GRID_3D)
+    box[1] = chunkStart.get2 ();
+    box[4] = chunkEnd.get2 ();
+#endif /* GRID_2D || GRID_3D */
+#if defined (GRID_3D)
+    box[2] = chunkStart.get3 ();
+    box[5] = chunkEnd.get3 ();
+#endif /* GRID_3D */
+  }
+  else
+  {
+    box[3] = 0;
+  }
 
-  ParallelGridCoordinate oldSize = currentSize;
+  allChunks.resize (CHUNK_BOX_SIZE * getParallelCore ()->getTotalProcCount ());
 
-  currentSize = newCurrentNodeSize;
+  int retCode = MPI_Allgather (box, CHUNK_BOX_SIZE, MPI_COORD,
+                               &allChunks[0], CHUNK_BOX_SIZE, MPI_COORD,
+                               getParallelCore ()->getCommunicator ());
+  ASSERT (retCode == MPI_SUCCESS);
+} /* ParallelGridGroup::gatherChunks */
 
-  int state = ParallelGrid::getParallelCore ()->getNodeState ()[ParallelGrid::getParallelCore ()->getProcessId ()];
+/**
+ * Resize chunk of current node for all grids of group. Sizes, buffers and start positions are recomputed, and chunks of
+ * all nodes before and after resize are saved, so that grids of group could migrate their values (see
+ * ParallelGrid::Resize). Must be called on all computational nodes.
+ */
+void
+ParallelGridGroup::Resize (ParallelGridCoordinate newCurrentSize) /**< new size of chunk of current node */
+{
+  gatherChunks (prevChunks);
+  prevPosStart = posStart;
 
-  if (state)
-  {
-    ParallelGridConstructor ();
+  currentSize = newCurrentSize;
+  ParallelGridGroupConstructor ();
 
-    /*
-     * TODO: do not free/allocate each time
-     */
-    for (grid_coord index = size.calculateTotalCoord (); index < gridValues.size (); ++index)
-    {
-      delete gridValues[index];
-    }
+  gatherChunks (chunks);
+  ++resizeCount;
+} /* ParallelGridGroup::Resize */
 
-    grid_coord temp = gridValues.size ();
-    gridValues.resize (size.calculateTotalCoord ());
+/**
+ * Intersect two chunks
+ *
+ * @return true if intersection is not empty
+ */
+static bool
+intersectChunks (const grid_coord *box1, /**< first chunk */
+                 const grid_coord *box2, /**< second chunk */
+                 grid_coord *res) /**< out: intersection */
+{
+  for (int axis = 0; axis < CHUNK_BOX_SIZE / 2; ++axis)
+  {
+    res[axis] = box1[axis] > box2[axis] ? box1[axis] : box2[axis];
+    res[axis + CHUNK_BOX_SIZE / 2] = box1[axis + CHUNK_BOX_SIZE / 2] < box2[axis + CHUNK_BOX_SIZE / 2]
+                                     ? box1[axis + CHUNK_BOX_SIZE / 2] : box2[axis + CHUNK_BOX_SIZE / 2];
 
-    for (grid_coord index = temp; index < size.calculateTotalCoord (); ++index)
+    if (res[axis] >= res[axis + CHUNK_BOX_SIZE / 2])
     {
-      gridValues[index] = new FieldPointValue ();
+      return false;
     }
   }
 
-  gatherStartPosition ();
+  return true;
+} /* intersectChunks */
 
-  if (state)
-  {
-    ParallelGridCoordinate chunkStart = getChunkStartPosition ();
-    ParallelGridCoordinate chunkEnd = chunkStart + getCurrentSize ();
+/**
+ * Copy values of all time steps and all lanes between chunk box of grid and buffer
+ */
+void
+ParallelGrid::copyChunkBox (const grid_coord *box, /**< chunk box in absolute coordinates */
+                            const ParallelGridCoordinate &boxGridSize, /**< size of grid (including buffers) */
+                            const ParallelGridCoordinate &boxPosStart, /**< absolute start position of grid */
+                            const std::vector<FieldValue *> &values, /**< time step layers of grid */
+                            VectorBufferValues &buffer, /**< buffer */
+                            bool isToBuffer) /**< whether to copy values from grid to buffer, or vice versa */
+{
+  buffer.resize ((box[3] - box[0]) * (box[4] - box[1]) * (box[5] - box[2]) * values.size () * batchSize);
 
+  grid_coord index = 0;
+
+  for (grid_coord i = box[0]; i < box[3]; ++i)
+  {
+    for (grid_coord j = box[1]; j < box[4]; ++j)
+    {
+      for (grid_coord k = box[2]; k < box[5]; ++k)
+      {
 #ifdef GRID_1D
-    ParallelGridCoordinate sizeCoord (chunkEnd.get1 () - chunkStart.get1 () COORD_TYPES);
+        ParallelGridCoordinate pos (i COORD_TYPES);
 #endif /* GRID_1D */
 #ifdef GRID_2D
-    ParallelGridCoordinate sizeCoord (chunkEnd.get1 () - chunkStart.get1 (),
-                                      chunkEnd.get2 () - chunkStart.get2 () COORD_TYPES);
+        ParallelGridCoordinate pos (i, j COORD_TYPES);
 #endif /* GRID_2D */
 #ifdef GRID_3D
-    ParallelGridCoordinate sizeCoord (chunkEnd.get1 () - chunkStart.get1 (),
-                                      chunkEnd.get2 () - chunkStart.get2 (),
-                                      chunkEnd.get3 () - chunkStart.get3 () COORD_TYPES);
+        ParallelGridCoordinate pos (i, j, k COORD_TYPES);
 #endif /* GRID_3D */
 
-    grid_coord left_coord, right_coord;
-    grid_coord down_coord, up_coord;
-    grid_coord back_coord, front_coord;
+        grid_coord coord = calculateIndexFromPosition (pos - boxPosStart, boxGridSize) * batchSize;
+
+        for (int t = 0; t < values.size (); ++t)
+        {
+          for (int lane = 0; lane < batchSize; ++lane)
+          {
+            if (isToBuffer)
+            {
+              buffer[index++] = values[t][coord + lane];
+            }
+            else
+            {
+              values[t][coord + lane] = buffer[index++];
+            }
+          }
+        }
+      }
+    }
+  }
+
+  ASSERT (index == (grid_coord) buffer.size ());
+} /* ParallelGrid::copyChunkBox */
 
-    getGroupConst ()->initBufferOffsets (left_coord, right_coord, down_coord, up_coord, back_coord, front_coord);
+/**
+ * Resize parallel grid for current process at a new size and migrate values to new chunks of all computational nodes.
+ * Only parts of chunks, which change their owner, are sent with point-to-point operations to the new owner, so full
+ * grid is never gathered. Buffers are filled with share operation afterwards. Must be called on all computational
+ * nodes for all grids of the same group (parallel group is resized with the first of them).
+ */
+void
+ParallelGrid::Resize (ParallelGridCoordinate newCurrentNodeSize) /**< new size of chunk assigned to current process */
+{
+  ALWAYS_ASSERT (nodeWindow == MPI_WIN_NULL);
 
-    grid_coord index = 0;
+  ParallelGridGroup *group = getGroup ();
 
-#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
-    for (grid_coord i = left_coord; i < left_coord + sizeCoord.get1 (); ++i)
+  if (resizeCount == group->getResizeCount ())
+  {
+    group->Resize (newCurrentNodeSize);
+  }
+  resizeCount = group->getResizeCount ();
+
+  ASSERT (group->getCurrentSize () == newCurrentNodeSize);
+
+  /*
+   * Allocate values for new size, old values are freed after migration
+   */
+  ParallelGridCoordinate oldSize = size;
+  std::vector<FieldValue *> oldValues = gridValues;
+  FieldValue *oldRawValues = rawValues;
+  size_t oldMappedSize = mappedSize;
+  bool oldIsExternalValues = isExternalValues;
+
+  rawValues = NULLPTR;
+  mappedSize = 0;
+  isExternalValues = false;
+  size = group->getSize ();
+  allocateValues ();
+
+  int processId = parallelGridCore->getProcessId ();
+  int totalProcCount = parallelGridCore->getTotalProcCount ();
+
+  const std::vector<grid_coord> &prevChunks = group->getPrevChunks ();
+  const std::vector<grid_coord> &chunks = group->getChunks ();
+
+  VectorBuffers buffersMigrate (totalProcCount);
+  std::vector<MPI_Request> requests;
+  grid_coord box[CHUNK_BOX_SIZE];
+  int retCode;
+
+  /*
+   * Receive parts of new chunk, which were owned by other nodes
+   */
+  for (int process = 0; process < totalProcCount; ++process)
+  {
+    if (process != processId
+        && intersectChunks (&chunks[CHUNK_BOX_SIZE * processId], &prevChunks[CHUNK_BOX_SIZE * process], box))
     {
-#endif /* GRID_1D || GRID_2D || GRID_3D */
-#if defined (GRID_2D) || defined (GRID_3D)
-      for (grid_coord j = down_coord; j < down_coord + sizeCoord.get2 (); ++j)
-      {
-#endif /* GRID_2D || GRID_3D */
-#if defined (GRID_3D)
-        for (grid_coord k = back_coord; k < back_coord + sizeCoord.get3 (); ++k)
-        {
-#endif /* GRID_3D */
+      buffersMigrate[process].resize ((box[3] - box[0]) * (box[4] - box[1]) * (box[5] - box[2])
+                                      * gridValues.size () * batchSize);
+
+      MPI_Request request;
+      retCode = MPI_Irecv (&buffersMigrate[process][0], buffersMigrate[process].size (), MPI_FPVALUE, process, process,
+                           parallelGridCore->getCommunicator (), &request);
+      ASSERT (retCode == MPI_SUCCESS);
+      requests.push_back (request);
+    }
+  }
 
-#ifdef GRID_1D
-          ParallelGridCoordinate pos (i COORD_TYPES);
-          ParallelGridCoordinate posTotal (i - left_coord + chunkStart.get1 () COORD_TYPES);
-#endif /* GRID_1D */
-#ifdef GRID_2D
-          ParallelGridCoordinate pos (i, j COORD_TYPES);
-          ParallelGridCoordinate posTotal (i - left_coord + chunkStart.get1 (),
-                                           j - down_coord + chunkStart.get2 () COORD_TYPES);
-#endif /* GRID_2D */
-#ifdef GRID_3D
-          ParallelGridCoordinate pos (i, j, k COORD_TYPES);
-          ParallelGridCoordinate posTotal (i - left_coord + chunkStart.get1 (),
-                                           j - down_coord + chunkStart.get2 (),
-                                           k - back_coord + chunkStart.get3 () COORD_TYPES);
-#endif /* GRID_3D */
+  /*
+   * Send parts of old chunk, which are now owned by other nodes, and copy part, which stays on this node
+   */
+  VectorBuffers buffersSendMigrate (totalProcCount);
 
-          grid_coord coord = calculateIndexFromPosition (pos);
+  for (int process = 0; process < totalProcCount; ++process)
+  {
+    if (!intersectChunks (&prevChunks[CHUNK_BOX_SIZE * processId], &chunks[CHUNK_BOX_SIZE * process], box))
+    {
+      continue;
+    }
 
-          FieldPointValue *val = gridValues[coord];
+    copyChunkBox (box, oldSize, group->getPrevStartPosition (), oldValues, buffersSendMigrate[process], true);
 
-          grid_coord coord_total = calculateIndexFromPosition (posTotal, totalSize);
+    if (process == processId)
+    {
+      copyChunkBox (box, size, group->getStartPosition (), gridValues, buffersSendMigrate[process], false);
+      continue;
+    }
 
-          *val = *totalGrid->getFieldPointValue (coord_total);
+    MPI_Request request;
+    retCode = MPI_Isend (&buffersSendMigrate[process][0], buffersSendMigrate[process].size (), MPI_FPVALUE, process,
+                         processId, parallelGridCore->getCommunicator (), &request);
+    ASSERT (retCode == MPI_SUCCESS);
+    requests.push_back (request);
+  }
 
-#if defined (GRID_3D)
-        }
-#endif /* GRID_3D */
-#if defined (GRID_2D) || defined (GRID_3D)
-      }
-#endif /* GRID_2D || GRID_3D */
-#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
+  if (!requests.empty ())
+  {
+    retCode = MPI_Waitall (requests.size (), &requests[0], MPI_STATUSES_IGNORE);
+    ASSERT (retCode == MPI_SUCCESS);
+  }
+
+  for (int process = 0; process < totalProcCount; ++process)
+  {
+    if (process != processId
+        && intersectChunks (&chunks[CHUNK_BOX_SIZE * processId], &prevChunks[CHUNK_BOX_SIZE * process], box))
+    {
+      copyChunkBox (box, size, group->getStartPosition (), gridValues, buffersMigrate[process], false);
     }
-#endif /* GRID_1D || GRID_2D || GRID_3D */
   }
 
-  delete totalGrid;
+  /*
+   * Free old values
+   */
+  FieldValue *newRawValues = rawValues;
+  grid_coord newStepStride = stepStride;
+  std::vector<FieldValue *> newValues = gridValues;
+
+  rawValues = oldRawValues;
+  mappedSize = oldMappedSize;
+  isExternalValues = oldIsExternalValues;
+  freeValues ();
+
+  rawValues = newRawValues;
+  stepStride = newStepStride;
+  gridValues = newValues;
 
   DPRINTF (LOG_LEVEL_STAGES_AND_DUMP, "Rebalanced grid '%s' for proc: %d (of %d) from raw size: %llu, to raw size %llu. Done\n",
            gridName.data (),
-           parallelGridCore->getProcessId (),
-           parallelGridCore->getTotalProcCount (),
+           processId,
+           totalProcCount,
            (unsigned long long)oldSize.calculateTotalCoord (),
-           (unsigned long long)currentSize.calculateTotalCoord ());
+           (unsigned long long)size.calculateTotalCoord ());
 
   /*
-   * TODO: check if this share is needed (looks like it's used only for buffers initialiation, which can be done without share)
-   * TODO: optimize to fill buffers without sharing
+   * Values in buffers are not migrated, they are received from neighbors
    */
-  share ();
+  SendReceive ();
 } /* ParallelGrid::Resize */
 
 #undef COORD_TYPES
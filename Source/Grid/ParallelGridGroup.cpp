@@ -33,9 +33,15 @@ ParallelGridGroup::ParallelGridGroup (ParallelGridCoordinate totSize,
   , shareStep (0)
   , shareStepLimit (stepLimit)
   , currentSize (curSize)
+#ifdef ZERO_COPY_SHARE
+  , datatypesStepStride (0)
+#endif /* ZERO_COPY_SHARE */
   , storedSteps (storedTimeSteps)
   , timeOffset (tOffset)
   , groupName (name)
+#ifdef DYNAMIC_GRID
+  , resizeCount (0)
+#endif /* DYNAMIC_GRID */
 {
 #ifdef DEBUG_INFO
   /*
@@ -57,6 +63,32 @@ ParallelGridGroup::ParallelGridGroup (ParallelGridCoordinate totSize,
   ParallelGridGroupConstructor ();
 }
 
+/**
+ * Free derived datatypes of share operations. Must be called before MPI_Finalize.
+ */
+ParallelGridGroup::~ParallelGridGroup ()
+{
+#ifdef ZERO_COPY_SHARE
+  for (int buf = 0; buf < datatypesSend.size (); ++buf)
+  {
+    if (datatypesSend[buf] != MPI_DATATYPE_NULL)
+    {
+      int retCode = MPI_Type_free (&datatypesSend[buf]);
+      ASSERT (retCode == MPI_SUCCESS);
+    }
+  }
+
+  for (int buf = 0; buf < datatypesReceive.size (); ++buf)
+  {
+    if (datatypesReceive[buf] != MPI_DATATYPE_NULL)
+    {
+      int retCode = MPI_Type_free (&datatypesReceive[buf]);
+      ASSERT (retCode == MPI_SUCCESS);
+    }
+  }
+#endif /* ZERO_COPY_SHARE */
+} /* ParallelGridGroup::~ParallelGridGroup */
+
 bool
 ParallelGridGroup::match (ParallelGridCoordinate totSize,
                           ParallelGridCoordinate bufSize,
@@ -680,6 +712,109 @@ ParallelGridGroup::InitBuffers ()
 #endif /* PARALLEL_BUFFER_DIMENSION_3D_XYZ */
 } /* ParallelGridGroup::InitBuffers */
 
+#ifdef ZERO_COPY_SHARE
+
+/**
+ * Create derived datatype, which describes values of all stored time steps of grid of group between start and end
+ * coordinates. Each time step layer is described with subarray of layer, and layers are combined with stride equal to
+ * distance between time step layers in grid memory.
+ *
+ * NOTE: layers are described in the order of their placement in memory, not in the order of time steps. This is
+ *       correct, because all computational nodes perform the same number of shifts in time for grids of group.
+ *
+ * @return committed datatype
+ */
+MPI_Datatype
+ParallelGridGroup::createShareDatatype (ParallelGridCoordinate start, /**< start coordinate of region */
+                                        ParallelGridCoordinate end, /**< end coordinate of region */
+                                        grid_coord stepStride) const /**< number of values between starts of
+                                                                      *   consecutive time step layers */
+{
+  int sizes[3];
+  int subsizes[3];
+  int starts[3];
+  int dims = 0;
+
+#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
+  sizes[dims] = (int) size.get1 ();
+  subsizes[dims] = (int) (end.get1 () - start.get1 ());
+  starts[dims] = (int) start.get1 ();
+  ++dims;
+#endif /* GRID_1D || GRID_2D || GRID_3D */
+
+#if defined (GRID_2D) || defined (GRID_3D)
+  sizes[dims] = (int) size.get2 ();
+  subsizes[dims] = (int) (end.get2 () - start.get2 ());
+  starts[dims] = (int) start.get2 ();
+  ++dims;
+#endif /* GRID_2D || GRID_3D */
+
+#if defined (GRID_3D)
+  sizes[dims] = (int) size.get3 ();
+  subsizes[dims] = (int) (end.get3 () - start.get3 ());
+  starts[dims] = (int) start.get3 ();
+  ++dims;
+#endif /* GRID_3D */
+
+  MPI_Datatype layer;
+  int retCode = MPI_Type_create_subarray (dims, sizes, subsizes, starts, MPI_ORDER_C, MPI_FPVALUE, &layer);
+  ASSERT (retCode == MPI_SUCCESS);
+
+  MPI_Datatype datatype;
+  retCode = MPI_Type_create_hvector (storedSteps, 1, (MPI_Aint) (stepStride * sizeof (FieldValue)), layer, &datatype);
+  ASSERT (retCode == MPI_SUCCESS);
+
+  retCode = MPI_Type_commit (&datatype);
+  ASSERT (retCode == MPI_SUCCESS);
+
+  retCode = MPI_Type_free (&layer);
+  ASSERT (retCode == MPI_SUCCESS);
+
+  return datatype;
+} /* ParallelGridGroup::createShareDatatype */
+
+/**
+ * Create derived datatypes for send/receive regions of all directions, which have neighbors. Datatypes are created
+ * once for group, when first grid of group is allocated, because all grids of group have the same layout in memory.
+ */
+void
+ParallelGridGroup::initShareDatatypes (grid_coord stepStride) /**< number of values between starts of consecutive
+                                                               *   time step layers in grids of group */
+{
+  if (!datatypesSend.empty ())
+  {
+    ASSERT (datatypesStepStride == stepStride);
+    return;
+  }
+
+  datatypesStepStride = stepStride;
+
+  datatypesSend.resize (BUFFER_COUNT, MPI_DATATYPE_NULL);
+  datatypesReceive.resize (BUFFER_COUNT, MPI_DATATYPE_NULL);
+
+  for (int buf = 0; buf < BUFFER_COUNT; ++buf)
+  {
+    BufferPosition bufferDirection = (BufferPosition) buf;
+    BufferPosition opposite = parallelGridCore->getOppositeDirections ()[bufferDirection];
+
+    if (parallelGridCore->getNodeForDirection (bufferDirection) != PID_NONE)
+    {
+      datatypesSend[bufferDirection] = createShareDatatype (sendStart[bufferDirection],
+                                                            sendEnd[bufferDirection],
+                                                            stepStride);
+    }
+
+    if (parallelGridCore->getNodeForDirection (opposite) != PID_NONE)
+    {
+      datatypesReceive[opposite] = createShareDatatype (recvStart[bufferDirection],
+                                                        recvEnd[bufferDirection],
+                                                        stepStride);
+    }
+  }
+} /* ParallelGridGroup::initShareDatatypes */
+
+#endif /* ZERO_COPY_SHARE */
+
 
 /**
  * Initialize start and end cooridnates for send/receive for all directions
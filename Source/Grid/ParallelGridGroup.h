@@ -20,6 +20,13 @@ typedef std::vector<VectorBufferValues> VectorBuffers;
 
 #define INVALID_GROUP (-1)
 
+#ifdef DYNAMIC_GRID
+/**
+ * Number of values, which describe chunk of one computational node: start and end coordinates by all three axes
+ */
+#define CHUNK_BOX_SIZE (6)
+#endif /* DYNAMIC_GRID */
+
 /**
  * Class with data shared between all members of one parallel group
  */
@@ -124,6 +131,26 @@ private:
    */
   VectorBuffers buffersReceive;
 
+#ifdef ZERO_COPY_SHARE
+  /**
+   * Derived datatypes, which describe send regions of grids of group (for all stored time steps) for all directions,
+   * so that values are sent directly from grid memory without copy to send buffers
+   */
+  std::vector<MPI_Datatype> datatypesSend;
+
+  /**
+   * Derived datatypes, which describe receive regions of grids of group (for all stored time steps), so that values
+   * are received directly to grid memory without copy from receive buffers. Same as receive buffers, these are
+   * indexed by direction, from which values are received.
+   */
+  std::vector<MPI_Datatype> datatypesReceive;
+
+  /**
+   * Number of values between starts of consecutive time step layers in grids, for which datatypes are created
+   */
+  grid_coord datatypesStepStride;
+#endif /* ZERO_COPY_SHARE */
+
   int storedSteps;
 
   /**
@@ -131,6 +158,28 @@ private:
    */
   std::string groupName;
 
+#ifdef DYNAMIC_GRID
+  /**
+   * Number of resizes of group, which were performed during rebalance
+   */
+  int resizeCount;
+
+  /**
+   * Absolute start position of chunk of current node (including buffers) before the last resize
+   */
+  ParallelGridCoordinate prevPosStart;
+
+  /**
+   * Chunks of all computational nodes (not considering buffers) before the last resize, CHUNK_BOX_SIZE values for each
+   */
+  std::vector<grid_coord> prevChunks;
+
+  /**
+   * Chunks of all computational nodes (not considering buffers) after the last resize, CHUNK_BOX_SIZE values for each
+   */
+  std::vector<grid_coord> chunks;
+#endif /* DYNAMIC_GRID */
+
 public:
 
   /**
@@ -152,7 +201,7 @@ public:
                      int storedTimeSteps,
                      int tOffset,
                      const char *name = "unnamed");
-  ~ParallelGridGroup () {}
+  ~ParallelGridGroup ();
 
   bool match (ParallelGridCoordinate totSize,
               ParallelGridCoordinate bufSize,
@@ -165,6 +214,11 @@ public:
 
   void InitBuffers ();
 
+#ifdef ZERO_COPY_SHARE
+  MPI_Datatype createShareDatatype (ParallelGridCoordinate, ParallelGridCoordinate, grid_coord) const;
+  void initShareDatatypes (grid_coord);
+#endif /* ZERO_COPY_SHARE */
+
   void SendReceiveCoordinatesInit ();
 
 #if defined (PARALLEL_BUFFER_DIMENSION_1D_X) || defined (PARALLEL_BUFFER_DIMENSION_2D_XY) || \
@@ -218,6 +272,51 @@ public:
   void initializeStartPosition (ParallelGridCoordinate);
   void gatherStartPosition ();
 
+#ifdef DYNAMIC_GRID
+  void gatherChunks (std::vector<grid_coord> &) const;
+  void Resize (ParallelGridCoordinate);
+
+  /**
+   * Get number of resizes of group
+   *
+   * @return number of resizes of group
+   */
+  int getResizeCount () const
+  {
+    return resizeCount;
+  } /* getResizeCount */
+
+  /**
+   * Get absolute start position of chunk of current node (including buffers) before the last resize
+   *
+   * @return absolute start position of chunk of current node before the last resize
+   */
+  ParallelGridCoordinate getPrevStartPosition () const
+  {
+    return prevPosStart;
+  } /* getPrevStartPosition */
+
+  /**
+   * Get chunks of all computational nodes before the last resize
+   *
+   * @return chunks of all computational nodes before the last resize
+   */
+  const std::vector<grid_coord> & getPrevChunks () const
+  {
+    return prevChunks;
+  } /* getPrevChunks */
+
+  /**
+   * Get chunks of all computational nodes after the last resize
+   *
+   * @return chunks of all computational nodes after the last resize
+   */
+  const std::vector<grid_coord> & getChunks () const
+  {
+    return chunks;
+  } /* getChunks */
+#endif /* DYNAMIC_GRID */
+
   time_step getShareStepLimit () const
   {
     return shareStepLimit;
@@ -335,6 +434,17 @@ public:
     return buffersReceive;
   }
 
+#ifdef ZERO_COPY_SHARE
+  const std::vector<MPI_Datatype> & getDatatypesSend () const
+  {
+    return datatypesSend;
+  }
+  const std::vector<MPI_Datatype> & getDatatypesReceive () const
+  {
+    return datatypesReceive;
+  }
+#endif /* ZERO_COPY_SHARE */
+
   /**
    * Get absolute position corresponding to first value in grid for current computational node (considering buffers)
    *
@@ -543,6 +653,86 @@ public:
 #endif /* GRID_3D */
   } /* ParallelGridGroup::getComputationEnd */
 
+  /**
+   * Get first coordinate of inner part of chunk, computations for which do not depend on values in buffers, i.e.
+   * could be performed while share operations are in progress. Computations for grid point depend on its closest
+   * neighbors, so inner part starts one point further from buffer.
+   *
+   * @return first coordinate of inner part of chunk
+   */
+  ParallelGridCoordinate getComputationInnerStart
+    (const ParallelGridCoordinate & start) const /**< first coordinate of chunk */
+  {
+    grid_coord left_coord, right_coord;
+    grid_coord down_coord, up_coord;
+    grid_coord back_coord, front_coord;
+
+    initBufferOffsets (left_coord, right_coord, down_coord, up_coord, back_coord, front_coord);
+
+    ParallelGridCoordinate res = start;
+
+#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
+    if (left_coord != 0 && res.get1 () < left_coord + 1)
+    {
+      res.set1 (left_coord + 1);
+    }
+#endif /* GRID_1D || GRID_2D || GRID_3D */
+#if defined (GRID_2D) || defined (GRID_3D)
+    if (down_coord != 0 && res.get2 () < down_coord + 1)
+    {
+      res.set2 (down_coord + 1);
+    }
+#endif /* GRID_2D || GRID_3D */
+#if defined (GRID_3D)
+    if (back_coord != 0 && res.get3 () < back_coord + 1)
+    {
+      res.set3 (back_coord + 1);
+    }
+#endif /* GRID_3D */
+
+    return res;
+  } /* ParallelGridGroup::getComputationInnerStart */
+
+  /**
+   * Get last coordinate of inner part of chunk, computations for which do not depend on values in buffers, i.e.
+   * could be performed while share operations are in progress.
+   *
+   * @return last coordinate of inner part of chunk
+   */
+  ParallelGridCoordinate getComputationInnerEnd
+    (const ParallelGridCoordinate & end, /**< last coordinate of chunk */
+     const ParallelGridCoordinate & size) const /**< size of grid */
+  {
+    grid_coord left_coord, right_coord;
+    grid_coord down_coord, up_coord;
+    grid_coord back_coord, front_coord;
+
+    initBufferOffsets (left_coord, right_coord, down_coord, up_coord, back_coord, front_coord);
+
+    ParallelGridCoordinate res = end;
+
+#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
+    if (right_coord != 0 && res.get1 () > size.get1 () - right_coord - 1)
+    {
+      res.set1 (size.get1 () - right_coord - 1);
+    }
+#endif /* GRID_1D || GRID_2D || GRID_3D */
+#if defined (GRID_2D) || defined (GRID_3D)
+    if (up_coord != 0 && res.get2 () > size.get2 () - up_coord - 1)
+    {
+      res.set2 (size.get2 () - up_coord - 1);
+    }
+#endif /* GRID_2D || GRID_3D */
+#if defined (GRID_3D)
+    if (front_coord != 0 && res.get3 () > size.get3 () - front_coord - 1)
+    {
+      res.set3 (size.get3 () - front_coord - 1);
+    }
+#endif /* GRID_3D */
+
+    return res;
+  } /* ParallelGridGroup::getComputationInnerEnd */
+
   /**
    * Initialize buffer offsets for computational node
    */
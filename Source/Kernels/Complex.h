@@ -53,8 +53,8 @@ public:
   template<class U>
   CUDA_DEVICE CUDA_HOST
   CComplex (const CComplex<U> & x) /**< complex value to convert */
-  : re (x.re)
-  , im (x.im)
+  : re (x.real ())
+  , im (x.imag ())
   {
   } /* CComplex::CComplex */
 
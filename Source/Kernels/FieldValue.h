@@ -62,6 +62,31 @@ typedef FPValue FieldValue;
 #define FIELDVALUE(real,imag) FieldValue(real)
 #endif /* !COMPLEX_FIELD_VALUES */
 
+/**
+ * Type of values, in which updates of fields are computed. In mixed precision mode values are stored in grids with
+ * precision of FPValue (float), but are converted to double on load in update kernels and back on store.
+ */
+#ifdef MIXED_PRECISION_VALUES
+#ifndef FLOAT_VALUES
+#error Mixed precision mode is supported only with float values
+#endif /* !FLOAT_VALUES */
+typedef double FPComputeValue;
+#else /* MIXED_PRECISION_VALUES */
+typedef FPValue FPComputeValue;
+#endif /* !MIXED_PRECISION_VALUES */
+
+#ifdef COMPLEX_FIELD_VALUES
+#ifdef STD_COMPLEX
+typedef std::complex<FPComputeValue> FieldComputeValue;
+#else /* STD_COMPLEX */
+typedef CComplex<FPComputeValue> FieldComputeValue;
+#endif /* !STD_COMPLEX */
+#define FIELDCOMPUTEVALUE(real,imag) FieldComputeValue(real,imag)
+#else /* COMPLEX_FIELD_VALUES */
+typedef FPComputeValue FieldComputeValue;
+#define FIELDCOMPUTEVALUE(real,imag) FieldComputeValue(real)
+#endif /* !COMPLEX_FIELD_VALUES */
+
 #ifdef CXX11_ENABLED
 #include <cstdint>
 #include <cinttypes>
@@ -366,6 +366,102 @@ Approximation::approximateSphereFast (GridCoordinateFP3D midPos,
 
 #define SPHERE_VOL_ACC_CUTOFF (1.0001)
 
+/**
+ * Check whether cell [start, end] is fully inside of sphere, fully outside of it, or is intersected by its surface.
+ * Cell is compared with sphere by the nearest and the farthest points of cell from the center of sphere.
+ *
+ * @return position of cell relatively to the surface of sphere
+ */
+CellIntersection
+Approximation::getSphereIntersection (GridCoordinateFP2D start, /**< start corner of cell */
+                                      GridCoordinateFP2D end, /**< end corner of cell */
+                                      GridCoordinateFP2D center, /**< center of sphere */
+                                      FPValue radius) /**< radius of sphere */
+{
+  FPValue startCoord[2] = {start.get1 (), start.get2 ()};
+  FPValue endCoord[2] = {end.get1 (), end.get2 ()};
+  FPValue centerCoord[2] = {center.get1 (), center.get2 ()};
+
+  FPValue nearest = 0;
+  FPValue farthest = 0;
+
+  for (int axis = 0; axis < 2; ++axis)
+  {
+    FPValue distStart = startCoord[axis] - centerCoord[axis];
+    FPValue distEnd = endCoord[axis] - centerCoord[axis];
+
+    if (distStart > 0)
+    {
+      nearest += SQR (distStart);
+    }
+    else if (distEnd < 0)
+    {
+      nearest += SQR (distEnd);
+    }
+
+    farthest += SQR (distStart) > SQR (distEnd) ? SQR (distStart) : SQR (distEnd);
+  }
+
+  if (nearest >= SQR (radius))
+  {
+    return CellIntersection::OUTSIDE;
+  }
+  else if (farthest <= SQR (radius))
+  {
+    return CellIntersection::INSIDE;
+  }
+
+  return CellIntersection::BORDER;
+}
+
+/**
+ * Check whether cell [start, end] is fully inside of sphere, fully outside of it, or is intersected by its surface.
+ * Cell is compared with sphere by the nearest and the farthest points of cell from the center of sphere.
+ *
+ * @return position of cell relatively to the surface of sphere
+ */
+CellIntersection
+Approximation::getSphereIntersection (GridCoordinateFP3D start, /**< start corner of cell */
+                                      GridCoordinateFP3D end, /**< end corner of cell */
+                                      GridCoordinateFP3D center, /**< center of sphere */
+                                      FPValue radius) /**< radius of sphere */
+{
+  FPValue startCoord[3] = {start.get1 (), start.get2 (), start.get3 ()};
+  FPValue endCoord[3] = {end.get1 (), end.get2 (), end.get3 ()};
+  FPValue centerCoord[3] = {center.get1 (), center.get2 (), center.get3 ()};
+
+  FPValue nearest = 0;
+  FPValue farthest = 0;
+
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    FPValue distStart = startCoord[axis] - centerCoord[axis];
+    FPValue distEnd = endCoord[axis] - centerCoord[axis];
+
+    if (distStart > 0)
+    {
+      nearest += SQR (distStart);
+    }
+    else if (distEnd < 0)
+    {
+      nearest += SQR (distEnd);
+    }
+
+    farthest += SQR (distStart) > SQR (distEnd) ? SQR (distStart) : SQR (distEnd);
+  }
+
+  if (nearest >= SQR (radius))
+  {
+    return CellIntersection::OUTSIDE;
+  }
+  else if (farthest <= SQR (radius))
+  {
+    return CellIntersection::INSIDE;
+  }
+
+  return CellIntersection::BORDER;
+}
+
 FieldValue
 Approximation::approximateSphereAccurate (GridCoordinateFP1D midPos,
                                           GridCoordinateFP1D center,
@@ -456,8 +552,27 @@ Approximation::approximateSphereAccurate (GridCoordinateFP2D midPos,
   ASSERT (center.get2 () - FPValue (0.5) == (grid_coord) (center.get2 () - FPValue (0.5)));
 
   /*
-   * TODO: use better approximation
+   * Only cells, which are intersected by the surface of sphere, are integrated numerically
    */
+  switch (getSphereIntersection (start, end, center, radius))
+  {
+    case CellIntersection::OUTSIDE:
+    {
+      return outsideEps;
+    }
+    case CellIntersection::INSIDE:
+    {
+      return eps;
+    }
+    case CellIntersection::BORDER:
+    {
+      break;
+    }
+    default:
+    {
+      UNREACHABLE;
+    }
+  }
 
   int numSteps = SOLVER_SETTINGS.getSphereAccuracy ();
   FPValue step = 1.0 / numSteps;
@@ -568,8 +683,27 @@ Approximation::approximateSphereAccurate (GridCoordinateFP3D midPos,
   ASSERT (center.get3 () - FPValue (0.5) == (grid_coord) (center.get3 () - FPValue (0.5)));
 
   /*
-   * TODO: use better approximation
+   * Only cells, which are intersected by the surface of sphere, are integrated numerically
    */
+  switch (getSphereIntersection (start, end, center, radius))
+  {
+    case CellIntersection::OUTSIDE:
+    {
+      return outsideEps;
+    }
+    case CellIntersection::INSIDE:
+    {
+      return eps;
+    }
+    case CellIntersection::BORDER:
+    {
+      break;
+    }
+    default:
+    {
+      UNREACHABLE;
+    }
+  }
 
   int numSteps = SOLVER_SETTINGS.getSphereAccuracy ();
   FPValue step = 1.0 / numSteps;
@@ -6,6 +6,15 @@
 
 #define APPROXIMATION_ACCURACY FPValue (0.0000001)
 
+/**
+ * Position of cell relatively to the surface of shape
+ */
+ENUM_CLASS (CellIntersection, uint8_t,
+  OUTSIDE, /**< cell is fully outside of shape */
+  INSIDE, /**< cell is fully inside of shape */
+  BORDER /**< surface of shape intersects cell */
+);
+
 class Approximation
 {
 public:
@@ -31,6 +40,9 @@ public:
 
   static FieldValue approximateSphereFast (GridCoordinateFP3D, GridCoordinateFP3D, FPValue, FieldValue);
 
+  static CellIntersection getSphereIntersection (GridCoordinateFP2D, GridCoordinateFP2D, GridCoordinateFP2D, FPValue);
+  static CellIntersection getSphereIntersection (GridCoordinateFP3D, GridCoordinateFP3D, GridCoordinateFP3D, FPValue);
+
   static FieldValue approximateSphereAccurate (GridCoordinateFP1D, GridCoordinateFP1D, FPValue, FieldValue, FieldValue);
   static FieldValue approximateSphereAccurate (GridCoordinateFP2D, GridCoordinateFP2D, FPValue, FieldValue, FieldValue);
   static FieldValue approximateSphereAccurate (GridCoordinateFP3D, GridCoordinateFP3D, FPValue, FieldValue, FieldValue);
@@ -496,18 +496,27 @@ ParallelYeeGridLayout<Type, layout_type>::estimateBorderX (std::vector<NodeBorde
       ++j;
     }
 
+    if (j >= parallelGridCore->getNodeGridSizeX ())
+    {
+      /*
+       * No enabled nodes to the right of i
+       */
+      break;
+    }
+
     /*
      * Checking border between i and j
      */
     DOUBLE timeVal = estimateTimeAcrossAxisX (i, j);
-    if (timeVal == DOUBLE (0))
+    if (timeVal != DOUBLE (0))
     {
       /*
-       * No time estimation is available
+       * Zero means that no time estimation is available
        */
-      continue;
+      borders.push_back (NodeBorder_t (i, j, OX, timeVal));
     }
-    borders.push_back (NodeBorder_t (i, j, OX, timeVal));
+
+    i = j;
   }
 }
 #endif
@@ -991,18 +1000,27 @@ ParallelYeeGridLayout<Type, layout_type>::estimateBorderY (std::vector<NodeBorde
       ++j;
     }
 
+    if (j >= parallelGridCore->getNodeGridSizeY ())
+    {
+      /*
+       * No enabled nodes to the right of i
+       */
+      break;
+    }
+
     /*
      * Checking border between i and j
      */
     DOUBLE timeVal = estimateTimeAcrossAxisY (i, j);
-    if (timeVal == DOUBLE (0))
+    if (timeVal != DOUBLE (0))
     {
       /*
-       * No time estimation is available
+       * Zero means that no time estimation is available
        */
-      continue;
+      borders.push_back (NodeBorder_t (i, j, OY, timeVal));
     }
-    borders.push_back (NodeBorder_t (i, j, OY, timeVal));
+
+    i = j;
   }
 }
 #endif
@@ -1443,18 +1461,27 @@ ParallelYeeGridLayout<Type, layout_type>::estimateBorderZ (std::vector<NodeBorde
       ++j;
     }
 
+    if (j >= parallelGridCore->getNodeGridSizeZ ())
+    {
+      /*
+       * No enabled nodes to the right of i
+       */
+      break;
+    }
+
     /*
      * Checking border between i and j
      */
     DOUBLE timeVal = estimateTimeAcrossAxisZ (i, j);
-    if (timeVal == DOUBLE (0))
+    if (timeVal != DOUBLE (0))
     {
       /*
-       * No time estimation is available
+       * Zero means that no time estimation is available
        */
-      continue;
+      borders.push_back (NodeBorder_t (i, j, OZ, timeVal));
     }
-    borders.push_back (NodeBorder_t (i, j, OZ, timeVal));
+
+    i = j;
   }
 }
 #endif
@@ -2258,14 +2285,22 @@ void ParallelYeeGridLayout<Type, layout_type>::disableNodesAfterSpread (const st
   for (int k = 0; k < parallelGridCore->getNodeGridSizeZ (); ++k)
 #endif
   {
-    bool doDisable = spreadX[i] == 0
-#if defined (GRID_2D) || defined (GRID_3D)
-                     || spreadY[i] == 0
+    /*
+     * Only axes, which are split between nodes, are spread
+     */
+    bool doDisable = false;
+#if defined (PARALLEL_BUFFER_DIMENSION_1D_X) || defined (PARALLEL_BUFFER_DIMENSION_2D_XY) \
+  || defined (PARALLEL_BUFFER_DIMENSION_2D_XZ) || defined (PARALLEL_BUFFER_DIMENSION_3D_XYZ)
+    doDisable = doDisable || spreadX[i] == 0;
 #endif
-#if defined (GRID_3D)
-                     || spreadZ[i] == 0
+#if defined (PARALLEL_BUFFER_DIMENSION_1D_Y) || defined (PARALLEL_BUFFER_DIMENSION_2D_XY) \
+  || defined (PARALLEL_BUFFER_DIMENSION_2D_YZ) || defined (PARALLEL_BUFFER_DIMENSION_3D_XYZ)
+    doDisable = doDisable || spreadY[j] == 0;
+#endif
+#if defined (PARALLEL_BUFFER_DIMENSION_1D_Z) || defined (PARALLEL_BUFFER_DIMENSION_2D_YZ) \
+  || defined (PARALLEL_BUFFER_DIMENSION_2D_XZ) || defined (PARALLEL_BUFFER_DIMENSION_3D_XYZ)
+    doDisable = doDisable || spreadZ[k] == 0;
 #endif
-                     ;
 
     if (doDisable)
     {
@@ -2285,7 +2320,9 @@ void ParallelYeeGridLayout<Type, layout_type>::disableNodesAfterSpread (const st
 }
 
 /**
- * Spread grid points across all enabled computational nodes across the chosen axis 1
+ * Spread grid points across all enabled computational nodes across the chosen axis 1. Each enabled node gets at least
+ * buffer size of points, so that nodes are never disabled by spread and buffers of neighbors are filled from single
+ * node.
  */
 template <SchemeType_t Type, LayoutType layout_type>
 void ParallelYeeGridLayout<Type, layout_type>::spreadGridPointsPerAxis (std::vector<grid_coord> &spread,
@@ -2313,6 +2350,7 @@ void ParallelYeeGridLayout<Type, layout_type>::spreadGridPointsPerAxis (std::vec
 #endif
 
   grid_coord sum_spread = 0;
+  grid_coord minChunk = std::max ((grid_coord) SOLVER_SETTINGS.getBufferSize (), (grid_coord) 1);
 
   grid_coord totalSize;
   if (axis1 == OX)
@@ -2436,15 +2474,37 @@ void ParallelYeeGridLayout<Type, layout_type>::spreadGridPointsPerAxis (std::vec
 
     spread[processAxis1] = ((DOUBLE) totalSize) * sumSpeedEnabledAxis / (sumSpeedEnabled);
 
-    if (spread[processAxis1] < 1
-        || !enabled)
+    if (!enabled)
     {
       spread[processAxis1] = 0;
     }
+    else if (spread[processAxis1] < minChunk)
+    {
+      spread[processAxis1] = minChunk;
+    }
 
     sum_spread += spread[processAxis1];
   }
 
+  /*
+   * Points, which were added to reach minimum chunk, are taken from the largest chunks
+   */
+  while (sum_spread > totalSize)
+  {
+    int maxI = axisStart1;
+    for (int i = axisStart1 + 1; i < axisSize1; ++i)
+    {
+      if (spread[i] > spread[maxI])
+      {
+        maxI = i;
+      }
+    }
+
+    ALWAYS_ASSERT (spread[maxI] > minChunk);
+    spread[maxI]--;
+    sum_spread--;
+  }
+
   grid_coord diff = totalSize - sum_spread;
   int i = 0;
   while (diff > 0)
@@ -2727,7 +2787,8 @@ void ParallelYeeGridLayout<Type, layout_type>::findMaxTimes (DOUBLE &max_share_L
 }
 
 /**
- * Rebalance total grid size between notes
+ * Rebalance total grid size between notes. Disabling of computational nodes is not supported by resize of grids, so
+ * if disabling conditions choose to disable some node, new spread is rejected and current chunks are kept.
  *
  * @return true if spread was changed
  *         false, otherwise
@@ -2768,8 +2829,11 @@ bool ParallelYeeGridLayout<Type, layout_type>::Rebalance (time_step difft) /**<
   /*
    * ==== Check if some nodes are better to be disabled
    */
+  bool isSpreadRejected = false;
   if (SOLVER_SETTINGS.getDoCheckDisablingConditions ())
   {
+    std::vector<int> nodeState = parallelGridCore->getNodeState ();
+
 #ifdef GRID_1D
     checkDisablingConditions (spreadX);
 #endif
@@ -2779,6 +2843,26 @@ bool ParallelYeeGridLayout<Type, layout_type>::Rebalance (time_step difft) /**<
 #ifdef GRID_3D
     checkDisablingConditions (spreadX, spreadY, spreadZ);
 #endif
+
+    if (nodeState != parallelGridCore->getNodeState ())
+    {
+      parallelGridCore->getNodeState () = nodeState;
+      isSpreadRejected = true;
+    }
+  }
+
+  if (isSpreadRejected)
+  {
+    if (parallelGridCore->getProcessId () == 0)
+    {
+      printf ("Rebalance: spread disables computational nodes, current chunks are kept\n");
+    }
+
+    parallelGridCore->ClearCalcClocks ();
+    parallelGridCore->ClearShareClocks ();
+    InitializeCounters ();
+
+    return false;
   }
 
   /*
@@ -2868,6 +2952,16 @@ bool ParallelYeeGridLayout<Type, layout_type>::Rebalance (time_step difft) /**<
         parallelGridCore->getTotalSumBandwidthPerConnection (i, j),
         parallelGridCore->getTotalSumBandwidthCountPerConnection (i, j));
     }
+
+    /*
+     * Measured values could be passed to the next launch to choose virtual topology
+     */
+    printf ("Cost model: --topology-latency-intra-node %.15f --topology-bandwidth-intra-node %f "
+            "--topology-latency-inter-node %.15f --topology-bandwidth-inter-node %f\n",
+            parallelGridCore->getCostModel ().latencyIntraNode,
+            parallelGridCore->getCostModel ().bandwidthIntraNode,
+            parallelGridCore->getCostModel ().latencyInterNode,
+            parallelGridCore->getCostModel ().bandwidthInterNode);
   }
 
   newSize.set1 (x);
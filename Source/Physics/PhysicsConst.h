@@ -7,9 +7,16 @@
 namespace PhysicsConst
 {
   const CUDA_DEVICE FPValue Pi = M_PI;
-  const CUDA_DEVICE FPValue SpeedOfLight = 299792458;
-  const CUDA_DEVICE FPValue Mu0 = 4 * Pi * 0.0000001;
-  const CUDA_DEVICE FPValue Eps0 = 1 / (Mu0 * SQR (SpeedOfLight));
+
+  /*
+   * Constants, which are used in coefficients of update of fields and in phase of sources, are stored with precision,
+   * in which updates are computed (see FPComputeValue). Pi itself is FPValue, because angles are compared with it.
+   */
+  const CUDA_DEVICE FPComputeValue PiCompute = M_PI;
+  const CUDA_DEVICE FPComputeValue SpeedOfLight = 299792458;
+  const CUDA_DEVICE FPComputeValue Mu0 = 4 * FPComputeValue (M_PI) * 0.0000001;
+  const CUDA_DEVICE FPComputeValue Eps0 = 1 / (Mu0 * SQR (SpeedOfLight));
+
   const CUDA_DEVICE FPValue accuracy = 0.001;
 };
 
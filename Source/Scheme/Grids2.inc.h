@@ -13,14 +13,14 @@ GRID_NAME_NO_CHECK(Eps, Eps, 1, 0)
 GRID_NAME_NO_CHECK(Mu, Eps, 1, 0)
 
 /**
- * Field grids
+ * Field grids (single time step is stored for them in case of in-place update)
  */
-GRID_NAME(Ex, Ex, storedSteps, 1)
-GRID_NAME(Ey, Ey, storedSteps, 1)
-GRID_NAME(Ez, Ez, storedSteps, 1)
-GRID_NAME(Hx, Hx, storedSteps, 0)
-GRID_NAME(Hy, Hy, storedSteps, 0)
-GRID_NAME(Hz, Hz, storedSteps, 0)
+GRID_NAME(Ex, Ex, fieldStoredSteps, 1)
+GRID_NAME(Ey, Ey, fieldStoredSteps, 1)
+GRID_NAME(Ez, Ez, fieldStoredSteps, 1)
+GRID_NAME(Hx, Hx, fieldStoredSteps, 0)
+GRID_NAME(Hy, Hy, fieldStoredSteps, 0)
+GRID_NAME(Hz, Hz, fieldStoredSteps, 0)
 
 if (SOLVER_SETTINGS.getDoUseCaCbGrids ())
 {
@@ -1,12 +1,27 @@
 #ifndef INTERNAL_SCHEME_H
 #define INTERNAL_SCHEME_H
 
+#include <algorithm>
+#include <vector>
+
 #include "GridInterface.h"
+#include "IncidentWaveTable.h"
+#include "MaterialIdGrid.h"
 #include "PhysicsConst.h"
 #include "YeeGridLayout.h"
 #include "ParallelYeeGridLayout.h"
 #include "CallBack.h"
 
+/**
+ * Margin (in points), which is added to borders of TF/SF and PML areas, when chunk is split into regions
+ */
+#define CHUNK_REGION_MARGIN 2
+
+/**
+ * Maximum number of cuts of chunk by single axis, when it is split into regions
+ */
+#define CHUNK_REGION_MAX_CUTS 8
+
 /**
  * InternalScheme is implemented without virtual functions in order to be copied to GPU (classes with vtable can't be)
  */
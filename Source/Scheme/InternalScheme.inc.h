@@ -39,7 +39,7 @@ namespace InternalSchemeKernelHelpers
                                           GridType gridType, /**< type of core grid */
                                           IGRID< TCoord<grid_coord, true> > *materialGrid, /**< material grid */
                                           GridType materialGridType, /**< type of material */
-                                          FPValue materialModifier, /**< additional multiplier for material */
+                                          FPComputeValue materialModifier, /**< additional multiplier for material */
                                           bool usePrecomputedGrids) /**< flag whether to use precomputed values */
   {
     GridCoordinate3D pos3D = start3D + GRID_COORDINATE_3D ((blockIdx.x * blockDim.x) + threadIdx.x,
@@ -135,7 +135,7 @@ namespace InternalSchemeKernelHelpers
                                                  GridType gridType, /**< type of core grid */
                                                  IGRID< TCoord<grid_coord, true> > *materialGrid, /**< material grid */
                                                  GridType materialGridType, /**< type of material */
-                                                 FPValue materialModifier, /**< additional multiplier for material */
+                                                 FPComputeValue materialModifier, /**< additional multiplier for material */
                                                  bool usePrecomputedGrids) /**< flag whether to use precomputed values */
   {
     ASSERT (blockIdx.x == 0 && blockDim.x == 1 && threadIdx.x == 0);
@@ -181,7 +181,7 @@ namespace InternalSchemeKernelHelpers
                                          GridType materialGridType2,
                                          IGRID< TCoord<grid_coord, true> > *materialGrid3,
                                          GridType materialGridType3,
-                                         FPValue materialModifier,
+                                         FPComputeValue materialModifier,
                                          bool usePrecomputedGrids)
   {
     GridCoordinate3D pos3D = start3D + GRID_COORDINATE_3D ((blockIdx.x * blockDim.x) + threadIdx.x,
@@ -233,7 +233,7 @@ namespace InternalSchemeKernelHelpers
                                            GridType materialGridType4,
                                            IGRID< TCoord<grid_coord, true> > *materialGrid5,
                                            GridType materialGridType5,
-                                           FPValue materialModifier,
+                                           FPComputeValue materialModifier,
                                            bool usePrecomputedGrids)
   {
     GridCoordinate3D pos3D = start3D + GRID_COORDINATE_3D ((blockIdx.x * blockDim.x) + threadIdx.x,
@@ -475,6 +475,21 @@ public:
   ICUDA_HOST
   static void allocateGridsInc (InternalScheme<Type, TCoord, layout_type> *intScheme, YeeGridLayout<Type, TCoord, layout_type> *layout);
 
+  /**
+   * Check whether E and H grids are updated in-place, i.e. only single time step is stored for them.
+   * Update of E/H point reads only previous value of this point and values of other grids, so previous time steps
+   * of E/H are required only by NTFF. CUDA grids are not supported in this mode.
+   *
+   * @return true if E and H grids are updated in-place
+   */
+  ICUDA_HOST
+  static bool doUpdateFieldsInPlace ()
+  {
+    return SOLVER_SETTINGS.getDoUseInPlaceUpdate ()
+           && !SOLVER_SETTINGS.getDoUseNTFF ()
+           && !SOLVER_SETTINGS.getDoUseCuda ();
+  }
+
 #endif /* !GPU_INTERNAL_SCHEME */
 
   ICUDA_DEVICE
@@ -601,7 +616,7 @@ private:
   /**
    * Wave length analytical
    */
-  FPValue sourceWaveLength;
+  FPComputeValue sourceWaveLength;
 
   /**
    * Wave length numerical
@@ -611,33 +626,76 @@ private:
   /**
    * Wave frequency
    */
-  FPValue sourceFrequency;
+  FPComputeValue sourceFrequency;
 
   /**
    * Wave relative phase velocity
    */
   FPValue relPhaseVelocity;
 
+  /**
+   * Number of incident waves, auxiliary grids of which are stored one after another in EInc and HInc
+   */
+  int incidentWavesCount;
+
+  /**
+   * Number of lanes of field grids, i.e. number of independent simulations, which are performed at once (each lane
+   * is excited by its own incident wave, see --use-batched-incident-waves)
+   */
+  int batchSize;
+
+  /**
+   * Lane of field grids, which is accessed by computations for separate points
+   */
+  int activeLane;
+
   /**
    * Courant number
    */
-  FPValue courantNum;
+  FPComputeValue courantNum;
 
   /**
    * dx (step in space)
    */
-  FPValue gridStep;
+  FPComputeValue gridStep;
 
   /**
    * dt (step in time)
    */
-  FPValue gridTimeStep;
+  FPComputeValue gridTimeStep;
 
 #define CALLBACK_NAME(x) \
   SourceCallBack x;
 #include "Callbacks.inc.h"
 #undef CALLBACK_NAME
 
+#ifndef GPU_INTERNAL_SCHEME
+  /**
+   * Grids of material identifiers with tables of precomputed coefficients (used instead of Ca, Cb, Da, Db grids)
+   */
+  MaterialIdGrid *MaterialIdsEx;
+  MaterialIdGrid *MaterialIdsEy;
+  MaterialIdGrid *MaterialIdsEz;
+  MaterialIdGrid *MaterialIdsHx;
+  MaterialIdGrid *MaterialIdsHy;
+  MaterialIdGrid *MaterialIdsHz;
+
+  /**
+   * Tables of precomputed projections of TF/SF incident wave on field components
+   */
+  IncidentWaveTable *IncidentEx;
+  IncidentWaveTable *IncidentEy;
+  IncidentWaveTable *IncidentEz;
+  IncidentWaveTable *IncidentHx;
+  IncidentWaveTable *IncidentHy;
+  IncidentWaveTable *IncidentHz;
+
+  /**
+   * Relative phase velocities of all incident waves
+   */
+  std::vector<FPValue> incidentWaveRelPhaseVelocity;
+#endif /* !GPU_INTERNAL_SCHEME */
+
 #ifdef GPU_INTERNAL_SCHEME
   FPValue *d_norm;
 #endif /* GPU_INTERNAL_SCHEME */
@@ -718,6 +776,9 @@ private:
     InternalSchemeHelper::allocateGridsInc<Type, TCoord, layout_type> (this, layout);
   }
 
+  ICUDA_HOST void allocateMaterialIdGrids ();
+  ICUDA_HOST void initIncidentWaveTables ();
+
 #endif /* !GPU_INTERNAL_SCHEME */
 
   ICUDA_HOST void initCoordTypes ()
@@ -740,38 +801,83 @@ private:
 
   template <uint8_t grid_type>
   ICUDA_DEVICE
-  void calculateTFSF (TC, FieldValue &, FieldValue &, FieldValue &, FieldValue &, TC, TC, TC, TC);
+  void calculateTFSF (TC, FieldValue &, FieldValue &, FieldValue &, FieldValue &, TC, TC, TC, TC, int);
 
+  /*
+   * Updates of fields are computed in FieldComputeValue, which in mixed precision mode is more precise than FieldValue,
+   * in which values are stored in grids. Values of fields are converted on load and result is converted back on store,
+   * while coefficients of update are computed and passed in FieldComputeValue.
+   */
   ICUDA_DEVICE
   FieldValue calcField (const FieldValue & prev, const FieldValue & oppositeField12, const FieldValue & oppositeField11,
                         const FieldValue & oppositeField22, const FieldValue & oppositeField21, const FieldValue & prevRightSide,
-                        const FieldValue & Ca, const FieldValue & Cb, const FPValue & delta)
+                        const FieldComputeValue & Ca, const FieldComputeValue & Cb, const FPComputeValue & delta)
   {
-    FieldValue tmp = oppositeField12 - oppositeField11 - oppositeField22 + oppositeField21 - prevRightSide * delta;
-    return prev * Ca + tmp * Cb;
+    FieldComputeValue tmp = FieldComputeValue (oppositeField12) - FieldComputeValue (oppositeField11)
+                            - FieldComputeValue (oppositeField22) + FieldComputeValue (oppositeField21)
+                            - FieldComputeValue (prevRightSide) * delta;
+    return FieldValue (FieldComputeValue (prev) * Ca + tmp * Cb);
   }
 
   ICUDA_DEVICE
   FieldValue calcFieldDrude (const FieldValue & curDOrB, const FieldValue & prevDOrB, const FieldValue & prevPrevDOrB,
                              const FieldValue & prevEOrH, const FieldValue & prevPrevEOrH,
-                             const FieldValue & b0, const FieldValue & b1, const FieldValue & b2, const FieldValue & a1, const FieldValue & a2)
+                             const FieldComputeValue & b0, const FieldComputeValue & b1, const FieldComputeValue & b2,
+                             const FieldComputeValue & a1, const FieldComputeValue & a2)
   {
-    return curDOrB * b0 + prevDOrB * b1 + prevPrevDOrB * b2 - prevEOrH * a1 - prevPrevEOrH * a2;
+    return FieldValue (FieldComputeValue (curDOrB) * b0
+                       + FieldComputeValue (prevDOrB) * b1
+                       + FieldComputeValue (prevPrevDOrB) * b2
+                       - FieldComputeValue (prevEOrH) * a1
+                       - FieldComputeValue (prevPrevEOrH) * a2);
   }
 
   ICUDA_DEVICE
   FieldValue calcFieldFromDOrB (const FieldValue & prevEOrH, const FieldValue & curDOrB, const FieldValue & prevDOrB,
-                                const FieldValue & Ca, const FieldValue & Cb, const FieldValue & Cc)
+                                const FieldComputeValue & Ca, const FieldComputeValue & Cb, const FieldComputeValue & Cc)
   {
-    return prevEOrH * Ca + curDOrB * Cb - prevDOrB * Cc;
+    return FieldValue (FieldComputeValue (prevEOrH) * Ca
+                       + FieldComputeValue (curDOrB) * Cb
+                       - FieldComputeValue (prevDOrB) * Cc);
   }
 
+#ifndef GPU_INTERNAL_SCHEME
+  /**
+   * Box of chunk, in which all points require the same computations
+   */
+  struct ChunkRegion
+  {
+    GridCoordinate3D start; /**< start of box */
+    GridCoordinate3D end; /**< end of box */
+    bool isTFSF; /**< flag whether TF/SF correction might be required for points of box */
+    bool isPML; /**< flag whether PML coefficients might differ from the ones outside PML for points of box */
+
+    ChunkRegion (GridCoordinate3D regionStart, GridCoordinate3D regionEnd, bool regionIsTFSF, bool regionIsPML)
+      : start (regionStart)
+      , end (regionEnd)
+      , isTFSF (regionIsTFSF)
+      , isPML (regionIsPML)
+    {
+    }
+  };
+
+  ICUDA_HOST
+  void getChunkRegions (GridCoordinate3D, GridCoordinate3D, IGRID<TC> *, bool, bool, std::vector<ChunkRegion> &);
+
+  template <uint8_t grid_type, bool usePrecomputedGrids, bool useMaterialIds, bool useConstantCaCb, bool useTFSF>
+  ICUDA_HOST
+  void calculateFieldStepIterationRows (GridCoordinate3D, GridCoordinate3D, TCS, TCS, TCS, TCS, IGRID<TC> *,
+                                        IGRID<TC> *, IGRID<TC> *, IGRID<TC> *, IGRID<TC> *, MaterialIdGrid *,
+                                        FieldComputeValue, FieldComputeValue, bool,
+                                        GridType, IGRID<TC> *, GridType, FPComputeValue);
+#endif /* !GPU_INTERNAL_SCHEME */
+
 public:
 
   ICUDA_DEVICE
-  FieldValue calcCurrent (const FieldValue & current, const FieldValue & Cb, const FPValue & delta)
+  FieldValue calcCurrent (const FieldValue & current, const FieldComputeValue & Cb, const FPComputeValue & delta)
   {
-    return current * delta * Cb;
+    return FieldValue (FieldComputeValue (current) * delta * Cb);
   }
 
   ICUDA_HOST
@@ -784,18 +890,18 @@ public:
   ICUDA_DEVICE
   void calculateFieldStepIteration (FPValue, TC, TC, TCS, TCS, TCS, TCS, IGRID<TC> *, TCFP,
                                     IGRID<TC> *, IGRID<TC> *, SourceCallBack, IGRID<TC> *, IGRID<TC> *, bool,
-                                    GridType, IGRID<TC> *, GridType, FPValue);
+                                    GridType, IGRID<TC> *, GridType, FPComputeValue);
 
   template <uint8_t grid_type, bool usePrecomputedGrids>
   ICUDA_DEVICE
   void calculateFieldStepIterationCurrent (FieldValue, IGRID<TC> *, IGRID<TC> *, IGRID<TC> *,
-                                           bool, GridType, IGRID<TC> *, GridType, FPValue);
+                                           bool, GridType, IGRID<TC> *, GridType, FPComputeValue);
 
   template <uint8_t grid_type, bool usePML, bool useMetamaterials>
   ICUDA_HOST
   void calculateFieldStepInit (IGRID<TC> **, GridType *, IGRID<TC> **, GridType *, IGRID<TC> **, GridType *, IGRID<TC> **, GridType *,
     IGRID<TC> **, GridType *, IGRID<TC> **, GridType *, IGRID<TC> **, GridType *, IGRID<TC> **, IGRID<TC> **,
-    IGRID<TC> **, GridType *, IGRID<TC> **, GridType *, SourceCallBack *, SourceCallBack *, SourceCallBack *, FPValue *,
+    IGRID<TC> **, GridType *, IGRID<TC> **, GridType *, SourceCallBack *, SourceCallBack *, SourceCallBack *, FPComputeValue *,
     IGRID<TC> **, IGRID<TC> **,
     IGRID<TC> **, IGRID<TC> **, IGRID<TC> **, IGRID<TC> **, IGRID<TC> **, IGRID<TC> **, IGRID<TC> **, IGRID<TC> **);
 
@@ -803,19 +909,25 @@ public:
   template <uint8_t grid_type>
   ICUDA_HOST
   void calculateFieldStepInitDiff (TCS *, TCS *, TCS *, TCS *);
+
+  template <uint8_t grid_type>
+  ICUDA_HOST
+  void calculateFieldStepIterationChunk (GridCoordinate3D, GridCoordinate3D, TCS, TCS, TCS, TCS, IGRID<TC> *,
+                                         IGRID<TC> *, IGRID<TC> *, IGRID<TC> *, IGRID<TC> *, bool,
+                                         GridType, IGRID<TC> *, GridType, FPComputeValue);
 #endif
 
   template <bool usePrecomputedGrids>
   ICUDA_DEVICE
   void calculateFieldStepIterationPMLMetamaterials (time_step, TC, IGRID<TC> *, IGRID<TC> *,
        IGRID<TC> *, IGRID<TC> *, IGRID<TC> *, IGRID<TC> *, IGRID<TC> *, GridType,
-       IGRID<TC> *, GridType,  IGRID<TC> *, GridType,  IGRID<TC> *, GridType, FPValue);
+       IGRID<TC> *, GridType,  IGRID<TC> *, GridType,  IGRID<TC> *, GridType, FPComputeValue);
 
   template <bool useMetamaterials, bool usePrecomputedGrids>
   ICUDA_DEVICE
   void calculateFieldStepIterationPML (time_step, TC, IGRID<TC> *, IGRID<TC> *, IGRID<TC> *,
        IGRID<TC> *, IGRID<TC> *, IGRID<TC> *, GridType,
-       IGRID<TC> *, GridType,  IGRID<TC> *, GridType,  IGRID<TC> *, GridType, FPValue);
+       IGRID<TC> *, GridType,  IGRID<TC> *, GridType,  IGRID<TC> *, GridType, FPComputeValue);
 
   template <uint8_t grid_type>
   ICUDA_DEVICE
@@ -832,9 +944,12 @@ public:
 
   template <bool usePrecomputedGrids>
   ICUDA_DEVICE
-  void computeCaCb (FieldValue &, FieldValue &, TC, TC,
+  void computeCaCb (FieldComputeValue &, FieldComputeValue &, TC, TC,
                     IGRID<TC> *, IGRID<TC> *, bool,
-                    GridType, IGRID<TC> *, GridType, FPValue);
+                    GridType, IGRID<TC> *, GridType, FPComputeValue);
+
+  ICUDA_DEVICE
+  void computeCaCbFromMaterial (FieldComputeValue &, FieldComputeValue &, FPComputeValue, bool, FPComputeValue);
 
 #ifdef GPU_INTERNAL_SCHEME
   ICUDA_HOST void initFromCPU (InternalScheme<Type, TCoord, layout_type> *cpuScheme, TC, TC);
@@ -901,7 +1016,7 @@ public:
                                                 GridType gridType,
                                                 IGRID<TC> *materialGrid,
                                                 GridType materialGridType,
-                                                FPValue materialModifier,
+                                                FPComputeValue materialModifier,
                                                 bool usePrecomputedGrids)
   {
     GridCoordinate3D diff3D = end3D - start3D;
@@ -923,7 +1038,7 @@ public:
                                                        GridType gridType,
                                                        IGRID<TC> *materialGrid,
                                                        GridType materialGridType,
-                                                       FPValue materialModifier,
+                                                       FPComputeValue materialModifier,
                                                        bool usePrecomputedGrids)
   {
     dim3 blocks (1, 1, 1);
@@ -953,7 +1068,7 @@ public:
                                                GridType materialGridType2,
                                                IGRID<TC> *materialGrid3,
                                                GridType materialGridType3,
-                                               FPValue materialModifier,
+                                               FPComputeValue materialModifier,
                                                bool usePrecomputedGrids)
   {
     GridCoordinate3D diff3D = end3D - start3D;
@@ -984,7 +1099,7 @@ public:
                                                  GridType materialGridType4,
                                                  IGRID<TC> *materialGrid5,
                                                  GridType materialGridType5,
-                                                 FPValue materialModifier,
+                                                 FPComputeValue materialModifier,
                                                  bool usePrecomputedGrids)
   {
     GridCoordinate3D diff3D = end3D - start3D;
@@ -1125,6 +1240,50 @@ public:
 
 #endif /* GPU_INTERNAL_SCHEME */
 
+  /*
+   * Get relative phase velocity of incident wave
+   */
+  ICUDA_DEVICE
+  FPValue getIncidentWaveRelPhaseVelocity (int wave) const
+  {
+#ifndef GPU_INTERNAL_SCHEME
+    ASSERT (wave >= 0 && wave < (int) incidentWaveRelPhaseVelocity.size ());
+    return incidentWaveRelPhaseVelocity[wave];
+#else /* !GPU_INTERNAL_SCHEME */
+    ASSERT (wave == 0);
+    return relPhaseVelocity;
+#endif /* GPU_INTERNAL_SCHEME */
+  }
+
+  ICUDA_DEVICE
+  int getBatchSize () const
+  {
+    return batchSize;
+  }
+
+  ICUDA_DEVICE
+  int getActiveLane () const
+  {
+    return activeLane;
+  }
+
+  /*
+   * Get incident wave, which excites lane of field grids (all incident waves excite single lane of non-batched grids)
+   */
+  ICUDA_DEVICE
+  int getIncidentWaveOfLane (int lane) const
+  {
+    ASSERT (lane >= 0 && lane < batchSize);
+    return batchSize > 1 ? lane : ALL_INCIDENT_WAVES;
+  }
+
+#ifndef GPU_INTERNAL_SCHEME
+  CUDA_HOST
+  void setActiveLane (int);
+  CUDA_HOST
+  void getIncidentWaveAngles (int, FPValue &, FPValue &, FPValue &) const;
+#endif /* !GPU_INTERNAL_SCHEME */
+
   ICUDA_DEVICE
   void performPlaneWaveESteps (time_step, GridCoordinate1D start, GridCoordinate1D end);
   ICUDA_DEVICE
@@ -1143,6 +1302,38 @@ public:
     return INTERNAL_SCHEME_HELPER::approximateIncidentWaveH<Type, TCoord> (pos, layout->getZeroIncCoordFP (), HInc, layout->getIncidentWaveAngle1 (), layout->getIncidentWaveAngle2 ());
   }
 
+  /*
+   * Get field component of incident wave (or sum of all incident waves) at total position of this component. On CPU
+   * precomputed projection tables are used (see initIncidentWaveTables).
+   */
+#ifndef GPU_INTERNAL_SCHEME
+#define INCIDENT_WAVE_COMPONENT(NAME, FIELD) \
+  ICUDA_DEVICE \
+  FieldValue getIncident ## NAME (TC posAbs, int wave) \
+  { \
+    ASSERT (Incident ## NAME != NULLPTR); \
+    return Incident ## NAME->approximate (expandTo3D (posAbs, ct1, ct2, ct3), FIELD ## Inc, wave); \
+  }
+#else /* !GPU_INTERNAL_SCHEME */
+#define INCIDENT_WAVE_COMPONENT(NAME, FIELD) \
+  ICUDA_DEVICE \
+  FieldValue getIncident ## NAME (TC posAbs, int wave) \
+  { \
+    ASSERT (wave == ALL_INCIDENT_WAVES || wave == 0); \
+    TCFP realCoord = yeeLayout->get ## NAME ## CoordFP (posAbs); \
+    return yeeLayout->get ## NAME ## FromIncident ## FIELD (approximateIncidentWave ## FIELD (realCoord)); \
+  }
+#endif /* GPU_INTERNAL_SCHEME */
+
+  INCIDENT_WAVE_COMPONENT(Ex, E)
+  INCIDENT_WAVE_COMPONENT(Ey, E)
+  INCIDENT_WAVE_COMPONENT(Ez, E)
+  INCIDENT_WAVE_COMPONENT(Hx, H)
+  INCIDENT_WAVE_COMPONENT(Hy, H)
+  INCIDENT_WAVE_COMPONENT(Hz, H)
+
+#undef INCIDENT_WAVE_COMPONENT
+
   ICUDA_DEVICE
   FPValue getMaterial (const TC &, GridType, IGRID<TC> *, GridType);
   ICUDA_DEVICE
@@ -1294,6 +1485,67 @@ public:
 #include "Grids.inc.h"
 #undef GRID_NAME
 
+#ifndef GPU_INTERNAL_SCHEME
+#define MATERIAL_IDS_NAME(x) \
+  ICUDA_HOST \
+  MaterialIdGrid * getMaterialIds ## x () \
+  { \
+    ASSERT (MaterialIds ## x); \
+    return MaterialIds ## x; \
+  }
+  MATERIAL_IDS_NAME (Ex)
+  MATERIAL_IDS_NAME (Ey)
+  MATERIAL_IDS_NAME (Ez)
+  MATERIAL_IDS_NAME (Hx)
+  MATERIAL_IDS_NAME (Hy)
+  MATERIAL_IDS_NAME (Hz)
+#undef MATERIAL_IDS_NAME
+
+  /**
+   * Get grid of material identifiers for field grid
+   *
+   * @return grid of material identifiers or NULLPTR if it is not allocated
+   */
+  template <uint8_t grid_type>
+  ICUDA_HOST
+  MaterialIdGrid * getMaterialIds ()
+  {
+    switch (grid_type)
+    {
+      case (static_cast<uint8_t> (GridType::EX)):
+      {
+        return MaterialIdsEx;
+      }
+      case (static_cast<uint8_t> (GridType::EY)):
+      {
+        return MaterialIdsEy;
+      }
+      case (static_cast<uint8_t> (GridType::EZ)):
+      {
+        return MaterialIdsEz;
+      }
+      case (static_cast<uint8_t> (GridType::HX)):
+      {
+        return MaterialIdsHx;
+      }
+      case (static_cast<uint8_t> (GridType::HY)):
+      {
+        return MaterialIdsHy;
+      }
+      case (static_cast<uint8_t> (GridType::HZ)):
+      {
+        return MaterialIdsHz;
+      }
+      default:
+      {
+        UNREACHABLE;
+      }
+    }
+
+    return NULLPTR;
+  }
+#endif /* !GPU_INTERNAL_SCHEME */
+
 #define CALLBACK_NAME(x) \
   ICUDA_HOST \
   SourceCallBack getCallback ## x () \
@@ -1323,13 +1575,13 @@ public:
   }
 
   ICUDA_HOST
-  FPValue getGridStep ()
+  FPComputeValue getGridStep ()
   {
     return gridStep;
   }
 
   ICUDA_HOST
-  FPValue getGridTimeStep ()
+  FPComputeValue getGridTimeStep ()
   {
     return gridTimeStep;
   }
@@ -1342,13 +1594,13 @@ public:
   }
 
   ICUDA_HOST
-  FPValue getSourceFrequency ()
+  FPComputeValue getSourceFrequency ()
   {
     return sourceFrequency;
   }
 
   ICUDA_HOST
-  FPValue getSourceWaveLength ()
+  FPComputeValue getSourceWaveLength ()
   {
     return sourceWaveLength;
   }
@@ -1375,7 +1627,8 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateTFSF (TC posAbs,
                                                        TC pos11,
                                                        TC pos12,
                                                        TC pos21,
-                                                       TC pos22)
+                                                       TC pos22,
+                                                       int wave) /**< index of incident wave or ALL_INCIDENT_WAVES */
 {
   bool doNeedUpdate11;
   bool doNeedUpdate12;
@@ -1612,8 +1865,7 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateTFSF (TC posAbs,
     {
       case (static_cast<uint8_t> (GridType::EX)):
       {
-        TCFP realCoord = yeeLayout->getHzCoordFP (Hz->getTotalPosition (auxPos1));
-        diff1 = yeeLayout->getHzFromIncidentH (approximateIncidentWaveH (realCoord));
+        diff1 = getIncidentHz (Hz->getTotalPosition (auxPos1), wave);
 
         if (layout_type == H_CENTERED)
         {
@@ -1624,8 +1876,7 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateTFSF (TC posAbs,
       }
       case (static_cast<uint8_t> (GridType::EY)):
       {
-        TCFP realCoord = yeeLayout->getHxCoordFP (Hx->getTotalPosition (auxPos1));
-        diff1 = yeeLayout->getHxFromIncidentH (approximateIncidentWaveH (realCoord));
+        diff1 = getIncidentHx (Hx->getTotalPosition (auxPos1), wave);
 
         if (layout_type == H_CENTERED)
         {
@@ -1636,8 +1887,7 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateTFSF (TC posAbs,
       }
       case (static_cast<uint8_t> (GridType::EZ)):
       {
-        TCFP realCoord = yeeLayout->getHyCoordFP (Hy->getTotalPosition (auxPos1));
-        diff1 = yeeLayout->getHyFromIncidentH (approximateIncidentWaveH (realCoord));
+        diff1 = getIncidentHy (Hy->getTotalPosition (auxPos1), wave);
 
         if (layout_type == H_CENTERED)
         {
@@ -1648,8 +1898,7 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateTFSF (TC posAbs,
       }
       case (static_cast<uint8_t> (GridType::HX)):
       {
-        TCFP realCoord = yeeLayout->getEyCoordFP (Ey->getTotalPosition (auxPos1));
-        diff1 = yeeLayout->getEyFromIncidentE (approximateIncidentWaveE (realCoord));
+        diff1 = getIncidentEy (Ey->getTotalPosition (auxPos1), wave);
 
         if (layout_type == E_CENTERED)
         {
@@ -1660,8 +1909,7 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateTFSF (TC posAbs,
       }
       case (static_cast<uint8_t> (GridType::HY)):
       {
-        TCFP realCoord = yeeLayout->getEzCoordFP (Ez->getTotalPosition (auxPos1));
-        diff1 = yeeLayout->getEzFromIncidentE (approximateIncidentWaveE (realCoord));
+        diff1 = getIncidentEz (Ez->getTotalPosition (auxPos1), wave);
 
         if (layout_type == E_CENTERED)
         {
@@ -1672,8 +1920,7 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateTFSF (TC posAbs,
       }
       case (static_cast<uint8_t> (GridType::HZ)):
       {
-        TCFP realCoord = yeeLayout->getExCoordFP (Ex->getTotalPosition (auxPos1));
-        diff1 = yeeLayout->getExFromIncidentE (approximateIncidentWaveE (realCoord));
+        diff1 = getIncidentEx (Ex->getTotalPosition (auxPos1), wave);
 
         if (layout_type == E_CENTERED)
         {
@@ -1695,8 +1942,7 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateTFSF (TC posAbs,
     {
       case (static_cast<uint8_t> (GridType::EX)):
       {
-        TCFP realCoord = yeeLayout->getHyCoordFP (Hy->getTotalPosition (auxPos2));
-        diff2 = yeeLayout->getHyFromIncidentH (approximateIncidentWaveH (realCoord));
+        diff2 = getIncidentHy (Hy->getTotalPosition (auxPos2), wave);
 
         if (layout_type == H_CENTERED)
         {
@@ -1707,8 +1953,7 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateTFSF (TC posAbs,
       }
       case (static_cast<uint8_t> (GridType::EY)):
       {
-        TCFP realCoord = yeeLayout->getHzCoordFP (Hz->getTotalPosition (auxPos2));
-        diff2 = yeeLayout->getHzFromIncidentH (approximateIncidentWaveH (realCoord));
+        diff2 = getIncidentHz (Hz->getTotalPosition (auxPos2), wave);
 
         if (layout_type == H_CENTERED)
         {
@@ -1719,8 +1964,7 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateTFSF (TC posAbs,
       }
       case (static_cast<uint8_t> (GridType::EZ)):
       {
-        TCFP realCoord = yeeLayout->getHxCoordFP (Hx->getTotalPosition (auxPos2));
-        diff2 = yeeLayout->getHxFromIncidentH (approximateIncidentWaveH (realCoord));
+        diff2 = getIncidentHx (Hx->getTotalPosition (auxPos2), wave);
 
         if (layout_type == H_CENTERED)
         {
@@ -1731,8 +1975,7 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateTFSF (TC posAbs,
       }
       case (static_cast<uint8_t> (GridType::HX)):
       {
-        TCFP realCoord = yeeLayout->getEzCoordFP (Ez->getTotalPosition (auxPos2));
-        diff2 = yeeLayout->getEzFromIncidentE (approximateIncidentWaveE (realCoord));
+        diff2 = getIncidentEz (Ez->getTotalPosition (auxPos2), wave);
 
         if (layout_type == E_CENTERED)
         {
@@ -1743,8 +1986,7 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateTFSF (TC posAbs,
       }
       case (static_cast<uint8_t> (GridType::HY)):
       {
-        TCFP realCoord = yeeLayout->getExCoordFP (Ex->getTotalPosition (auxPos2));
-        diff2 = yeeLayout->getExFromIncidentE (approximateIncidentWaveE (realCoord));
+        diff2 = getIncidentEx (Ex->getTotalPosition (auxPos2), wave);
 
         if (layout_type == E_CENTERED)
         {
@@ -1755,8 +1997,7 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateTFSF (TC posAbs,
       }
       case (static_cast<uint8_t> (GridType::HZ)):
       {
-        TCFP realCoord = yeeLayout->getEyCoordFP (Ey->getTotalPosition (auxPos2));
-        diff2 = yeeLayout->getEyFromIncidentE (approximateIncidentWaveE (realCoord));
+        diff2 = getIncidentEy (Ey->getTotalPosition (auxPos2), wave);
 
         if (layout_type == E_CENTERED)
         {
@@ -1891,7 +2132,7 @@ void
 INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepInit (IGRID<TC> **grid, GridType *gridType, IGRID<TC> **materialGrid, GridType *materialGridType, IGRID<TC> **materialGrid1, GridType *materialGridType1,
 IGRID<TC> **materialGrid2, GridType *materialGridType2, IGRID<TC> **materialGrid3, GridType *materialGridType3, IGRID<TC> **materialGrid4, GridType *materialGridType4,
 IGRID<TC> **materialGrid5, GridType *materialGridType5, IGRID<TC> **oppositeGrid1, IGRID<TC> **oppositeGrid2, IGRID<TC> **gridPML1, GridType *gridPMLType1, IGRID<TC> **gridPML2, GridType *gridPMLType2,
-SourceCallBack *rightSideFunc, SourceCallBack *borderFunc, SourceCallBack *exactFunc, FPValue *materialModifier,
+SourceCallBack *rightSideFunc, SourceCallBack *borderFunc, SourceCallBack *exactFunc, FPComputeValue *materialModifier,
   IGRID<TC> **Ca, IGRID<TC> **Cb, IGRID<TC> **CB0, IGRID<TC> **CB1, IGRID<TC> **CB2, IGRID<TC> **CA1, IGRID<TC> **CA2, IGRID<TC> **CaPML, IGRID<TC> **CbPML, IGRID<TC> **CcPML)
 {
   switch (grid_type)
@@ -2278,8 +2519,8 @@ template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType
 template<bool usePrecomputedGrids>
 ICUDA_DEVICE
 void
-INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::computeCaCb (FieldValue &valCa,
-                                                              FieldValue &valCb,
+INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::computeCaCb (FieldComputeValue &valCa,
+                                                              FieldComputeValue &valCb,
                                                               TC pos,
                                                               TC posAbs,
                                                               IGRID<TC> *Ca,
@@ -2288,15 +2529,15 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::computeCaCb (FieldValue &valCa,
                                                               GridType gridType,
                                                               IGRID<TC> *materialGrid,
                                                               GridType materialGridType,
-                                                              FPValue materialModifier)
+                                                              FPComputeValue materialModifier)
 {
   if (usePrecomputedGrids)
   {
     ASSERT (Ca != NULLPTR);
     ASSERT (Cb != NULLPTR);
 
-    valCa = *Ca->getFieldValue (pos, 0);
-    valCb = *Cb->getFieldValue (pos, 0);
+    valCa = FieldComputeValue (*Ca->getFieldValue (pos, 0));
+    valCb = FieldComputeValue (*Cb->getFieldValue (pos, 0));
   }
   else
   {
@@ -2304,28 +2545,44 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::computeCaCb (FieldValue &valCa,
     ASSERT (Cb == NULLPTR);
     ASSERT (materialGrid != NULLPTR || SOLVER_SETTINGS.getDoUsePML ());
 
-    FPValue material = materialGrid ? getMaterial (posAbs, gridType, materialGrid, materialGridType) : 0;
-    FPValue ca = FPValue (0);
-    FPValue cb = FPValue (0);
+    FPComputeValue material = materialGrid ? getMaterial (posAbs, gridType, materialGrid, materialGridType) : 0;
 
-    FPValue k_mod = FPValue (1);
+    computeCaCbFromMaterial (valCa, valCb, material, usePML, materialModifier);
+  }
+}
 
-    if (usePML)
-    {
-      FPValue eps0 = PhysicsConst::Eps0;
-      FPValue dd = (2 * eps0 * k_mod + material * gridTimeStep);
-      ca = (2 * eps0 * k_mod - material * gridTimeStep) / dd;
-      cb = (2 * eps0 * gridTimeStep / gridStep) / dd;
-    }
-    else
-    {
-      ca = 1.0;
-      cb = gridTimeStep / (material * materialModifier * gridStep);
-    }
+/**
+ * Compute Ca and Cb from value of material at point
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+ICUDA_DEVICE
+void
+INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::computeCaCbFromMaterial (FieldComputeValue &valCa,
+                                                                          FieldComputeValue &valCb,
+                                                                          FPComputeValue material,
+                                                                          bool usePML,
+                                                                          FPComputeValue materialModifier)
+{
+  FPComputeValue ca = FPComputeValue (0);
+  FPComputeValue cb = FPComputeValue (0);
+
+  FPComputeValue k_mod = FPComputeValue (1);
 
-    valCa = FIELDVALUE (ca, 0);
-    valCb = FIELDVALUE (cb, 0);
+  if (usePML)
+  {
+    FPComputeValue eps0 = PhysicsConst::Eps0;
+    FPComputeValue dd = (2 * eps0 * k_mod + material * gridTimeStep);
+    ca = (2 * eps0 * k_mod - material * gridTimeStep) / dd;
+    cb = (2 * eps0 * gridTimeStep / gridStep) / dd;
+  }
+  else
+  {
+    ca = 1.0;
+    cb = gridTimeStep / (material * materialModifier * gridStep);
   }
+
+  valCa = FIELDCOMPUTEVALUE (ca, 0);
+  valCb = FIELDCOMPUTEVALUE (cb, 0);
 }
 
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
@@ -2350,19 +2607,19 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepIteration (FP
                                                                              GridType gridType,
                                                                              IGRID<TC> *materialGrid,
                                                                              GridType materialGridType,
-                                                                             FPValue materialModifier)
+                                                                             FPComputeValue materialModifier)
 {
   ASSERT (grid != NULLPTR);
   grid_coord coord = grid->calculateIndexFromPosition (pos);
   FieldValue val = *grid->getFieldValue (coord, 1);
 
-  FieldValue valCa = FIELDVALUE (0, 0);
-  FieldValue valCb = FIELDVALUE (0, 0);
+  FieldComputeValue valCa = FIELDCOMPUTEVALUE (0, 0);
+  FieldComputeValue valCb = FIELDCOMPUTEVALUE (0, 0);
 
   computeCaCb<usePrecomputedGrids> (valCa, valCb, pos, posAbs, Ca, Cb, usePML, gridType, materialGrid, materialGridType, materialModifier);
 
-  ASSERT (valCa != FIELDVALUE (0, 0));
-  ASSERT (valCb != FIELDVALUE (0, 0));
+  ASSERT (valCa != FIELDCOMPUTEVALUE (0, 0));
+  ASSERT (valCb != FIELDCOMPUTEVALUE (0, 0));
 
   FieldValue prev11 = FIELDVALUE (0, 0);
   FieldValue prev12 = FIELDVALUE (0, 0);
@@ -2385,7 +2642,8 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepIteration (FP
 
   if (SOLVER_SETTINGS.getDoUseTFSF ())
   {
-    calculateTFSF<grid_type> (posAbs, prev11, prev12, prev21, prev22, pos + diff11, pos + diff12, pos + diff21, pos + diff22);
+    calculateTFSF<grid_type> (posAbs, prev11, prev12, prev21, prev22, pos + diff11, pos + diff12, pos + diff21, pos + diff22,
+                              getIncidentWaveOfLane (activeLane));
   }
 
   if (rightSideFunc != NULLPTR)
@@ -2397,6 +2655,453 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepIteration (FP
   grid->setFieldValue (valNew, coord, 0);
 }
 
+#ifndef GPU_INTERNAL_SCHEME
+/**
+ * Split chunk into boxes, in which all points require the same computations.
+ *
+ * TF/SF correction is required only for points near TF/SF border, and PML coefficients differ from the ones in
+ * the rest of grid only near PML. Chunk is cut by each axis at borders of these areas (with margin of
+ * CHUNK_REGION_MARGIN points, which covers both offsets of field components and averaging of materials), and then
+ * neighboring boxes with the same labels are merged along the third axis, so that rows stay as long as possible.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+ICUDA_HOST
+void
+INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::getChunkRegions (GridCoordinate3D start3D, /**< start of chunk */
+                                                                 GridCoordinate3D end3D, /**< end of chunk */
+                                                                 IGRID<TC> *grid, /**< grid, which is updated */
+                                                                 bool doSplitTFSF, /**< flag whether to label TF/SF border */
+                                                                 bool doSplitPML, /**< flag whether to label PML */
+                                                                 std::vector<ChunkRegion> &regions) /**< out: boxes */
+{
+  regions.clear ();
+
+  if (start3D.get1 () >= end3D.get1 ()
+      || start3D.get2 () >= end3D.get2 ()
+      || start3D.get3 () >= end3D.get3 ())
+  {
+    return;
+  }
+
+  /*
+   * Borders are converted to coordinates of chunk, i.e. to coordinates relative to start of grid
+   */
+  TC zeroPos = TC::initAxesCoordinate (0, 0, 0, ct1, ct2, ct3);
+  GridCoordinate3D shift = expandTo3D (grid->getTotalPosition (zeroPos), ct1, ct2, ct3);
+
+  GridCoordinate3D leftTFSF = expandTo3D (yeeLayout->getLeftBorderTFSF (), ct1, ct2, ct3);
+  GridCoordinate3D rightTFSF = expandTo3D (yeeLayout->getRightBorderTFSF (), ct1, ct2, ct3);
+  GridCoordinate3D leftPML = expandTo3D (yeeLayout->getLeftBorderPML (), ct1, ct2, ct3);
+  GridCoordinate3D rightPML = expandTo3D (yeeLayout->getRightBorderPML (), ct1, ct2, ct3);
+
+  /*
+   * Relative borders might be negative, so they are not stored in coordinates
+   */
+  grid_coord start[3] = { start3D.get1 (), start3D.get2 (), start3D.get3 () };
+  grid_coord end[3] = { end3D.get1 (), end3D.get2 (), end3D.get3 () };
+  grid_coord borderL[3] = { leftTFSF.get1 () - shift.get1 (), leftTFSF.get2 () - shift.get2 (), leftTFSF.get3 () - shift.get3 () };
+  grid_coord borderR[3] = { rightTFSF.get1 () - shift.get1 (), rightTFSF.get2 () - shift.get2 (), rightTFSF.get3 () - shift.get3 () };
+  grid_coord borderPMLL[3] = { leftPML.get1 () - shift.get1 (), leftPML.get2 () - shift.get2 (), leftPML.get3 () - shift.get3 () };
+  grid_coord borderPMLR[3] = { rightPML.get1 () - shift.get1 (), rightPML.get2 () - shift.get2 (), rightPML.get3 () - shift.get3 () };
+  bool hasAxis[3] =
+  {
+    ct1 == CoordinateType::X || ct2 == CoordinateType::X || ct3 == CoordinateType::X,
+    ct1 == CoordinateType::Y || ct2 == CoordinateType::Y || ct3 == CoordinateType::Y,
+    ct1 == CoordinateType::Z || ct2 == CoordinateType::Z || ct3 == CoordinateType::Z
+  };
+
+  const grid_coord m = CHUNK_REGION_MARGIN;
+
+  /*
+   * Cuts and labels of intervals between them for each axis
+   */
+  grid_coord cuts[3][CHUNK_REGION_MAX_CUTS];
+  int cutsCount[3];
+  bool isTFSFOuter[3][CHUNK_REGION_MAX_CUTS];
+  bool isTFSFNear[3][CHUNK_REGION_MAX_CUTS];
+  bool isPMLInner[3][CHUNK_REGION_MAX_CUTS];
+
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    grid_coord candidates[CHUNK_REGION_MAX_CUTS];
+    int count = 0;
+
+    candidates[count++] = start[axis];
+    candidates[count++] = end[axis];
+
+    if (hasAxis[axis] && doSplitTFSF)
+    {
+      candidates[count++] = borderL[axis] - m;
+      candidates[count++] = borderL[axis] + m;
+      candidates[count++] = borderR[axis] - m;
+      candidates[count++] = borderR[axis] + m;
+    }
+
+    if (hasAxis[axis] && doSplitPML)
+    {
+      candidates[count++] = borderPMLL[axis] + m;
+      candidates[count++] = borderPMLR[axis] - m;
+    }
+
+    ASSERT (count <= CHUNK_REGION_MAX_CUTS);
+
+    cutsCount[axis] = 0;
+    for (int c = 0; c < count; ++c)
+    {
+      if (candidates[c] >= start[axis] && candidates[c] <= end[axis])
+      {
+        cuts[axis][cutsCount[axis]++] = candidates[c];
+      }
+    }
+
+    std::sort (cuts[axis], cuts[axis] + cutsCount[axis]);
+    cutsCount[axis] = std::unique (cuts[axis], cuts[axis] + cutsCount[axis]) - cuts[axis];
+
+    for (int c = 0; c < cutsCount[axis] - 1; ++c)
+    {
+      grid_coord x = cuts[axis][c];
+
+      isTFSFOuter[axis][c] = !hasAxis[axis] || (x >= borderL[axis] - m && x < borderR[axis] + m);
+      isTFSFNear[axis][c] = hasAxis[axis] && ((x >= borderL[axis] - m && x < borderL[axis] + m)
+                                              || (x >= borderR[axis] - m && x < borderR[axis] + m));
+      isPMLInner[axis][c] = !hasAxis[axis] || (x >= borderPMLL[axis] + m && x < borderPMLR[axis] - m);
+    }
+  }
+
+  for (int i = 0; i < cutsCount[0] - 1; ++i)
+  {
+    for (int j = 0; j < cutsCount[1] - 1; ++j)
+    {
+      for (int k = 0; k < cutsCount[2] - 1; ++k)
+      {
+        bool isTFSF = doSplitTFSF
+                      && isTFSFOuter[0][i] && isTFSFOuter[1][j] && isTFSFOuter[2][k]
+                      && (isTFSFNear[0][i] || isTFSFNear[1][j] || isTFSFNear[2][k]);
+        bool isPML = doSplitPML
+                     && !(isPMLInner[0][i] && isPMLInner[1][j] && isPMLInner[2][k]);
+
+        GridCoordinate3D regionStart = GRID_COORDINATE_3D (cuts[0][i], cuts[1][j], cuts[2][k],
+                                                           CoordinateType::X, CoordinateType::Y, CoordinateType::Z);
+        GridCoordinate3D regionEnd = GRID_COORDINATE_3D (cuts[0][i + 1], cuts[1][j + 1], cuts[2][k + 1],
+                                                         CoordinateType::X, CoordinateType::Y, CoordinateType::Z);
+
+        if (k > 0
+            && regions.back ().isTFSF == isTFSF
+            && regions.back ().isPML == isPML)
+        {
+          regions.back ().end = regionEnd;
+        }
+        else
+        {
+          regions.push_back (ChunkRegion (regionStart, regionEnd, isTFSF, isPML));
+        }
+      }
+    }
+  }
+} /* INTERNAL_SCHEME_BASE::getChunkRegions */
+
+/**
+ * Perform calculateFieldStepIteration for all points of chunk without right side function.
+ *
+ * NOTE: this is the same computation as in calculateFieldStepIteration, but with all per-point checks hoisted out of
+ *       the loops. Chunk is split into boxes (see getChunkRegions), and each box is computed by kernel, which is
+ *       specialized for exactly the computations required in it: TF/SF correction is applied only near TF/SF border,
+ *       and outside of PML coefficients of PML are the same for all points, so they are computed once.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template<uint8_t grid_type>
+ICUDA_HOST
+void
+INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepIterationChunk (GridCoordinate3D start3D, /**< start of chunk */
+                                                                                  GridCoordinate3D end3D, /**< end of chunk */
+                                                                                  TCS diff11,
+                                                                                  TCS diff12,
+                                                                                  TCS diff21,
+                                                                                  TCS diff22,
+                                                                                  IGRID<TC> *grid,
+                                                                                  IGRID<TC> *oppositeGrid1,
+                                                                                  IGRID<TC> *oppositeGrid2,
+                                                                                  IGRID<TC> *Ca,
+                                                                                  IGRID<TC> *Cb,
+                                                                                  bool usePML,
+                                                                                  GridType gridType,
+                                                                                  IGRID<TC> *materialGrid,
+                                                                                  GridType materialGridType,
+                                                                                  FPComputeValue materialModifier)
+{
+  bool usePrecomputedGrids = SOLVER_SETTINGS.getDoUseCaCbGrids ();
+  bool useMaterialIds = SOLVER_SETTINGS.getDoUseCaCbMaterialIds ();
+
+  /*
+   * PML coefficients are computed from sigma, which is zero everywhere outside PML (averaging of materials with double
+   * precision is not taken into account by margins of regions, so such coefficients are always computed per point).
+   */
+  bool useConstantCaCb = usePML
+                         && !usePrecomputedGrids
+                         && !useMaterialIds
+                         && !yeeLayout->getIsDoubleMaterialPrecision ();
+
+  FieldComputeValue constCa = FIELDCOMPUTEVALUE (0, 0);
+  FieldComputeValue constCb = FIELDCOMPUTEVALUE (0, 0);
+
+  if (useConstantCaCb)
+  {
+    computeCaCbFromMaterial (constCa, constCb, FPComputeValue (0), usePML, materialModifier);
+  }
+
+  MaterialIdGrid *materialIds = getMaterialIds<grid_type> ();
+
+  std::vector<ChunkRegion> regions;
+  getChunkRegions (start3D, end3D, grid, SOLVER_SETTINGS.getDoUseTFSF (), useConstantCaCb && materialGrid != NULLPTR,
+                   regions);
+
+#define CALCULATE_ROWS(usePrecomputedGrids, useMaterialIds, useConstantCaCb, useTFSF) \
+  calculateFieldStepIterationRows<grid_type, usePrecomputedGrids, useMaterialIds, useConstantCaCb, useTFSF> \
+    (region.start, region.end, diff11, diff12, diff21, diff22, grid, oppositeGrid1, oppositeGrid2, Ca, Cb, materialIds, \
+     constCa, constCb, usePML, gridType, materialGrid, materialGridType, materialModifier);
+
+#define CALCULATE_ROWS_TFSF(usePrecomputedGrids, useMaterialIds, useConstantCaCb) \
+  if (region.isTFSF) \
+  { \
+    CALCULATE_ROWS (usePrecomputedGrids, useMaterialIds, useConstantCaCb, true) \
+  } \
+  else \
+  { \
+    CALCULATE_ROWS (usePrecomputedGrids, useMaterialIds, useConstantCaCb, false) \
+  }
+
+  for (typename std::vector<ChunkRegion>::iterator it = regions.begin (); it != regions.end (); ++it)
+  {
+    const ChunkRegion &region = *it;
+
+    if (usePrecomputedGrids)
+    {
+      CALCULATE_ROWS_TFSF (true, false, false)
+    }
+    else if (useMaterialIds)
+    {
+      CALCULATE_ROWS_TFSF (false, true, false)
+    }
+    else if (useConstantCaCb && !region.isPML)
+    {
+      CALCULATE_ROWS_TFSF (false, false, true)
+    }
+    else
+    {
+      CALCULATE_ROWS_TFSF (false, false, false)
+    }
+  }
+
+#undef CALCULATE_ROWS_TFSF
+#undef CALCULATE_ROWS
+} /* INTERNAL_SCHEME_BASE::calculateFieldStepIterationChunk */
+
+/**
+ * Perform calculateFieldStepIteration for all points of chunk row by row, with innermost loop over the third axis.
+ *
+ * Linear indices of the first point of row are computed once per row, and strides along the third axis are computed
+ * once per chunk, so that innermost loop works directly with raw time step layers of grids. Coordinates of points are
+ * constructed only if they are required by TF/SF or by computation of Ca and Cb from material grid, and absolute
+ * coordinates are obtained by constant shift instead of virtual call of getTotalPosition. With material identifiers
+ * Ca and Cb are taken from small table by identifier of point, and with constant coefficients they are the same for
+ * all points of chunk.
+ *
+ * All lanes of batched field grids are updated in the innermost loop, so that coefficients and indices are obtained
+ * once per point for all lanes.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template<uint8_t grid_type, bool usePrecomputedGrids, bool useMaterialIds, bool useConstantCaCb, bool useTFSF>
+ICUDA_HOST
+void
+INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepIterationRows (GridCoordinate3D start3D, /**< start of chunk */
+                                                                                 GridCoordinate3D end3D, /**< end of chunk */
+                                                                                 TCS diff11,
+                                                                                 TCS diff12,
+                                                                                 TCS diff21,
+                                                                                 TCS diff22,
+                                                                                 IGRID<TC> *grid,
+                                                                                 IGRID<TC> *oppositeGrid1,
+                                                                                 IGRID<TC> *oppositeGrid2,
+                                                                                 IGRID<TC> *Ca,
+                                                                                 IGRID<TC> *Cb,
+                                                                                 MaterialIdGrid *materialIds,
+                                                                                 FieldComputeValue constCa,
+                                                                                 FieldComputeValue constCb,
+                                                                                 bool usePML,
+                                                                                 GridType gridType,
+                                                                                 IGRID<TC> *materialGrid,
+                                                                                 GridType materialGridType,
+                                                                                 FPComputeValue materialModifier)
+{
+  ASSERT (grid != NULLPTR);
+
+  if (start3D.get1 () >= end3D.get1 ()
+      || start3D.get2 () >= end3D.get2 ()
+      || start3D.get3 () >= end3D.get3 ())
+  {
+    return;
+  }
+
+  /*
+   * Absent opposite grid is replaced with single zero value with zero stride
+   */
+  FieldValue zero = FIELDVALUE (0, 0);
+
+  /*
+   * Values of all lanes of point are placed together, so indices of field values are multiplied by number of lanes
+   */
+  const grid_coord lanes = grid->getBatchSize ();
+  const grid_coord laneStep1 = oppositeGrid1 ? 1 : 0;
+  const grid_coord laneStep2 = oppositeGrid2 ? 1 : 0;
+
+  ASSERT (oppositeGrid1 == NULLPTR || oppositeGrid1->getBatchSize () == lanes);
+  ASSERT (oppositeGrid2 == NULLPTR || oppositeGrid2->getBatchSize () == lanes);
+
+  FieldValue *cur = grid->getRaw (0);
+  FieldValue *prev = grid->getRaw (1);
+  FieldValue *opposite1 = oppositeGrid1 ? oppositeGrid1->getRaw (1) : &zero;
+  FieldValue *opposite2 = oppositeGrid2 ? oppositeGrid2->getRaw (1) : &zero;
+
+  FieldValue *rawCa = NULLPTR;
+  FieldValue *rawCb = NULLPTR;
+
+  if (usePrecomputedGrids)
+  {
+    ASSERT (Ca != NULLPTR && Ca->getSize () == grid->getSize ());
+    ASSERT (Cb != NULLPTR && Cb->getSize () == grid->getSize ());
+
+    rawCa = Ca->getRaw (0);
+    rawCb = Cb->getRaw (0);
+  }
+
+  /*
+   * Whether Ca and Cb are computed from materials for each point
+   */
+  const bool doComputeCaCb = !usePrecomputedGrids && !useMaterialIds && !useConstantCaCb;
+
+  const material_id *rawIds = NULLPTR;
+  const FieldComputeValue *tableCa = NULLPTR;
+  const FieldComputeValue *tableCb = NULLPTR;
+
+  if (useMaterialIds)
+  {
+    ASSERT (materialIds != NULLPTR && materialIds->getSize () == grid->getSize ().calculateTotalCoord ());
+
+    rawIds = materialIds->getRawIds ();
+    tableCa = materialIds->getRawCa ();
+    tableCb = materialIds->getRawCb ();
+  }
+
+  TC zeroPos = TC::initAxesCoordinate (0, 0, 0, ct1, ct2, ct3);
+  TC posAbsShift = grid->getTotalPosition (zeroPos);
+
+  grid_coord stride = 0;
+  grid_coord stride11 = 0;
+  grid_coord stride12 = 0;
+  grid_coord stride21 = 0;
+  grid_coord stride22 = 0;
+
+  if (end3D.get3 () - start3D.get3 () > 1)
+  {
+    TC first = TC::initAxesCoordinate (start3D.get1 (), start3D.get2 (), start3D.get3 (), ct1, ct2, ct3);
+    TC next = TC::initAxesCoordinate (start3D.get1 (), start3D.get2 (), start3D.get3 () + 1, ct1, ct2, ct3);
+
+    stride = grid->calculateIndexFromPosition (next) - grid->calculateIndexFromPosition (first);
+
+    if (oppositeGrid1)
+    {
+      stride11 = oppositeGrid1->calculateIndexFromPosition (next + diff11) - oppositeGrid1->calculateIndexFromPosition (first + diff11);
+      stride12 = oppositeGrid1->calculateIndexFromPosition (next + diff12) - oppositeGrid1->calculateIndexFromPosition (first + diff12);
+    }
+
+    if (oppositeGrid2)
+    {
+      stride21 = oppositeGrid2->calculateIndexFromPosition (next + diff21) - oppositeGrid2->calculateIndexFromPosition (first + diff21);
+      stride22 = oppositeGrid2->calculateIndexFromPosition (next + diff22) - oppositeGrid2->calculateIndexFromPosition (first + diff22);
+    }
+
+    stride11 *= lanes;
+    stride12 *= lanes;
+    stride21 *= lanes;
+    stride22 *= lanes;
+  }
+
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for collapse(2)
+#endif /* OPENMP_ENABLED */
+  for (grid_coord i = start3D.get1 (); i < end3D.get1 (); ++i)
+  {
+    for (grid_coord j = start3D.get2 (); j < end3D.get2 (); ++j)
+    {
+      TC rowPos = TC::initAxesCoordinate (i, j, start3D.get3 (), ct1, ct2, ct3);
+
+      grid_coord index = grid->calculateIndexFromPosition (rowPos);
+      grid_coord index11 = oppositeGrid1 ? oppositeGrid1->calculateIndexFromPosition (rowPos + diff11) * lanes : 0;
+      grid_coord index12 = oppositeGrid1 ? oppositeGrid1->calculateIndexFromPosition (rowPos + diff12) * lanes : 0;
+      grid_coord index21 = oppositeGrid2 ? oppositeGrid2->calculateIndexFromPosition (rowPos + diff21) * lanes : 0;
+      grid_coord index22 = oppositeGrid2 ? oppositeGrid2->calculateIndexFromPosition (rowPos + diff22) * lanes : 0;
+
+      for (grid_coord k = start3D.get3 (); k < end3D.get3 (); ++k)
+      {
+        FieldComputeValue valCa = constCa;
+        FieldComputeValue valCb = constCb;
+
+        if (usePrecomputedGrids)
+        {
+          valCa = FieldComputeValue (rawCa[index]);
+          valCb = FieldComputeValue (rawCb[index]);
+        }
+        else if (useMaterialIds)
+        {
+          valCa = tableCa[rawIds[index]];
+          valCb = tableCb[rawIds[index]];
+        }
+
+        TC pos;
+        TC posAbs;
+
+        if (doComputeCaCb || useTFSF)
+        {
+          pos = TC::initAxesCoordinate (i, j, k, ct1, ct2, ct3);
+          posAbs = pos + posAbsShift;
+
+          if (doComputeCaCb)
+          {
+            computeCaCb<false> (valCa, valCb, pos, posAbs, Ca, Cb, usePML, gridType, materialGrid, materialGridType, materialModifier);
+          }
+        }
+
+        ASSERT (valCa != FIELDCOMPUTEVALUE (0, 0));
+        ASSERT (valCb != FIELDCOMPUTEVALUE (0, 0));
+
+        for (grid_coord lane = 0; lane < lanes; ++lane)
+        {
+          FieldValue prev11 = opposite1[index11 + lane * laneStep1];
+          FieldValue prev12 = opposite1[index12 + lane * laneStep1];
+          FieldValue prev21 = opposite2[index21 + lane * laneStep2];
+          FieldValue prev22 = opposite2[index22 + lane * laneStep2];
+
+          if (useTFSF)
+          {
+            calculateTFSF<grid_type> (posAbs, prev11, prev12, prev21, prev22, pos + diff11, pos + diff12, pos + diff21, pos + diff22,
+                                      getIncidentWaveOfLane (lane));
+          }
+
+          grid_coord fieldIndex = index * lanes + lane;
+          cur[fieldIndex] = calcField (prev[fieldIndex], prev12, prev11, prev22, prev21, zero, valCa, valCb, gridStep);
+        }
+
+        index += stride;
+        index11 += stride11;
+        index12 += stride12;
+        index21 += stride21;
+        index22 += stride22;
+      }
+    }
+  }
+} /* INTERNAL_SCHEME_BASE::calculateFieldStepIterationRows */
+#endif /* !GPU_INTERNAL_SCHEME */
+
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
 template<uint8_t grid_type, bool usePrecomputedGrids>
 ICUDA_DEVICE
@@ -2409,7 +3114,7 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepIterationCurr
                                                                              GridType gridType,
                                                                              IGRID<TC> *materialGrid,
                                                                              GridType materialGridType,
-                                                                             FPValue materialModifier)
+                                                                             FPComputeValue materialModifier)
 {
   TC pos = TC::initAxesCoordinate (SOLVER_SETTINGS.getCurrentSourcePositionX (),
                                    SOLVER_SETTINGS.getCurrentSourcePositionY (),
@@ -2421,8 +3126,8 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepIterationCurr
 
   if (pointVal)
   {
-    FieldValue valCa = FIELDVALUE (0, 0);
-    FieldValue valCb = FIELDVALUE (0, 0);
+    FieldComputeValue valCa = FIELDCOMPUTEVALUE (0, 0);
+    FieldComputeValue valCb = FIELDCOMPUTEVALUE (0, 0);
 
     computeCaCb<usePrecomputedGrids> (valCa, valCb, pos, posAbs, Ca, Cb, usePML, gridType, materialGrid, materialGridType, materialModifier);
 
@@ -2450,7 +3155,7 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepIterationPMLM
                                                                                GridType materialGridType2,
                                                                                IGRID<TC> *materialGrid3,
                                                                                GridType materialGridType3,
-                                                                               FPValue materialModifier)
+                                                                               FPComputeValue materialModifier)
 {
   ASSERT (grid != NULLPTR);
   ASSERT (gridPML != NULLPTR);
@@ -2463,11 +3168,11 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepIterationPMLM
   FieldValue prevPML = *gridPML->getFieldValue (coord, 1);
   FieldValue prevPrevPML = *gridPML->getFieldValue (coord, 2);
 
-  FieldValue valb0 = FIELDVALUE (0, 0);
-  FieldValue valb1 = FIELDVALUE (0, 0);
-  FieldValue valb2 = FIELDVALUE (0, 0);
-  FieldValue vala1 = FIELDVALUE (0, 0);
-  FieldValue vala2 = FIELDVALUE (0, 0);
+  FieldComputeValue valb0 = FIELDCOMPUTEVALUE (0, 0);
+  FieldComputeValue valb1 = FIELDCOMPUTEVALUE (0, 0);
+  FieldComputeValue valb2 = FIELDCOMPUTEVALUE (0, 0);
+  FieldComputeValue vala1 = FIELDCOMPUTEVALUE (0, 0);
+  FieldComputeValue vala2 = FIELDCOMPUTEVALUE (0, 0);
 
   if (usePrecomputedGrids)
   {
@@ -2477,11 +3182,11 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepIterationPMLM
     ASSERT (CA1 != NULLPTR);
     ASSERT (CA2 != NULLPTR);
 
-    valb0 = *CB0->getFieldValue (coord, 0);
-    valb1 = *CB1->getFieldValue (coord, 0);
-    valb2 = *CB2->getFieldValue (coord, 0);
-    vala1 = *CA1->getFieldValue (coord, 0);
-    vala2 = *CA2->getFieldValue (coord, 0);
+    valb0 = FieldComputeValue (*CB0->getFieldValue (coord, 0));
+    valb1 = FieldComputeValue (*CB1->getFieldValue (coord, 0));
+    valb2 = FieldComputeValue (*CB2->getFieldValue (coord, 0));
+    vala1 = FieldComputeValue (*CA1->getFieldValue (coord, 0));
+    vala2 = FieldComputeValue (*CA2->getFieldValue (coord, 0));
   }
   else
   {
@@ -2500,31 +3205,31 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepIterationPMLM
     FPValue material1;
     FPValue material2;
 
-    FPValue material = getMetaMaterial (posAbs, gridType,
-                                        materialGrid1, materialGridType1,
-                                        materialGrid2, materialGridType2,
-                                        materialGrid3, materialGridType3,
-                                        material1, material2);
-
-    FPValue A = 4*materialModifier*material + 2*gridTimeStep*materialModifier*material*material2 + materialModifier*SQR(gridTimeStep*material1);
-    FPValue b0 = (4 + 2*gridTimeStep*material2) / A;
-    FPValue b1 = -8 / A;
-    FPValue b2 = (4 - 2*gridTimeStep*material2) / A;
-    FPValue a1 = (2*materialModifier*SQR(gridTimeStep*material1) - 8*materialModifier*material) / A;
-    FPValue a2 = (4*materialModifier*material - 2*gridTimeStep*materialModifier*material*material2 + materialModifier*SQR(gridTimeStep*material1)) / A;
-
-    valb0 = FIELDVALUE (b0, 0);
-    valb1 = FIELDVALUE (b1, 0);
-    valb2 = FIELDVALUE (b2, 0);
-    vala1 = FIELDVALUE (a1, 0);
-    vala2 = FIELDVALUE (a2, 0);
+    FPComputeValue material = getMetaMaterial (posAbs, gridType,
+                                               materialGrid1, materialGridType1,
+                                               materialGrid2, materialGridType2,
+                                               materialGrid3, materialGridType3,
+                                               material1, material2);
+
+    FPComputeValue A = 4*materialModifier*material + 2*gridTimeStep*materialModifier*material*material2 + materialModifier*SQR(gridTimeStep*material1);
+    FPComputeValue b0 = (4 + 2*gridTimeStep*material2) / A;
+    FPComputeValue b1 = -8 / A;
+    FPComputeValue b2 = (4 - 2*gridTimeStep*material2) / A;
+    FPComputeValue a1 = (2*materialModifier*SQR(gridTimeStep*material1) - 8*materialModifier*material) / A;
+    FPComputeValue a2 = (4*materialModifier*material - 2*gridTimeStep*materialModifier*material*material2 + materialModifier*SQR(gridTimeStep*material1)) / A;
+
+    valb0 = FIELDCOMPUTEVALUE (b0, 0);
+    valb1 = FIELDCOMPUTEVALUE (b1, 0);
+    valb2 = FIELDCOMPUTEVALUE (b2, 0);
+    vala1 = FIELDCOMPUTEVALUE (a1, 0);
+    vala2 = FIELDCOMPUTEVALUE (a2, 0);
   }
 
-  ASSERT (valb0 != FIELDVALUE (0, 0));
-  ASSERT (valb1 != FIELDVALUE (0, 0));
-  ASSERT (valb2 != FIELDVALUE (0, 0));
-  ASSERT (vala1 != FIELDVALUE (0, 0));
-  ASSERT (vala2 != FIELDVALUE (0, 0));
+  ASSERT (valb0 != FIELDCOMPUTEVALUE (0, 0));
+  ASSERT (valb1 != FIELDCOMPUTEVALUE (0, 0));
+  ASSERT (valb2 != FIELDCOMPUTEVALUE (0, 0));
+  ASSERT (vala1 != FIELDCOMPUTEVALUE (0, 0));
+  ASSERT (vala2 != FIELDCOMPUTEVALUE (0, 0));
 
   FieldValue valNew = calcFieldDrude (cur, prev, prevPrev, prevPML, prevPrevPML, valb0, valb1, valb2, vala1, vala2);
   gridPML->setFieldValue (valNew, coord, 0);
@@ -2549,7 +3254,7 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepIterationPML
                                                                    GridType materialGridType4,
                                                                    IGRID<TC> *materialGrid5,
                                                                    GridType materialGridType5,
-                                                                   FPValue materialModifier)
+                                                                   FPComputeValue materialModifier)
 {
   ASSERT (gridPML2 != NULLPTR);
   grid_coord coord = gridPML2->calculateIndexFromPosition (pos);
@@ -2558,9 +3263,9 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepIterationPML
   FieldValue curDorB = FIELDVALUE (0, 0);
   FieldValue prevDorB = FIELDVALUE (0, 0);
 
-  FieldValue valCa = FIELDVALUE (0, 0);
-  FieldValue valCb = FIELDVALUE (0, 0);
-  FieldValue valCc = FIELDVALUE (0, 0);
+  FieldComputeValue valCa = FIELDCOMPUTEVALUE (0, 0);
+  FieldComputeValue valCb = FIELDCOMPUTEVALUE (0, 0);
+  FieldComputeValue valCc = FIELDCOMPUTEVALUE (0, 0);
 
   if (useMetamaterials)
   {
@@ -2581,42 +3286,42 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::calculateFieldStepIterationPML
     ASSERT (Cb != NULLPTR);
     ASSERT (Cc != NULLPTR);
 
-    valCa = *Ca->getFieldValue (coord, 0);
-    valCb = *Cb->getFieldValue (coord, 0);
-    valCc = *Cc->getFieldValue (coord, 0);
+    valCa = FieldComputeValue (*Ca->getFieldValue (coord, 0));
+    valCb = FieldComputeValue (*Cb->getFieldValue (coord, 0));
+    valCc = FieldComputeValue (*Cc->getFieldValue (coord, 0));
   }
   else
   {
-    FPValue eps0 = PhysicsConst::Eps0;
+    FPComputeValue eps0 = PhysicsConst::Eps0;
     TC posAbs = gridPML2->getTotalPosition (pos);
 
-    FPValue material1 = materialGrid1 ? getMaterial (posAbs, gridPMLType1, materialGrid1, materialGridType1) : 0;
-    FPValue material4 = materialGrid4 ? getMaterial (posAbs, gridPMLType1, materialGrid4, materialGridType4) : 0;
-    FPValue material5 = materialGrid5 ? getMaterial (posAbs, gridPMLType1, materialGrid5, materialGridType5) : 0;
+    FPComputeValue material1 = materialGrid1 ? getMaterial (posAbs, gridPMLType1, materialGrid1, materialGridType1) : 0;
+    FPComputeValue material4 = materialGrid4 ? getMaterial (posAbs, gridPMLType1, materialGrid4, materialGridType4) : 0;
+    FPComputeValue material5 = materialGrid5 ? getMaterial (posAbs, gridPMLType1, materialGrid5, materialGridType5) : 0;
 
-    FPValue modifier = material1 * materialModifier;
+    FPComputeValue modifier = material1 * materialModifier;
     if (useMetamaterials)
     {
       modifier = 1;
     }
 
-    FPValue k_mod1 = 1;
-    FPValue k_mod2 = 1;
+    FPComputeValue k_mod1 = 1;
+    FPComputeValue k_mod2 = 1;
 
-    FPValue dd = (2 * eps0 * k_mod2 + material5 * gridTimeStep);
+    FPComputeValue dd = (2 * eps0 * k_mod2 + material5 * gridTimeStep);
 
-    FPValue ca = (2 * eps0 * k_mod2 - material5 * gridTimeStep) / dd;
-    FPValue cb = ((2 * eps0 * k_mod1 + material4 * gridTimeStep) / (modifier)) / dd;
-    FPValue cc = ((2 * eps0 * k_mod1 - material4 * gridTimeStep) / (modifier)) / dd;
+    FPComputeValue ca = (2 * eps0 * k_mod2 - material5 * gridTimeStep) / dd;
+    FPComputeValue cb = ((2 * eps0 * k_mod1 + material4 * gridTimeStep) / (modifier)) / dd;
+    FPComputeValue cc = ((2 * eps0 * k_mod1 - material4 * gridTimeStep) / (modifier)) / dd;
 
-    valCa = FIELDVALUE (ca, 0);
-    valCb = FIELDVALUE (cb, 0);
-    valCc = FIELDVALUE (cc, 0);
+    valCa = FIELDCOMPUTEVALUE (ca, 0);
+    valCb = FIELDCOMPUTEVALUE (cb, 0);
+    valCc = FIELDCOMPUTEVALUE (cc, 0);
   }
 
-  ASSERT (valCa != FIELDVALUE (0, 0));
-  ASSERT (valCb != FIELDVALUE (0, 0));
-  ASSERT (valCc != FIELDVALUE (0, 0));
+  ASSERT (valCa != FIELDCOMPUTEVALUE (0, 0));
+  ASSERT (valCb != FIELDCOMPUTEVALUE (0, 0));
+  ASSERT (valCc != FIELDCOMPUTEVALUE (0, 0));
 
   FieldValue valNew = calcFieldFromDOrB (prevEorH, curDorB, prevDorB, valCa, valCb, valCc);
   gridPML2->setFieldValue (valNew, coord, 0);
@@ -2869,10 +3574,10 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::performPointSourceCalc (time_st
   if (pointVal)
   {
 #ifdef COMPLEX_FIELD_VALUES
-    *pointVal = FieldValue (sin (gridTimeStep * timestep * 2 * PhysicsConst::Pi * sourceFrequency),
-                            cos (gridTimeStep * timestep * 2 * PhysicsConst::Pi * sourceFrequency));
+    *pointVal = FieldValue (sin (gridTimeStep * timestep * 2 * PhysicsConst::PiCompute * sourceFrequency),
+                            cos (gridTimeStep * timestep * 2 * PhysicsConst::PiCompute * sourceFrequency));
 #else /* COMPLEX_FIELD_VALUES */
-    *pointVal = sin (gridTimeStep * timestep * 2 * PhysicsConst::Pi * sourceFrequency);
+    *pointVal = sin (gridTimeStep * timestep * 2 * PhysicsConst::PiCompute * sourceFrequency);
 #endif /* !COMPLEX_FIELD_VALUES */
   }
 }
@@ -3212,6 +3917,9 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::INTERNAL_SCHEME_BASE ()
   , sourceWaveLength (0)
   , sourceWaveLengthNumerical (0)
   , sourceFrequency (0)
+  , incidentWavesCount (1)
+  , batchSize (1)
+  , activeLane (0)
   , courantNum (0)
   , gridStep (0)
   , gridTimeStep (0)
@@ -3220,6 +3928,20 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::INTERNAL_SCHEME_BASE ()
 #include "Callbacks.inc.h"
 #undef CALLBACK_NAME
 
+#ifndef GPU_INTERNAL_SCHEME
+  , MaterialIdsEx (NULLPTR)
+  , MaterialIdsEy (NULLPTR)
+  , MaterialIdsEz (NULLPTR)
+  , MaterialIdsHx (NULLPTR)
+  , MaterialIdsHy (NULLPTR)
+  , MaterialIdsHz (NULLPTR)
+  , IncidentEx (NULLPTR)
+  , IncidentEy (NULLPTR)
+  , IncidentEz (NULLPTR)
+  , IncidentHx (NULLPTR)
+  , IncidentHy (NULLPTR)
+  , IncidentHz (NULLPTR)
+#endif /* !GPU_INTERNAL_SCHEME */
 #ifdef GPU_INTERNAL_SCHEME
   , d_norm (NULLPTR)
 #endif /* GPU_INTERNAL_SCHEME */
@@ -3256,6 +3978,10 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::INTERNAL_SCHEME_BASE ()
 {
 }
 
+/**
+ * Perform time step for E auxiliary grids of incident waves. Auxiliary grids of all incident waves are stored one after
+ * another in EInc and are updated with the same loop, only relative phase velocities of waves differ.
+ */
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
 ICUDA_DEVICE
 void
@@ -3264,46 +3990,60 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::performPlaneWaveESteps (time_st
   ASSERT (end.get1 () > start.get1 ());
   ASSERT (end.get1 () <= EInc->getSize ().get1 ());
 
-  FPValue modifier = gridTimeStep / (relPhaseVelocity * PhysicsConst::Eps0 * gridStep);
-
-  grid_coord cstart = start.get1 ();
-  grid_coord cend = end.get1 ();
+  grid_coord waveSize = EInc->getSize ().get1 () / incidentWavesCount;
 
-  bool setSource = false;
-  if (cstart == 0)
+  for (int wave = 0; wave < incidentWavesCount; ++wave)
   {
-    setSource = true;
-    cstart = 1;
-  }
+    FPValue modifier = gridTimeStep / (getIncidentWaveRelPhaseVelocity (wave) * PhysicsConst::Eps0 * gridStep);
 
-  for (grid_coord i = cstart; i < cend; ++i)
-  {
-    FieldValue valE = *EInc->getFieldValue (i, 1);
-    FieldValue valH1 = *HInc->getFieldValue (i - 1, 1);
-    FieldValue valH2 = *HInc->getFieldValue (i, 1);
+    grid_coord waveStart = wave * waveSize;
+    grid_coord waveEnd = waveStart + waveSize;
 
-    FieldValue val = valE + (valH1 - valH2) * modifier;
-    EInc->setFieldValue (val, i, 0);
-  }
+    grid_coord cstart = start.get1 () > waveStart ? start.get1 () : waveStart;
+    grid_coord cend = end.get1 () < waveEnd ? end.get1 () : waveEnd;
 
-  if (setSource)
-  {
-    FPValue arg = gridTimeStep * t * 2 * PhysicsConst::Pi * sourceFrequency;
+    if (cstart >= cend)
+    {
+      continue;
+    }
+
+    bool setSource = false;
+    if (cstart == waveStart)
+    {
+      setSource = true;
+      cstart = waveStart + 1;
+    }
+
+    for (grid_coord i = cstart; i < cend; ++i)
+    {
+      FieldValue valE = *EInc->getFieldValue (i, 1);
+      FieldValue valH1 = *HInc->getFieldValue (i - 1, 1);
+      FieldValue valH2 = *HInc->getFieldValue (i, 1);
+
+      FieldValue val = valE + (valH1 - valH2) * modifier;
+      EInc->setFieldValue (val, i, 0);
+    }
+
+    if (setSource)
+    {
+      FPComputeValue arg = gridTimeStep * t * 2 * PhysicsConst::PiCompute * sourceFrequency;
 
 #ifdef COMPLEX_FIELD_VALUES
-    EInc->setFieldValue (FieldValue (sin (arg), cos (arg)), 0, 0);
+      EInc->setFieldValue (FieldValue (sin (arg), cos (arg)), waveStart, 0);
 #else /* COMPLEX_FIELD_VALUES */
-    EInc->setFieldValue (sin (arg), 0, 0);
+      EInc->setFieldValue (sin (arg), waveStart, 0);
 #endif /* !COMPLEX_FIELD_VALUES */
-
-    //printf ("EInc[0] %f \n", valE->getCurValue ());
-  }
+    }
 
 #ifdef ENABLE_ASSERTS
-  ALWAYS_ASSERT (*EInc->getFieldValue (EInc->getSize ().get1 () - 1, 0) == getFieldValueRealOnly (0.0));
+    ALWAYS_ASSERT (*EInc->getFieldValue (waveEnd - 1, 0) == getFieldValueRealOnly (0.0));
 #endif
+  }
 }
 
+/**
+ * Perform time step for H auxiliary grids of incident waves (see performPlaneWaveESteps)
+ */
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
 ICUDA_DEVICE
 void
@@ -3312,29 +4052,37 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::performPlaneWaveHSteps (time_st
   ASSERT (end.get1 () > start.get1 ());
   ASSERT (end.get1 () <= HInc->getSize ().get1 ());
 
-  FPValue modifier = gridTimeStep / (relPhaseVelocity * PhysicsConst::Mu0 * gridStep);
-
-  grid_coord cstart = start.get1 ();
-  grid_coord cend = end.get1 ();
+  grid_coord waveSize = HInc->getSize ().get1 () / incidentWavesCount;
 
-  if (cend == HInc->getSize ().get1 ())
+  for (int wave = 0; wave < incidentWavesCount; ++wave)
   {
-    cend--;
-  }
+    FPValue modifier = gridTimeStep / (getIncidentWaveRelPhaseVelocity (wave) * PhysicsConst::Mu0 * gridStep);
 
-  for (grid_coord i = cstart; i < cend; ++i)
-  {
-    FieldValue valH = *HInc->getFieldValue (i, 1);
-    FieldValue valE1 = *EInc->getFieldValue (i, 1);
-    FieldValue valE2 = *EInc->getFieldValue (i + 1, 1);
+    grid_coord waveStart = wave * waveSize;
+    grid_coord waveEnd = waveStart + waveSize;
 
-    FieldValue val = valH + (valE1 - valE2) * modifier;
-    HInc->setFieldValue (val, i, 0);
-  }
+    grid_coord cstart = start.get1 () > waveStart ? start.get1 () : waveStart;
+    grid_coord cend = end.get1 () < waveEnd ? end.get1 () : waveEnd;
+
+    if (cend == waveEnd)
+    {
+      cend--;
+    }
+
+    for (grid_coord i = cstart; i < cend; ++i)
+    {
+      FieldValue valH = *HInc->getFieldValue (i, 1);
+      FieldValue valE1 = *EInc->getFieldValue (i, 1);
+      FieldValue valE2 = *EInc->getFieldValue (i + 1, 1);
+
+      FieldValue val = valH + (valE1 - valE2) * modifier;
+      HInc->setFieldValue (val, i, 0);
+    }
 
 #ifdef ENABLE_ASSERTS
-  ALWAYS_ASSERT (*HInc->getFieldValue (HInc->getSize ().get1 () - 2, 0) == getFieldValueRealOnly (0.0));
+    ALWAYS_ASSERT (*HInc->getFieldValue (waveEnd - 2, 0) == getFieldValueRealOnly (0.0));
 #endif
+  }
 }
 
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
@@ -3358,6 +4106,20 @@ INTERNAL_SCHEME_BASE<Type, TCoord, layout_type>::initScheme (FPValue dx, FPValue
   relPhaseVelocity = phaseVelocity0 / phaseVelocity;
   sourceWaveLengthNumerical = 2 * PhysicsConst::Pi / k;
 
+#ifndef GPU_INTERNAL_SCHEME
+  incidentWaveRelPhaseVelocity.resize (incidentWavesCount);
+  incidentWaveRelPhaseVelocity[0] = relPhaseVelocity;
+  for (int wave = 1; wave < incidentWavesCount; ++wave)
+  {
+    FPValue incAngle1;
+    FPValue incAngle2;
+    FPValue incAngle3;
+    getIncidentWaveAngles (wave, incAngle1, incAngle2, incAngle3);
+
+    incidentWaveRelPhaseVelocity[wave] = phaseVelocity0 / Approximation::phaseVelocityIncidentWave (gridStep, sourceWaveLength, courantNum, N_lambda, incAngle1, incAngle2);
+  }
+#endif /* !GPU_INTERNAL_SCHEME */
+
   DPRINTF (LOG_LEVEL_STAGES_AND_DUMP, "initScheme: "
                                       "\n\tphase velocity relation -> %f "
                                       "\n\tphase velosity 0 -> %f "
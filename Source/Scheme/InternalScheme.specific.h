@@ -12,6 +12,20 @@ InternalScheme<Type, TCoord, layout_type>::~InternalScheme ()
     delete EInc;
     delete HInc;
   }
+
+  delete MaterialIdsEx;
+  delete MaterialIdsEy;
+  delete MaterialIdsEz;
+  delete MaterialIdsHx;
+  delete MaterialIdsHy;
+  delete MaterialIdsHz;
+
+  delete IncidentEx;
+  delete IncidentEy;
+  delete IncidentEz;
+  delete IncidentHx;
+  delete IncidentHy;
+  delete IncidentHz;
 }
 
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
@@ -41,11 +55,171 @@ InternalScheme<Type, TCoord, layout_type>::init (YeeGridLayout<Type, TCoord, lay
   if (SOLVER_SETTINGS.getDoUseTFSF ())
   {
     allocateGridsInc ();
+    initIncidentWaveTables ();
+  }
+
+  if (SOLVER_SETTINGS.getDoUseCaCbMaterialIds ())
+  {
+    allocateMaterialIdGrids ();
   }
 
   isInitialized = true;
 }
 
+/**
+ * Allocate grids of material identifiers with the same number of points as the corresponding field grids
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+CUDA_HOST
+void
+InternalScheme<Type, TCoord, layout_type>::allocateMaterialIdGrids ()
+{
+#define ALLOCATE_MATERIAL_IDS(x) \
+  MaterialIds ## x = doNeed ## x ? new MaterialIdGrid (x->getSize ().calculateTotalCoord ()) : NULLPTR;
+
+  ALLOCATE_MATERIAL_IDS (Ex)
+  ALLOCATE_MATERIAL_IDS (Ey)
+  ALLOCATE_MATERIAL_IDS (Ez)
+  ALLOCATE_MATERIAL_IDS (Hx)
+  ALLOCATE_MATERIAL_IDS (Hy)
+  ALLOCATE_MATERIAL_IDS (Hz)
+
+#undef ALLOCATE_MATERIAL_IDS
+}
+
+/**
+ * Set lane of all field grids, which is accessed by computations for separate points (see Grid::setActiveLane)
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+CUDA_HOST
+void
+InternalScheme<Type, TCoord, layout_type>::setActiveLane (int lane) /**< lane */
+{
+  ASSERT (lane >= 0 && lane < batchSize);
+
+  if (batchSize == 1)
+  {
+    return;
+  }
+
+  activeLane = lane;
+
+#define GRID_NAME(x) \
+  if (x != NULLPTR) \
+  { \
+    x->setActiveLane (lane); \
+  }
+#include "Grids.inc.h"
+#undef GRID_NAME
+}
+
+/**
+ * Get angles of incident wave (angles of wave with index k are angles of layout plus k angle steps)
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+CUDA_HOST
+void
+InternalScheme<Type, TCoord, layout_type>::getIncidentWaveAngles (int wave, /**< index of incident wave */
+                                                                  FPValue &incAngle1, /**< out: teta */
+                                                                  FPValue &incAngle2, /**< out: phi */
+                                                                  FPValue &incAngle3) const /**< out: psi */
+{
+  ASSERT (wave >= 0 && wave < incidentWavesCount);
+
+  incAngle1 = yeeLayout->getIncidentWaveAngle1 () + wave * SOLVER_SETTINGS.getIncidentWaveAngle1Step () * PhysicsConst::Pi / 180.0;
+  incAngle2 = yeeLayout->getIncidentWaveAngle2 () + wave * SOLVER_SETTINGS.getIncidentWaveAngle2Step () * PhysicsConst::Pi / 180.0;
+  incAngle3 = yeeLayout->getIncidentWaveAngle3 () + wave * SOLVER_SETTINGS.getIncidentWaveAngle3Step () * PhysicsConst::Pi / 180.0;
+}
+
+/**
+ * Precompute tables of projections of TF/SF incident waves for all field components, so that no trigonometry is
+ * performed for points of TF/SF border during time steps
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+CUDA_HOST
+void
+InternalScheme<Type, TCoord, layout_type>::initIncidentWaveTables ()
+{
+  grid_coord waveSize = EInc->getSize ().get1 () / incidentWavesCount;
+
+#define ALLOCATE_INCIDENT_WAVE_TABLE(NAME, SHIFT) \
+  if (doNeed ## NAME) \
+  { \
+    GridCoordinate3D size = expandTo3D (yeeLayout->get ## NAME ## Size (), ct1, ct2, ct3); \
+    Incident ## NAME = new IncidentWaveTable (GRID_COORDINATE_3D (std::max (size.get1 (), (grid_coord) 1), \
+                                                                  std::max (size.get2 (), (grid_coord) 1), \
+                                                                  std::max (size.get3 (), (grid_coord) 1), \
+                                                                  CoordinateType::X, CoordinateType::Y, CoordinateType::Z), \
+                                              FPValue (SHIFT), incidentWavesCount, waveSize); \
+  }
+
+  ALLOCATE_INCIDENT_WAVE_TABLE (Ex, 0.0)
+  ALLOCATE_INCIDENT_WAVE_TABLE (Ey, 0.0)
+  ALLOCATE_INCIDENT_WAVE_TABLE (Ez, 0.0)
+  ALLOCATE_INCIDENT_WAVE_TABLE (Hx, 0.5)
+  ALLOCATE_INCIDENT_WAVE_TABLE (Hy, 0.5)
+  ALLOCATE_INCIDENT_WAVE_TABLE (Hz, 0.5)
+
+#undef ALLOCATE_INCIDENT_WAVE_TABLE
+
+  for (int wave = 0; wave < incidentWavesCount; ++wave)
+  {
+    FPValue incAngle1;
+    FPValue incAngle2;
+    FPValue incAngle3;
+    getIncidentWaveAngles (wave, incAngle1, incAngle2, incAngle3);
+
+    /*
+     * Zero point of auxiliary grid and projections of incident wave on field components depend on angles of wave,
+     * so they are taken from layout with these angles
+     */
+    YeeGridLayout<Type, TCoord, layout_type> waveLayout (yeeLayout->getSize (),
+                                                         yeeLayout->getLeftBorderPML (),
+                                                         yeeLayout->getLeftBorderTFSF (),
+                                                         yeeLayout->getSize () - yeeLayout->getRightBorderTFSF (),
+                                                         incAngle1,
+                                                         incAngle2,
+                                                         incAngle3,
+                                                         yeeLayout->getIsDoubleMaterialPrecision ());
+
+    /*
+     * Contribution of each axis to distance is computed in the same way as in approximateIncidentWave
+     */
+    GridCoordinateFP3D zeroCoord = expandTo3D (waveLayout.getZeroIncCoordFP (), ct1, ct2, ct3);
+
+#define INIT_INCIDENT_WAVE_TABLE(NAME, FIELD) \
+    if (doNeed ## NAME) \
+    { \
+      GridCoordinate3D size = expandTo3D (yeeLayout->get ## NAME ## Size (), ct1, ct2, ct3); \
+      Incident ## NAME->setProjection (wave, getRealOnlyFromFieldValue (waveLayout.get ## NAME ## FromIncident ## FIELD (getFieldValueRealOnly (FPValue (1))))); \
+      for (grid_coord i = 0; i < size.get1 (); ++i) \
+      { \
+        GridCoordinateFP3D realCoord = expandTo3D (yeeLayout->get ## NAME ## CoordFP (TC::initAxesCoordinate (i, 0, 0, ct1, ct2, ct3)), ct1, ct2, ct3); \
+        Incident ## NAME->setOffset (wave, CoordinateType::X, i, (realCoord.get1 () - zeroCoord.get1 ()) * sin (incAngle1) * cos (incAngle2)); \
+      } \
+      for (grid_coord i = 0; i < size.get2 (); ++i) \
+      { \
+        GridCoordinateFP3D realCoord = expandTo3D (yeeLayout->get ## NAME ## CoordFP (TC::initAxesCoordinate (0, i, 0, ct1, ct2, ct3)), ct1, ct2, ct3); \
+        Incident ## NAME->setOffset (wave, CoordinateType::Y, i, (realCoord.get2 () - zeroCoord.get2 ()) * sin (incAngle1) * sin (incAngle2)); \
+      } \
+      for (grid_coord i = 0; i < size.get3 (); ++i) \
+      { \
+        GridCoordinateFP3D realCoord = expandTo3D (yeeLayout->get ## NAME ## CoordFP (TC::initAxesCoordinate (0, 0, i, ct1, ct2, ct3)), ct1, ct2, ct3); \
+        Incident ## NAME->setOffset (wave, CoordinateType::Z, i, (realCoord.get3 () - zeroCoord.get3 ()) * cos (incAngle1)); \
+      } \
+    }
+
+    INIT_INCIDENT_WAVE_TABLE (Ex, E)
+    INIT_INCIDENT_WAVE_TABLE (Ey, E)
+    INIT_INCIDENT_WAVE_TABLE (Ez, E)
+    INIT_INCIDENT_WAVE_TABLE (Hx, H)
+    INIT_INCIDENT_WAVE_TABLE (Hy, H)
+    INIT_INCIDENT_WAVE_TABLE (Hz, H)
+
+#undef INIT_INCIDENT_WAVE_TABLE
+  }
+}
+
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
 CUDA_HOST
 void
@@ -57,8 +231,7 @@ InternalSchemeHelper::allocateGrids (InternalScheme<Type, TCoord, layout_type> *
   typedef TCoord<FPValue, false> TCSFP;
 
   /*
-   * Minimum number of stores steps is 2.
-   * TODO: optimize to be able to allocate single step for non-PML modes.
+   * Minimum number of stores steps is 2, except for E and H grids, which could be updated in-place.
    */
   int storedSteps = 2;
 
@@ -67,6 +240,8 @@ InternalSchemeHelper::allocateGrids (InternalScheme<Type, TCoord, layout_type> *
     storedSteps = 3;
   }
 
+  int fieldStoredSteps = InternalSchemeHelper::doUpdateFieldsInPlace () ? 1 : storedSteps;
+
 #define GRID_NAME(x, y, steps, time_offset) \
   intScheme->x = intScheme->doNeed ## y ? new Grid<TC> (layout->get ## y ## Size (), steps, #x) : NULLPTR;
 #define GRID_NAME_NO_CHECK(x, y, steps, time_offset) \
@@ -74,6 +249,44 @@ InternalSchemeHelper::allocateGrids (InternalScheme<Type, TCoord, layout_type> *
 #include "Grids2.inc.h"
 #undef GRID_NAME
 #undef GRID_NAME_NO_CHECK
+
+  if (SOLVER_SETTINGS.getDoUseBatchedIncidentWaves ())
+  {
+    /*
+     * Each incident wave excites its own lane of field grids, while materials and coefficients are shared by lanes
+     */
+    intScheme->batchSize = SOLVER_SETTINGS.getIncidentWavesCount ();
+    ALWAYS_ASSERT (intScheme->batchSize > 0);
+
+#define BATCH_GRID(x) \
+  if (intScheme->x != NULLPTR) \
+  { \
+    intScheme->x->setBatchSize (intScheme->batchSize); \
+  }
+
+    BATCH_GRID (Ex)
+    BATCH_GRID (Ey)
+    BATCH_GRID (Ez)
+    BATCH_GRID (Hx)
+    BATCH_GRID (Hy)
+    BATCH_GRID (Hz)
+
+    BATCH_GRID (Dx)
+    BATCH_GRID (Dy)
+    BATCH_GRID (Dz)
+    BATCH_GRID (Bx)
+    BATCH_GRID (By)
+    BATCH_GRID (Bz)
+
+    BATCH_GRID (D1x)
+    BATCH_GRID (D1y)
+    BATCH_GRID (D1z)
+    BATCH_GRID (B1x)
+    BATCH_GRID (B1y)
+    BATCH_GRID (B1z)
+
+#undef BATCH_GRID
+  }
 }
 
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
@@ -81,9 +294,16 @@ CUDA_HOST
 void
 InternalSchemeHelper::allocateGridsInc (InternalScheme<Type, TCoord, layout_type> *intScheme, YeeGridLayout<Type, TCoord, layout_type> *layout)
 {
+  intScheme->incidentWavesCount = SOLVER_SETTINGS.getIncidentWavesCount ();
+  ALWAYS_ASSERT (intScheme->incidentWavesCount > 0);
+
+  /*
+   * Auxiliary grids of all incident waves are stored one after another
+   */
   // TODO: allocate considering number of time steps
-  intScheme->EInc = new Grid<GridCoordinate1D> (GRID_COORDINATE_1D (500*(layout->getSize ().get1 ()), CoordinateType::X), 2, "EInc");
-  intScheme->HInc = new Grid<GridCoordinate1D> (GRID_COORDINATE_1D (500*(layout->getSize ().get1 ()), CoordinateType::X), 2, "HInc");
+  grid_coord size = intScheme->incidentWavesCount * 500 * layout->getSize ().get1 ();
+  intScheme->EInc = new Grid<GridCoordinate1D> (GRID_COORDINATE_1D (size, CoordinateType::X), 2, "EInc");
+  intScheme->HInc = new Grid<GridCoordinate1D> (GRID_COORDINATE_1D (size, CoordinateType::X), 2, "HInc");
 }
 
 #ifdef PARALLEL_GRID
@@ -104,6 +324,7 @@ InternalSchemeHelper::allocateParallelGrids1D (InternalScheme<Type, GridCoordina
   ParallelYeeGridLayout<Type, layout_type> *pLayout = (ParallelYeeGridLayout<Type, layout_type> *) intScheme->yeeLayout;
 
   int storedSteps = 3;
+  int fieldStoredSteps = InternalSchemeHelper::doUpdateFieldsInPlace () ? 1 : storedSteps;
 
 #define GRID_NAME(x, y, steps, time_offset) \
   intScheme->x = intScheme->doNeed ## y ? new ParallelGrid (pLayout->get ## y ## Size (), bufSize, 1, pLayout->get ## y ## SizeForCurNode (), steps, time_offset, #x) : NULLPTR;
@@ -132,6 +353,7 @@ InternalSchemeHelper::allocateParallelGrids2D (InternalScheme<Type, GridCoordina
   ParallelYeeGridLayout<Type, layout_type> *pLayout = (ParallelYeeGridLayout<Type, layout_type> *) intScheme->yeeLayout;
 
   int storedSteps = 3;
+  int fieldStoredSteps = InternalSchemeHelper::doUpdateFieldsInPlace () ? 1 : storedSteps;
 
 #define GRID_NAME(x, y, steps, time_offset) \
   intScheme->x = intScheme->doNeed ## y ? new ParallelGrid (pLayout->get ## y ## Size (), bufSize, 1, pLayout->get ## y ## SizeForCurNode (), steps, time_offset, #x) : NULLPTR;
@@ -160,6 +382,7 @@ InternalSchemeHelper::allocateParallelGrids3D (InternalScheme<Type, GridCoordina
   ParallelYeeGridLayout<Type, layout_type> *pLayout = (ParallelYeeGridLayout<Type, layout_type> *) intScheme->yeeLayout;
 
   int storedSteps = 3;
+  int fieldStoredSteps = InternalSchemeHelper::doUpdateFieldsInPlace () ? 1 : storedSteps;
 
 #define GRID_NAME(x, y, steps, time_offset) \
   intScheme->x = intScheme->doNeed ## y ? new ParallelGrid (pLayout->get ## y ## Size (), bufSize, 1, pLayout->get ## y ## SizeForCurNode (), steps, time_offset, #x) : NULLPTR;
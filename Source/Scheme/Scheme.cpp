@@ -103,6 +103,41 @@ SPECIALIZE_TEMPLATE(void, void, void,
                      intScheme->getDoNeedHy (), intScheme->getDoNeedHy () ? intScheme->getHy () : NULLPTR, &totalHy,
                      intScheme->getDoNeedHz (), intScheme->getDoNeedHz () ? intScheme->getHz () : NULLPTR, &totalHz))
 
+SPECIALIZE_TEMPLATE(void, void, void,
+                    accessGridCollective,
+                    (Grid<GridCoordinate1D> *grid, const std::string &fileName, GridCoordinate1D start,
+                     GridCoordinate1D end, int time_step_back, bool isWrite),
+                    (Grid<GridCoordinate2D> *grid, const std::string &fileName, GridCoordinate2D start,
+                     GridCoordinate2D end, int time_step_back, bool isWrite),
+                    (Grid<GridCoordinate3D> *grid, const std::string &fileName, GridCoordinate3D start,
+                     GridCoordinate3D end, int time_step_back, bool isWrite),
+                    (grid, fileName, start, end, time_step_back, isWrite))
+
+SPECIALIZE_TEMPLATE(void, void, void,
+                    ntffAccumulate,
+                    (GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF, FieldValue phase, NTFFFace *faces),
+                    (GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF, FieldValue phase, NTFFFace *faces),
+                    (GridCoordinate3D leftNTFF, GridCoordinate3D rightNTFF, FieldValue phase, NTFFFace *faces),
+                    (leftNTFF, rightNTFF, yeeLayout, phase,
+                     intScheme->getEx (), intScheme->getEy (), intScheme->getEz (),
+                     intScheme->getHx (), intScheme->getHy (), intScheme->getHz (),
+                     faces))
+
+SPECIALIZE_TEMPLATE(void, void, void,
+                    ntffFarField,
+                    (const std::vector<FPValue> &anglesTeta, const std::vector<FPValue> &anglesPhi,
+                     GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF,
+                     const NTFFFace *faces, FPValue norm, std::vector<NPair> &N, std::vector<NPair> &L),
+                    (const std::vector<FPValue> &anglesTeta, const std::vector<FPValue> &anglesPhi,
+                     GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF,
+                     const NTFFFace *faces, FPValue norm, std::vector<NPair> &N, std::vector<NPair> &L),
+                    (const std::vector<FPValue> &anglesTeta, const std::vector<FPValue> &anglesPhi,
+                     GridCoordinate3D leftNTFF, GridCoordinate3D rightNTFF,
+                     const NTFFFace *faces, FPValue norm, std::vector<NPair> &N, std::vector<NPair> &L),
+                    (anglesTeta, anglesPhi, leftNTFF, rightNTFF, yeeLayout,
+                     intScheme->getGridStep (), intScheme->getSourceWaveLength (),
+                     faces, norm, N, L))
+
 #ifdef PARALLEL_GRID
 
 SPECIALIZE_TEMPLATE(void, void, void,
@@ -563,357 +598,3 @@ Scheme<static_cast<SchemeType_t> (SchemeType::Dim3), GridCoordinate3DTemplate, H
   SchemeHelper::performNSteps3D<static_cast<SchemeType_t> (SchemeType::Dim3), H_CENTERED> (this, tStart, N);
 }
 #endif /* MODE_DIM3 */
-
-/*
- * NTFF
- */
-#ifdef MODE_EX_HY
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_ExHy), GridCoordinate1DTemplate, E_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffN1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_ExHy), GridCoordinate1DTemplate, H_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffN1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_ExHy), GridCoordinate1DTemplate, E_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffL1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_ExHy), GridCoordinate1DTemplate, H_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffL1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-#endif /* MODE_EX_HY */
-
-#ifdef MODE_EX_HZ
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_ExHz), GridCoordinate1DTemplate, E_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffN1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_ExHz), GridCoordinate1DTemplate, H_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffN1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_ExHz), GridCoordinate1DTemplate, E_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffL1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_ExHz), GridCoordinate1DTemplate, H_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffL1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-#endif /* MODE_EX_HZ */
-
-#ifdef MODE_EY_HX
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_EyHx), GridCoordinate1DTemplate, E_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffN1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_EyHx), GridCoordinate1DTemplate, H_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffN1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_EyHx), GridCoordinate1DTemplate, E_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffL1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_EyHx), GridCoordinate1DTemplate, H_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffL1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-#endif /* MODE_EY_HX */
-
-#ifdef MODE_EY_HZ
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_EyHz), GridCoordinate1DTemplate, E_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffN1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_EyHz), GridCoordinate1DTemplate, H_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffN1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_EyHz), GridCoordinate1DTemplate, E_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffL1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_EyHz), GridCoordinate1DTemplate, H_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffL1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-#endif /* MODE_EY_HZ */
-
-#ifdef MODE_EZ_HX
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_EzHx), GridCoordinate1DTemplate, E_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffN1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_EzHx), GridCoordinate1DTemplate, H_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffN1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_EzHx), GridCoordinate1DTemplate, E_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffL1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_EzHx), GridCoordinate1DTemplate, H_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffL1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-#endif /* MODE_EZ_HX */
-
-#ifdef MODE_EZ_HY
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_EzHy), GridCoordinate1DTemplate, E_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffN1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_EzHy), GridCoordinate1DTemplate, H_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffN1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_EzHy), GridCoordinate1DTemplate, E_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffL1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim1_EzHy), GridCoordinate1DTemplate, H_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate1D> *curEx, Grid<GridCoordinate1D> *curEy, Grid<GridCoordinate1D> *curEz, Grid<GridCoordinate1D> *curHx, Grid<GridCoordinate1D> *curHy, Grid<GridCoordinate1D> *curHz, GridCoordinate1D leftNTFF, GridCoordinate1D rightNTFF)
-{
-  return SchemeHelper::ntffL1D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-#endif /* MODE_EZ_HY */
-
-#ifdef MODE_TEX
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TEx), GridCoordinate2DTemplate, E_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffN2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TEx), GridCoordinate2DTemplate, H_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffN2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TEx), GridCoordinate2DTemplate, E_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffL2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TEx), GridCoordinate2DTemplate, H_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffL2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-#endif /* MODE_TEX */
-
-#ifdef MODE_TEY
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TEy), GridCoordinate2DTemplate, E_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffN2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TEy), GridCoordinate2DTemplate, H_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffN2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TEy), GridCoordinate2DTemplate, E_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffL2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TEy), GridCoordinate2DTemplate, H_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffL2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-#endif /* MODE_TEY */
-
-#ifdef MODE_TEZ
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TEz), GridCoordinate2DTemplate, E_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffN2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TEz), GridCoordinate2DTemplate, H_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffN2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TEz), GridCoordinate2DTemplate, E_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffL2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TEz), GridCoordinate2DTemplate, H_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffL2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-#endif /* MODE_TEZ */
-
-#ifdef MODE_TMX
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TMx), GridCoordinate2DTemplate, E_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffN2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TMx), GridCoordinate2DTemplate, H_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffN2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TMx), GridCoordinate2DTemplate, E_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffL2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TMx), GridCoordinate2DTemplate, H_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffL2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-#endif /* MODE_TMX */
-
-#ifdef MODE_TMY
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TMy), GridCoordinate2DTemplate, E_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffN2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TMy), GridCoordinate2DTemplate, H_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffN2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TMy), GridCoordinate2DTemplate, E_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffL2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TMy), GridCoordinate2DTemplate, H_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffL2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-#endif /* MODE_TMY */
-
-#ifdef MODE_TMZ
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TMz), GridCoordinate2DTemplate, E_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffN2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TMz), GridCoordinate2DTemplate, H_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffN2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TMz), GridCoordinate2DTemplate, E_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffL2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim2_TMz), GridCoordinate2DTemplate, H_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate2D> *curEx, Grid<GridCoordinate2D> *curEy, Grid<GridCoordinate2D> *curEz, Grid<GridCoordinate2D> *curHx, Grid<GridCoordinate2D> *curHy, Grid<GridCoordinate2D> *curHz, GridCoordinate2D leftNTFF, GridCoordinate2D rightNTFF)
-{
-  return SchemeHelper::ntffL2D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-#endif /* MODE_TMZ */
-
-#ifdef MODE_DIM3
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim3), GridCoordinate3DTemplate, E_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate3D> *curEx, Grid<GridCoordinate3D> *curEy, Grid<GridCoordinate3D> *curEz, Grid<GridCoordinate3D> *curHx, Grid<GridCoordinate3D> *curHy, Grid<GridCoordinate3D> *curHz, GridCoordinate3D leftNTFF, GridCoordinate3D rightNTFF)
-{
-  return SchemeHelper::ntffN3D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim3), GridCoordinate3DTemplate, H_CENTERED>::ntffN (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate3D> *curEx, Grid<GridCoordinate3D> *curEy, Grid<GridCoordinate3D> *curEz, Grid<GridCoordinate3D> *curHx, Grid<GridCoordinate3D> *curHy, Grid<GridCoordinate3D> *curHz, GridCoordinate3D leftNTFF, GridCoordinate3D rightNTFF)
-{
-  return SchemeHelper::ntffN3D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim3), GridCoordinate3DTemplate, E_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate3D> *curEx, Grid<GridCoordinate3D> *curEy, Grid<GridCoordinate3D> *curEz, Grid<GridCoordinate3D> *curHx, Grid<GridCoordinate3D> *curHy, Grid<GridCoordinate3D> *curHz, GridCoordinate3D leftNTFF, GridCoordinate3D rightNTFF)
-{
-  return SchemeHelper::ntffL3D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-template <>
-NPair
-Scheme<static_cast<SchemeType_t> (SchemeType::Dim3), GridCoordinate3DTemplate, H_CENTERED>::ntffL (FPValue angleTeta, FPValue anglePhi, Grid<GridCoordinate3D> *curEx, Grid<GridCoordinate3D> *curEy, Grid<GridCoordinate3D> *curEz, Grid<GridCoordinate3D> *curHx, Grid<GridCoordinate3D> *curHy, Grid<GridCoordinate3D> *curHz, GridCoordinate3D leftNTFF, GridCoordinate3D rightNTFF)
-{
-  return SchemeHelper::ntffL3D (angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, intScheme->getGridStep (), intScheme->getSourceWaveLength (), curEx, curEy, curEz, curHx, curHy, curHz);
-}
-#endif /* MODE_DIM3 */
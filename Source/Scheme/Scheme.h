@@ -8,6 +8,7 @@
 #include "CallBack.h"
 #include "SchemeHelper.h"
 #include "InternalScheme.h"
+#include "Checkpoint.h"
 
 class SchemeHelper;
 
@@ -40,6 +41,12 @@ protected:
 #ifdef PARALLEL_GRID
   ParallelGridGroup *eGroup;
   ParallelGridGroup *hGroup;
+
+  /*
+   * Flags whether non-blocking share operations for E/H grids are in progress
+   */
+  bool isShareEPending;
+  bool isShareHPending;
 #endif /* PARALLEL_GRID */
 
 private:
@@ -79,23 +86,51 @@ private:
 
   YeeGridLayout<Type, TCoord, layout_type> *yeeLayout;
 
+  /**
+   * Running DFT of tangential fields on faces of NTFF boxes (NTFF_FACES_COUNT faces for each box), and number of time
+   * steps accumulated in it (see --ntff-running-dft)
+   */
+  std::vector<NTFFFace> ntffFaces;
+  time_step ntffRunningCount;
+
+  /**
+   * Writer of checkpoints (see --checkpoint-every), time step of the last checkpoint, which is being written, and
+   * time step of the last checkpoint, which is completely written by all processes (0 if there is none)
+   */
+  CheckpointWriter *checkpointWriter;
+  time_step checkpointPendingStep;
+  time_step checkpointCompleteStep;
+
+  /**
+   * Time step to start computations from (non-zero after restart from checkpoint)
+   */
+  time_step startTimeStep;
+
 private:
 
   void performNSteps (time_step tStart, time_step N);
   void performNStepsForBlock (time_step tStart, time_step N, TC blockIdx);
+  void performNStepsTemporalBlocking (time_step tStart, time_step N);
 
 #ifdef PARALLEL_GRID
   void tryShareE ();
   void tryShareH ();
   void shareE ();
   void shareH ();
+  void startShareE ();
+  void startShareH ();
+  void finishShareE ();
+  void finishShareH ();
+  void shareGridsE (void (ParallelGrid::*) ());
+  void shareGridsH (void (ParallelGrid::*) ());
 #endif /* PARALLEL_GRID */
 
-  void rebalance ();
+  void rebalance (time_step);
 
   void initCallBacks ();
   void initGrids ();
   void initBlocks (time_step t_total);
+  void checkTemporalBlocking ();
 
 #ifdef PARALLEL_GRID
   void initParallelBlocks ();
@@ -109,6 +144,18 @@ private:
 
   template <uint8_t grid_type>
   void performFieldSteps (time_step, TC, TC);
+  template <uint8_t grid_type>
+  void performFieldStepsInner (time_step, TC, TC);
+  template <uint8_t grid_type>
+  void performFieldStepsBorder (time_step, TC, TC);
+  template <uint8_t grid_type>
+  void performFieldStepsTile (time_step, TC, TC, grid_coord, grid_coord);
+  template <uint8_t grid_type>
+  void getComputationInnerChunk (TC, TC, GridCoordinate3D &, GridCoordinate3D &, GridCoordinate3D &, GridCoordinate3D &);
+  template <uint8_t grid_type>
+  void calculateFieldStepChunk (time_step, TC, TC);
+  template <uint8_t grid_type>
+  void performPointSourceStep (time_step);
 
   template <uint8_t grid_type, bool usePML, bool useMetamaterials>
   void calculateFieldStep (time_step, TC, TC);
@@ -117,8 +164,12 @@ private:
 
   void makeGridScattered (Grid<TC> *, GridType);
   void gatherFieldsTotal (bool);
+  void setActiveLane (int);
   void saveGrids (time_step);
   void saveNTFF (bool, time_step);
+  void saveNTFFOfLane (bool, time_step, int);
+  void getNTFFBox (grid_coord, TC &, TC &);
+  void accumulateNTFF (time_step);
 
   TC getStartCoord (GridType, TC);
   TC getEndCoord (GridType, TC);
@@ -137,11 +188,11 @@ private:
    * 3D ntff
    * TODO: add 1D,2D modes
    */
-  NPair ntffN (FPValue angleTeta, FPValue anglePhi, Grid<TC> *, Grid<TC> *, Grid<TC> *, Grid<TC> *, Grid<TC> *, Grid<TC> *, TC, TC);
-  NPair ntffL (FPValue angleTeta, FPValue anglePhi, Grid<TC> *, Grid<TC> *, Grid<TC> *, Grid<TC> *, Grid<TC> *, Grid<TC> *, TC, TC);
+  void ntffAccumulate (TC, TC, FieldValue, NTFFFace *);
+  void ntffFarField (const std::vector<FPValue> &, const std::vector<FPValue> &, TC, TC, const NTFFFace *, FPValue,
+                     std::vector<NPair> &, std::vector<NPair> &);
 
-  FPValue Pointing_scat (FPValue angleTeta, FPValue anglePhi, Grid<TC> *, Grid<TC> *, Grid<TC> *, Grid<TC> *,
-                         Grid<TC> *, Grid<TC> *, TC, TC);
+  void Pointing_scat (const std::vector<NPair> &, const std::vector<NPair> &, std::vector<FPValue> &);
   FPValue Pointing_inc (FPValue angleTeta, FPValue anglePhi);
 
   void performCudaSteps ();
@@ -149,6 +200,27 @@ private:
   void initFullMaterialGrids ();
   void initFullFieldGrids ();
 
+  void accessGridCollective (Grid<TC> *, const std::string &, TC, TC, int, bool);
+  void dumpGridCollective (Grid<TC> *, TC, TC, time_step, int);
+
+  void shareMaterialsOnNode ();
+
+  void accessCheckpointBlock (const std::string &, void *, uint64_t, CheckpointReader *);
+  template <typename TGridCoord>
+  void accessCheckpointGrid (Grid<TGridCoord> *, CheckpointReader *);
+  void accessCheckpoint (CheckpointReader *);
+  void saveCheckpoint (time_step);
+  void commitCheckpoint ();
+  void loadCheckpoint ();
+
+  /**
+   * Whether .dat files of parallel grids are saved/loaded with collective MPI-IO, without gathering of full grids
+   */
+  bool getDoUseCollectiveDATIO () const
+  {
+    return useParallel && SOLVER_SETTINGS.getDoUseCollectiveDATIO ();
+  }
+
 public:
 
   /**
@@ -161,15 +233,33 @@ public:
      *
      * For non-Cuda solver (both sequential and parallel), NTimeSteps == 1
      * For Cuda solver, NTimeSteps == bufSize - 1
+     * For temporal blocking, NTimeSteps == number of time steps performed for tile
      */
-    if (!SOLVER_SETTINGS.getDoUseCuda ())
+    if (!SOLVER_SETTINGS.getDoUseCuda ()
+        && !SOLVER_SETTINGS.getDoUseTemporalBlocking ())
     {
       ASSERT (NTimeSteps == 1);
     }
 
-    for (time_step t = 0; t < totalTimeSteps; t += NTimeSteps)
+    for (time_step t = startTimeStep; t < totalTimeSteps; t += NTimeSteps)
+    {
+      time_step N = NTimeSteps;
+
+      /*
+       * With temporal blocking last block of time steps might be shorter
+       */
+      if (SOLVER_SETTINGS.getDoUseTemporalBlocking ()
+          && t + N > totalTimeSteps)
+      {
+        N = totalTimeSteps - t;
+      }
+
+      performNSteps (t, N);
+    }
+
+    if (checkpointWriter != NULLPTR)
     {
-      performNSteps (t, NTimeSteps);
+      commitCheckpoint ();
     }
 
     if (SOLVER_SETTINGS.getDoSaveRes ())
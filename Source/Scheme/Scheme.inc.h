@@ -11,6 +11,12 @@ Scheme<Type, TCoord, layout_type>::performNStepsForBlock (time_step tStart, /**<
                                                           time_step N, /**< number of time steps to compute */
                                                           TC blockIdx) /**< index of block, for which computations are to be performed */
 {
+  if (SOLVER_SETTINGS.getDoUseTemporalBlocking ())
+  {
+    performNStepsTemporalBlocking (tStart, N);
+    return;
+  }
+
   int processId = 0;
 
   if (useParallel)
@@ -123,19 +129,61 @@ Scheme<Type, TCoord, layout_type>::performNStepsForBlock (time_step tStart, /**<
 #endif
     }
 
-    if (intScheme->getDoNeedEx ())
+#ifdef PARALLEL_GRID
+    if (isShareHPending)
     {
-      performFieldSteps<static_cast<uint8_t> (GridType::EX)> (t, ExStart, ExEnd);
-    }
+      /*
+       * Inner parts of E grids do not depend on values of H in buffers, so they are computed while H is shared
+       */
+      if (intScheme->getDoNeedEx ())
+      {
+        performFieldStepsInner<static_cast<uint8_t> (GridType::EX)> (t, ExStart, ExEnd);
+      }
 
-    if (intScheme->getDoNeedEy ())
-    {
-      performFieldSteps<static_cast<uint8_t> (GridType::EY)> (t, EyStart, EyEnd);
-    }
+      if (intScheme->getDoNeedEy ())
+      {
+        performFieldStepsInner<static_cast<uint8_t> (GridType::EY)> (t, EyStart, EyEnd);
+      }
 
-    if (intScheme->getDoNeedEz ())
+      if (intScheme->getDoNeedEz ())
+      {
+        performFieldStepsInner<static_cast<uint8_t> (GridType::EZ)> (t, EzStart, EzEnd);
+      }
+
+      finishShareH ();
+
+      if (intScheme->getDoNeedEx ())
+      {
+        performFieldStepsBorder<static_cast<uint8_t> (GridType::EX)> (t, ExStart, ExEnd);
+      }
+
+      if (intScheme->getDoNeedEy ())
+      {
+        performFieldStepsBorder<static_cast<uint8_t> (GridType::EY)> (t, EyStart, EyEnd);
+      }
+
+      if (intScheme->getDoNeedEz ())
+      {
+        performFieldStepsBorder<static_cast<uint8_t> (GridType::EZ)> (t, EzStart, EzEnd);
+      }
+    }
+    else
+#endif /* PARALLEL_GRID */
     {
-      performFieldSteps<static_cast<uint8_t> (GridType::EZ)> (t, EzStart, EzEnd);
+      if (intScheme->getDoNeedEx ())
+      {
+        performFieldSteps<static_cast<uint8_t> (GridType::EX)> (t, ExStart, ExEnd);
+      }
+
+      if (intScheme->getDoNeedEy ())
+      {
+        performFieldSteps<static_cast<uint8_t> (GridType::EY)> (t, EyStart, EyEnd);
+      }
+
+      if (intScheme->getDoNeedEz ())
+      {
+        performFieldSteps<static_cast<uint8_t> (GridType::EZ)> (t, EzStart, EzEnd);
+      }
     }
 
     if (useParallel && SOLVER_SETTINGS.getDoUseDynamicGrid ())
@@ -295,19 +343,61 @@ Scheme<Type, TCoord, layout_type>::performNStepsForBlock (time_step tStart, /**<
 #endif
     }
 
-    if (intScheme->getDoNeedHx ())
+#ifdef PARALLEL_GRID
+    if (isShareEPending)
     {
-      performFieldSteps<static_cast<uint8_t> (GridType::HX)> (t, HxStart, HxEnd);
-    }
+      /*
+       * Inner parts of H grids do not depend on values of E in buffers, so they are computed while E is shared
+       */
+      if (intScheme->getDoNeedHx ())
+      {
+        performFieldStepsInner<static_cast<uint8_t> (GridType::HX)> (t, HxStart, HxEnd);
+      }
 
-    if (intScheme->getDoNeedHy ())
-    {
-      performFieldSteps<static_cast<uint8_t> (GridType::HY)> (t, HyStart, HyEnd);
-    }
+      if (intScheme->getDoNeedHy ())
+      {
+        performFieldStepsInner<static_cast<uint8_t> (GridType::HY)> (t, HyStart, HyEnd);
+      }
 
-    if (intScheme->getDoNeedHz ())
+      if (intScheme->getDoNeedHz ())
+      {
+        performFieldStepsInner<static_cast<uint8_t> (GridType::HZ)> (t, HzStart, HzEnd);
+      }
+
+      finishShareE ();
+
+      if (intScheme->getDoNeedHx ())
+      {
+        performFieldStepsBorder<static_cast<uint8_t> (GridType::HX)> (t, HxStart, HxEnd);
+      }
+
+      if (intScheme->getDoNeedHy ())
+      {
+        performFieldStepsBorder<static_cast<uint8_t> (GridType::HY)> (t, HyStart, HyEnd);
+      }
+
+      if (intScheme->getDoNeedHz ())
+      {
+        performFieldStepsBorder<static_cast<uint8_t> (GridType::HZ)> (t, HzStart, HzEnd);
+      }
+    }
+    else
+#endif /* PARALLEL_GRID */
     {
-      performFieldSteps<static_cast<uint8_t> (GridType::HZ)> (t, HzStart, HzEnd);
+      if (intScheme->getDoNeedHx ())
+      {
+        performFieldSteps<static_cast<uint8_t> (GridType::HX)> (t, HxStart, HxEnd);
+      }
+
+      if (intScheme->getDoNeedHy ())
+      {
+        performFieldSteps<static_cast<uint8_t> (GridType::HY)> (t, HyStart, HyEnd);
+      }
+
+      if (intScheme->getDoNeedHz ())
+      {
+        performFieldSteps<static_cast<uint8_t> (GridType::HZ)> (t, HzStart, HzEnd);
+      }
     }
 
     if (useParallel && SOLVER_SETTINGS.getDoUseDynamicGrid ())
@@ -438,6 +528,13 @@ Scheme<Type, TCoord, layout_type>::performNStepsForBlock (time_step tStart, /**<
 #endif /* PARALLEL_GRID */
   }
 
+#ifdef PARALLEL_GRID
+  /*
+   * Values in buffers are required after computations for block (e.g. for dump of grids)
+   */
+  finishShareH ();
+#endif /* PARALLEL_GRID */
+
 #ifdef CUDA_ENABLED
   if (SOLVER_SETTINGS.getDoUseCuda ()
       && SOLVER_SETTINGS.getIndexOfGPUForCurrentNode () != NO_GPU)
@@ -452,6 +549,97 @@ Scheme<Type, TCoord, layout_type>::performNStepsForBlock (time_step tStart, /**<
 #endif /* CUDA_ENABLED */
 }
 
+/**
+ * Perform computation of N steps with temporal blocking. Grid is split in tiles by first axis (i.e. in slabs, which are
+ * contiguous in memory), and all N time steps are performed for tile before moving to the next one, so that values of
+ * tile are reused from cache between time steps.
+ *
+ * Computation of E (H) point depends only on neighboring points of H (E) at previous half step, so tile is shifted back
+ * by one point by first axis for each half step. This way all values, which are required for computations in tile, are
+ * already computed by previous tiles or by previous half steps in this tile, and values, which are required for next
+ * tiles, are not overwritten yet. Result is identical to the one of Scheme::performNStepsForBlock.
+ *
+ * NOTE: E and H grids should be updated in-place, see Scheme::checkTemporalBlocking.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::performNStepsTemporalBlocking (time_step tStart, /**< start time step */
+                                                                  time_step N) /**< number of time steps to compute */
+{
+  DPRINTF (LOG_LEVEL_STAGES, "Calculating time steps %u-%u with temporal blocking...\n", tStart, tStart + N - 1);
+
+  TC ExStart = intScheme->getDoNeedEx () ? intScheme->getEx ()->getComputationStart (yeeLayout->getExStartDiff ()) : TC_COORD (0, 0, 0, ct1, ct2, ct3);
+  TC ExEnd = intScheme->getDoNeedEx () ? intScheme->getEx ()->getComputationEnd (yeeLayout->getExEndDiff ()) : TC_COORD (0, 0, 0, ct1, ct2, ct3);
+
+  TC EyStart = intScheme->getDoNeedEy () ? intScheme->getEy ()->getComputationStart (yeeLayout->getEyStartDiff ()) : TC_COORD (0, 0, 0, ct1, ct2, ct3);
+  TC EyEnd = intScheme->getDoNeedEy () ? intScheme->getEy ()->getComputationEnd (yeeLayout->getEyEndDiff ()) : TC_COORD (0, 0, 0, ct1, ct2, ct3);
+
+  TC EzStart = intScheme->getDoNeedEz () ? intScheme->getEz ()->getComputationStart (yeeLayout->getEzStartDiff ()) : TC_COORD (0, 0, 0, ct1, ct2, ct3);
+  TC EzEnd = intScheme->getDoNeedEz () ? intScheme->getEz ()->getComputationEnd (yeeLayout->getEzEndDiff ()) : TC_COORD (0, 0, 0, ct1, ct2, ct3);
+
+  TC HxStart = intScheme->getDoNeedHx () ? intScheme->getHx ()->getComputationStart (yeeLayout->getHxStartDiff ()) : TC_COORD (0, 0, 0, ct1, ct2, ct3);
+  TC HxEnd = intScheme->getDoNeedHx () ? intScheme->getHx ()->getComputationEnd (yeeLayout->getHxEndDiff ()) : TC_COORD (0, 0, 0, ct1, ct2, ct3);
+
+  TC HyStart = intScheme->getDoNeedHy () ? intScheme->getHy ()->getComputationStart (yeeLayout->getHyStartDiff ()) : TC_COORD (0, 0, 0, ct1, ct2, ct3);
+  TC HyEnd = intScheme->getDoNeedHy () ? intScheme->getHy ()->getComputationEnd (yeeLayout->getHyEndDiff ()) : TC_COORD (0, 0, 0, ct1, ct2, ct3);
+
+  TC HzStart = intScheme->getDoNeedHz () ? intScheme->getHz ()->getComputationStart (yeeLayout->getHzStartDiff ()) : TC_COORD (0, 0, 0, ct1, ct2, ct3);
+  TC HzEnd = intScheme->getDoNeedHz () ? intScheme->getHz ()->getComputationEnd (yeeLayout->getHzEndDiff ()) : TC_COORD (0, 0, 0, ct1, ct2, ct3);
+
+  grid_coord size1 = expandTo3D (yeeLayout->getSize (), ct1, ct2, ct3).get1 ();
+  grid_coord tileSize = SOLVER_SETTINGS.getTemporalBlockingTileSize ();
+  grid_coord halfSteps = (grid_coord) (2 * N);
+
+  /*
+   * Last half step of last tile should cover the whole grid
+   */
+  for (grid_coord tileStart = 0; tileStart < size1 + halfSteps - 1; tileStart += tileSize)
+  {
+    grid_coord tileEnd = tileStart + tileSize;
+
+    for (time_step t = tStart; t < tStart + N; ++t)
+    {
+      grid_coord shift = (grid_coord) (2 * (t - tStart));
+
+      if (intScheme->getDoNeedEx ())
+      {
+        performFieldStepsTile<static_cast<uint8_t> (GridType::EX)> (t, ExStart, ExEnd, tileStart - shift, tileEnd - shift);
+      }
+
+      if (intScheme->getDoNeedEy ())
+      {
+        performFieldStepsTile<static_cast<uint8_t> (GridType::EY)> (t, EyStart, EyEnd, tileStart - shift, tileEnd - shift);
+      }
+
+      if (intScheme->getDoNeedEz ())
+      {
+        performFieldStepsTile<static_cast<uint8_t> (GridType::EZ)> (t, EzStart, EzEnd, tileStart - shift, tileEnd - shift);
+      }
+
+      ++shift;
+
+      if (intScheme->getDoNeedHx ())
+      {
+        performFieldStepsTile<static_cast<uint8_t> (GridType::HX)> (t, HxStart, HxEnd, tileStart - shift, tileEnd - shift);
+      }
+
+      if (intScheme->getDoNeedHy ())
+      {
+        performFieldStepsTile<static_cast<uint8_t> (GridType::HY)> (t, HyStart, HyEnd, tileStart - shift, tileEnd - shift);
+      }
+
+      if (intScheme->getDoNeedHz ())
+      {
+        performFieldStepsTile<static_cast<uint8_t> (GridType::HZ)> (t, HzStart, HzEnd, tileStart - shift, tileEnd - shift);
+      }
+    }
+  }
+
+  /*
+   * E and H grids store single time step, so there is no need to shift them in time
+   */
+}
+
 #ifdef PARALLEL_GRID
 /**
  * Perform share operations with checks
@@ -471,7 +659,14 @@ Scheme<Type, TCoord, layout_type>::tryShareE ()
   {
     ASSERT (eGroup->getShareStep () == NTimeSteps);
 
-    shareE ();
+    if (SOLVER_SETTINGS.getDoUseAsyncShare ())
+    {
+      startShareE ();
+    }
+    else
+    {
+      shareE ();
+    }
   }
 }
 
@@ -493,12 +688,19 @@ Scheme<Type, TCoord, layout_type>::tryShareH ()
   {
     ASSERT (hGroup->getShareStep () == NTimeSteps);
 
-    shareH ();
+    if (SOLVER_SETTINGS.getDoUseAsyncShare ())
+    {
+      startShareH ();
+    }
+    else
+    {
+      shareH ();
+    }
   }
 }
 
 /**
- * Perform share operations, required for grids
+ * Perform share operations for E grids
  */
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
 void
@@ -509,51 +711,100 @@ Scheme<Type, TCoord, layout_type>::shareE ()
     return;
   }
 
+  shareGridsE (&ParallelGrid::share);
+
+  eGroup->zeroShareStep ();
+}
+
+/**
+ * Start non-blocking share operations for E grids, which are finished in Scheme::finishShareE
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::startShareE ()
+{
+  if (!useParallel)
+  {
+    return;
+  }
+
+  ASSERT (!isShareEPending);
+
+  shareGridsE (&ParallelGrid::startShare);
+  isShareEPending = true;
+
+  eGroup->zeroShareStep ();
+}
+
+/**
+ * Finish non-blocking share operations for E grids, if they are in progress
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::finishShareE ()
+{
+  if (!isShareEPending)
+  {
+    return;
+  }
+
+  shareGridsE (&ParallelGrid::finishShare);
+  isShareEPending = false;
+}
+
+/**
+ * Call share method for all E grids
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::shareGridsE (void (ParallelGrid::*shareFunc) ()) /**< share method */
+{
   if (intScheme->getDoNeedEx ())
   {
-    ((ParallelGrid *) intScheme->getEx ())->share ();
+    (((ParallelGrid *) intScheme->getEx ())->*shareFunc) ();
 
     if (SOLVER_SETTINGS.getDoUsePML ())
     {
-      ((ParallelGrid *) intScheme->getDx ())->share ();
+      (((ParallelGrid *) intScheme->getDx ())->*shareFunc) ();
     }
     if (SOLVER_SETTINGS.getDoUseMetamaterials ())
     {
-      ((ParallelGrid *) intScheme->getD1x ())->share ();
+      (((ParallelGrid *) intScheme->getD1x ())->*shareFunc) ();
     }
   }
 
   if (intScheme->getDoNeedEy ())
   {
-    ((ParallelGrid *) intScheme->getEy ())->share ();
+    (((ParallelGrid *) intScheme->getEy ())->*shareFunc) ();
 
     if (SOLVER_SETTINGS.getDoUsePML ())
     {
-      ((ParallelGrid *) intScheme->getDy ())->share ();
+      (((ParallelGrid *) intScheme->getDy ())->*shareFunc) ();
     }
     if (SOLVER_SETTINGS.getDoUseMetamaterials ())
     {
-      ((ParallelGrid *) intScheme->getD1y ())->share ();
+      (((ParallelGrid *) intScheme->getD1y ())->*shareFunc) ();
     }
   }
 
   if (intScheme->getDoNeedEz ())
   {
-    ((ParallelGrid *) intScheme->getEz ())->share ();
+    (((ParallelGrid *) intScheme->getEz ())->*shareFunc) ();
 
     if (SOLVER_SETTINGS.getDoUsePML ())
     {
-      ((ParallelGrid *) intScheme->getDz ())->share ();
+      (((ParallelGrid *) intScheme->getDz ())->*shareFunc) ();
     }
     if (SOLVER_SETTINGS.getDoUseMetamaterials ())
     {
-      ((ParallelGrid *) intScheme->getD1z ())->share ();
+      (((ParallelGrid *) intScheme->getD1z ())->*shareFunc) ();
     }
   }
-
-  eGroup->zeroShareStep ();
 }
 
+/**
+ * Perform share operations for H grids
+ */
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
 void
 Scheme<Type, TCoord, layout_type>::shareH ()
@@ -563,235 +814,433 @@ Scheme<Type, TCoord, layout_type>::shareH ()
     return;
   }
 
+  shareGridsH (&ParallelGrid::share);
+
+  hGroup->zeroShareStep ();
+}
+
+/**
+ * Start non-blocking share operations for H grids, which are finished in Scheme::finishShareH
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::startShareH ()
+{
+  if (!useParallel)
+  {
+    return;
+  }
+
+  ASSERT (!isShareHPending);
+
+  shareGridsH (&ParallelGrid::startShare);
+  isShareHPending = true;
+
+  hGroup->zeroShareStep ();
+}
+
+/**
+ * Finish non-blocking share operations for H grids, if they are in progress
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::finishShareH ()
+{
+  if (!isShareHPending)
+  {
+    return;
+  }
+
+  shareGridsH (&ParallelGrid::finishShare);
+  isShareHPending = false;
+}
+
+/**
+ * Call share method for all H grids
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::shareGridsH (void (ParallelGrid::*shareFunc) ()) /**< share method */
+{
   if (intScheme->getDoNeedHx ())
   {
-    ((ParallelGrid *) intScheme->getHx ())->share ();
+    (((ParallelGrid *) intScheme->getHx ())->*shareFunc) ();
 
     if (SOLVER_SETTINGS.getDoUsePML ())
     {
-      ((ParallelGrid *) intScheme->getBx ())->share ();
+      (((ParallelGrid *) intScheme->getBx ())->*shareFunc) ();
     }
     if (SOLVER_SETTINGS.getDoUseMetamaterials ())
     {
-      ((ParallelGrid *) intScheme->getB1x ())->share ();
+      (((ParallelGrid *) intScheme->getB1x ())->*shareFunc) ();
     }
   }
 
   if (intScheme->getDoNeedHy ())
   {
-    ((ParallelGrid *) intScheme->getHy ())->share ();
+    (((ParallelGrid *) intScheme->getHy ())->*shareFunc) ();
 
     if (SOLVER_SETTINGS.getDoUsePML ())
     {
-      ((ParallelGrid *) intScheme->getBy ())->share ();
+      (((ParallelGrid *) intScheme->getBy ())->*shareFunc) ();
     }
     if (SOLVER_SETTINGS.getDoUseMetamaterials ())
     {
-      ((ParallelGrid *) intScheme->getB1y ())->share ();
+      (((ParallelGrid *) intScheme->getB1y ())->*shareFunc) ();
     }
   }
 
   if (intScheme->getDoNeedHz ())
   {
-    ((ParallelGrid *) intScheme->getHz ())->share ();
+    (((ParallelGrid *) intScheme->getHz ())->*shareFunc) ();
 
     if (SOLVER_SETTINGS.getDoUsePML ())
     {
-      ((ParallelGrid *) intScheme->getBz ())->share ();
+      (((ParallelGrid *) intScheme->getBz ())->*shareFunc) ();
     }
     if (SOLVER_SETTINGS.getDoUseMetamaterials ())
     {
-      ((ParallelGrid *) intScheme->getB1z ())->share ();
+      (((ParallelGrid *) intScheme->getB1z ())->*shareFunc) ();
     }
   }
-
-  hGroup->zeroShareStep ();
 }
 #endif /* PARALLEL_GRID */
 
 /**
- * Perform balancing operations
+ * Perform balancing operations: every --rebalance-step time steps chunks of computational nodes are resized according
+ * to measured performance of nodes and values of all parallel grids are migrated to new chunks
  *
  * NOTE: this should be non-empty basically for ParallelGrids only
  */
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
 void
-Scheme<Type, TCoord, layout_type>::rebalance ()
-{
-  // if (useParallel && SOLVER_SETTINGS.getDoUseDynamicGrid ())
-  // {
-  // #if defined (PARALLEL_GRID) && defined (DYNAMIC_GRID)
-  //   //if (false && t % SOLVER_SETTINGS.getRebalanceStep () == 0)
-  //   if (t % diffT == 0 && t > 0)
-  //   {
-  //     if (ParallelGrid::getParallelCore ()->getProcessId () == 0)
-  //     {
-  //       DPRINTF (LOG_LEVEL_STAGES, "Try rebalance on step %u, steps elapsed after previous %u\n", t, diffT);
-  //     }
-  //
-  //     ASSERT (isParallelLayout);
-  //
-  //     ParallelYeeGridLayout<Type, layout_type> *parallelYeeLayout = (ParallelYeeGridLayout<Type, layout_type> *) yeeLayout;
-  //
-  //     if (parallelYeeLayout->Rebalance (diffT))
-  //     {
-  //       DPRINTF (LOG_LEVEL_STAGES_AND_DUMP, "Rebalancing for process %d!\n", ParallelGrid::getParallelCore ()->getProcessId ());
-  //
-  //       ((ParallelGrid *) internalScheme.Eps)->Resize (parallelYeeLayout->getEpsSizeForCurNode ());
-  //       ((ParallelGrid *) internalScheme.Mu)->Resize (parallelYeeLayout->getMuSizeForCurNode ());
-  //
-  //       if (internalScheme.doNeedEx)
-  //       {
-  //         ((ParallelGrid *) internalScheme.Ex)->Resize (parallelYeeLayout->getExSizeForCurNode ());
-  //       }
-  //       if (internalScheme.doNeedEy)
-  //       {
-  //         ((ParallelGrid *) internalScheme.Ey)->Resize (parallelYeeLayout->getEySizeForCurNode ());
-  //       }
-  //       if (internalScheme.doNeedEz)
-  //       {
-  //         ((ParallelGrid *) internalScheme.Ez)->Resize (parallelYeeLayout->getEzSizeForCurNode ());
-  //       }
-  //
-  //       if (internalScheme.doNeedHx)
-  //       {
-  //         ((ParallelGrid *) internalScheme.Hx)->Resize (parallelYeeLayout->getHxSizeForCurNode ());
-  //       }
-  //       if (internalScheme.doNeedHy)
-  //       {
-  //         ((ParallelGrid *) internalScheme.Hy)->Resize (parallelYeeLayout->getHySizeForCurNode ());
-  //       }
-  //       if (internalScheme.doNeedHz)
-  //       {
-  //         ((ParallelGrid *) internalScheme.Hz)->Resize (parallelYeeLayout->getHzSizeForCurNode ());
-  //       }
-  //
-  //       if (SOLVER_SETTINGS.getDoUsePML ())
-  //       {
-  //         if (internalScheme.doNeedEx)
-  //         {
-  //           ((ParallelGrid *) internalScheme.Dx)->Resize (parallelYeeLayout->getExSizeForCurNode ());
-  //         }
-  //         if (internalScheme.doNeedEy)
-  //         {
-  //           ((ParallelGrid *) internalScheme.Dy)->Resize (parallelYeeLayout->getEySizeForCurNode ());
-  //         }
-  //         if (internalScheme.doNeedEz)
-  //         {
-  //           ((ParallelGrid *) internalScheme.Dz)->Resize (parallelYeeLayout->getEzSizeForCurNode ());
-  //         }
-  //
-  //         if (internalScheme.doNeedHx)
-  //         {
-  //           ((ParallelGrid *) internalScheme.Bx)->Resize (parallelYeeLayout->getHxSizeForCurNode ());
-  //         }
-  //         if (internalScheme.doNeedHy)
-  //         {
-  //           ((ParallelGrid *) internalScheme.By)->Resize (parallelYeeLayout->getHySizeForCurNode ());
-  //         }
-  //         if (internalScheme.doNeedHz)
-  //         {
-  //           ((ParallelGrid *) internalScheme.Bz)->Resize (parallelYeeLayout->getHzSizeForCurNode ());
-  //         }
-  //
-  //         if (SOLVER_SETTINGS.getDoUseMetamaterials ())
-  //         {
-  //           if (internalScheme.doNeedEx)
-  //           {
-  //             ((ParallelGrid *) internalScheme.D1x)->Resize (parallelYeeLayout->getExSizeForCurNode ());
-  //           }
-  //           if (internalScheme.doNeedEy)
-  //           {
-  //             ((ParallelGrid *) internalScheme.D1y)->Resize (parallelYeeLayout->getEySizeForCurNode ());
-  //           }
-  //           if (internalScheme.doNeedEz)
-  //           {
-  //             ((ParallelGrid *) internalScheme.D1z)->Resize (parallelYeeLayout->getEzSizeForCurNode ());
-  //           }
-  //
-  //           if (internalScheme.doNeedHx)
-  //           {
-  //             ((ParallelGrid *) internalScheme.B1x)->Resize (parallelYeeLayout->getHxSizeForCurNode ());
-  //           }
-  //           if (internalScheme.doNeedHy)
-  //           {
-  //             ((ParallelGrid *) internalScheme.B1y)->Resize (parallelYeeLayout->getHySizeForCurNode ());
-  //           }
-  //           if (internalScheme.doNeedHz)
-  //           {
-  //             ((ParallelGrid *) internalScheme.B1z)->Resize (parallelYeeLayout->getHzSizeForCurNode ());
-  //           }
-  //         }
-  //
-  //         if (internalScheme.doNeedSigmaX)
-  //         {
-  //           ((ParallelGrid *) internalScheme.SigmaX)->Resize (parallelYeeLayout->getEpsSizeForCurNode ());
-  //         }
-  //         if (internalScheme.doNeedSigmaY)
-  //         {
-  //           ((ParallelGrid *) internalScheme.SigmaY)->Resize (parallelYeeLayout->getEpsSizeForCurNode ());
-  //         }
-  //         if (internalScheme.doNeedSigmaZ)
-  //         {
-  //           ((ParallelGrid *) internalScheme.SigmaZ)->Resize (parallelYeeLayout->getEpsSizeForCurNode ());
-  //         }
-  //       }
-  //
-  //       if (SOLVER_SETTINGS.getDoUseMetamaterials ())
-  //       {
-  //         ((ParallelGrid *) internalScheme.OmegaPE)->Resize (parallelYeeLayout->getEpsSizeForCurNode ());
-  //         ((ParallelGrid *) internalScheme.GammaE)->Resize (parallelYeeLayout->getEpsSizeForCurNode ());
-  //         ((ParallelGrid *) internalScheme.OmegaPM)->Resize (parallelYeeLayout->getEpsSizeForCurNode ());
-  //         ((ParallelGrid *) internalScheme.GammaM)->Resize (parallelYeeLayout->getEpsSizeForCurNode ());
-  //       }
-  //
-  //       //diffT += 1;
-  //       //diffT *= 2;
-  //     }
-  //   }
-  // #else
-  //   ASSERT_MESSAGE ("Solver is not compiled with support of parallel grid. "
-  //                   "Recompile it with -DPARALLEL_GRID=ON and -DDYNAMIC_GRID=ON.");
-  // #endif
-  // }
-}
-
-/**
- * Perform computations of single time step for specific field and for specified chunk.
- *
- * NOTE: Start and End coordinates should correctly consider buffers in parallel grid,
- *       which means, that computations should not be performed for incorrect grid points.
- */
-template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
-template <uint8_t grid_type>
-void
-Scheme<Type, TCoord, layout_type>::performFieldSteps (time_step t, /**< time step to compute */
-                                                      TC Start, /**< start coordinate of chunk to compute */
-                                                      TC End) /**< end coordinate of chunk to compute */
+Scheme<Type, TCoord, layout_type>::rebalance (time_step t) /**< number of performed time steps */
 {
-  if (SOLVER_SETTINGS.getDoUsePML ())
+  if (!useParallel || !SOLVER_SETTINGS.getDoUseDynamicGrid ())
   {
-    if (SOLVER_SETTINGS.getDoUseMetamaterials ())
-    {
-      calculateFieldStep<grid_type, true, true> (t, Start, End);
-    }
-    else
+    return;
+  }
+
+#if defined (PARALLEL_GRID) && defined (DYNAMIC_GRID)
+  time_step diffT = SOLVER_SETTINGS.getRebalanceStep ();
+
+  if (t == 0 || t % diffT != 0)
+  {
+    return;
+  }
+
+  if (ParallelGrid::getParallelCore ()->getProcessId () == 0)
+  {
+    DPRINTF (LOG_LEVEL_STAGES, "Try rebalance on step %u, steps elapsed after previous %u\n", t, diffT);
+  }
+
+  ParallelYeeGridLayout<Type, layout_type> *pLayout = (ParallelYeeGridLayout<Type, layout_type> *) yeeLayout;
+
+  if (!pLayout->Rebalance (diffT))
+  {
+    return;
+  }
+
+  /*
+   * Layout never disables computational nodes during rebalance (see ParallelYeeGridLayout::Rebalance)
+   */
+#ifdef ENABLE_ASSERTS
+  std::vector<int> &nodeState = ParallelGrid::getParallelCore ()->getNodeState ();
+  for (int i = 0; i < nodeState.size (); ++i)
+  {
+    ASSERT (nodeState[i] == 1);
+  }
+#endif /* ENABLE_ASSERTS */
+
+  DPRINTF (LOG_LEVEL_STAGES_AND_DUMP, "Rebalancing for process %d!\n", ParallelGrid::getParallelCore ()->getProcessId ());
+
+#define GRID_NAME(x, y, steps, time_offset) \
+  if (intScheme->has ## x ()) \
+  { \
+    ((ParallelGrid *) intScheme->get ## x ())->Resize (pLayout->get ## y ## SizeForCurNode ()); \
+  }
+#define GRID_NAME_NO_CHECK(x, y, steps, time_offset) \
+  GRID_NAME(x, y, steps, time_offset)
+#include "Grids2.inc.h"
+#undef GRID_NAME
+#undef GRID_NAME_NO_CHECK
+#else /* PARALLEL_GRID && DYNAMIC_GRID */
+  ASSERT_MESSAGE ("Solver is not compiled with support of dynamic grid. "
+                  "Recompile it with -DDYNAMIC_GRID=ON.");
+#endif /* !PARALLEL_GRID || !DYNAMIC_GRID */
+}
+
+/**
+ * Perform computations of single time step for specific field and for specified chunk.
+ *
+ * NOTE: Start and End coordinates should correctly consider buffers in parallel grid,
+ *       which means, that computations should not be performed for incorrect grid points.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <uint8_t grid_type>
+void
+Scheme<Type, TCoord, layout_type>::performFieldSteps (time_step t, /**< time step to compute */
+                                                      TC Start, /**< start coordinate of chunk to compute */
+                                                      TC End) /**< end coordinate of chunk to compute */
+{
+  calculateFieldStepChunk<grid_type> (t, Start, End);
+  performPointSourceStep<grid_type> (t);
+}
+
+/**
+ * Perform computations of single time step for specific field only for inner part of specified chunk, i.e. for grid
+ * points, computations for which do not depend on values in buffers of parallel grid. These computations could be
+ * performed while share operations are in progress. Point sources are applied in Scheme::performFieldStepsBorder.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <uint8_t grid_type>
+void
+Scheme<Type, TCoord, layout_type>::performFieldStepsInner (time_step t, /**< time step to compute */
+                                                           TC Start, /**< start coordinate of chunk to compute */
+                                                           TC End) /**< end coordinate of chunk to compute */
+{
+  GridCoordinate3D start3D;
+  GridCoordinate3D end3D;
+  GridCoordinate3D innerStart3D;
+  GridCoordinate3D innerEnd3D;
+  getComputationInnerChunk<grid_type> (Start, End, start3D, end3D, innerStart3D, innerEnd3D);
+
+  if (innerStart3D.get1 () < innerEnd3D.get1 ()
+      && innerStart3D.get2 () < innerEnd3D.get2 ()
+      && innerStart3D.get3 () < innerEnd3D.get3 ())
+  {
+    calculateFieldStepChunk<grid_type> (t,
+                                        TC::initAxesCoordinate (innerStart3D.get1 (), innerStart3D.get2 (), innerStart3D.get3 (), ct1, ct2, ct3),
+                                        TC::initAxesCoordinate (innerEnd3D.get1 (), innerEnd3D.get2 (), innerEnd3D.get3 (), ct1, ct2, ct3));
+  }
+}
+
+/**
+ * Perform computations of single time step for specific field for part of specified chunk, which is not computed
+ * in Scheme::performFieldStepsInner, i.e. which depends on values in buffers of parallel grid. Share operations
+ * should be finished before this.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <uint8_t grid_type>
+void
+Scheme<Type, TCoord, layout_type>::performFieldStepsBorder (time_step t, /**< time step to compute */
+                                                            TC Start, /**< start coordinate of chunk to compute */
+                                                            TC End) /**< end coordinate of chunk to compute */
+{
+  GridCoordinate3D start3D;
+  GridCoordinate3D end3D;
+  GridCoordinate3D innerStart3D;
+  GridCoordinate3D innerEnd3D;
+  getComputationInnerChunk<grid_type> (Start, End, start3D, end3D, innerStart3D, innerEnd3D);
+
+  /*
+   * Border part of chunk consists of at most 6 boxes: 2 boxes by first axis, which take whole chunk by other axes,
+   * 2 boxes by second axis, which take inner part by first axis, and 2 boxes by third axis, which take inner part by
+   * first and second axes.
+   */
+  GridCoordinate3D borderStart[6];
+  GridCoordinate3D borderEnd[6];
+  for (int i = 0; i < 6; ++i)
+  {
+    borderStart[i] = start3D;
+    borderEnd[i] = end3D;
+
+    if (i >= 2)
+    {
+      borderStart[i].set1 (innerStart3D.get1 ());
+      borderEnd[i].set1 (innerEnd3D.get1 ());
+    }
+    if (i >= 4)
     {
-      calculateFieldStep<grid_type, true, false> (t, Start, End);
+      borderStart[i].set2 (innerStart3D.get2 ());
+      borderEnd[i].set2 (innerEnd3D.get2 ());
     }
   }
-  else
+
+  borderEnd[0].set1 (innerStart3D.get1 ());
+  borderStart[1].set1 (innerEnd3D.get1 ());
+  borderEnd[2].set2 (innerStart3D.get2 ());
+  borderStart[3].set2 (innerEnd3D.get2 ());
+  borderEnd[4].set3 (innerStart3D.get3 ());
+  borderStart[5].set3 (innerEnd3D.get3 ());
+
+  for (int i = 0; i < 6; ++i)
   {
-    if (SOLVER_SETTINGS.getDoUseMetamaterials ())
+    if (borderStart[i].get1 () < borderEnd[i].get1 ()
+        && borderStart[i].get2 () < borderEnd[i].get2 ()
+        && borderStart[i].get3 () < borderEnd[i].get3 ())
+    {
+      calculateFieldStepChunk<grid_type> (t,
+                                          TC::initAxesCoordinate (borderStart[i].get1 (), borderStart[i].get2 (), borderStart[i].get3 (), ct1, ct2, ct3),
+                                          TC::initAxesCoordinate (borderEnd[i].get1 (), borderEnd[i].get2 (), borderEnd[i].get3 (), ct1, ct2, ct3));
+    }
+  }
+
+  performPointSourceStep<grid_type> (t);
+}
+
+/**
+ * Perform computations of single time step for specific field for part of specified chunk, which is inside tile by
+ * first axis, and apply point source if it is inside tile (see Scheme::performNStepsTemporalBlocking).
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <uint8_t grid_type>
+void
+Scheme<Type, TCoord, layout_type>::performFieldStepsTile (time_step t, /**< time step to compute */
+                                                          TC Start, /**< start coordinate of chunk to compute */
+                                                          TC End, /**< end coordinate of chunk to compute */
+                                                          grid_coord tileStart, /**< start of tile by first axis */
+                                                          grid_coord tileEnd) /**< end of tile by first axis */
+{
+  GridCoordinate3D start3D;
+  GridCoordinate3D end3D;
+  expandTo3DStartEnd (Start, End, start3D, end3D, ct1, ct2, ct3);
+
+  /*
+   * Tile might be partially out of grid, so intersection is checked before it is set to coordinates
+   */
+  grid_coord start1 = std::max (start3D.get1 (), tileStart);
+  grid_coord end1 = std::min (end3D.get1 (), tileEnd);
+
+  if (start1 < end1)
+  {
+    calculateFieldStepChunk<grid_type> (t,
+                                        TC::initAxesCoordinate (start1, start3D.get2 (), start3D.get3 (), ct1, ct2, ct3),
+                                        TC::initAxesCoordinate (end1, end3D.get2 (), end3D.get3 (), ct1, ct2, ct3));
+  }
+
+  /*
+   * Tiles for each half step cover the whole grid, so point source is applied exactly once
+   */
+  TC pointSourcePos = TC::initAxesCoordinate (SOLVER_SETTINGS.getPointSourcePositionX (),
+                                              SOLVER_SETTINGS.getPointSourcePositionY (),
+                                              SOLVER_SETTINGS.getPointSourcePositionZ (),
+                                              ct1, ct2, ct3);
+  grid_coord pointSourcePos1 = expandTo3D (pointSourcePos, ct1, ct2, ct3).get1 ();
+
+  if (tileStart <= pointSourcePos1 && pointSourcePos1 < tileEnd)
+  {
+    performPointSourceStep<grid_type> (t);
+  }
+}
+
+/**
+ * Get chunk and its inner part (see Scheme::performFieldStepsInner) as 3D coordinates. Inner part is always inside
+ * chunk, and might be empty.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <uint8_t grid_type>
+void
+Scheme<Type, TCoord, layout_type>::getComputationInnerChunk (TC start, /**< start coordinate of chunk */
+                                                              TC end, /**< end coordinate of chunk */
+                                                              GridCoordinate3D &start3D, /**< out: start coordinate of chunk */
+                                                              GridCoordinate3D &end3D, /**< out: end coordinate of chunk */
+                                                              GridCoordinate3D &innerStart3D, /**< out: start coordinate of inner part */
+                                                              GridCoordinate3D &innerEnd3D) /**< out: end coordinate of inner part */
+{
+  Grid<TC> *grid = NULLPTR;
+
+  switch (grid_type)
+  {
+    case (static_cast<uint8_t> (GridType::EX)):
+    {
+      grid = intScheme->getEx ();
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::EY)):
+    {
+      grid = intScheme->getEy ();
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::EZ)):
+    {
+      grid = intScheme->getEz ();
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::HX)):
+    {
+      grid = intScheme->getHx ();
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::HY)):
+    {
+      grid = intScheme->getHy ();
+      break;
+    }
+    case (static_cast<uint8_t> (GridType::HZ)):
+    {
+      grid = intScheme->getHz ();
+      break;
+    }
+    default:
+    {
+      UNREACHABLE;
+    }
+  }
+
+  expandTo3DStartEnd (start, end, start3D, end3D, ct1, ct2, ct3);
+  expandTo3DStartEnd (grid->getComputationInnerStart (start), grid->getComputationInnerEnd (end),
+                      innerStart3D, innerEnd3D, ct1, ct2, ct3);
+
+  innerStart3D.set1 (std::min (std::max (innerStart3D.get1 (), start3D.get1 ()), end3D.get1 ()));
+  innerStart3D.set2 (std::min (std::max (innerStart3D.get2 (), start3D.get2 ()), end3D.get2 ()));
+  innerStart3D.set3 (std::min (std::max (innerStart3D.get3 (), start3D.get3 ()), end3D.get3 ()));
+
+  innerEnd3D.set1 (std::max (std::min (innerEnd3D.get1 (), end3D.get1 ()), innerStart3D.get1 ()));
+  innerEnd3D.set2 (std::max (std::min (innerEnd3D.get2 (), end3D.get2 ()), innerStart3D.get2 ()));
+  innerEnd3D.set3 (std::max (std::min (innerEnd3D.get3 (), end3D.get3 ()), innerStart3D.get3 ()));
+}
+
+/**
+ * Perform computations of single time step for specific field and for specified chunk without point sources.
+ * Computations for separate points are performed for each lane of batched field grids.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <uint8_t grid_type>
+void
+Scheme<Type, TCoord, layout_type>::calculateFieldStepChunk (time_step t, /**< time step to compute */
+                                                            TC Start, /**< start coordinate of chunk to compute */
+                                                            TC End) /**< end coordinate of chunk to compute */
+{
+  for (int lane = 0; lane < intScheme->getBatchSize (); ++lane)
+  {
+    intScheme->setActiveLane (lane);
+
+    if (SOLVER_SETTINGS.getDoUsePML ())
     {
-      calculateFieldStep<grid_type, false, true> (t, Start, End);
+      if (SOLVER_SETTINGS.getDoUseMetamaterials ())
+      {
+        calculateFieldStep<grid_type, true, true> (t, Start, End);
+      }
+      else
+      {
+        calculateFieldStep<grid_type, true, false> (t, Start, End);
+      }
     }
     else
     {
-      calculateFieldStep<grid_type, false, false> (t, Start, End);
+      if (SOLVER_SETTINGS.getDoUseMetamaterials ())
+      {
+        calculateFieldStep<grid_type, false, true> (t, Start, End);
+      }
+      else
+      {
+        calculateFieldStep<grid_type, false, false> (t, Start, End);
+      }
     }
   }
 
+  intScheme->setActiveLane (0);
+}
+
+/**
+ * Apply point source for specific field
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <uint8_t grid_type>
+void
+Scheme<Type, TCoord, layout_type>::performPointSourceStep (time_step t) /**< time step to compute */
+{
   bool doUsePointSource;
   switch (grid_type)
   {
@@ -842,7 +1291,18 @@ Scheme<Type, TCoord, layout_type>::performFieldSteps (time_step t, /**< time ste
     else
 #endif /* CUDA_ENABLED */
     {
-      intScheme->template performPointSourceCalc<grid_type> (t);
+      /*
+       * Point source excites all lanes of batched field grids: lanes are separate simulations only for incident
+       * waves of TF/SF (see InternalScheme::getIncidentWaveOfLane), and point and current sources are the same for
+       * all of them
+       */
+      for (int lane = 0; lane < intScheme->getBatchSize (); ++lane)
+      {
+        intScheme->setActiveLane (lane);
+        intScheme->template performPointSourceCalc<grid_type> (t);
+      }
+
+      intScheme->setActiveLane (0);
     }
   }
 }
@@ -932,7 +1392,7 @@ Scheme<Type, TCoord, layout_type>::calculateFieldStep (time_step t, /**< time st
   /*
    * TODO: remove this, multiply on this at initialization
    */
-  FPValue materialModifier;
+  FPComputeValue materialModifier;
 
   intScheme->template calculateFieldStepInit<grid_type, usePML, useMetamaterials> (&grid, &gridType,
     &materialGrid, &materialGridType, &materialGrid1, &materialGridType1, &materialGrid2, &materialGridType2,
@@ -991,7 +1451,7 @@ Scheme<Type, TCoord, layout_type>::calculateFieldStep (time_step t, /**< time st
   SourceCallBack _borderFunc = NULLPTR;
   SourceCallBack _exactFunc = NULLPTR;
 
-  FPValue _materialModifier;
+  FPComputeValue _materialModifier;
 
   if (SOLVER_SETTINGS.getDoUseCuda ()
       && SOLVER_SETTINGS.getIndexOfGPUForCurrentNode () != NO_GPU)
@@ -1079,79 +1539,100 @@ Scheme<Type, TCoord, layout_type>::calculateFieldStep (time_step t, /**< time st
     else
 #endif /* CUDA_ENABLED */
     {
-      for (grid_coord i = start3D.get1 (); i < end3D.get1 (); ++i)
+      if (rightSideFunc == NULLPTR)
       {
-        // TODO: check that this loop is optimized out
-        for (grid_coord j = start3D.get2 (); j < end3D.get2 (); ++j)
+        /*
+         * Fast path: no per-point coordinates, virtual calls and checks. All lanes of batched field grids are updated
+         * at once, so this is done only for the first lane (see Scheme::calculateFieldStepChunk).
+         */
+        if (intScheme->getActiveLane () == 0)
+        {
+          intScheme->template calculateFieldStepIterationChunk<grid_type> (start3D, end3D, diff11, diff12, diff21, diff22,
+                                                                            grid, oppositeGrid1, oppositeGrid2, Ca, Cb,
+                                                                            usePML,
+                                                                            gridType, materialGrid, materialGridType,
+                                                                            materialModifier);
+        }
+      }
+      else
+      {
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for collapse(2)
+#endif /* OPENMP_ENABLED */
+        for (grid_coord i = start3D.get1 (); i < end3D.get1 (); ++i)
         {
-          // TODO: check that this is optimized out in case 2D mode
-          for (grid_coord k = start3D.get3 (); k < end3D.get3 (); ++k)
+          // TODO: check that this loop is optimized out
+          for (grid_coord j = start3D.get2 (); j < end3D.get2 (); ++j)
           {
-            TC pos = TC::initAxesCoordinate (i, j, k, ct1, ct2, ct3);
+            // TODO: check that this is optimized out in case 2D mode
+            for (grid_coord k = start3D.get3 (); k < end3D.get3 (); ++k)
+            {
+              TC pos = TC::initAxesCoordinate (i, j, k, ct1, ct2, ct3);
 
-            // TODO: add getTotalPositionDiff here, which will be called before loop
-            TC posAbs = grid->getTotalPosition (pos);
+              // TODO: add getTotalPositionDiff here, which will be called before loop
+              TC posAbs = grid->getTotalPosition (pos);
 
-            TCFP coordFP;
+              TCFP coordFP;
 
-            if (rightSideFunc != NULLPTR)
-            {
-              switch (grid_type)
+              if (rightSideFunc != NULLPTR)
               {
-                case (static_cast<uint8_t> (GridType::EX)):
-                {
-                  coordFP = yeeLayout->getExCoordFP (posAbs);
-                  break;
-                }
-                case (static_cast<uint8_t> (GridType::EY)):
-                {
-                  coordFP = yeeLayout->getEyCoordFP (posAbs);
-                  break;
-                }
-                case (static_cast<uint8_t> (GridType::EZ)):
-                {
-                  coordFP = yeeLayout->getEzCoordFP (posAbs);
-                  break;
-                }
-                case (static_cast<uint8_t> (GridType::HX)):
-                {
-                  coordFP = yeeLayout->getHxCoordFP (posAbs);
-                  break;
-                }
-                case (static_cast<uint8_t> (GridType::HY)):
-                {
-                  coordFP = yeeLayout->getHyCoordFP (posAbs);
-                  break;
-                }
-                case (static_cast<uint8_t> (GridType::HZ)):
-                {
-                  coordFP = yeeLayout->getHzCoordFP (posAbs);
-                  break;
-                }
-                default:
+                switch (grid_type)
                 {
-                  UNREACHABLE;
+                  case (static_cast<uint8_t> (GridType::EX)):
+                  {
+                    coordFP = yeeLayout->getExCoordFP (posAbs);
+                    break;
+                  }
+                  case (static_cast<uint8_t> (GridType::EY)):
+                  {
+                    coordFP = yeeLayout->getEyCoordFP (posAbs);
+                    break;
+                  }
+                  case (static_cast<uint8_t> (GridType::EZ)):
+                  {
+                    coordFP = yeeLayout->getEzCoordFP (posAbs);
+                    break;
+                  }
+                  case (static_cast<uint8_t> (GridType::HX)):
+                  {
+                    coordFP = yeeLayout->getHxCoordFP (posAbs);
+                    break;
+                  }
+                  case (static_cast<uint8_t> (GridType::HY)):
+                  {
+                    coordFP = yeeLayout->getHyCoordFP (posAbs);
+                    break;
+                  }
+                  case (static_cast<uint8_t> (GridType::HZ)):
+                  {
+                    coordFP = yeeLayout->getHzCoordFP (posAbs);
+                    break;
+                  }
+                  default:
+                  {
+                    UNREACHABLE;
+                  }
                 }
               }
-            }
 
-            if (SOLVER_SETTINGS.getDoUseCaCbGrids ())
-            {
-              intScheme->template calculateFieldStepIteration<grid_type, true> (timestep, pos, posAbs, diff11, diff12, diff21, diff22,
-                                                                 grid, coordFP,
-                                                                 oppositeGrid1, oppositeGrid2, rightSideFunc, Ca, Cb,
-                                                                 usePML,
-                                                                 gridType, materialGrid, materialGridType,
-                                                                 materialModifier);
-            }
-            else
-            {
-              intScheme->template calculateFieldStepIteration<grid_type, false> (timestep, pos, posAbs, diff11, diff12, diff21, diff22,
-                                                                 grid, coordFP,
-                                                                 oppositeGrid1, oppositeGrid2, rightSideFunc, Ca, Cb,
-                                                                 usePML,
-                                                                 gridType, materialGrid, materialGridType,
-                                                                 materialModifier);
+              if (SOLVER_SETTINGS.getDoUseCaCbGrids ())
+              {
+                intScheme->template calculateFieldStepIteration<grid_type, true> (timestep, pos, posAbs, diff11, diff12, diff21, diff22,
+                                                                   grid, coordFP,
+                                                                   oppositeGrid1, oppositeGrid2, rightSideFunc, Ca, Cb,
+                                                                   usePML,
+                                                                   gridType, materialGrid, materialGridType,
+                                                                   materialModifier);
+              }
+              else
+              {
+                intScheme->template calculateFieldStepIteration<grid_type, false> (timestep, pos, posAbs, diff11, diff12, diff21, diff22,
+                                                                   grid, coordFP,
+                                                                   oppositeGrid1, oppositeGrid2, rightSideFunc, Ca, Cb,
+                                                                   usePML,
+                                                                   gridType, materialGrid, materialGridType,
+                                                                   materialModifier);
+              }
             }
           }
         }
@@ -1215,15 +1696,18 @@ Scheme<Type, TCoord, layout_type>::calculateFieldStep (time_step t, /**< time st
       }
     }
 
+    /*
+     * Current source is applied to active lane, i.e. it excites all lanes of batched field grids as point source
+     */
     if (doComputeCurrentSource)
     {
       FieldValue current = FIELDVALUE (0, 0);
 
 #ifdef COMPLEX_FIELD_VALUES
-      current = FieldValue (cos (intScheme->getGridTimeStep () * (timestep-1) * 2 * PhysicsConst::Pi * intScheme->getSourceFrequency ()),
-                             -sin (intScheme->getGridTimeStep () * (timestep-1) * 2 * PhysicsConst::Pi * intScheme->getSourceFrequency ()));
+      current = FieldValue (cos (intScheme->getGridTimeStep () * (timestep-1) * 2 * PhysicsConst::PiCompute * intScheme->getSourceFrequency ()),
+                             -sin (intScheme->getGridTimeStep () * (timestep-1) * 2 * PhysicsConst::PiCompute * intScheme->getSourceFrequency ()));
 #else /* COMPLEX_FIELD_VALUES */
-      current = sin (intScheme->getGridTimeStep () * timestep * 2 * PhysicsConst::Pi * intScheme->getSourceFrequency ());
+      current = sin (intScheme->getGridTimeStep () * timestep * 2 * PhysicsConst::PiCompute * intScheme->getSourceFrequency ());
 #endif /* !COMPLEX_FIELD_VALUES */
 
       current = current * PhysicsConst::Mu0 / intScheme->getGridTimeStep () / 2.0;
@@ -1271,6 +1755,9 @@ Scheme<Type, TCoord, layout_type>::calculateFieldStep (time_step t, /**< time st
         else
 #endif /* CUDA_ENABLED */
         {
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for collapse(2)
+#endif /* OPENMP_ENABLED */
           for (grid_coord i = start3D.get1 (); i < end3D.get1 (); ++i)
           {
             // TODO: check that this loop is optimized out
@@ -1316,6 +1803,9 @@ Scheme<Type, TCoord, layout_type>::calculateFieldStep (time_step t, /**< time st
       else
 #endif /* CUDA_ENABLED */
       {
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for collapse(2)
+#endif /* OPENMP_ENABLED */
         for (grid_coord i = start3D.get1 (); i < end3D.get1 (); ++i)
         {
           // TODO: check that this loop is optimized out
@@ -1366,6 +1856,9 @@ Scheme<Type, TCoord, layout_type>::calculateFieldStep (time_step t, /**< time st
     else
 #endif
     {
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for collapse(2)
+#endif /* OPENMP_ENABLED */
       for (grid_coord i = startBorder.get1 (); i < endBorder.get1 (); ++i)
       {
         // TODO: check that this loop is optimized out
@@ -1749,6 +2242,11 @@ Scheme<Type, TCoord, layout_type>::initBlocks (time_step t_total)
   // TODO: remove this check, when correct block setup is implemented
   ALWAYS_ASSERT (blockCount.calculateTotalCoord () == 1);
 
+  if (SOLVER_SETTINGS.getDoUseTemporalBlocking ())
+  {
+    checkTemporalBlocking ();
+  }
+
   {
 #ifdef CUDA_ENABLED
     if (SOLVER_SETTINGS.getDoUseCuda ())
@@ -1797,6 +2295,11 @@ Scheme<Type, TCoord, layout_type>::initBlocks (time_step t_total)
     }
     else
 #endif /* CUDA_ENABLED */
+    if (SOLVER_SETTINGS.getDoUseTemporalBlocking ())
+    {
+      NTimeSteps = SOLVER_SETTINGS.getTemporalBlockingSteps ();
+    }
+    else
     {
       /*
        * For non-Cuda builds it's fine to perform single step for block
@@ -1834,6 +2337,65 @@ Scheme<Type, TCoord, layout_type>::initBlocks (time_step t_total)
 #endif /* CUDA_ENABLED */
 }
 
+/**
+ * Check that computations could be performed with temporal blocking (see Scheme::performNStepsTemporalBlocking).
+ * Only updates of E and H grids, which depend on neighboring points, and point sources are supported.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::checkTemporalBlocking ()
+{
+  if (useParallel
+      || !InternalSchemeHelper::doUpdateFieldsInPlace ())
+  {
+    ALWAYS_ASSERT_MESSAGE ("Temporal blocking requires sequential mode with in-place update of E and H grids "
+                           "(--use-in-place-update without NTFF and CUDA).");
+  }
+
+  if (SOLVER_SETTINGS.getDoUsePML ()
+      || SOLVER_SETTINGS.getDoUseMetamaterials ()
+      || SOLVER_SETTINGS.getDoUseTFSF ())
+  {
+    ALWAYS_ASSERT_MESSAGE ("Temporal blocking is not supported with PML, metamaterials and TF/SF.");
+  }
+
+  /*
+   * Current sources, border conditions and exact solutions are applied once for each call of calculateFieldStep
+   */
+  SourceCallBack callbacks[] =
+  {
+    intScheme->getCallbackExBorder (), intScheme->getCallbackExExact (), intScheme->getCallbackJx (),
+    intScheme->getCallbackEyBorder (), intScheme->getCallbackEyExact (), intScheme->getCallbackJy (),
+    intScheme->getCallbackEzBorder (), intScheme->getCallbackEzExact (), intScheme->getCallbackJz (),
+    intScheme->getCallbackHxBorder (), intScheme->getCallbackHxExact (), intScheme->getCallbackMx (),
+    intScheme->getCallbackHyBorder (), intScheme->getCallbackHyExact (), intScheme->getCallbackMy (),
+    intScheme->getCallbackHzBorder (), intScheme->getCallbackHzExact (), intScheme->getCallbackMz ()
+  };
+
+  bool doUseCallbacks = false;
+  for (size_t i = 0; i < sizeof (callbacks) / sizeof (callbacks[0]); ++i)
+  {
+    doUseCallbacks = doUseCallbacks || callbacks[i] != NULLPTR;
+  }
+
+  if (doUseCallbacks
+      || SOLVER_SETTINGS.getDoUseCurrentSourceJx ()
+      || SOLVER_SETTINGS.getDoUseCurrentSourceJy ()
+      || SOLVER_SETTINGS.getDoUseCurrentSourceJz ()
+      || SOLVER_SETTINGS.getDoUseCurrentSourceMx ()
+      || SOLVER_SETTINGS.getDoUseCurrentSourceMy ()
+      || SOLVER_SETTINGS.getDoUseCurrentSourceMz ())
+  {
+    ALWAYS_ASSERT_MESSAGE ("Temporal blocking is not supported with current sources, border conditions and exact solutions.");
+  }
+
+  if (SOLVER_SETTINGS.getTemporalBlockingSteps () < 1
+      || SOLVER_SETTINGS.getTemporalBlockingTileSize () < 1)
+  {
+    ALWAYS_ASSERT_MESSAGE ("Number of time steps and tile size for temporal blocking should be positive.");
+  }
+}
+
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
 Scheme<Type, TCoord, layout_type>::Scheme (YeeGridLayout<Type, TCoord, layout_type> *layout,
                                            bool parallelLayout,
@@ -1844,6 +2406,8 @@ Scheme<Type, TCoord, layout_type>::Scheme (YeeGridLayout<Type, TCoord, layout_ty
 #ifdef PARALLEL_GRID
   , eGroup (NULLPTR)
   , hGroup (NULLPTR)
+  , isShareEPending (false)
+  , isShareHPending (false)
 #endif /* PARALLEL_GRID */
   , totalTimeSteps (0)
   , NTimeSteps (0)
@@ -1872,6 +2436,11 @@ Scheme<Type, TCoord, layout_type>::Scheme (YeeGridLayout<Type, TCoord, layout_ty
   , ct2 (intScheme->get_ct2 ())
   , ct3 (intScheme->get_ct3 ())
   , yeeLayout (layout)
+  , ntffRunningCount (0)
+  , checkpointWriter (NULLPTR)
+  , checkpointPendingStep (0)
+  , checkpointCompleteStep (0)
+  , startTimeStep (0)
 {
   ASSERT (!SOLVER_SETTINGS.getDoUseTFSF ()
           || (SOLVER_SETTINGS.getDoUseTFSF ()
@@ -1895,7 +2464,84 @@ Scheme<Type, TCoord, layout_type>::Scheme (YeeGridLayout<Type, TCoord, layout_ty
   }
 #endif
 
-  intScheme->init (layout, useParallel);
+  if (SOLVER_SETTINGS.getDoUseAsyncShare () && SOLVER_SETTINGS.getDoUseDynamicGrid ())
+  {
+    ALWAYS_ASSERT_MESSAGE ("Non-blocking share operations with dynamic grid are not implemented");
+  }
+
+  if (SOLVER_SETTINGS.getDoUseNodeSharedMaterials ()
+      && (SOLVER_SETTINGS.getDoUseDynamicGrid () || SOLVER_SETTINGS.getDoUseCuda ()))
+  {
+    ALWAYS_ASSERT_MESSAGE ("Grids shared on node are not supported with dynamic grid and CUDA.");
+  }
+
+  if (SOLVER_SETTINGS.getDoUseCaCbMaterialIds ()
+      && (SOLVER_SETTINGS.getDoUseCaCbGrids () || SOLVER_SETTINGS.getDoUseCuda ()))
+  {
+    ALWAYS_ASSERT_MESSAGE ("Grids of material identifiers are not supported with --use-ca-cb and CUDA.");
+  }
+
+  if (SOLVER_SETTINGS.getDoUseCaCbMaterialIds () && SOLVER_SETTINGS.getDoUseDynamicGrid ())
+  {
+    ALWAYS_ASSERT_MESSAGE ("Grids of material identifiers are not supported with dynamic grid.");
+  }
+
+  if (SOLVER_SETTINGS.getDoUseNTFF ()
+      && SOLVER_SETTINGS.getDoUseNTFFRunningDFT ())
+  {
+#ifdef COMPLEX_FIELD_VALUES
+    if (TCoord<grid_coord, false>::dimension != Dimension::Dim3
+        || SOLVER_SETTINGS.getDoUseCuda ())
+    {
+      ALWAYS_ASSERT_MESSAGE ("Running DFT for NTFF is supported only in 3D mode without CUDA.");
+    }
+
+    /*
+     * Faces of all NTFF boxes are accumulated separately for each lane of batched field grids
+     */
+    grid_coord lanes = SOLVER_SETTINGS.getDoUseBatchedIncidentWaves () ? SOLVER_SETTINGS.getIncidentWavesCount () : 1;
+    ntffFaces.resize (lanes * SOLVER_SETTINGS.getNTFFDiff () * NTFF_FACES_COUNT);
+#else /* COMPLEX_FIELD_VALUES */
+    ALWAYS_ASSERT_MESSAGE ("Solver is not compiled with support of complex values. Recompile it with -DCOMPLEX_FIELD_VALUES=ON.");
+#endif /* !COMPLEX_FIELD_VALUES */
+  }
+
+  if (SOLVER_SETTINGS.getIncidentWavesCount () > 1
+      && SOLVER_SETTINGS.getDoUseCuda ())
+  {
+    ALWAYS_ASSERT_MESSAGE ("Multiple incident waves are not supported with CUDA.");
+  }
+
+  if (SOLVER_SETTINGS.getDoUseBatchedIncidentWaves ()
+      && (!SOLVER_SETTINGS.getDoUseTFSF () || useParallel || SOLVER_SETTINGS.getDoUseCuda ()))
+  {
+    ALWAYS_ASSERT_MESSAGE ("Batched incident waves require TF/SF and are not supported with parallel grid and CUDA.");
+  }
+
+#ifndef BATCHED_GRID_VALUES
+  if (SOLVER_SETTINGS.getDoUseBatchedIncidentWaves ())
+  {
+    ALWAYS_ASSERT_MESSAGE ("Solver is not compiled with support of batched grid values. Recompile it with -DBATCHED_GRID_VALUES=ON.");
+  }
+#endif /* !BATCHED_GRID_VALUES */
+
+  if ((SOLVER_SETTINGS.getCheckpointStep () > 0 || !SOLVER_SETTINGS.getRestartDir ().empty ())
+      && SOLVER_SETTINGS.getDoUseCuda ())
+  {
+    ALWAYS_ASSERT_MESSAGE ("Checkpoints are not supported with CUDA.");
+  }
+
+  if (SOLVER_SETTINGS.getCheckpointStep () > 0)
+  {
+    CheckpointWriter::makeDirectory (SOLVER_SETTINGS.getCheckpointDir ());
+
+    checkpointWriter = new CheckpointWriter ();
+#ifdef CXX11_ENABLED
+    checkpointWriter->setWriteInBackground (true);
+#endif /* CXX11_ENABLED */
+  }
+
+  intScheme->init (layout, useParallel);
 
   if (!useParallel)
   {
@@ -1951,7 +2597,8 @@ Scheme<Type, TCoord, layout_type>::Scheme (YeeGridLayout<Type, TCoord, layout_ty
     ASSERT (hGroup != NULLPTR);
 #endif /* PARALLEL_GRID */
 
-    if (SOLVER_SETTINGS.getDoSaveMaterials ())
+    if (SOLVER_SETTINGS.getDoSaveMaterials ()
+        && !getDoUseCollectiveDATIO ())
     {
       totalEps = new Grid<TC> (yeeLayout->getEpsSize (), intScheme->getEps ()->getCountStoredSteps (), "Eps");
       totalMu = new Grid<TC> (yeeLayout->getMuSize (), intScheme->getMu ()->getCountStoredSteps (), "Mu");
@@ -2009,6 +2656,16 @@ Scheme<Type, TCoord, layout_type>::Scheme (YeeGridLayout<Type, TCoord, layout_ty
   {
     dumper[FILE_TYPE_DAT] = new DATDumper<TC> ();
     dumper1D[FILE_TYPE_DAT] = new DATDumper<GridCoordinate1D> ();
+
+    if (SOLVER_SETTINGS.getDoSaveDATInBackground ())
+    {
+#ifdef CXX11_ENABLED
+      ((DATDumper<TC> *) dumper[FILE_TYPE_DAT])->setWriteInBackground (true);
+      ((DATDumper<GridCoordinate1D> *) dumper1D[FILE_TYPE_DAT])->setWriteInBackground (true);
+#else /* CXX11_ENABLED */
+      ALWAYS_ASSERT_MESSAGE ("Solver is not compiled with support of C++11. Recompile it with -DCXX11_ENABLED=ON.");
+#endif /* !CXX11_ENABLED */
+    }
   }
   else
   {
@@ -2016,6 +2673,21 @@ Scheme<Type, TCoord, layout_type>::Scheme (YeeGridLayout<Type, TCoord, layout_ty
     dumper1D[FILE_TYPE_DAT] = NULLPTR;
   }
 
+  if (getDoUseCollectiveDATIO ())
+  {
+    /*
+     * Full grids are not gathered in this mode, so only .dat files could be saved
+     */
+    if (SOLVER_SETTINGS.getDoSaveAsBMP ()
+        || SOLVER_SETTINGS.getDoSaveAsTXT ()
+        || SOLVER_SETTINGS.getDoSaveResPerProcess ()
+        || SOLVER_SETTINGS.getDoSaveScatteredFieldRes ()
+        || SOLVER_SETTINGS.getDoSaveScatteredFieldIntermediate ())
+    {
+      ALWAYS_ASSERT_MESSAGE ("Only total field could be saved to .dat files with collective MPI-IO.");
+    }
+  }
+
   if (SOLVER_SETTINGS.getDoSaveAsTXT ())
   {
     dumper[FILE_TYPE_TXT] = new TXTDumper<TC> ();
@@ -2066,6 +2738,11 @@ Scheme<Type, TCoord, layout_type>::Scheme (YeeGridLayout<Type, TCoord, layout_ty
     }
     {
       loader[FILE_TYPE_DAT] = new DATLoader<TC> ();
+
+      if (SOLVER_SETTINGS.getDoUseMmapDATIO ())
+      {
+        ((DATLoader<TC> *) loader[FILE_TYPE_DAT])->setUseMmap (true);
+      }
     }
     {
       loader[FILE_TYPE_TXT] = new TXTLoader<TC> ();
@@ -2145,6 +2822,8 @@ Scheme<Type, TCoord, layout_type>::~Scheme ()
   delete dumper1D[FILE_TYPE_BMP];
   delete dumper1D[FILE_TYPE_DAT];
   delete dumper1D[FILE_TYPE_TXT];
+
+  delete checkpointWriter;
 }
 
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
@@ -2155,7 +2834,19 @@ Scheme<Type, TCoord, layout_type>::initScheme (FPValue dx, FPValue sourceWaveLen
 
   initCallBacks ();
   initGrids ();
+
+  if (useParallel
+      && SOLVER_SETTINGS.getDoUseNodeSharedMaterials ())
+  {
+    shareMaterialsOnNode ();
+  }
+
   initBlocks (t_total);
+
+  if (!SOLVER_SETTINGS.getRestartDir ().empty ())
+  {
+    loadCheckpoint ();
+  }
 }
 
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
@@ -2848,26 +3539,55 @@ Scheme<Type, TCoord, layout_type>::initMaterialFromFile (GridType gridType, Grid
 
   FileType type = GridFileManager::getFileType (filename);
 
+  /*
+   * In parallel mode each process reads from .dat file only values of its own chunk with buffers (with collective
+   * MPI-IO or from memory mapping of file)
+   */
+  if (type == FILE_TYPE_DAT
+      && useParallel)
+  {
+    accessGridCollective (grid, filename, zero, grid->getTotalSize (), 0, false);
+    return;
+  }
+
   std::vector< std::string > fileNames (1);
   fileNames[0] = filename;
 
-  loader[type]->loadGrid (totalGrid, zero, totalGrid->getSize (), 0, 0, fileNames);
+  /*
+   * Other formats could be loaded only to full grid. In parallel mode it is kept only when materials are saved.
+   */
+  Grid<TC> *fullGrid = totalGrid;
+  if (fullGrid == NULLPTR)
+  {
+    ASSERT (useParallel);
+    fullGrid = new Grid<TC> (grid->getTotalSize (), grid->getCountStoredSteps (), grid->getName ());
+  }
+
+  loader[type]->loadGrid (fullGrid, zero, fullGrid->getSize (), 0, 0, fileNames);
 
   if (useParallel)
   {
 #ifdef PARALLEL_GRID
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for
+#endif /* OPENMP_ENABLED */
     for (grid_coord i = 0; i < grid->getSize ().calculateTotalCoord (); ++i)
     {
       TC pos = grid->calculatePositionFromIndex (i);
       TC posAbs = grid->getTotalPosition (pos);
 
       FieldValue *val = grid->getFieldValue (pos, 0);
-      *val = *totalGrid->getFieldValue (posAbs, 0);
+      *val = *fullGrid->getFieldValue (posAbs, 0);
     }
 #else
     ASSERT_MESSAGE ("Solver is not compiled with support of parallel grid. Recompile it with -DPARALLEL_GRID=ON.");
 #endif
   }
+
+  if (fullGrid != totalGrid)
+  {
+    delete fullGrid;
+  }
 }
 
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
@@ -2987,6 +3707,9 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
   if (SOLVER_SETTINGS.getEpsSphere () != 1)
   {
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for
+#endif /* OPENMP_ENABLED */
     for (grid_coord i = 0; i < intScheme->getEps ()->getSize ().calculateTotalCoord (); ++i)
     {
       TC pos = intScheme->getEps ()->calculatePositionFromIndex (i);
@@ -3021,6 +3744,9 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
   }
   if (SOLVER_SETTINGS.getUseEpsAllNorm ())
   {
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for
+#endif /* OPENMP_ENABLED */
     for (grid_coord i = 0; i < intScheme->getEps ()->getSize ().calculateTotalCoord (); ++i)
     {
       FieldValue *val = intScheme->getEps ()->getFieldValue (i, 0);
@@ -3033,6 +3759,9 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
   if (SOLVER_SETTINGS.getMuSphere () != 1)
   {
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for
+#endif /* OPENMP_ENABLED */
     for (grid_coord i = 0; i < intScheme->getMu ()->getSize ().calculateTotalCoord (); ++i)
     {
       TC pos = intScheme->getMu ()->calculatePositionFromIndex (i);
@@ -3067,6 +3796,9 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
   }
   if (SOLVER_SETTINGS.getUseMuAllNorm ())
   {
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for
+#endif /* OPENMP_ENABLED */
     for (grid_coord i = 0; i < intScheme->getMu ()->getSize ().calculateTotalCoord (); ++i)
     {
       FieldValue *val = intScheme->getMu ()->getFieldValue (i, 0);
@@ -3080,6 +3812,9 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
     if (SOLVER_SETTINGS.getOmegaPESphere () != 0)
     {
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for
+#endif /* OPENMP_ENABLED */
       for (grid_coord i = 0; i < intScheme->getOmegaPE ()->getSize ().calculateTotalCoord (); ++i)
       {
         TC pos = intScheme->getOmegaPE ()->calculatePositionFromIndex (i);
@@ -3117,6 +3852,9 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
     if (SOLVER_SETTINGS.getOmegaPMSphere () != 0)
     {
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for
+#endif /* OPENMP_ENABLED */
       for (grid_coord i = 0; i < intScheme->getOmegaPM ()->getSize ().calculateTotalCoord (); ++i)
       {
         TC pos = intScheme->getOmegaPM ()->calculatePositionFromIndex (i);
@@ -3169,12 +3907,14 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 
     if (SOLVER_SETTINGS.getDoSaveMaterials ())
     {
-      if (useParallel)
+      if (useParallel
+          && !getDoUseCollectiveDATIO ())
       {
         initFullMaterialGrids ();
       }
 
-      if (processId == 0)
+      if (processId == 0
+          || getDoUseCollectiveDATIO ())
       {
         TC startEps, startMu, startOmegaPE, startOmegaPM, startGammaE, startGammaM;
         TC endEps, endMu, endOmegaPE, endOmegaPM, endGammaE, endGammaM;
@@ -3194,37 +3934,53 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
         }
         else
         {
-          startEps = getStartCoord (GridType::EPS, totalEps->getSize ());
-          endEps = getEndCoord (GridType::EPS, totalEps->getSize ());
+          startEps = getStartCoord (GridType::EPS, intScheme->getEps ()->getTotalSize ());
+          endEps = getEndCoord (GridType::EPS, intScheme->getEps ()->getTotalSize ());
 
-          startMu = getStartCoord (GridType::MU, totalMu->getSize ());
-          endMu = getEndCoord (GridType::MU, totalMu->getSize ());
+          startMu = getStartCoord (GridType::MU, intScheme->getMu ()->getTotalSize ());
+          endMu = getEndCoord (GridType::MU, intScheme->getMu ()->getTotalSize ());
 
           if (SOLVER_SETTINGS.getDoUseMetamaterials ())
           {
-            startOmegaPE = getStartCoord (GridType::OMEGAPE, totalOmegaPE->getSize ());
-            endOmegaPE = getEndCoord (GridType::OMEGAPE, totalOmegaPE->getSize ());
+            startOmegaPE = getStartCoord (GridType::OMEGAPE, intScheme->getOmegaPE ()->getTotalSize ());
+            endOmegaPE = getEndCoord (GridType::OMEGAPE, intScheme->getOmegaPE ()->getTotalSize ());
 
-            startOmegaPM = getStartCoord (GridType::OMEGAPM, totalOmegaPM->getSize ());
-            endOmegaPM = getEndCoord (GridType::OMEGAPM, totalOmegaPM->getSize ());
+            startOmegaPM = getStartCoord (GridType::OMEGAPM, intScheme->getOmegaPM ()->getTotalSize ());
+            endOmegaPM = getEndCoord (GridType::OMEGAPM, intScheme->getOmegaPM ()->getTotalSize ());
 
-            startGammaE = getStartCoord (GridType::GAMMAE, totalGammaE->getSize ());
-            endGammaE = getEndCoord (GridType::GAMMAE, totalGammaE->getSize ());
+            startGammaE = getStartCoord (GridType::GAMMAE, intScheme->getGammaE ()->getTotalSize ());
+            endGammaE = getEndCoord (GridType::GAMMAE, intScheme->getGammaE ()->getTotalSize ());
 
-            startGammaM = getStartCoord (GridType::GAMMAM, totalGammaM->getSize ());
-            endGammaM = getEndCoord (GridType::GAMMAM, totalGammaM->getSize ());
+            startGammaM = getStartCoord (GridType::GAMMAM, intScheme->getGammaM ()->getTotalSize ());
+            endGammaM = getEndCoord (GridType::GAMMAM, intScheme->getGammaM ()->getTotalSize ());
           }
         }
 
-        dumper[type]->dumpGrid (totalEps, startEps, endEps, 0, 0, processId);
-        dumper[type]->dumpGrid (totalMu, startMu, endMu, 0, 0, processId);
+        if (getDoUseCollectiveDATIO ())
+        {
+          dumpGridCollective (intScheme->getEps (), startEps, endEps, 0, 0);
+          dumpGridCollective (intScheme->getMu (), startMu, endMu, 0, 0);
 
-        if (SOLVER_SETTINGS.getDoUseMetamaterials ())
+          if (SOLVER_SETTINGS.getDoUseMetamaterials ())
+          {
+            dumpGridCollective (intScheme->getOmegaPE (), startOmegaPE, endOmegaPE, 0, 0);
+            dumpGridCollective (intScheme->getOmegaPM (), startOmegaPM, endOmegaPM, 0, 0);
+            dumpGridCollective (intScheme->getGammaE (), startGammaE, endGammaE, 0, 0);
+            dumpGridCollective (intScheme->getGammaM (), startGammaM, endGammaM, 0, 0);
+          }
+        }
+        else
         {
-          dumper[type]->dumpGrid (totalOmegaPE, startOmegaPE, endOmegaPE, 0, 0, processId);
-          dumper[type]->dumpGrid (totalOmegaPM, startOmegaPM, endOmegaPM, 0, 0, processId);
-          dumper[type]->dumpGrid (totalGammaE, startGammaE, endGammaE, 0, 0, processId);
-          dumper[type]->dumpGrid (totalGammaM, startGammaM, endGammaM, 0, 0, processId);
+          dumper[type]->dumpGrid (totalEps, startEps, endEps, 0, 0, processId);
+          dumper[type]->dumpGrid (totalMu, startMu, endMu, 0, 0, processId);
+
+          if (SOLVER_SETTINGS.getDoUseMetamaterials ())
+          {
+            dumper[type]->dumpGrid (totalOmegaPE, startOmegaPE, endOmegaPE, 0, 0, processId);
+            dumper[type]->dumpGrid (totalOmegaPM, startOmegaPM, endOmegaPM, 0, 0, processId);
+            dumper[type]->dumpGrid (totalGammaE, startGammaE, endGammaE, 0, 0, processId);
+            dumper[type]->dumpGrid (totalGammaM, startGammaM, endGammaM, 0, 0, processId);
+          }
         }
         //
         // if (SOLVER_SETTINGS.getDoUsePML ())
@@ -3248,32 +4004,42 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
     }
   }
 
-  if (intScheme->getDoNeedEx ())
-  {
-    initGridWithInitialVals (GridType::EX, intScheme->getEx (), 0.5 * intScheme->getGridTimeStep ());
-  }
-  if (intScheme->getDoNeedEy ())
-  {
-    initGridWithInitialVals (GridType::EY, intScheme->getEy (), 0.5 * intScheme->getGridTimeStep ());
-  }
-  if (intScheme->getDoNeedEz ())
+  /*
+   * Initial values are the same for all lanes of batched field grids
+   */
+  for (int lane = 0; lane < intScheme->getBatchSize (); ++lane)
   {
-    initGridWithInitialVals (GridType::EZ, intScheme->getEz (), 0.5 * intScheme->getGridTimeStep ());
-  }
+    intScheme->setActiveLane (lane);
 
-  if (intScheme->getDoNeedHx ())
-  {
-    initGridWithInitialVals (GridType::HX, intScheme->getHx (), intScheme->getGridTimeStep ());
-  }
-  if (intScheme->getDoNeedHy ())
-  {
-    initGridWithInitialVals (GridType::HY, intScheme->getHy (), intScheme->getGridTimeStep ());
-  }
-  if (intScheme->getDoNeedHz ())
-  {
-    initGridWithInitialVals (GridType::HZ, intScheme->getHz (), intScheme->getGridTimeStep ());
+    if (intScheme->getDoNeedEx ())
+    {
+      initGridWithInitialVals (GridType::EX, intScheme->getEx (), 0.5 * intScheme->getGridTimeStep ());
+    }
+    if (intScheme->getDoNeedEy ())
+    {
+      initGridWithInitialVals (GridType::EY, intScheme->getEy (), 0.5 * intScheme->getGridTimeStep ());
+    }
+    if (intScheme->getDoNeedEz ())
+    {
+      initGridWithInitialVals (GridType::EZ, intScheme->getEz (), 0.5 * intScheme->getGridTimeStep ());
+    }
+
+    if (intScheme->getDoNeedHx ())
+    {
+      initGridWithInitialVals (GridType::HX, intScheme->getHx (), intScheme->getGridTimeStep ());
+    }
+    if (intScheme->getDoNeedHy ())
+    {
+      initGridWithInitialVals (GridType::HY, intScheme->getHy (), intScheme->getGridTimeStep ());
+    }
+    if (intScheme->getDoNeedHz ())
+    {
+      initGridWithInitialVals (GridType::HZ, intScheme->getHz (), intScheme->getGridTimeStep ());
+    }
   }
 
+  intScheme->setActiveLane (0);
+
   if (useParallel)
   {
 #if defined (PARALLEL_GRID)
@@ -3302,7 +4068,8 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 #endif
   }
 
-  if (SOLVER_SETTINGS.getDoUseCaCbGrids ())
+  if (SOLVER_SETTINGS.getDoUseCaCbGrids ()
+      || SOLVER_SETTINGS.getDoUseCaCbMaterialIds ())
   {
     if (intScheme->getDoNeedEx ())
     {
@@ -3315,29 +4082,36 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
           continue;
         }
 
-        FPValue Ca;
-        FPValue Cb;
+        FPComputeValue Ca;
+        FPComputeValue Cb;
 
-        FPValue k_mod = FPValue (1);
+        FPComputeValue k_mod = FPComputeValue (1);
 
         TC posAbs = intScheme->getEx ()->getTotalPosition (pos);
 
         if (SOLVER_SETTINGS.getDoUsePML ())
         {
-          FPValue material = intScheme->hasSigmaY () ? intScheme->getMaterial (posAbs, GridType::EX, intScheme->getSigmaY (), GridType::SIGMAY) : 0;
-          FPValue dd = (2 * PhysicsConst::Eps0 * k_mod + material * intScheme->getGridTimeStep ());
+          FPComputeValue material = intScheme->hasSigmaY () ? intScheme->getMaterial (posAbs, GridType::EX, intScheme->getSigmaY (), GridType::SIGMAY) : 0;
+          FPComputeValue dd = (2 * PhysicsConst::Eps0 * k_mod + material * intScheme->getGridTimeStep ());
           Ca = (2 * PhysicsConst::Eps0 * k_mod - material * intScheme->getGridTimeStep ()) / dd;
           Cb = (2 * PhysicsConst::Eps0 * intScheme->getGridTimeStep () / intScheme->getGridStep ()) / dd;
         }
         else
         {
-          FPValue material = intScheme->getMaterial (posAbs, GridType::EX, intScheme->getEps (), GridType::EPS);
-          Ca = FPValue (1);
+          FPComputeValue material = intScheme->getMaterial (posAbs, GridType::EX, intScheme->getEps (), GridType::EPS);
+          Ca = FPComputeValue (1);
           Cb = intScheme->getGridTimeStep () / (material * PhysicsConst::Eps0 * intScheme->getGridStep ());
         }
 
-        intScheme->getCaEx ()->setFieldValue (FIELDVALUE (Ca, FPValue (0)), pos, 0);
-        intScheme->getCbEx ()->setFieldValue (FIELDVALUE (Cb, FPValue (0)), pos, 0);
+        if (SOLVER_SETTINGS.getDoUseCaCbMaterialIds ())
+        {
+          intScheme->getMaterialIdsEx ()->setCoefficients (i, Ca, Cb);
+        }
+        else
+        {
+          intScheme->getCaEx ()->setFieldValue (FIELDVALUE (Ca, FPValue (0)), pos, 0);
+          intScheme->getCbEx ()->setFieldValue (FIELDVALUE (Cb, FPValue (0)), pos, 0);
+        }
       }
     }
 
@@ -3352,29 +4126,36 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
           continue;
         }
 
-        FPValue Ca;
-        FPValue Cb;
+        FPComputeValue Ca;
+        FPComputeValue Cb;
 
-        FPValue k_mod = FPValue (1);
+        FPComputeValue k_mod = FPComputeValue (1);
 
         TC posAbs = intScheme->getEy ()->getTotalPosition (pos);
 
         if (SOLVER_SETTINGS.getDoUsePML ())
         {
-          FPValue material = intScheme->hasSigmaZ () ? intScheme->getMaterial (posAbs, GridType::EY, intScheme->getSigmaZ (), GridType::SIGMAZ) : 0;
-          FPValue dd = (2 * PhysicsConst::Eps0 * k_mod + material * intScheme->getGridTimeStep ());
+          FPComputeValue material = intScheme->hasSigmaZ () ? intScheme->getMaterial (posAbs, GridType::EY, intScheme->getSigmaZ (), GridType::SIGMAZ) : 0;
+          FPComputeValue dd = (2 * PhysicsConst::Eps0 * k_mod + material * intScheme->getGridTimeStep ());
           Ca = (2 * PhysicsConst::Eps0 * k_mod - material * intScheme->getGridTimeStep ()) / dd;
           Cb = (2 * PhysicsConst::Eps0 * intScheme->getGridTimeStep () / intScheme->getGridStep ()) / dd;
         }
         else
         {
-          FPValue material = intScheme->getMaterial (posAbs, GridType::EY, intScheme->getEps (), GridType::EPS);
-          Ca = FPValue (1);
+          FPComputeValue material = intScheme->getMaterial (posAbs, GridType::EY, intScheme->getEps (), GridType::EPS);
+          Ca = FPComputeValue (1);
           Cb = intScheme->getGridTimeStep () / (material * PhysicsConst::Eps0 * intScheme->getGridStep ());
         }
 
-        intScheme->getCaEy ()->setFieldValue (FIELDVALUE (Ca, FPValue (0)), pos, 0);
-        intScheme->getCbEy ()->setFieldValue (FIELDVALUE (Cb, FPValue (0)), pos, 0);
+        if (SOLVER_SETTINGS.getDoUseCaCbMaterialIds ())
+        {
+          intScheme->getMaterialIdsEy ()->setCoefficients (i, Ca, Cb);
+        }
+        else
+        {
+          intScheme->getCaEy ()->setFieldValue (FIELDVALUE (Ca, FPValue (0)), pos, 0);
+          intScheme->getCbEy ()->setFieldValue (FIELDVALUE (Cb, FPValue (0)), pos, 0);
+        }
       }
     }
 
@@ -3389,29 +4170,36 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
           continue;
         }
 
-        FPValue Ca;
-        FPValue Cb;
+        FPComputeValue Ca;
+        FPComputeValue Cb;
 
-        FPValue k_mod = FPValue (1);
+        FPComputeValue k_mod = FPComputeValue (1);
 
         TC posAbs = intScheme->getEz ()->getTotalPosition (pos);
 
         if (SOLVER_SETTINGS.getDoUsePML ())
         {
-          FPValue material = intScheme->hasSigmaX () ? intScheme->getMaterial (posAbs, GridType::EZ, intScheme->getSigmaX (), GridType::SIGMAX) : 0;
-          FPValue dd = (2 * PhysicsConst::Eps0 * k_mod + material * intScheme->getGridTimeStep ());
+          FPComputeValue material = intScheme->hasSigmaX () ? intScheme->getMaterial (posAbs, GridType::EZ, intScheme->getSigmaX (), GridType::SIGMAX) : 0;
+          FPComputeValue dd = (2 * PhysicsConst::Eps0 * k_mod + material * intScheme->getGridTimeStep ());
           Ca = (2 * PhysicsConst::Eps0 * k_mod - material * intScheme->getGridTimeStep ()) / dd;
           Cb = (2 * PhysicsConst::Eps0 * intScheme->getGridTimeStep () / intScheme->getGridStep ()) / dd;
         }
         else
         {
-          FPValue material = intScheme->getMaterial (posAbs, GridType::EZ, intScheme->getEps (), GridType::EPS);
-          Ca = FPValue (1);
+          FPComputeValue material = intScheme->getMaterial (posAbs, GridType::EZ, intScheme->getEps (), GridType::EPS);
+          Ca = FPComputeValue (1);
           Cb = intScheme->getGridTimeStep () / (material * PhysicsConst::Eps0 * intScheme->getGridStep ());
         }
 
-        intScheme->getCaEz ()->setFieldValue (FIELDVALUE (Ca, FPValue (0)), pos, 0);
-        intScheme->getCbEz ()->setFieldValue (FIELDVALUE (Cb, FPValue (0)), pos, 0);
+        if (SOLVER_SETTINGS.getDoUseCaCbMaterialIds ())
+        {
+          intScheme->getMaterialIdsEz ()->setCoefficients (i, Ca, Cb);
+        }
+        else
+        {
+          intScheme->getCaEz ()->setFieldValue (FIELDVALUE (Ca, FPValue (0)), pos, 0);
+          intScheme->getCbEz ()->setFieldValue (FIELDVALUE (Cb, FPValue (0)), pos, 0);
+        }
       }
     }
 
@@ -3426,16 +4214,16 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
           continue;
         }
 
-        FPValue Ca;
-        FPValue Cb;
+        FPComputeValue Ca;
+        FPComputeValue Cb;
 
-        FPValue k_mod = FPValue (1);
+        FPComputeValue k_mod = FPComputeValue (1);
 
         TC posAbs = intScheme->getHx ()->getTotalPosition (pos);
 
         if (SOLVER_SETTINGS.getDoUsePML ())
         {
-          FPValue material = intScheme->hasSigmaY () ? intScheme->getMaterial (posAbs, GridType::HX, intScheme->getSigmaY (), GridType::SIGMAY) : 0;
+          FPComputeValue material = intScheme->hasSigmaY () ? intScheme->getMaterial (posAbs, GridType::HX, intScheme->getSigmaY (), GridType::SIGMAY) : 0;
           Ca = (2 * PhysicsConst::Eps0 * k_mod - material * intScheme->getGridTimeStep ())
                / (2 * PhysicsConst::Eps0 * k_mod + material * intScheme->getGridTimeStep ());
           Cb = (2 * PhysicsConst::Eps0 * intScheme->getGridTimeStep () / intScheme->getGridStep ())
@@ -3443,13 +4231,20 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
         }
         else
         {
-          FPValue material = intScheme->getMaterial (posAbs, GridType::HX, intScheme->getMu (), GridType::MU);
-          Ca = FPValue (1);
+          FPComputeValue material = intScheme->getMaterial (posAbs, GridType::HX, intScheme->getMu (), GridType::MU);
+          Ca = FPComputeValue (1);
           Cb = intScheme->getGridTimeStep () / (material * PhysicsConst::Mu0 * intScheme->getGridStep ());
         }
 
-        intScheme->getDaHx ()->setFieldValue (FIELDVALUE (Ca, FPValue (0)), pos, 0);
-        intScheme->getDbHx ()->setFieldValue (FIELDVALUE (Cb, FPValue (0)), pos, 0);
+        if (SOLVER_SETTINGS.getDoUseCaCbMaterialIds ())
+        {
+          intScheme->getMaterialIdsHx ()->setCoefficients (i, Ca, Cb);
+        }
+        else
+        {
+          intScheme->getDaHx ()->setFieldValue (FIELDVALUE (Ca, FPValue (0)), pos, 0);
+          intScheme->getDbHx ()->setFieldValue (FIELDVALUE (Cb, FPValue (0)), pos, 0);
+        }
       }
     }
 
@@ -3464,16 +4259,16 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
           continue;
         }
 
-        FPValue Ca;
-        FPValue Cb;
+        FPComputeValue Ca;
+        FPComputeValue Cb;
 
-        FPValue k_mod = FPValue (1);
+        FPComputeValue k_mod = FPComputeValue (1);
 
         TC posAbs = intScheme->getHy ()->getTotalPosition (pos);
 
         if (SOLVER_SETTINGS.getDoUsePML ())
         {
-          FPValue material = intScheme->hasSigmaZ () ? intScheme->getMaterial (posAbs, GridType::HY, intScheme->getSigmaZ (), GridType::SIGMAZ) : 0;
+          FPComputeValue material = intScheme->hasSigmaZ () ? intScheme->getMaterial (posAbs, GridType::HY, intScheme->getSigmaZ (), GridType::SIGMAZ) : 0;
           Ca = (2 * PhysicsConst::Eps0 * k_mod - material * intScheme->getGridTimeStep ())
                / (2 * PhysicsConst::Eps0 * k_mod + material * intScheme->getGridTimeStep ());
           Cb = (2 * PhysicsConst::Eps0 * intScheme->getGridTimeStep () / intScheme->getGridStep ())
@@ -3481,13 +4276,20 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
         }
         else
         {
-          FPValue material = intScheme->getMaterial (posAbs, GridType::HY, intScheme->getMu (), GridType::MU);
-          Ca = FPValue (1);
+          FPComputeValue material = intScheme->getMaterial (posAbs, GridType::HY, intScheme->getMu (), GridType::MU);
+          Ca = FPComputeValue (1);
           Cb = intScheme->getGridTimeStep () / (material * PhysicsConst::Mu0 * intScheme->getGridStep ());
         }
 
-        intScheme->getDaHy ()->setFieldValue (FIELDVALUE (Ca, FPValue (0)), pos, 0);
-        intScheme->getDbHy ()->setFieldValue (FIELDVALUE (Cb, FPValue (0)), pos, 0);
+        if (SOLVER_SETTINGS.getDoUseCaCbMaterialIds ())
+        {
+          intScheme->getMaterialIdsHy ()->setCoefficients (i, Ca, Cb);
+        }
+        else
+        {
+          intScheme->getDaHy ()->setFieldValue (FIELDVALUE (Ca, FPValue (0)), pos, 0);
+          intScheme->getDbHy ()->setFieldValue (FIELDVALUE (Cb, FPValue (0)), pos, 0);
+        }
       }
     }
 
@@ -3502,16 +4304,16 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
           continue;
         }
 
-        FPValue Ca;
-        FPValue Cb;
+        FPComputeValue Ca;
+        FPComputeValue Cb;
 
-        FPValue k_mod = FPValue (1);
+        FPComputeValue k_mod = FPComputeValue (1);
 
         TC posAbs = intScheme->getHz ()->getTotalPosition (pos);
 
         if (SOLVER_SETTINGS.getDoUsePML ())
         {
-          FPValue material = intScheme->hasSigmaX () ? intScheme->getMaterial (posAbs, GridType::HZ, intScheme->getSigmaX (), GridType::SIGMAX) : 0;
+          FPComputeValue material = intScheme->hasSigmaX () ? intScheme->getMaterial (posAbs, GridType::HZ, intScheme->getSigmaX (), GridType::SIGMAX) : 0;
           Ca = (2 * PhysicsConst::Eps0 * k_mod - material * intScheme->getGridTimeStep ())
                / (2 * PhysicsConst::Eps0 * k_mod + material * intScheme->getGridTimeStep ());
           Cb = (2 * PhysicsConst::Eps0 * intScheme->getGridTimeStep () / intScheme->getGridStep ())
@@ -3519,13 +4321,20 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
         }
         else
         {
-          FPValue material = intScheme->getMaterial (posAbs, GridType::HZ, intScheme->getMu (), GridType::MU);
-          Ca = FPValue (1);
+          FPComputeValue material = intScheme->getMaterial (posAbs, GridType::HZ, intScheme->getMu (), GridType::MU);
+          Ca = FPComputeValue (1);
           Cb = intScheme->getGridTimeStep () / (material * PhysicsConst::Mu0 * intScheme->getGridStep ());
         }
 
-        intScheme->getDaHz ()->setFieldValue (FIELDVALUE (Ca, FPValue (0)), pos, 0);
-        intScheme->getDbHz ()->setFieldValue (FIELDVALUE (Cb, FPValue (0)), pos, 0);
+        if (SOLVER_SETTINGS.getDoUseCaCbMaterialIds ())
+        {
+          intScheme->getMaterialIdsHz ()->setCoefficients (i, Ca, Cb);
+        }
+        else
+        {
+          intScheme->getDaHz ()->setFieldValue (FIELDVALUE (Ca, FPValue (0)), pos, 0);
+          intScheme->getDbHz ()->setFieldValue (FIELDVALUE (Cb, FPValue (0)), pos, 0);
+        }
       }
     }
   }
@@ -3786,7 +4595,7 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
                                                        intScheme->getGammaE (), GridType::GAMMAE,
                                                        material1, material2);
 
-        FPValue materialModifier = PhysicsConst::Eps0;
+        FPComputeValue materialModifier = PhysicsConst::Eps0;
         FPValue A = 4*materialModifier*material + 2*intScheme->getGridTimeStep ()*materialModifier*material*material2 + materialModifier*SQR(intScheme->getGridTimeStep ()*material1);
         FPValue b0 = (4 + 2*intScheme->getGridTimeStep ()*material2) / A;
         FPValue b1 = -8 / A;
@@ -3823,7 +4632,7 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
                                                        intScheme->getGammaE (), GridType::GAMMAE,
                                                        material1, material2);
 
-        FPValue materialModifier = PhysicsConst::Eps0;
+        FPComputeValue materialModifier = PhysicsConst::Eps0;
         FPValue A = 4*materialModifier*material + 2*intScheme->getGridTimeStep ()*materialModifier*material*material2 + materialModifier*SQR(intScheme->getGridTimeStep ()*material1);
         FPValue b0 = (4 + 2*intScheme->getGridTimeStep ()*material2) / A;
         FPValue b1 = -8 / A;
@@ -3860,7 +4669,7 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
                                                        intScheme->getGammaE (), GridType::GAMMAE,
                                                        material1, material2);
 
-        FPValue materialModifier = PhysicsConst::Eps0;
+        FPComputeValue materialModifier = PhysicsConst::Eps0;
         FPValue A = 4*materialModifier*material + 2*intScheme->getGridTimeStep ()*materialModifier*material*material2 + materialModifier*SQR(intScheme->getGridTimeStep ()*material1);
         FPValue b0 = (4 + 2*intScheme->getGridTimeStep ()*material2) / A;
         FPValue b1 = -8 / A;
@@ -3897,7 +4706,7 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
                                                        intScheme->getGammaM (), GridType::GAMMAM,
                                                        material1, material2);
 
-        FPValue materialModifier = PhysicsConst::Mu0;
+        FPComputeValue materialModifier = PhysicsConst::Mu0;
         FPValue A = 4*materialModifier*material + 2*intScheme->getGridTimeStep ()*materialModifier*material*material2 + materialModifier*SQR(intScheme->getGridTimeStep ()*material1);
         FPValue b0 = (4 + 2*intScheme->getGridTimeStep ()*material2) / A;
         FPValue b1 = -8 / A;
@@ -3934,7 +4743,7 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
                                                        intScheme->getGammaM (), GridType::GAMMAM,
                                                        material1, material2);
 
-        FPValue materialModifier = PhysicsConst::Mu0;
+        FPComputeValue materialModifier = PhysicsConst::Mu0;
         FPValue A = 4*materialModifier*material + 2*intScheme->getGridTimeStep ()*materialModifier*material*material2 + materialModifier*SQR(intScheme->getGridTimeStep ()*material1);
         FPValue b0 = (4 + 2*intScheme->getGridTimeStep ()*material2) / A;
         FPValue b1 = -8 / A;
@@ -3971,7 +4780,7 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
                                                        intScheme->getGammaM (), GridType::GAMMAM,
                                                        material1, material2);
 
-        FPValue materialModifier = PhysicsConst::Mu0;
+        FPComputeValue materialModifier = PhysicsConst::Mu0;
         FPValue A = 4*materialModifier*material + 2*intScheme->getGridTimeStep ()*materialModifier*material*material2 + materialModifier*SQR(intScheme->getGridTimeStep ()*material1);
         FPValue b0 = (4 + 2*intScheme->getGridTimeStep ()*material2) / A;
         FPValue b1 = -8 / A;
@@ -3990,46 +4799,46 @@ Scheme<Type, TCoord, layout_type>::initGrids ()
 }
 
 /**
- * Compute value of time-averaged Poynting vector of the scattered field (mulptiplied on 4*Pi*r^2)
+ * Compute values of time-averaged Poynting vector of the scattered field (mulptiplied on 4*Pi*r^2) for all angles from
+ * local parts of N and L. Local parts for all angles are summed over all processes with a single reduction, and
+ * values are computed only on process 0.
  */
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
-FPValue
-Scheme<Type, TCoord, layout_type>::Pointing_scat (FPValue angleTeta, FPValue anglePhi, Grid<TC> *curEx, Grid<TC> *curEy, Grid<TC> *curEz,
-                       Grid<TC> *curHx, Grid<TC> *curHy, Grid<TC> *curHz, TC leftNTFF, TC rightNTFF)
+void
+Scheme<Type, TCoord, layout_type>::Pointing_scat (const std::vector<NPair> &N, /**< local parts of N for each angle */
+                                                  const std::vector<NPair> &L, /**< local parts of L for each angle */
+                                                  std::vector<FPValue> &res) /**< out: values for each angle */
 {
+  ASSERT (N.size () == L.size ());
+
+  res.assign (N.size (), FPValue (0));
+
 #ifdef COMPLEX_FIELD_VALUES
   FPValue k = 2 * PhysicsConst::Pi / intScheme->getSourceWaveLength (); // TODO: check numerical here
 
-  NPair N = ntffN (angleTeta, anglePhi, curEx, curEy, curEz, curHx, curHy, curHz, leftNTFF, rightNTFF);
-  NPair L = ntffL (angleTeta, anglePhi, curEx, curEy, curEz, curHx, curHy, curHz, leftNTFF, rightNTFF);
-
   int processId = 0;
 
+  std::vector<FieldValue> values (4 * N.size ());
+  for (size_t i = 0; i < N.size (); ++i)
+  {
+    values[4 * i] = N[i].nTeta;
+    values[4 * i + 1] = N[i].nPhi;
+    values[4 * i + 2] = L[i].nTeta;
+    values[4 * i + 3] = L[i].nPhi;
+  }
+
   if (useParallel)
   {
 #ifdef PARALLEL_GRID
     processId = ParallelGrid::getParallelCore ()->getProcessId ();
 
-    FieldValue tmpArray[4];
-    FieldValue tmpArrayRes[4];
-    const int count = 4;
-
-    tmpArray[0] = N.nTeta;
-    tmpArray[1] = N.nPhi;
-    tmpArray[2] = L.nTeta;
-    tmpArray[3] = L.nPhi;
+    std::vector<FieldValue> valuesRes (values.size ());
 
-    // gather all sum_teta and sum_phi on 0 node
-    MPI_Reduce (tmpArray, tmpArrayRes, count, MPI_FPVALUE, MPI_SUM, 0, ParallelGrid::getParallelCore ()->getCommunicator ());
-
-    if (processId == 0)
-    {
-      N.nTeta = FieldValue (tmpArrayRes[0]);
-      N.nPhi = FieldValue (tmpArrayRes[1]);
+    // gather all sum_teta and sum_phi for all angles on 0 node
+    MPI_Reduce (&values[0], &valuesRes[0], values.size (), MPI_FPVALUE, MPI_SUM, 0,
+                ParallelGrid::getParallelCore ()->getCommunicator ());
 
-      L.nTeta = FieldValue (tmpArrayRes[2]);
-      L.nPhi = FieldValue (tmpArrayRes[3]);
-    }
+    values.swap (valuesRes);
 #else
     ASSERT_MESSAGE ("Solver is not compiled with support of parallel grid. Recompile it with -DPARALLEL_GRID=ON.");
 #endif
@@ -4039,21 +4848,19 @@ Scheme<Type, TCoord, layout_type>::Pointing_scat (FPValue angleTeta, FPValue ang
   {
     FPValue n0 = sqrt (PhysicsConst::Mu0 / PhysicsConst::Eps0);
 
-    FieldValue first = L.nPhi + N.nTeta * n0;
-    FieldValue second = L.nTeta - N.nPhi * n0;
+    for (size_t i = 0; i < N.size (); ++i)
+    {
+      FieldValue first = values[4 * i + 3] + values[4 * i] * n0;
+      FieldValue second = values[4 * i + 2] - values[4 * i + 1] * n0;
 
-    FPValue first_abs2 = SQR (first.real ()) + SQR (first.imag ());
-    FPValue second_abs2 = SQR (second.real ()) + SQR (second.imag ());
+      FPValue first_abs2 = SQR (first.real ()) + SQR (first.imag ());
+      FPValue second_abs2 = SQR (second.real ()) + SQR (second.imag ());
 
-    return SQR(k) / (8 * PhysicsConst::Pi * n0) * (first_abs2 + second_abs2);
-  }
-  else
-  {
-    return FPValue (0);
+      res[i] = SQR(k) / (8 * PhysicsConst::Pi * n0) * (first_abs2 + second_abs2);
+    }
   }
 #else
   ASSERT_MESSAGE ("Solver is not compiled with support of complex values. Recompile it with -DCOMPLEX_FIELD_VALUES=ON.");
-  return FPValue (0);
 #endif
 }
 
@@ -4072,6 +4879,9 @@ template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType
 void
 Scheme<Type, TCoord, layout_type>::makeGridScattered (Grid<TC> *grid, GridType gridType)
 {
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for
+#endif /* OPENMP_ENABLED */
   for (grid_coord i = 0; i < grid->getSize ().calculateTotalCoord (); ++i)
   {
     FieldValue *val = grid->getFieldValue (i, 1);
@@ -4123,55 +4933,42 @@ Scheme<Type, TCoord, layout_type>::makeGridScattered (Grid<TC> *grid, GridType g
       continue;
     }
 
-    FieldValue iVal;
-    if (gridType == GridType::EX
-        || gridType == GridType::EY
-        || gridType == GridType::EZ)
-    {
-      iVal = intScheme->approximateIncidentWaveE (realCoord);
-    }
-    else if (gridType == GridType::HX
-             || gridType == GridType::HY
-             || gridType == GridType::HZ)
-    {
-      iVal = intScheme->approximateIncidentWaveH (realCoord);
-    }
-    else
-    {
-      UNREACHABLE;
-    }
+    /*
+     * Incident field is the sum of all incident waves, or single incident wave of active lane of batched grid
+     */
+    int wave = intScheme->getIncidentWaveOfLane (grid->getActiveLane ());
 
     FieldValue incVal;
     switch (gridType)
     {
       case GridType::EX:
       {
-        incVal = yeeLayout->getExFromIncidentE (iVal);
+        incVal = intScheme->getIncidentEx (posAbs, wave);
         break;
       }
       case GridType::EY:
       {
-        incVal = yeeLayout->getEyFromIncidentE (iVal);
+        incVal = intScheme->getIncidentEy (posAbs, wave);
         break;
       }
       case GridType::EZ:
       {
-        incVal = yeeLayout->getEzFromIncidentE (iVal);
+        incVal = intScheme->getIncidentEz (posAbs, wave);
         break;
       }
       case GridType::HX:
       {
-        incVal = yeeLayout->getHxFromIncidentH (iVal);
+        incVal = intScheme->getIncidentHx (posAbs, wave);
         break;
       }
       case GridType::HY:
       {
-        incVal = yeeLayout->getHyFromIncidentH (iVal);
+        incVal = intScheme->getIncidentHy (posAbs, wave);
         break;
       }
       case GridType::HZ:
       {
-        incVal = yeeLayout->getHzFromIncidentH (iVal);
+        incVal = intScheme->getIncidentHz (posAbs, wave);
         break;
       }
       default:
@@ -4188,6 +4985,15 @@ template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType
 void
 Scheme<Type, TCoord, layout_type>::gatherFieldsTotal (bool scattered)
 {
+  if (getDoUseCollectiveDATIO ())
+  {
+    /*
+     * Each process saves its own chunk in saveGrids
+     */
+    ASSERT (!scattered);
+    return;
+  }
+
   if (useParallel)
   {
     initFullFieldGrids ();
@@ -4229,32 +5035,38 @@ Scheme<Type, TCoord, layout_type>::gatherFieldsTotal (bool scattered)
         if (intScheme->getDoNeedEx ())
         {
           totalEx = new Grid<TC> (yeeLayout->getExSize (), intScheme->getEx ()->getCountStoredSteps (), "Ex");
+          totalEx->setBatchSize (intScheme->getEx ()->getBatchSize ());
           totalEx->copy (intScheme->getEx ());
         }
         if (intScheme->getDoNeedEy ())
         {
           totalEy = new Grid<TC> (yeeLayout->getEySize (), intScheme->getEy ()->getCountStoredSteps (), "Ey");
+          totalEy->setBatchSize (intScheme->getEy ()->getBatchSize ());
           totalEy->copy (intScheme->getEy ());
         }
         if (intScheme->getDoNeedEz ())
         {
           totalEz = new Grid<TC> (yeeLayout->getEzSize (), intScheme->getEz ()->getCountStoredSteps (), "Ez");
+          totalEz->setBatchSize (intScheme->getEz ()->getBatchSize ());
           totalEz->copy (intScheme->getEz ());
         }
 
         if (intScheme->getDoNeedHx ())
         {
           totalHx = new Grid<TC> (yeeLayout->getHxSize (), intScheme->getHx ()->getCountStoredSteps (), "Hx");
+          totalHx->setBatchSize (intScheme->getHx ()->getBatchSize ());
           totalHx->copy (intScheme->getHx ());
         }
         if (intScheme->getDoNeedHy ())
         {
           totalHy = new Grid<TC> (yeeLayout->getHySize (), intScheme->getHy ()->getCountStoredSteps (), "Hy");
+          totalHy->setBatchSize (intScheme->getHy ()->getBatchSize ());
           totalHy->copy (intScheme->getHy ());
         }
         if (intScheme->getDoNeedHz ())
         {
           totalHz = new Grid<TC> (yeeLayout->getHzSize (), intScheme->getHz ()->getCountStoredSteps (), "Hz");
+          totalHz->setBatchSize (intScheme->getHz ()->getBatchSize ());
           totalHz->copy (intScheme->getHz ());
         }
 
@@ -4293,30 +5105,57 @@ Scheme<Type, TCoord, layout_type>::gatherFieldsTotal (bool scattered)
 
   if (scattered)
   {
-    if (intScheme->getDoNeedEx ())
+    for (int lane = 0; lane < intScheme->getBatchSize (); ++lane)
     {
-      makeGridScattered (totalEx, GridType::EX);
-    }
-    if (intScheme->getDoNeedEy ())
-    {
-      makeGridScattered (totalEy, GridType::EY);
-    }
-    if (intScheme->getDoNeedEz ())
-    {
-      makeGridScattered (totalEz, GridType::EZ);
-    }
+      setActiveLane (lane);
 
-    if (intScheme->getDoNeedHx ())
-    {
-      makeGridScattered (totalHx, GridType::HX);
-    }
-    if (intScheme->getDoNeedHy ())
-    {
-      makeGridScattered (totalHy, GridType::HY);
+      if (intScheme->getDoNeedEx ())
+      {
+        makeGridScattered (totalEx, GridType::EX);
+      }
+      if (intScheme->getDoNeedEy ())
+      {
+        makeGridScattered (totalEy, GridType::EY);
+      }
+      if (intScheme->getDoNeedEz ())
+      {
+        makeGridScattered (totalEz, GridType::EZ);
+      }
+
+      if (intScheme->getDoNeedHx ())
+      {
+        makeGridScattered (totalHx, GridType::HX);
+      }
+      if (intScheme->getDoNeedHy ())
+      {
+        makeGridScattered (totalHy, GridType::HY);
+      }
+      if (intScheme->getDoNeedHz ())
+      {
+        makeGridScattered (totalHz, GridType::HZ);
+      }
     }
-    if (intScheme->getDoNeedHz ())
+
+    setActiveLane (0);
+  }
+}
+
+/**
+ * Set lane of batched field grids and of full field grids, which is accessed by computations for separate points and
+ * by dumpers
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::setActiveLane (int lane) /**< lane */
+{
+  intScheme->setActiveLane (lane);
+
+  Grid<TC> *totalGrids[] = { totalEx, totalEy, totalEz, totalHx, totalHy, totalHz };
+  for (int i = 0; i < 6; ++i)
+  {
+    if (totalGrids[i] != NULLPTR)
     {
-      makeGridScattered (totalHz, GridType::HZ);
+      totalGrids[i]->setActiveLane (lane);
     }
   }
 }
@@ -4395,78 +5234,117 @@ Scheme<Type, TCoord, layout_type>::saveGrids (time_step t)
 
     int currentLayer = 1;
 
-    if (intScheme->getDoNeedEx ())
+    /*
+     * Grids, which are updated in-place, have only single layer
+     */
+    int currentFieldLayer = InternalSchemeHelper::doUpdateFieldsInPlace () ? 0 : currentLayer;
+
+    /*
+     * Each lane of batched field grids is saved to separate files (see Grid::getName)
+     */
+    for (int lane = 0; lane < intScheme->getBatchSize (); ++lane)
     {
-      if (SOLVER_SETTINGS.getDoSaveResPerProcess ())
-      {
-        dumper[type]->dumpGrid (intScheme->getEx (), zero, intScheme->getEx ()->getSize (), t, currentLayer, processId);
-      }
-      else if (processId == 0)
+      setActiveLane (lane);
+
+      if (intScheme->getDoNeedEx ())
       {
-        dumper[type]->dumpGrid (totalEx, startEx, endEx, t, currentLayer, processId);
+        if (SOLVER_SETTINGS.getDoSaveResPerProcess ())
+        {
+          dumper[type]->dumpGrid (intScheme->getEx (), zero, intScheme->getEx ()->getSize (), t, currentFieldLayer, processId);
+        }
+        else if (getDoUseCollectiveDATIO ())
+        {
+          dumpGridCollective (intScheme->getEx (), startEx, endEx, t, currentFieldLayer);
+        }
+        else if (processId == 0)
+        {
+          dumper[type]->dumpGrid (totalEx, startEx, endEx, t, currentFieldLayer, processId);
+        }
       }
-    }
 
-    if (intScheme->getDoNeedEy ())
-    {
-      if (SOLVER_SETTINGS.getDoSaveResPerProcess ())
+      if (intScheme->getDoNeedEy ())
       {
-        dumper[type]->dumpGrid (intScheme->getEy (), zero, intScheme->getEy ()->getSize (), t, currentLayer, processId);
-      }
-      else if (processId == 0)
-      {
-        dumper[type]->dumpGrid (totalEy, startEy, endEy, t, currentLayer, processId);
+        if (SOLVER_SETTINGS.getDoSaveResPerProcess ())
+        {
+          dumper[type]->dumpGrid (intScheme->getEy (), zero, intScheme->getEy ()->getSize (), t, currentFieldLayer, processId);
+        }
+        else if (getDoUseCollectiveDATIO ())
+        {
+          dumpGridCollective (intScheme->getEy (), startEy, endEy, t, currentFieldLayer);
+        }
+        else if (processId == 0)
+        {
+          dumper[type]->dumpGrid (totalEy, startEy, endEy, t, currentFieldLayer, processId);
+        }
       }
-    }
 
-    if (intScheme->getDoNeedEz ())
-    {
-      if (SOLVER_SETTINGS.getDoSaveResPerProcess ())
-      {
-        dumper[type]->dumpGrid (intScheme->getEz (), zero, intScheme->getEz ()->getSize (), t, currentLayer, processId);
-      }
-      else if (processId == 0)
+      if (intScheme->getDoNeedEz ())
       {
-        dumper[type]->dumpGrid (totalEz, startEz, endEz, t, currentLayer, processId);
+        if (SOLVER_SETTINGS.getDoSaveResPerProcess ())
+        {
+          dumper[type]->dumpGrid (intScheme->getEz (), zero, intScheme->getEz ()->getSize (), t, currentFieldLayer, processId);
+        }
+        else if (getDoUseCollectiveDATIO ())
+        {
+          dumpGridCollective (intScheme->getEz (), startEz, endEz, t, currentFieldLayer);
+        }
+        else if (processId == 0)
+        {
+          dumper[type]->dumpGrid (totalEz, startEz, endEz, t, currentFieldLayer, processId);
+        }
       }
-    }
 
-    if (intScheme->getDoNeedHx ())
-    {
-      if (SOLVER_SETTINGS.getDoSaveResPerProcess ())
-      {
-        dumper[type]->dumpGrid (intScheme->getHx (), zero, intScheme->getHx ()->getSize (), t, currentLayer, processId);
-      }
-      else if (processId == 0)
+      if (intScheme->getDoNeedHx ())
       {
-        dumper[type]->dumpGrid (totalHx, startHx, endHx, t, currentLayer, processId);
+        if (SOLVER_SETTINGS.getDoSaveResPerProcess ())
+        {
+          dumper[type]->dumpGrid (intScheme->getHx (), zero, intScheme->getHx ()->getSize (), t, currentFieldLayer, processId);
+        }
+        else if (getDoUseCollectiveDATIO ())
+        {
+          dumpGridCollective (intScheme->getHx (), startHx, endHx, t, currentFieldLayer);
+        }
+        else if (processId == 0)
+        {
+          dumper[type]->dumpGrid (totalHx, startHx, endHx, t, currentFieldLayer, processId);
+        }
       }
-    }
 
-    if (intScheme->getDoNeedHy ())
-    {
-      if (SOLVER_SETTINGS.getDoSaveResPerProcess ())
-      {
-        dumper[type]->dumpGrid (intScheme->getHy (), zero, intScheme->getHy ()->getSize (), t, currentLayer, processId);
-      }
-      else if (processId == 0)
+      if (intScheme->getDoNeedHy ())
       {
-        dumper[type]->dumpGrid (totalHy, startHy, endHy, t, currentLayer, processId);
+        if (SOLVER_SETTINGS.getDoSaveResPerProcess ())
+        {
+          dumper[type]->dumpGrid (intScheme->getHy (), zero, intScheme->getHy ()->getSize (), t, currentFieldLayer, processId);
+        }
+        else if (getDoUseCollectiveDATIO ())
+        {
+          dumpGridCollective (intScheme->getHy (), startHy, endHy, t, currentFieldLayer);
+        }
+        else if (processId == 0)
+        {
+          dumper[type]->dumpGrid (totalHy, startHy, endHy, t, currentFieldLayer, processId);
+        }
       }
-    }
 
-    if (intScheme->getDoNeedHz ())
-    {
-      if (SOLVER_SETTINGS.getDoSaveResPerProcess ())
-      {
-        dumper[type]->dumpGrid (intScheme->getHz (), zero, intScheme->getHz ()->getSize (), t, currentLayer, processId);
-      }
-      else if (processId == 0)
+      if (intScheme->getDoNeedHz ())
       {
-        dumper[type]->dumpGrid (totalHz, startHz, endHz, t, currentLayer, processId);
+        if (SOLVER_SETTINGS.getDoSaveResPerProcess ())
+        {
+          dumper[type]->dumpGrid (intScheme->getHz (), zero, intScheme->getHz ()->getSize (), t, currentFieldLayer, processId);
+        }
+        else if (getDoUseCollectiveDATIO ())
+        {
+          dumpGridCollective (intScheme->getHz (), startHz, endHz, t, currentFieldLayer);
+        }
+        else if (processId == 0)
+        {
+          dumper[type]->dumpGrid (totalHz, startHz, endHz, t, currentFieldLayer, processId);
+        }
       }
     }
 
+    setActiveLane (0);
+
     if (SOLVER_SETTINGS.getDoSaveTFSFEInc ())
     {
       if (!dumper1D[type])
@@ -4489,12 +5367,452 @@ Scheme<Type, TCoord, layout_type>::saveGrids (time_step t)
   }
 }
 
+/**
+ * Collectively save box of parallel grid to .dat file with the same name as DATDumper uses for full grid
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::dumpGridCollective (Grid<TC> *grid, TC start, TC end, time_step t, int time_step_back)
+{
+  std::string fileName = GridFileManager::getFileName (time_step_back, t, 0, std::string (grid->getName ()), FILE_TYPE_DAT);
+
+  accessGridCollective (grid, fileName, start, end, time_step_back, true);
+}
+
+/**
+ * Move read-only material and coefficient grids to shared memory windows, so that all processes on the same shared
+ * memory node use single copy of them (see --use-node-shared-materials). Must be called after all these grids are
+ * initialized and shared.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::shareMaterialsOnNode ()
+{
+#ifdef PARALLEL_GRID
+#define SHARE_ON_NODE(x) \
+  if (intScheme->has ## x ()) \
+  { \
+    ((ParallelGrid *) intScheme->get ## x ())->shareValuesOnNode (); \
+  }
+
+  SHARE_ON_NODE (Eps)
+  SHARE_ON_NODE (Mu)
+  SHARE_ON_NODE (OmegaPE)
+  SHARE_ON_NODE (OmegaPM)
+  SHARE_ON_NODE (GammaE)
+  SHARE_ON_NODE (GammaM)
+
+  SHARE_ON_NODE (SigmaX)
+  SHARE_ON_NODE (SigmaY)
+  SHARE_ON_NODE (SigmaZ)
+
+  SHARE_ON_NODE (CaEx)
+  SHARE_ON_NODE (CbEx)
+  SHARE_ON_NODE (CaEy)
+  SHARE_ON_NODE (CbEy)
+  SHARE_ON_NODE (CaEz)
+  SHARE_ON_NODE (CbEz)
+  SHARE_ON_NODE (DaHx)
+  SHARE_ON_NODE (DbHx)
+  SHARE_ON_NODE (DaHy)
+  SHARE_ON_NODE (DbHy)
+  SHARE_ON_NODE (DaHz)
+  SHARE_ON_NODE (DbHz)
+
+  SHARE_ON_NODE (CaPMLEx)
+  SHARE_ON_NODE (CbPMLEx)
+  SHARE_ON_NODE (CcPMLEx)
+  SHARE_ON_NODE (CaPMLEy)
+  SHARE_ON_NODE (CbPMLEy)
+  SHARE_ON_NODE (CcPMLEy)
+  SHARE_ON_NODE (CaPMLEz)
+  SHARE_ON_NODE (CbPMLEz)
+  SHARE_ON_NODE (CcPMLEz)
+  SHARE_ON_NODE (DaPMLHx)
+  SHARE_ON_NODE (DbPMLHx)
+  SHARE_ON_NODE (DcPMLHx)
+  SHARE_ON_NODE (DaPMLHy)
+  SHARE_ON_NODE (DbPMLHy)
+  SHARE_ON_NODE (DcPMLHy)
+  SHARE_ON_NODE (DaPMLHz)
+  SHARE_ON_NODE (DbPMLHz)
+  SHARE_ON_NODE (DcPMLHz)
+
+#undef SHARE_ON_NODE
+#else /* PARALLEL_GRID */
+  ASSERT_MESSAGE ("Solver is not compiled with support of parallel grid. Recompile it with -DPARALLEL_GRID=ON.");
+#endif /* !PARALLEL_GRID */
+}
+
+/**
+ * Add block to checkpoint, which is being saved, or read it from checkpoint, if reader is specified
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::accessCheckpointBlock (const std::string &name, /**< name of block */
+                                                          void *data, /**< values of block */
+                                                          uint64_t size, /**< size of block in bytes */
+                                                          CheckpointReader *reader) /**< reader or NULLPTR for save */
+{
+  if (reader == NULLPTR)
+  {
+    checkpointWriter->addBlock (name, data, size);
+  }
+  else
+  {
+    reader->readBlock (name, data, size);
+  }
+}
+
+/**
+ * Save all stored time steps of grid (including buffers of parallel grid and all lanes of batched grid) to checkpoint
+ * or load them from it
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+template <typename TGridCoord>
+void
+Scheme<Type, TCoord, layout_type>::accessCheckpointGrid (Grid<TGridCoord> *grid, /**< grid */
+                                                         CheckpointReader *reader) /**< reader or NULLPTR for save */
+{
+  uint64_t size = grid->getSize ().calculateTotalCoord () * grid->getBatchSize () * sizeof (FieldValue);
+
+  for (int i = 0; i < grid->getCountStoredSteps (); ++i)
+  {
+    std::string name = std::string (grid->getName ()) + std::string ("_") + int64_to_string (i);
+    accessCheckpointBlock (name, grid->getRaw (i), size, reader);
+  }
+}
+
+/**
+ * Save all time-dependent state of process to checkpoint or load it from checkpoint. Materials and coefficients are
+ * not saved, because they are fully determined by command line.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::accessCheckpoint (CheckpointReader *reader) /**< reader or NULLPTR for save */
+{
+  /*
+   * Number of processes, number of time steps in running DFT of NTFF, share steps of E and H groups
+   */
+  uint64_t state[4];
+  state[0] = 1;
+  state[1] = ntffRunningCount;
+  state[2] = 0;
+  state[3] = 0;
+
+#ifdef PARALLEL_GRID
+  if (useParallel)
+  {
+    state[0] = ParallelGrid::getParallelCore ()->getTotalProcCount ();
+    state[2] = eGroup->getShareStep ();
+    state[3] = hGroup->getShareStep ();
+  }
+#endif /* PARALLEL_GRID */
+
+  uint64_t numProcesses = state[0];
+
+  accessCheckpointBlock ("State", state, sizeof (state), reader);
+
+  if (reader != NULLPTR)
+  {
+    if (state[0] != numProcesses)
+    {
+      ALWAYS_ASSERT_MESSAGE ("Checkpoint was saved with different number of processes.");
+    }
+
+    ntffRunningCount = state[1];
+
+#ifdef PARALLEL_GRID
+    if (useParallel)
+    {
+      eGroup->setShareStep (state[2]);
+      hGroup->setShareStep (state[3]);
+    }
+#endif /* PARALLEL_GRID */
+  }
+
+#define CHECKPOINT_GRID(x) \
+  if (intScheme->has ## x ()) \
+  { \
+    accessCheckpointGrid (intScheme->get ## x (), reader); \
+  }
+
+  CHECKPOINT_GRID (Ex)
+  CHECKPOINT_GRID (Ey)
+  CHECKPOINT_GRID (Ez)
+  CHECKPOINT_GRID (Hx)
+  CHECKPOINT_GRID (Hy)
+  CHECKPOINT_GRID (Hz)
+
+  CHECKPOINT_GRID (Dx)
+  CHECKPOINT_GRID (Dy)
+  CHECKPOINT_GRID (Dz)
+  CHECKPOINT_GRID (Bx)
+  CHECKPOINT_GRID (By)
+  CHECKPOINT_GRID (Bz)
+
+  CHECKPOINT_GRID (D1x)
+  CHECKPOINT_GRID (D1y)
+  CHECKPOINT_GRID (D1z)
+  CHECKPOINT_GRID (B1x)
+  CHECKPOINT_GRID (B1y)
+  CHECKPOINT_GRID (B1z)
+
+#undef CHECKPOINT_GRID
+
+  if (SOLVER_SETTINGS.getDoUseTFSF ())
+  {
+    accessCheckpointGrid (intScheme->getEInc (), reader);
+    accessCheckpointGrid (intScheme->getHInc (), reader);
+  }
+
+  for (size_t i = 0; i < ntffFaces.size (); ++i)
+  {
+    NTFFFace &face = ntffFaces[i];
+    std::string prefix = std::string ("NTFF") + int64_to_string (i);
+
+    uint64_t size[2];
+    size[0] = face.sizeU;
+    size[1] = face.sizeV;
+    accessCheckpointBlock (prefix + std::string ("_Size"), size, sizeof (size), reader);
+
+    if (reader != NULLPTR)
+    {
+      face.sizeU = size[0];
+      face.sizeV = size[1];
+
+      size_t count = face.sizeU * face.sizeV;
+      face.E1.resize (count);
+      face.E2.resize (count);
+      face.H1.resize (count);
+      face.H2.resize (count);
+    }
+
+    if (face.E1.empty ())
+    {
+      continue;
+    }
+
+    uint64_t bytes = face.E1.size () * sizeof (FieldValue);
+    accessCheckpointBlock (prefix + std::string ("_E1"), face.E1.data (), bytes, reader);
+    accessCheckpointBlock (prefix + std::string ("_E2"), face.E2.data (), bytes, reader);
+    accessCheckpointBlock (prefix + std::string ("_H1"), face.H1.data (), bytes, reader);
+    accessCheckpointBlock (prefix + std::string ("_H2"), face.H2.data (), bytes, reader);
+  }
+}
+
+/**
+ * Save checkpoint of process after time step t. Values are copied to memory and written in background (with C++11),
+ * while computations continue.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::saveCheckpoint (time_step t) /**< time step, after which checkpoint is saved */
+{
+  ASSERT (checkpointWriter != NULLPTR);
+
+  int processId = 0;
+
+  if (useParallel)
+  {
+#ifdef PARALLEL_GRID
+    processId = ParallelGrid::getParallelCore ()->getProcessId ();
+
+    /*
+     * Buffers should be in final state, so that no share operation is pending after restart
+     */
+    finishShareE ();
+    finishShareH ();
+#else /* PARALLEL_GRID */
+    ASSERT_MESSAGE ("Solver is not compiled with support of parallel grid. Recompile it with -DPARALLEL_GRID=ON.");
+#endif /* !PARALLEL_GRID */
+  }
+
+  /*
+   * Previous checkpoint should be complete, before it becomes the last one for restart
+   */
+  commitCheckpoint ();
+
+  if (processId == 0)
+  {
+    DPRINTF (LOG_LEVEL_STAGES, "Saving checkpoint after time step %u.\n", t);
+  }
+
+  checkpointWriter->begin (t);
+  accessCheckpoint (NULLPTR);
+  checkpointWriter->write (CheckpointWriter::getFileName (SOLVER_SETTINGS.getCheckpointDir (), t, processId));
+
+  checkpointPendingStep = t;
+}
+
+/**
+ * Wait until last checkpoint is written by all processes and make it the one to restart from. Checkpoint files, which
+ * were the last ones before, are removed.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::commitCheckpoint ()
+{
+  ASSERT (checkpointWriter != NULLPTR);
+
+  if (checkpointPendingStep == checkpointCompleteStep)
+  {
+    return;
+  }
+
+  int processId = 0;
+
+  checkpointWriter->waitForWriter ();
+
+  if (useParallel)
+  {
+#ifdef PARALLEL_GRID
+    processId = ParallelGrid::getParallelCore ()->getProcessId ();
+    MPI_Barrier (ParallelGrid::getParallelCore ()->getCommunicator ());
+#else /* PARALLEL_GRID */
+    ASSERT_MESSAGE ("Solver is not compiled with support of parallel grid. Recompile it with -DPARALLEL_GRID=ON.");
+#endif /* !PARALLEL_GRID */
+  }
+
+  if (processId == 0)
+  {
+    CheckpointWriter::writeIndex (SOLVER_SETTINGS.getCheckpointDir (), checkpointPendingStep);
+  }
+
+  if (checkpointCompleteStep > 0)
+  {
+#ifdef PARALLEL_GRID
+    if (useParallel)
+    {
+      /*
+       * Index should point to the new checkpoint, before the old one is removed
+       */
+      MPI_Barrier (ParallelGrid::getParallelCore ()->getCommunicator ());
+    }
+#endif /* PARALLEL_GRID */
+
+    remove (CheckpointWriter::getFileName (SOLVER_SETTINGS.getCheckpointDir (), checkpointCompleteStep, processId).c_str ());
+  }
+
+  checkpointCompleteStep = checkpointPendingStep;
+}
+
+/**
+ * Load checkpoint of process from directory specified with --restart-from, so that computations continue from the
+ * time step, after which it was saved
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::loadCheckpoint ()
+{
+  int processId = 0;
+
+  if (useParallel)
+  {
+#ifdef PARALLEL_GRID
+    processId = ParallelGrid::getParallelCore ()->getProcessId ();
+#else /* PARALLEL_GRID */
+    ASSERT_MESSAGE ("Solver is not compiled with support of parallel grid. Recompile it with -DPARALLEL_GRID=ON.");
+#endif /* !PARALLEL_GRID */
+  }
+
+  const std::string &dir = SOLVER_SETTINGS.getRestartDir ();
+  time_step t = CheckpointReader::readIndex (dir);
+
+  if (t > totalTimeSteps)
+  {
+    ALWAYS_ASSERT_MESSAGE ("Checkpoint is saved after the last time step of computations.");
+  }
+
+  if (processId == 0)
+  {
+    DPRINTF (LOG_LEVEL_STAGES, "Loading checkpoint saved after time step %u.\n", t);
+  }
+
+  CheckpointReader reader (CheckpointWriter::getFileName (dir, t, processId));
+  ALWAYS_ASSERT (reader.getTimeStep () == t);
+
+  accessCheckpoint (&reader);
+
+  startTimeStep = t;
+}
+
+/**
+ * Get borders of NTFF box with specified step from the default one
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::getNTFFBox (grid_coord step_ntff, /**< step of box from the default one */
+                                               TC &leftNTFF, /**< out: left border of box */
+                                               TC &rightNTFF) /**< out: right border of box */
+{
+  TC stepNTFF = TC::initAxesCoordinate (step_ntff, step_ntff, step_ntff, ct1, ct2, ct3);
+  leftNTFF = TC::initAxesCoordinate (SOLVER_SETTINGS.getNTFFSizeX (), SOLVER_SETTINGS.getNTFFSizeY (), SOLVER_SETTINGS.getNTFFSizeZ (),
+                                     ct1, ct2, ct3);
+  rightNTFF = yeeLayout->getSize () - leftNTFF + TC_COORD (1, 1, 1, ct1, ct2, ct3);
+
+  leftNTFF = leftNTFF + stepNTFF;
+  rightNTFF = rightNTFF - stepNTFF;
+}
+
+/**
+ * Add tangential fields on faces of all NTFF boxes, multiplied by phase of source frequency at time step t, to the
+ * running DFT (separately for each lane of batched field grids)
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::accumulateNTFF (time_step t)
+{
+#ifdef COMPLEX_FIELD_VALUES
+  FPValue arg = intScheme->getGridTimeStep () * t * 2 * PhysicsConst::Pi * intScheme->getSourceFrequency ();
+  FieldValue phase = FIELDVALUE (cos (arg), sin (arg));
+
+  for (int lane = 0; lane < intScheme->getBatchSize (); ++lane)
+  {
+    setActiveLane (lane);
+
+    for (grid_coord step_ntff = 0; step_ntff < SOLVER_SETTINGS.getNTFFDiff (); ++step_ntff)
+    {
+      TC leftNTFF;
+      TC rightNTFF;
+      getNTFFBox (step_ntff, leftNTFF, rightNTFF);
+
+      grid_coord index = lane * SOLVER_SETTINGS.getNTFFDiff () + step_ntff;
+      ntffAccumulate (leftNTFF, rightNTFF, phase, &ntffFaces[index * NTFF_FACES_COUNT]);
+    }
+  }
+
+  setActiveLane (0);
+
+  ++ntffRunningCount;
+#else
+  ASSERT_MESSAGE ("Solver is not compiled with support of complex values. Recompile it with -DCOMPLEX_FIELD_VALUES=ON.");
+#endif
+}
+
+/**
+ * Save NTFF of all lanes of batched field grids (NTFF of lane k is computed for incident wave k and is saved with
+ * _lane<k> suffix of file name)
+ */
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
 void
 Scheme<Type, TCoord, layout_type>::saveNTFF (bool isReverse, time_step t)
 {
   DPRINTF (LOG_LEVEL_STAGES, "Saving NTFF.\n");
 
+  for (int lane = 0; lane < intScheme->getBatchSize (); ++lane)
+  {
+    setActiveLane (lane);
+    saveNTFFOfLane (isReverse, t, lane);
+  }
+
+  setActiveLane (0);
+}
+
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void
+Scheme<Type, TCoord, layout_type>::saveNTFFOfLane (bool isReverse, time_step t, int lane)
+{
   int processId = 0;
 
   if (useParallel)
@@ -4506,15 +5824,22 @@ Scheme<Type, TCoord, layout_type>::saveNTFF (bool isReverse, time_step t)
 #endif
   }
 
-  for (grid_coord step_ntff = 0; step_ntff < SOLVER_SETTINGS.getNTFFDiff (); ++step_ntff)
+  FPValue incAngle1 = yeeLayout->getIncidentWaveAngle1 ();
+  FPValue incAngle2 = yeeLayout->getIncidentWaveAngle2 ();
+  FPValue incAngle3 = yeeLayout->getIncidentWaveAngle3 ();
+  std::string laneSuffix;
+
+  if (intScheme->getBatchSize () > 1)
   {
-    TC stepNTFF = TC::initAxesCoordinate (step_ntff, step_ntff, step_ntff, ct1, ct2, ct3);
-    TC leftNTFF = TC::initAxesCoordinate (SOLVER_SETTINGS.getNTFFSizeX (), SOLVER_SETTINGS.getNTFFSizeY (), SOLVER_SETTINGS.getNTFFSizeZ (),
-                                          ct1, ct2, ct3);
-    TC rightNTFF = yeeLayout->getSize () - leftNTFF + TC_COORD (1, 1, 1, ct1, ct2, ct3);
+    intScheme->getIncidentWaveAngles (intScheme->getIncidentWaveOfLane (lane), incAngle1, incAngle2, incAngle3);
+    laneSuffix = std::string ("_lane") + int64_to_string (lane);
+  }
 
-    leftNTFF = leftNTFF + stepNTFF;
-    rightNTFF = rightNTFF - stepNTFF;
+  for (grid_coord step_ntff = 0; step_ntff < SOLVER_SETTINGS.getNTFFDiff (); ++step_ntff)
+  {
+    TC leftNTFF;
+    TC rightNTFF;
+    getNTFFBox (step_ntff, leftNTFF, rightNTFF);
 
     std::ofstream outfile;
     std::ostream *outs;
@@ -4526,8 +5851,8 @@ Scheme<Type, TCoord, layout_type>::saveNTFF (bool isReverse, time_step t)
     if (isReverse)
     {
       strName = "Reverse diagram";
-      start = yeeLayout->getIncidentWaveAngle2 ();
-      end = yeeLayout->getIncidentWaveAngle2 ();
+      start = incAngle2;
+      end = incAngle2;
       step = 1.0;
     }
     else
@@ -4548,6 +5873,7 @@ Scheme<Type, TCoord, layout_type>::saveNTFF (bool isReverse, time_step t)
       else
       {
         std::string ntffFileName = SOLVER_SETTINGS.getFileNameNTFF ()
+                                   + laneSuffix
                                    + std::string ("_[timestep=")
                                    + int64_to_string (t)
                                    + std::string ("]_[step=")
@@ -4561,28 +5887,57 @@ Scheme<Type, TCoord, layout_type>::saveNTFF (bool isReverse, time_step t)
       (*outs) << strName << std::endl << std::endl;
     }
 
+    std::vector<FPValue> anglesTeta;
+    std::vector<FPValue> anglesPhi;
     for (FPValue angle = start; angle <= end; angle += step)
     {
-      FPValue val = Pointing_scat (yeeLayout->getIncidentWaveAngle1 (),
-                                   angle,
-                                   intScheme->getEx (),
-                                   intScheme->getEy (),
-                                   intScheme->getEz (),
-                                   intScheme->getHx (),
-                                   intScheme->getHy (),
-                                   intScheme->getHz (),
-                                   leftNTFF,
-                                   rightNTFF);
-      val /= Pointing_inc (yeeLayout->getIncidentWaveAngle1 (), angle);
+      anglesTeta.push_back (incAngle1);
+      anglesPhi.push_back (angle);
+    }
+
+    /*
+     * Tangential fields on faces are sampled once, and then N and L for all angles are computed from them
+     */
+    std::vector<NTFFFace> faces;
+    const NTFFFace *curFaces;
+    FPValue norm;
+
+    if (SOLVER_SETTINGS.getDoUseNTFFRunningDFT ())
+    {
+      ASSERT (ntffRunningCount > 0);
+
+      curFaces = &ntffFaces[(lane * SOLVER_SETTINGS.getNTFFDiff () + step_ntff) * NTFF_FACES_COUNT];
+      norm = FPValue (1) / ntffRunningCount;
+    }
+    else
+    {
+      faces.resize (NTFF_FACES_COUNT);
+      ntffAccumulate (leftNTFF, rightNTFF, FIELDVALUE (1, 0), &faces[0]);
+
+      curFaces = &faces[0];
+      norm = FPValue (1);
+    }
+
+    std::vector<NPair> N;
+    std::vector<NPair> L;
+    ntffFarField (anglesTeta, anglesPhi, leftNTFF, rightNTFF, curFaces, norm, N, L);
+
+    std::vector<FPValue> values;
+    Pointing_scat (N, L, values);
+
+    for (size_t i = 0; i < anglesPhi.size (); ++i)
+    {
+      FPValue angle = anglesPhi[i];
+      FPValue val = values[i] / Pointing_inc (anglesTeta[i], angle);
 
       if (processId == 0)
       {
         (*outs) << "timestep = "
                 << t
                 << ", incident wave angle=("
-                << yeeLayout->getIncidentWaveAngle1 () << ","
-                << yeeLayout->getIncidentWaveAngle2 () << ","
-                << yeeLayout->getIncidentWaveAngle3 () << ","
+                << incAngle1 << ","
+                << incAngle2 << ","
+                << incAngle3 << ","
                 << "), angle NTFF = "
                 << angle
                 << ", NTFF value = "
@@ -14,6 +14,9 @@
 #include "TXTDumper.h"
 #include "TXTLoader.h"
 
+#include <algorithm>
+#include <vector>
+
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
 class Scheme;
 
@@ -34,6 +37,37 @@ struct NPair
   }
 };
 
+/**
+ * Number of faces of NTFF box (left and right faces for each axis)
+ */
+#define NTFF_FACES_COUNT 6
+
+/**
+ * Number of angles, for which NTFF is computed in one pass over faces of NTFF box
+ */
+#define NTFF_ANGLES_BLOCK ((size_t) 64)
+
+/**
+ * Tangential components of E and H (instantaneous or running DFT) in the middles of cells of NTFF face (see
+ * ntffSampleFace3D for order of components). Values are stored for all cells of face, first tangential axis is the outer one.
+ */
+struct NTFFFace
+{
+  grid_coord sizeU; /**< number of cells by first tangential axis */
+  grid_coord sizeV; /**< number of cells by second tangential axis */
+
+  std::vector<FieldValue> E1;
+  std::vector<FieldValue> E2;
+  std::vector<FieldValue> H1;
+  std::vector<FieldValue> H2;
+
+  NTFFFace ()
+    : sizeU (0)
+  , sizeV (0)
+  {
+  }
+};
+
 class SchemeHelper
 {
 public:
@@ -68,7 +102,7 @@ public:
       scheme->shareH ();
     }
 #endif /* CUDA_ENABLED */
-    scheme->rebalance ();
+    scheme->rebalance (tStart + N);
 #endif /* PARALLEL_GRID */
 
     /*
@@ -97,6 +131,12 @@ public:
 
       scheme->saveGrids (tStart + N);
     }
+
+    if (SOLVER_SETTINGS.getCheckpointStep () > 0
+        && ((tStart) / SOLVER_SETTINGS.getCheckpointStep () < (tStart + N) / SOLVER_SETTINGS.getCheckpointStep ()))
+    {
+      scheme->saveCheckpoint (tStart + N);
+    }
   }
 
   template <SchemeType_t Type, LayoutType layout_type>
@@ -132,7 +172,7 @@ public:
       scheme->shareH ();
     }
 #endif /* CUDA_ENABLED */
-    scheme->rebalance ();
+    scheme->rebalance (tStart + N);
 #endif /* PARALLEL_GRID */
 
     /*
@@ -161,6 +201,12 @@ public:
 
       scheme->saveGrids (tStart + N);
     }
+
+    if (SOLVER_SETTINGS.getCheckpointStep () > 0
+        && ((tStart) / SOLVER_SETTINGS.getCheckpointStep () < (tStart + N) / SOLVER_SETTINGS.getCheckpointStep ()))
+    {
+      scheme->saveCheckpoint (tStart + N);
+    }
   }
 
   template <SchemeType_t Type, LayoutType layout_type>
@@ -199,7 +245,7 @@ public:
       scheme->shareH ();
     }
 #endif /* CUDA_ENABLED */
-    scheme->rebalance ();
+    scheme->rebalance (tStart + N);
 #endif /* PARALLEL_GRID */
 
     /*
@@ -208,6 +254,12 @@ public:
      * obtained on CPU at all.
      */
 
+    if (SOLVER_SETTINGS.getDoUseNTFF ()
+        && SOLVER_SETTINGS.getDoUseNTFFRunningDFT ())
+    {
+      scheme->accumulateNTFF (tStart + N);
+    }
+
     if (SOLVER_SETTINGS.getDoUseNTFF ()
         && ((tStart) / SOLVER_SETTINGS.getIntermediateNTFFStep () < (tStart + N) / SOLVER_SETTINGS.getIntermediateNTFFStep ()))
     {
@@ -228,6 +280,12 @@ public:
 
       scheme->saveGrids (tStart + N);
     }
+
+    if (SOLVER_SETTINGS.getCheckpointStep () > 0
+        && ((tStart) / SOLVER_SETTINGS.getCheckpointStep () < (tStart + N) / SOLVER_SETTINGS.getCheckpointStep ()))
+    {
+      scheme->saveCheckpoint (tStart + N);
+    }
   }
 
   static
@@ -317,6 +375,87 @@ public:
 #endif
   }
 
+  static
+  void accessGridCollective1D (Grid<GridCoordinate1D> *grid, const std::string &fileName,
+                                GridCoordinate1D start, GridCoordinate1D end, int time_step_back, bool isWrite)
+  {
+#ifdef PARALLEL_GRID
+#ifdef GRID_1D
+    if (isWrite)
+    {
+      ((ParallelGrid *) grid)->dumpCollective (fileName, start, end, time_step_back);
+    }
+    else if (SOLVER_SETTINGS.getDoUseMmapDATIO ())
+    {
+      ((ParallelGrid *) grid)->loadMapped (fileName, start, end, time_step_back);
+    }
+    else
+    {
+      ((ParallelGrid *) grid)->loadCollective (fileName, start, end, time_step_back);
+    }
+#else
+    ASSERT_MESSAGE ("Solver is not compiled with support of parallel grid for this dimension. "
+                    "Recompile it with -DPARALLEL_GRID_DIMENSION=1.");
+#endif
+#else
+    ASSERT_MESSAGE ("Solver is not compiled with support of parallel grid. Recompile it with -DPARALLEL_GRID=ON.");
+#endif
+  }
+
+  static
+  void accessGridCollective2D (Grid<GridCoordinate2D> *grid, const std::string &fileName,
+                                GridCoordinate2D start, GridCoordinate2D end, int time_step_back, bool isWrite)
+  {
+#ifdef PARALLEL_GRID
+#ifdef GRID_2D
+    if (isWrite)
+    {
+      ((ParallelGrid *) grid)->dumpCollective (fileName, start, end, time_step_back);
+    }
+    else if (SOLVER_SETTINGS.getDoUseMmapDATIO ())
+    {
+      ((ParallelGrid *) grid)->loadMapped (fileName, start, end, time_step_back);
+    }
+    else
+    {
+      ((ParallelGrid *) grid)->loadCollective (fileName, start, end, time_step_back);
+    }
+#else
+    ASSERT_MESSAGE ("Solver is not compiled with support of parallel grid for this dimension. "
+                    "Recompile it with -DPARALLEL_GRID_DIMENSION=2.");
+#endif
+#else
+    ASSERT_MESSAGE ("Solver is not compiled with support of parallel grid. Recompile it with -DPARALLEL_GRID=ON.");
+#endif
+  }
+
+  static
+  void accessGridCollective3D (Grid<GridCoordinate3D> *grid, const std::string &fileName,
+                                GridCoordinate3D start, GridCoordinate3D end, int time_step_back, bool isWrite)
+  {
+#ifdef PARALLEL_GRID
+#ifdef GRID_3D
+    if (isWrite)
+    {
+      ((ParallelGrid *) grid)->dumpCollective (fileName, start, end, time_step_back);
+    }
+    else if (SOLVER_SETTINGS.getDoUseMmapDATIO ())
+    {
+      ((ParallelGrid *) grid)->loadMapped (fileName, start, end, time_step_back);
+    }
+    else
+    {
+      ((ParallelGrid *) grid)->loadCollective (fileName, start, end, time_step_back);
+    }
+#else
+    ASSERT_MESSAGE ("Solver is not compiled with support of parallel grid for this dimension. "
+                    "Recompile it with -DPARALLEL_GRID_DIMENSION=3.");
+#endif
+#else
+    ASSERT_MESSAGE ("Solver is not compiled with support of parallel grid. Recompile it with -DPARALLEL_GRID=ON.");
+#endif
+  }
+
   static
   void initFullFieldGrids1D (bool *totalInitialized,
                              bool doNeedEx, Grid<GridCoordinate1D> *Ex, Grid<GridCoordinate1D> **totalEx,
@@ -579,6 +718,9 @@ public:
     FPValue PMLSizeX = FPValue (PMLSize.get1 ());
     FPValue boundary = PMLSizeX * dx;
 
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for
+#endif /* OPENMP_ENABLED */
     for (grid_coord i = 0; i < sigma->getSize ().calculateTotalCoord (); ++i)
     {
       TCoord<grid_coord, true> pos = sigma->calculatePositionFromIndex (i);
@@ -619,6 +761,9 @@ public:
     FPValue PMLSizeY = FPValue (PMLSize.get2 ());
     FPValue boundary = PMLSizeY * dx;
 
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for
+#endif /* OPENMP_ENABLED */
     for (grid_coord i = 0; i < sigma->getSize ().calculateTotalCoord (); ++i)
     {
       TCoord<grid_coord, true> pos = sigma->calculatePositionFromIndex (i);
@@ -659,6 +804,9 @@ public:
     FPValue PMLSizeZ = FPValue (PMLSize.get3 ());
     FPValue boundary = PMLSizeZ * dx;
 
+#ifdef OPENMP_ENABLED
+#pragma omp parallel for
+#endif /* OPENMP_ENABLED */
     for (grid_coord i = 0; i < sigma->getSize ().calculateTotalCoord (); ++i)
     {
       TCoord<grid_coord, true> pos = sigma->calculatePositionFromIndex (i);
@@ -693,141 +841,78 @@ public:
 
   template <LayoutType layout_type>
   static
-  NPair ntffN3D_x (grid_coord, FPValue, FPValue,
-                   GridCoordinate3D, GridCoordinate3D,
-                   YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *,
-                   FPValue, FPValue,
-                   Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *);
-  template <LayoutType layout_type>
-  static
-  NPair ntffN3D_y (grid_coord, FPValue, FPValue,
-                   GridCoordinate3D, GridCoordinate3D,
-                   YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *,
-                   FPValue, FPValue,
-                   Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *);
-  template <LayoutType layout_type>
+  bool ntffSampleFace3D (OrthogonalAxis, GridCoordinateFP3D, bool,
+                         YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *,
+                         Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *,
+                         Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *,
+                         Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *,
+                         FieldValue &, FieldValue &);
   static
-  NPair ntffN3D_z (grid_coord, FPValue, FPValue,
-                   GridCoordinate3D, GridCoordinate3D,
-                   YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *,
-                   FPValue, FPValue,
-                   Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *);
+  NPair ntffTerm3D (OrthogonalAxis, bool, FPValue, FPValue, FieldValue, FieldValue);
   template <LayoutType layout_type>
   static
-  NPair ntffN3D (FPValue, FPValue,
-                 GridCoordinate3D, GridCoordinate3D,
-                 YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *,
-                 FPValue, FPValue,
-                 Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *,
-                 Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *,
-                 Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *);
+  void ntffAccumulate3D (GridCoordinate3D, GridCoordinate3D,
+                         YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *,
+                         FieldValue,
+                         Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *,
+                         Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *,
+                         Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *,
+                         NTFFFace *);
 
   template <SchemeType_t Type, LayoutType layout_type>
   static
-  NPair ntffN2D (FPValue, FPValue,
-                 GridCoordinate2D, GridCoordinate2D,
-                 YeeGridLayout<Type, GridCoordinate2DTemplate, layout_type> *,
-                 FPValue, FPValue,
-                 Grid<GridCoordinate2D> *, Grid<GridCoordinate2D> *,
-                 Grid<GridCoordinate2D> *, Grid<GridCoordinate2D> *,
-                 Grid<GridCoordinate2D> *, Grid<GridCoordinate2D> *)
+  void ntffAccumulate2D (GridCoordinate2D, GridCoordinate2D,
+                         YeeGridLayout<Type, GridCoordinate2DTemplate, layout_type> *,
+                         FieldValue,
+                         Grid<GridCoordinate2D> *, Grid<GridCoordinate2D> *,
+                         Grid<GridCoordinate2D> *, Grid<GridCoordinate2D> *,
+                         Grid<GridCoordinate2D> *, Grid<GridCoordinate2D> *,
+                         NTFFFace *)
   {
     UNREACHABLE;
-    return NPair ();
   }
 
   template <SchemeType_t Type, LayoutType layout_type>
   static
-  NPair ntffN1D (FPValue, FPValue,
-                 GridCoordinate1D, GridCoordinate1D,
-                 YeeGridLayout<Type, GridCoordinate1DTemplate, layout_type> *,
-                 FPValue, FPValue,
-                 Grid<GridCoordinate1D> *, Grid<GridCoordinate1D> *,
-                 Grid<GridCoordinate1D> *, Grid<GridCoordinate1D> *,
-                 Grid<GridCoordinate1D> *, Grid<GridCoordinate1D> *)
+  void ntffAccumulate1D (GridCoordinate1D, GridCoordinate1D,
+                         YeeGridLayout<Type, GridCoordinate1DTemplate, layout_type> *,
+                         FieldValue,
+                         Grid<GridCoordinate1D> *, Grid<GridCoordinate1D> *,
+                         Grid<GridCoordinate1D> *, Grid<GridCoordinate1D> *,
+                         Grid<GridCoordinate1D> *, Grid<GridCoordinate1D> *,
+                         NTFFFace *)
   {
     UNREACHABLE;
-    return NPair ();
   }
 
   template <LayoutType layout_type>
   static
-  NPair ntffL3D_x (grid_coord, FPValue, FPValue,
-                   GridCoordinate3D, GridCoordinate3D,
-                   YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *,
-                   FPValue, FPValue,
-                   Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *);
-  template <LayoutType layout_type>
-  static
-  NPair ntffL3D_y (grid_coord, FPValue, FPValue,
-                   GridCoordinate3D, GridCoordinate3D,
-                   YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *,
-                   FPValue, FPValue,
-                   Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *);
-  template <LayoutType layout_type>
-  static
-  NPair ntffL3D_z (grid_coord, FPValue, FPValue,
-                   GridCoordinate3D, GridCoordinate3D,
-                   YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *,
-                   FPValue, FPValue,
-                   Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *,
-                   Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *);
-  template <LayoutType layout_type>
-  static
-  NPair ntffL3D (FPValue, FPValue,
-                 GridCoordinate3D, GridCoordinate3D,
-                 YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *,
-                 FPValue, FPValue,
-                 Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *,
-                 Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *,
-                 Grid<GridCoordinate3D> *, Grid<GridCoordinate3D> *);
+  void ntffFarField3D (const std::vector<FPValue> &, const std::vector<FPValue> &,
+                       GridCoordinate3D, GridCoordinate3D,
+                       YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *,
+                       FPValue, FPValue,
+                       const NTFFFace *, FPValue, std::vector<NPair> &, std::vector<NPair> &);
 
   template <SchemeType_t Type, LayoutType layout_type>
   static
-  NPair ntffL2D (FPValue, FPValue,
-                 GridCoordinate2D, GridCoordinate2D,
-                 YeeGridLayout<Type, GridCoordinate2DTemplate, layout_type> *,
-                 FPValue, FPValue,
-                 Grid<GridCoordinate2D> *, Grid<GridCoordinate2D> *,
-                 Grid<GridCoordinate2D> *, Grid<GridCoordinate2D> *,
-                 Grid<GridCoordinate2D> *, Grid<GridCoordinate2D> *)
+  void ntffFarField2D (const std::vector<FPValue> &, const std::vector<FPValue> &,
+                       GridCoordinate2D, GridCoordinate2D,
+                       YeeGridLayout<Type, GridCoordinate2DTemplate, layout_type> *,
+                       FPValue, FPValue,
+                       const NTFFFace *, FPValue, std::vector<NPair> &, std::vector<NPair> &)
   {
     UNREACHABLE;
-    return NPair ();
   }
 
   template <SchemeType_t Type, LayoutType layout_type>
   static
-  NPair ntffL1D (FPValue, FPValue,
-                 GridCoordinate1D, GridCoordinate1D,
-                 YeeGridLayout<Type, GridCoordinate1DTemplate, layout_type> *,
-                 FPValue, FPValue,
-                 Grid<GridCoordinate1D> *, Grid<GridCoordinate1D> *,
-                 Grid<GridCoordinate1D> *, Grid<GridCoordinate1D> *,
-                 Grid<GridCoordinate1D> *, Grid<GridCoordinate1D> *)
+  void ntffFarField1D (const std::vector<FPValue> &, const std::vector<FPValue> &,
+                       GridCoordinate1D, GridCoordinate1D,
+                       YeeGridLayout<Type, GridCoordinate1DTemplate, layout_type> *,
+                       FPValue, FPValue,
+                       const NTFFFace *, FPValue, std::vector<NPair> &, std::vector<NPair> &)
   {
     UNREACHABLE;
-    return NPair ();
   }
 
   template <typename TCoord>
@@ -1003,590 +1088,245 @@ public:
 
 
 /**
- * Compute N for +-x0 on time step t+0.5 (i.e. E is used as is, H as is averaged for t and t+1)
+ * Get tangential components of E (for L) or H (for N) in the middle of cell of NTFF face on time step t+0.5
+ * (i.e. E is used as is, H is averaged for t and t+1). Components are ordered as follows:
+ *   - Ez, Ey (Hz, Hy) for faces, which are orthogonal to x axis
+ *   - Ez, Ex (Hz, Hx) for faces, which are orthogonal to y axis
+ *   - Ey, Ex (Hy, Hx) for faces, which are orthogonal to z axis
+ *
+ * @return false if values are not stored in this process (i.e. are not available or are in left buffer), true otherwise
  */
 template <LayoutType layout_type>
-NPair
-SchemeHelper::ntffN3D_x (grid_coord x0, FPValue angleTeta, FPValue anglePhi,
-                         GridCoordinate3D leftNTFF,
-                         GridCoordinate3D rightNTFF,
-                         YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *yeeLayout,
-                         FPValue gridStep,
-                         FPValue sourceWaveLength,
-                         Grid<GridCoordinate3D> *curEx,
-                         Grid<GridCoordinate3D> *curEy,
-                         Grid<GridCoordinate3D> *curEz,
-                         Grid<GridCoordinate3D> *curHx,
-                         Grid<GridCoordinate3D> *curHy,
-                         Grid<GridCoordinate3D> *curHz)
+bool
+SchemeHelper::ntffSampleFace3D (OrthogonalAxis normal, /**< axis, which is orthogonal to face */
+                                GridCoordinateFP3D pos, /**< middle of face cell */
+                                bool isH, /**< flag whether to get H (for N) or E (for L) */
+                                YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *yeeLayout,
+                                Grid<GridCoordinate3D> *curEx,
+                                Grid<GridCoordinate3D> *curEy,
+                                Grid<GridCoordinate3D> *curEz,
+                                Grid<GridCoordinate3D> *curHx,
+                                Grid<GridCoordinate3D> *curHy,
+                                Grid<GridCoordinate3D> *curHz,
+                                FieldValue &val1, /**< out: first tangential component */
+                                FieldValue &val2) /**< out: second tangential component */
 {
-#ifdef COMPLEX_FIELD_VALUES
-  ASSERT (yeeLayout->getSize ().get1 () % 2 == 0);
-  ASSERT (yeeLayout->getSize ().get2 () % 2 == 0);
-  ASSERT (yeeLayout->getSize ().get3 () % 2 == 0);
-  FPValue diffx0 = yeeLayout->getSize ().get1 () / 2;
-  FPValue diffy0 = yeeLayout->getSize ().get2 () / 2;
-  FPValue diffz0 = yeeLayout->getSize ().get3 () / 2;
-
   CoordinateType ct1, ct2, ct3;
 #ifdef DEBUG_INFO
-  ct1 = leftNTFF.getType1 ();
-  ct2 = leftNTFF.getType2 ();
-  ct3 = leftNTFF.getType3 ();
+  ct1 = pos.getType1 ();
+  ct2 = pos.getType2 ();
+  ct3 = pos.getType3 ();
 #endif
 
-  GridCoordinateFP3D coordStart = GRID_COORDINATE_FP_3D (x0, leftNTFF.get2 () + 0.5, leftNTFF.get3 () + 0.5, ct1, ct2, ct3);
-  GridCoordinateFP3D coordEnd = GRID_COORDINATE_FP_3D (x0, rightNTFF.get2 () - 0.5, rightNTFF.get3 () - 0.5, ct1, ct2, ct3);
+  GridCoordinateFP3D halfShift[3] =
+  {
+    GRID_COORDINATE_FP_3D (0.5, 0, 0, ct1, ct2, ct3),
+    GRID_COORDINATE_FP_3D (0, 0.5, 0, ct1, ct2, ct3),
+    GRID_COORDINATE_FP_3D (0, 0, 0.5, ct1, ct2, ct3)
+  };
 
-  FieldValue sum_teta (0.0, 0.0);
-  FieldValue sum_phi (0.0, 0.0);
+  Grid<GridCoordinate3D> *grids[3] =
+  {
+    isH ? curHx : curEx,
+    isH ? curHy : curEy,
+    isH ? curHz : curEz
+  };
 
-  for (FPValue coordY = coordStart.get2 (); coordY <= coordEnd.get2 (); ++coordY)
+  GridCoordinateFP3D minCoords[3] =
   {
-    for (FPValue coordZ = coordStart.get3 (); coordZ <= coordEnd.get3 (); ++coordZ)
-    {
-      FieldValue Hz1;
-      FieldValue Hz2;
-      FieldValue Hy1;
-      FieldValue Hy2;
+    isH ? yeeLayout->getMinHxCoordFP () : yeeLayout->getMinExCoordFP (),
+    isH ? yeeLayout->getMinHyCoordFP () : yeeLayout->getMinEyCoordFP (),
+    isH ? yeeLayout->getMinHzCoordFP () : yeeLayout->getMinEzCoordFP ()
+  };
 
-      if (layout_type == E_CENTERED)
-      {
-        GridCoordinateFP3D pos1 = GRID_COORDINATE_FP_3D (x0, coordY - 0.5, coordZ, ct1, ct2, ct3);
-        GridCoordinateFP3D pos2 = GRID_COORDINATE_FP_3D (x0, coordY + 0.5, coordZ, ct1, ct2, ct3);
-        GridCoordinateFP3D pos3 = GRID_COORDINATE_FP_3D (x0, coordY, coordZ - 0.5, ct1, ct2, ct3);
-        GridCoordinateFP3D pos4 = GRID_COORDINATE_FP_3D (x0, coordY, coordZ + 0.5, ct1, ct2, ct3);
+  uint8_t n = static_cast<uint8_t> (normal);
 
-        pos1 = pos1 - yeeLayout->getMinHzCoordFP ();
-        pos2 = pos2 - yeeLayout->getMinHzCoordFP ();
+  uint8_t comp[2];
+  comp[0] = n == 2 ? 1 : 2;
+  comp[1] = n == 0 ? 1 : 0;
 
-        pos3 = pos3 - yeeLayout->getMinHyCoordFP ();
-        pos4 = pos4 - yeeLayout->getMinHyCoordFP ();
+  /*
+   * H for E_CENTERED layout and E for H_CENTERED layout are placed on face. Other fields are placed at the half of cell
+   * from face and are averaged for both sides of face. Each component is averaged for two neighboring points of face.
+   */
+  bool doAverageNormal = (layout_type == E_CENTERED) != isH;
+  int countNormal = doAverageNormal ? 2 : 1;
 
-        GridCoordinate3D pos11 = convertCoord (pos1);
-        GridCoordinate3D pos21 = convertCoord (pos2);
-        GridCoordinate3D pos31 = convertCoord (pos3);
-        GridCoordinate3D pos41 = convertCoord (pos4);
+  GridCoordinate3D positions[2][2][2];
+  FieldValue *values[2][2][2];
 
-        FieldValue *valHz1 = curHz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos11);
-        FieldValue *valHz2 = curHz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos21);
+  for (int c = 0; c < 2; ++c)
+  {
+    uint8_t split = doAverageNormal ? comp[c] : comp[1 - c];
+    Grid<GridCoordinate3D> *grid = grids[comp[c]];
 
-        FieldValue *valHy1 = curHy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos31);
-        FieldValue *valHy2 = curHy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos41);
+    for (int side = 0; side < 2; ++side)
+    {
+      GridCoordinateFP3D posSide = side == 0 ? pos - halfShift[split] : pos + halfShift[split];
+      posSide = posSide - minCoords[comp[c]];
 
-#ifdef PARALLEL_GRID
-        if (valHz1 == NULLPTR || ((ParallelGrid*) curHz)->isBufferLeftPosition (pos11)
-            || valHz2 == NULLPTR || ((ParallelGrid*) curHz)->isBufferLeftPosition (pos21)
-            || valHy1 == NULLPTR || ((ParallelGrid*) curHy)->isBufferLeftPosition (pos31)
-            || valHy2 == NULLPTR || ((ParallelGrid*) curHy)->isBufferLeftPosition (pos41))
+      for (int k = 0; k < countNormal; ++k)
+      {
+        GridCoordinateFP3D posPoint = posSide;
+        if (doAverageNormal)
         {
-          continue;
+          posPoint = k == 0 ? posSide - halfShift[n] : posSide + halfShift[n];
         }
-#endif
-
-        FieldValue *valHz1_prev = curHz->getFieldValuePreviousAfterShiftByAbsolutePos (pos11);
-        FieldValue *valHz2_prev = curHz->getFieldValuePreviousAfterShiftByAbsolutePos (pos21);
 
-        FieldValue *valHy1_prev = curHy->getFieldValuePreviousAfterShiftByAbsolutePos (pos31);
-        FieldValue *valHy2_prev = curHy->getFieldValuePreviousAfterShiftByAbsolutePos (pos41);
-
-        ASSERT (valHz1 != NULLPTR && valHz2 != NULLPTR && valHy1 != NULLPTR && valHy2 != NULLPTR
-                && valHz1_prev != NULLPTR && valHz2_prev != NULLPTR && valHy1_prev != NULLPTR && valHy2_prev != NULLPTR);
-
-        Hz1 = (*valHz1 + *valHz1_prev) / FPValue (2);
-        Hz2 = (*valHz2 + *valHz2_prev) / FPValue (2);
-        Hy1 = (*valHy1 + *valHy1_prev) / FPValue (2);
-        Hy2 = (*valHy2 + *valHy2_prev) / FPValue (2);
-      }
-      else if (layout_type == H_CENTERED)
-      {
-        GridCoordinateFP3D pos1 = GRID_COORDINATE_FP_3D (x0, coordY, coordZ - 0.5, ct1, ct2, ct3);
-        GridCoordinateFP3D pos2 = GRID_COORDINATE_FP_3D (x0, coordY, coordZ + 0.5, ct1, ct2, ct3);
-        GridCoordinateFP3D pos3 = GRID_COORDINATE_FP_3D (x0, coordY - 0.5, coordZ, ct1, ct2, ct3);
-        GridCoordinateFP3D pos4 = GRID_COORDINATE_FP_3D (x0, coordY + 0.5, coordZ, ct1, ct2, ct3);
-
-        pos1 = pos1 - yeeLayout->getMinHzCoordFP ();
-        pos2 = pos2 - yeeLayout->getMinHzCoordFP ();
-
-        pos3 = pos3 - yeeLayout->getMinHyCoordFP ();
-        pos4 = pos4 - yeeLayout->getMinHyCoordFP ();
-
-        GridCoordinate3D pos11 = convertCoord (pos1 - GRID_COORDINATE_FP_3D (0.5, 0, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos12 = convertCoord (pos1 + GRID_COORDINATE_FP_3D (0.5, 0, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos21 = convertCoord (pos2 - GRID_COORDINATE_FP_3D (0.5, 0, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos22 = convertCoord (pos2 + GRID_COORDINATE_FP_3D (0.5, 0, 0, ct1, ct2, ct3));
-
-        GridCoordinate3D pos31 = convertCoord (pos3 - GRID_COORDINATE_FP_3D (0.5, 0, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos32 = convertCoord (pos3 + GRID_COORDINATE_FP_3D (0.5, 0, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos41 = convertCoord (pos4 - GRID_COORDINATE_FP_3D (0.5, 0, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos42 = convertCoord (pos4 + GRID_COORDINATE_FP_3D (0.5, 0, 0, ct1, ct2, ct3));
-
-        FieldValue *valHz11 = curHz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos11);
-        FieldValue *valHz12 = curHz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos12);
-        FieldValue *valHz21 = curHz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos21);
-        FieldValue *valHz22 = curHz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos22);
-
-        FieldValue *valHy11 = curHy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos31);
-        FieldValue *valHy12 = curHy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos32);
-        FieldValue *valHy21 = curHy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos41);
-        FieldValue *valHy22 = curHy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos42);
+        positions[c][side][k] = convertCoord (posPoint);
+        values[c][side][k] = grid->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (positions[c][side][k]);
 
 #ifdef PARALLEL_GRID
-        if (valHz11 == NULLPTR || ((ParallelGrid*) curHz)->isBufferLeftPosition (pos11)
-            || valHz12 == NULLPTR || ((ParallelGrid*) curHz)->isBufferLeftPosition (pos11)
-            || valHz21 == NULLPTR || ((ParallelGrid*) curHz)->isBufferLeftPosition (pos21)
-            || valHz22 == NULLPTR || ((ParallelGrid*) curHz)->isBufferLeftPosition (pos22)
-            || valHy11 == NULLPTR || ((ParallelGrid*) curHy)->isBufferLeftPosition (pos31)
-            || valHy12 == NULLPTR || ((ParallelGrid*) curHy)->isBufferLeftPosition (pos32)
-            || valHy21 == NULLPTR || ((ParallelGrid*) curHy)->isBufferLeftPosition (pos41)
-            || valHy22 == NULLPTR || ((ParallelGrid*) curHy)->isBufferLeftPosition (pos42))
+        if (values[c][side][k] == NULLPTR || ((ParallelGrid*) grid)->isBufferLeftPosition (positions[c][side][k]))
         {
-          continue;
+          return false;
         }
 #endif
 
-        FieldValue *valHz11_prev = curHz->getFieldValuePreviousAfterShiftByAbsolutePos (pos11);
-        FieldValue *valHz12_prev = curHz->getFieldValuePreviousAfterShiftByAbsolutePos (pos12);
-        FieldValue *valHz21_prev = curHz->getFieldValuePreviousAfterShiftByAbsolutePos (pos21);
-        FieldValue *valHz22_prev = curHz->getFieldValuePreviousAfterShiftByAbsolutePos (pos22);
-
-        FieldValue *valHy11_prev = curHy->getFieldValuePreviousAfterShiftByAbsolutePos (pos31);
-        FieldValue *valHy12_prev = curHy->getFieldValuePreviousAfterShiftByAbsolutePos (pos32);
-        FieldValue *valHy21_prev = curHy->getFieldValuePreviousAfterShiftByAbsolutePos (pos41);
-        FieldValue *valHy22_prev = curHy->getFieldValuePreviousAfterShiftByAbsolutePos (pos42);
-
-        ASSERT (valHz11 != NULLPTR && valHz12 != NULLPTR && valHz21 != NULLPTR && valHz22 != NULLPTR
-                && valHy11 != NULLPTR && valHy12 != NULLPTR && valHy21 != NULLPTR && valHy22 != NULLPTR
-                && valHz11_prev != NULLPTR && valHz12_prev != NULLPTR && valHz21_prev != NULLPTR && valHz22_prev != NULLPTR
-                && valHy11_prev != NULLPTR && valHy12_prev != NULLPTR && valHy21_prev != NULLPTR && valHy22_prev != NULLPTR);
-
-        Hz1 = (*valHz11 + *valHz12 + *valHz11_prev + *valHz12_prev) / FPValue(4.0);
-        Hz2 = (*valHz21 + *valHz22 + *valHz21_prev + *valHz22_prev) / FPValue(4.0);
-        Hy1 = (*valHy11 + *valHy12 + *valHy11_prev + *valHy12_prev) / FPValue(4.0);
-        Hy2 = (*valHy21 + *valHy22 + *valHy21_prev + *valHy22_prev) / FPValue(4.0);
+        ASSERT (values[c][side][k] != NULLPTR);
       }
-      else
-      {
-        UNREACHABLE;
-      }
-
-      FPValue arg = (x0 - diffx0) * sin(angleTeta)*cos(anglePhi) + (coordY - diffy0) * sin(angleTeta)*sin(anglePhi) + (coordZ - diffz0) * cos (angleTeta);
-      arg *= gridStep;
-
-      FPValue k = 2*PhysicsConst::Pi / sourceWaveLength;
-
-      FieldValue exponent (cos(k*arg), sin(k*arg));
-
-      sum_teta += ((Hz1 + Hz2)/FPValue(2.0) * FPValue (cos (angleTeta)) * FPValue (sin (anglePhi))
-                   + (Hy1 + Hy2)/FPValue(2.0) * FPValue (sin (angleTeta))) * exponent * SQR (gridStep) * (-1) * (x0==rightNTFF.get1 ()?1:-1);
-
-      sum_phi += ((Hz1 + Hz2)/FPValue(2.0) * FPValue (cos (anglePhi))) * exponent * SQR (gridStep) * (-1) * (x0==rightNTFF.get1 ()?1:-1);
     }
   }
 
-  return NPair (sum_teta, sum_phi);
-#else
-  ASSERT_MESSAGE ("Solver is not compiled with support of complex values. Recompile it with -DCOMPLEX_FIELD_VALUES=ON.");
-  return NPair (FPValue (0), FPValue (0));
-#endif
-}
-
-template <LayoutType layout_type>
-NPair
-SchemeHelper::ntffN3D_y (grid_coord y0, FPValue angleTeta, FPValue anglePhi,
-                         GridCoordinate3D leftNTFF,
-                         GridCoordinate3D rightNTFF,
-                         YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *yeeLayout,
-                         FPValue gridStep,
-                         FPValue sourceWaveLength,
-                         Grid<GridCoordinate3D> *curEx,
-                         Grid<GridCoordinate3D> *curEy,
-                         Grid<GridCoordinate3D> *curEz,
-                         Grid<GridCoordinate3D> *curHx,
-                         Grid<GridCoordinate3D> *curHy,
-                         Grid<GridCoordinate3D> *curHz)
-{
-#ifdef COMPLEX_FIELD_VALUES
-  ASSERT (yeeLayout->getSize ().get1 () % 2 == 0);
-  ASSERT (yeeLayout->getSize ().get2 () % 2 == 0);
-  ASSERT (yeeLayout->getSize ().get3 () % 2 == 0);
-  FPValue diffx0 = yeeLayout->getSize ().get1 () / 2;
-  FPValue diffy0 = yeeLayout->getSize ().get2 () / 2;
-  FPValue diffz0 = yeeLayout->getSize ().get3 () / 2;
-
-  CoordinateType ct1, ct2, ct3;
-#ifdef DEBUG_INFO
-  ct1 = leftNTFF.getType1 ();
-  ct2 = leftNTFF.getType2 ();
-  ct3 = leftNTFF.getType3 ();
-#endif
-
-  GridCoordinateFP3D coordStart = GRID_COORDINATE_FP_3D (leftNTFF.get1 () + 0.5, y0, leftNTFF.get3 () + 0.5, ct1, ct2, ct3);
-  GridCoordinateFP3D coordEnd = GRID_COORDINATE_FP_3D (rightNTFF.get1 () - 0.5, y0, rightNTFF.get3 () - 0.5, ct1, ct2, ct3);
+  FieldValue vals[2];
 
-  FieldValue sum_teta (0.0, 0.0);
-  FieldValue sum_phi (0.0, 0.0);
-
-  for (FPValue coordX = coordStart.get1 (); coordX <= coordEnd.get1 (); ++coordX)
+  for (int c = 0; c < 2; ++c)
   {
-    for (FPValue coordZ = coordStart.get3 (); coordZ <= coordEnd.get3 (); ++coordZ)
-    {
-      FieldValue Hz1;
-      FieldValue Hz2;
-      FieldValue Hx1;
-      FieldValue Hx2;
+    Grid<GridCoordinate3D> *grid = grids[comp[c]];
+    FieldValue valSide[2];
 
-      if (layout_type == E_CENTERED)
+    for (int side = 0; side < 2; ++side)
+    {
+      if (isH)
       {
-        GridCoordinateFP3D pos1 = GRID_COORDINATE_FP_3D (coordX - 0.5, y0, coordZ, ct1, ct2, ct3);
-        GridCoordinateFP3D pos2 = GRID_COORDINATE_FP_3D (coordX + 0.5, y0, coordZ, ct1, ct2, ct3);
-        GridCoordinateFP3D pos3 = GRID_COORDINATE_FP_3D (coordX, y0, coordZ - 0.5, ct1, ct2, ct3);
-        GridCoordinateFP3D pos4 = GRID_COORDINATE_FP_3D (coordX, y0, coordZ + 0.5, ct1, ct2, ct3);
+        FieldValue *valPrev1 = grid->getFieldValuePreviousAfterShiftByAbsolutePos (positions[c][side][0]);
+        ASSERT (valPrev1 != NULLPTR);
 
-        pos1 = pos1 - yeeLayout->getMinHzCoordFP ();
-        pos2 = pos2 - yeeLayout->getMinHzCoordFP ();
-
-        pos3 = pos3 - yeeLayout->getMinHxCoordFP ();
-        pos4 = pos4 - yeeLayout->getMinHxCoordFP ();
-
-        GridCoordinate3D pos11 = convertCoord (pos1);
-        GridCoordinate3D pos21 = convertCoord (pos2);
-        GridCoordinate3D pos31 = convertCoord (pos3);
-        GridCoordinate3D pos41 = convertCoord (pos4);
-
-        FieldValue *valHz1 = curHz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos11);
-        FieldValue *valHz2 = curHz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos21);
-
-        FieldValue *valHx1 = curHx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos31);
-        FieldValue *valHx2 = curHx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos41);
-
-#ifdef PARALLEL_GRID
-        if (valHz1 == NULLPTR || ((ParallelGrid*) curHz)->isBufferLeftPosition (pos11)
-            || valHz2 == NULLPTR || ((ParallelGrid*) curHz)->isBufferLeftPosition (pos21)
-            || valHx1 == NULLPTR || ((ParallelGrid*) curHx)->isBufferLeftPosition (pos31)
-            || valHx2 == NULLPTR || ((ParallelGrid*) curHx)->isBufferLeftPosition (pos41))
+        if (doAverageNormal)
         {
-          continue;
-        }
-#endif
-
-        FieldValue *valHz1_prev = curHz->getFieldValuePreviousAfterShiftByAbsolutePos (pos11);
-        FieldValue *valHz2_prev = curHz->getFieldValuePreviousAfterShiftByAbsolutePos (pos21);
-
-        FieldValue *valHx1_prev = curHx->getFieldValuePreviousAfterShiftByAbsolutePos (pos31);
-        FieldValue *valHx2_prev = curHx->getFieldValuePreviousAfterShiftByAbsolutePos (pos41);
-
-        ASSERT (valHz1 != NULLPTR && valHz2 != NULLPTR && valHx1 != NULLPTR && valHx2 != NULLPTR
-                && valHz1_prev != NULLPTR && valHz2_prev != NULLPTR && valHx1_prev != NULLPTR && valHx2_prev != NULLPTR);
-
-        Hz1 = (*valHz1 + *valHz1_prev) / FPValue (2);
-        Hz2 = (*valHz2 + *valHz2_prev) / FPValue (2);
-        Hx1 = (*valHx1 + *valHx1_prev) / FPValue (2);
-        Hx2 = (*valHx2 + *valHx2_prev) / FPValue (2);
-      }
-      else if (layout_type == H_CENTERED)
-      {
-        GridCoordinateFP3D pos1 = GRID_COORDINATE_FP_3D (coordX, y0, coordZ - 0.5, ct1, ct2, ct3);
-        GridCoordinateFP3D pos2 = GRID_COORDINATE_FP_3D (coordX, y0, coordZ + 0.5, ct1, ct2, ct3);
-        GridCoordinateFP3D pos3 = GRID_COORDINATE_FP_3D (coordX - 0.5, y0, coordZ, ct1, ct2, ct3);
-        GridCoordinateFP3D pos4 = GRID_COORDINATE_FP_3D (coordX + 0.5, y0, coordZ, ct1, ct2, ct3);
+          FieldValue *valPrev2 = grid->getFieldValuePreviousAfterShiftByAbsolutePos (positions[c][side][1]);
+          ASSERT (valPrev2 != NULLPTR);
 
-        pos1 = pos1 - yeeLayout->getMinHzCoordFP ();
-        pos2 = pos2 - yeeLayout->getMinHzCoordFP ();
-
-        pos3 = pos3 - yeeLayout->getMinHxCoordFP ();
-        pos4 = pos4 - yeeLayout->getMinHxCoordFP ();
-
-        GridCoordinate3D pos11 = convertCoord (pos1 - GRID_COORDINATE_FP_3D (0, 0.5, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos12 = convertCoord (pos1 + GRID_COORDINATE_FP_3D (0, 0.5, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos21 = convertCoord (pos2 - GRID_COORDINATE_FP_3D (0, 0.5, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos22 = convertCoord (pos2 + GRID_COORDINATE_FP_3D (0, 0.5, 0, ct1, ct2, ct3));
-
-        GridCoordinate3D pos31 = convertCoord (pos3 - GRID_COORDINATE_FP_3D (0, 0.5, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos32 = convertCoord (pos3 + GRID_COORDINATE_FP_3D (0, 0.5, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos41 = convertCoord (pos4 - GRID_COORDINATE_FP_3D (0, 0.5, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos42 = convertCoord (pos4 + GRID_COORDINATE_FP_3D (0, 0.5, 0, ct1, ct2, ct3));
-
-        FieldValue *valHz11 = curHz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos11);
-        FieldValue *valHz12 = curHz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos12);
-        FieldValue *valHz21 = curHz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos21);
-        FieldValue *valHz22 = curHz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos22);
-
-        FieldValue *valHx11 = curHx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos31);
-        FieldValue *valHx12 = curHx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos32);
-        FieldValue *valHx21 = curHx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos41);
-        FieldValue *valHx22 = curHx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos42);
-
-#ifdef PARALLEL_GRID
-        if (valHz11 == NULLPTR || ((ParallelGrid*) curHz)->isBufferLeftPosition (pos11)
-            || valHz12 == NULLPTR || ((ParallelGrid*) curHz)->isBufferLeftPosition (pos11)
-            || valHz21 == NULLPTR || ((ParallelGrid*) curHz)->isBufferLeftPosition (pos21)
-            || valHz22 == NULLPTR || ((ParallelGrid*) curHz)->isBufferLeftPosition (pos22)
-            || valHx11 == NULLPTR || ((ParallelGrid*) curHx)->isBufferLeftPosition (pos31)
-            || valHx12 == NULLPTR || ((ParallelGrid*) curHx)->isBufferLeftPosition (pos32)
-            || valHx21 == NULLPTR || ((ParallelGrid*) curHx)->isBufferLeftPosition (pos41)
-            || valHx22 == NULLPTR || ((ParallelGrid*) curHx)->isBufferLeftPosition (pos42))
+          valSide[side] = (*values[c][side][0] + *values[c][side][1] + *valPrev1 + *valPrev2) / FPValue (4.0);
+        }
+        else
         {
-          continue;
+          valSide[side] = (*values[c][side][0] + *valPrev1) / FPValue (2);
         }
-#endif
-
-        FieldValue *valHz11_prev = curHz->getFieldValuePreviousAfterShiftByAbsolutePos (pos11);
-        FieldValue *valHz12_prev = curHz->getFieldValuePreviousAfterShiftByAbsolutePos (pos12);
-        FieldValue *valHz21_prev = curHz->getFieldValuePreviousAfterShiftByAbsolutePos (pos21);
-        FieldValue *valHz22_prev = curHz->getFieldValuePreviousAfterShiftByAbsolutePos (pos22);
-
-        FieldValue *valHx11_prev = curHx->getFieldValuePreviousAfterShiftByAbsolutePos (pos31);
-        FieldValue *valHx12_prev = curHx->getFieldValuePreviousAfterShiftByAbsolutePos (pos32);
-        FieldValue *valHx21_prev = curHx->getFieldValuePreviousAfterShiftByAbsolutePos (pos41);
-        FieldValue *valHx22_prev = curHx->getFieldValuePreviousAfterShiftByAbsolutePos (pos42);
-
-        ASSERT (valHz11 != NULLPTR && valHz12 != NULLPTR && valHz21 != NULLPTR && valHz22 != NULLPTR
-                && valHx11 != NULLPTR && valHx12 != NULLPTR && valHx21 != NULLPTR && valHx22 != NULLPTR
-                && valHz11_prev != NULLPTR && valHz12_prev != NULLPTR && valHz21_prev != NULLPTR && valHz22_prev != NULLPTR
-                && valHx11_prev != NULLPTR && valHx12_prev != NULLPTR && valHx21_prev != NULLPTR && valHx22_prev != NULLPTR);
-
-        Hz1 = (*valHz11 + *valHz12 + *valHz11_prev + *valHz12_prev) / FPValue(4.0);
-        Hz2 = (*valHz21 + *valHz22 + *valHz21_prev + *valHz22_prev) / FPValue(4.0);
-        Hx1 = (*valHx11 + *valHx12 + *valHx11_prev + *valHx12_prev) / FPValue(4.0);
-        Hx2 = (*valHx21 + *valHx22 + *valHx21_prev + *valHx22_prev) / FPValue(4.0);
       }
       else
       {
-        UNREACHABLE;
+        if (doAverageNormal)
+        {
+          valSide[side] = (*values[c][side][0] + *values[c][side][1]) / FPValue (2.0);
+        }
+        else
+        {
+          valSide[side] = *values[c][side][0];
+        }
       }
-
-      FPValue arg = (coordX - diffx0) * sin(angleTeta)*cos(anglePhi) + (y0 - diffy0) * sin(angleTeta)*sin(anglePhi) + (coordZ - diffz0) * cos (angleTeta);
-      arg *= gridStep;
-
-      FPValue k = 2*PhysicsConst::Pi / sourceWaveLength;
-
-      FieldValue exponent (cos(k*arg), sin(k*arg));
-
-      sum_teta += ((Hz1 + Hz2)/FPValue(2.0) * FPValue (cos (angleTeta)) * FPValue (cos (anglePhi))
-                   + (Hx1 + Hx2)/FPValue(2.0) * FPValue (sin (angleTeta))) * exponent * SQR (gridStep) * (y0==rightNTFF.get2 ()?1:-1);
-
-      sum_phi += ((Hz1 + Hz2)/FPValue(2.0) * FPValue (sin (anglePhi))) * exponent * SQR (gridStep) * (-1) * (y0==rightNTFF.get2 ()?1:-1);
     }
+
+    vals[c] = (valSide[0] + valSide[1]) / FPValue (2.0);
   }
 
-  return NPair (sum_teta, sum_phi);
-#else
-  ASSERT_MESSAGE ("Solver is not compiled with support of complex values. Recompile it with -DCOMPLEX_FIELD_VALUES=ON.");
-  return NPair (FPValue (0), FPValue (0));
-#endif
+  val1 = vals[0];
+  val2 = vals[1];
+
+  return true;
 }
 
-template <LayoutType layout_type>
+/**
+ * Compute contribution of tangential components of E (for L) or H (for N) to sums of NTFF face, without exponent,
+ * area of cell and direction of normal to face
+ *
+ * @return contribution to sums for teta and phi
+ */
+inline
 NPair
-SchemeHelper::ntffN3D_z (grid_coord z0, FPValue angleTeta, FPValue anglePhi,
-                         GridCoordinate3D leftNTFF,
-                         GridCoordinate3D rightNTFF,
-                         YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *yeeLayout,
-                         FPValue gridStep,
-                         FPValue sourceWaveLength,
-                         Grid<GridCoordinate3D> *curEx,
-                         Grid<GridCoordinate3D> *curEy,
-                         Grid<GridCoordinate3D> *curEz,
-                         Grid<GridCoordinate3D> *curHx,
-                         Grid<GridCoordinate3D> *curHy,
-                         Grid<GridCoordinate3D> *curHz)
+SchemeHelper::ntffTerm3D (OrthogonalAxis normal, /**< axis, which is orthogonal to face */
+                          bool isH, /**< flag whether to compute N or L */
+                          FPValue angleTeta,
+                          FPValue anglePhi,
+                          FieldValue val1, /**< first tangential component (see ntffSampleFace3D) */
+                          FieldValue val2) /**< second tangential component (see ntffSampleFace3D) */
 {
-#ifdef COMPLEX_FIELD_VALUES
-  ASSERT (yeeLayout->getSize ().get1 () % 2 == 0);
-  ASSERT (yeeLayout->getSize ().get2 () % 2 == 0);
-  ASSERT (yeeLayout->getSize ().get3 () % 2 == 0);
-  FPValue diffx0 = yeeLayout->getSize ().get1 () / 2;
-  FPValue diffy0 = yeeLayout->getSize ().get2 () / 2;
-  FPValue diffz0 = yeeLayout->getSize ().get3 () / 2;
-
-  CoordinateType ct1, ct2, ct3;
-#ifdef DEBUG_INFO
-  ct1 = leftNTFF.getType1 ();
-  ct2 = leftNTFF.getType2 ();
-  ct3 = leftNTFF.getType3 ();
-#endif
+  FieldValue sum_teta;
+  FieldValue sum_phi;
 
-  GridCoordinateFP3D coordStart = GRID_COORDINATE_FP_3D (leftNTFF.get1 () + 0.5, leftNTFF.get2 () + 0.5, z0, ct1, ct2, ct3);
-  GridCoordinateFP3D coordEnd = GRID_COORDINATE_FP_3D (rightNTFF.get1 () - 0.5, rightNTFF.get2 () - 0.5, z0, ct1, ct2, ct3);
+  if (normal == OrthogonalAxis::X)
+  {
+    sum_teta = val1 * FPValue (cos (angleTeta)) * FPValue (sin (anglePhi))
+               + val2 * FPValue (sin (angleTeta));
+    sum_phi = val1 * FPValue (cos (anglePhi));
 
-  FieldValue sum_teta (0.0, 0.0);
-  FieldValue sum_phi (0.0, 0.0);
+    if (isH)
+    {
+      sum_teta = sum_teta * FPValue (-1);
+      sum_phi = sum_phi * FPValue (-1);
+    }
+  }
+  else if (normal == OrthogonalAxis::Y)
+  {
+    sum_teta = val1 * FPValue (cos (angleTeta)) * FPValue (cos (anglePhi))
+               + val2 * FPValue (sin (angleTeta));
+    sum_phi = val1 * FPValue (sin (anglePhi));
 
-  for (FPValue coordX = coordStart.get1 (); coordX <= coordEnd.get1 (); ++coordX)
+    if (isH)
+    {
+      sum_phi = sum_phi * FPValue (-1);
+    }
+    else
+    {
+      sum_teta = sum_teta * FPValue (-1);
+    }
+  }
+  else if (normal == OrthogonalAxis::Z)
   {
-    for (FPValue coordY = coordStart.get2 (); coordY <= coordEnd.get2 (); ++coordY)
+    if (isH)
     {
-      FieldValue Hy1;
-      FieldValue Hy2;
-      FieldValue Hx1;
-      FieldValue Hx2;
-
-      if (layout_type == E_CENTERED)
-      {
-        GridCoordinateFP3D pos1 = GRID_COORDINATE_FP_3D (coordX - 0.5, coordY, z0, ct1, ct2, ct3);
-        GridCoordinateFP3D pos2 = GRID_COORDINATE_FP_3D (coordX + 0.5, coordY, z0, ct1, ct2, ct3);
-        GridCoordinateFP3D pos3 = GRID_COORDINATE_FP_3D (coordX, coordY - 0.5, z0, ct1, ct2, ct3);
-        GridCoordinateFP3D pos4 = GRID_COORDINATE_FP_3D (coordX, coordY + 0.5, z0, ct1, ct2, ct3);
-
-        pos1 = pos1 - yeeLayout->getMinHyCoordFP ();
-        pos2 = pos2 - yeeLayout->getMinHyCoordFP ();
-
-        pos3 = pos3 - yeeLayout->getMinHxCoordFP ();
-        pos4 = pos4 - yeeLayout->getMinHxCoordFP ();
-
-        GridCoordinate3D pos11 = convertCoord (pos1);
-        GridCoordinate3D pos21 = convertCoord (pos2);
-        GridCoordinate3D pos31 = convertCoord (pos3);
-        GridCoordinate3D pos41 = convertCoord (pos4);
-
-        FieldValue *valHy1 = curHy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos11);
-        FieldValue *valHy2 = curHy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos21);
-
-        FieldValue *valHx1 = curHx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos31);
-        FieldValue *valHx2 = curHx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos41);
-
-#ifdef PARALLEL_GRID
-        if (valHy1 == NULLPTR || ((ParallelGrid*) curHy)->isBufferLeftPosition (pos11)
-            || valHy2 == NULLPTR || ((ParallelGrid*) curHy)->isBufferLeftPosition (pos21)
-            || valHx1 == NULLPTR || ((ParallelGrid*) curHx)->isBufferLeftPosition (pos31)
-            || valHx2 == NULLPTR || ((ParallelGrid*) curHx)->isBufferLeftPosition (pos41))
-        {
-          continue;
-        }
-#endif
-
-        FieldValue *valHy1_prev = curHy->getFieldValuePreviousAfterShiftByAbsolutePos (pos11);
-        FieldValue *valHy2_prev = curHy->getFieldValuePreviousAfterShiftByAbsolutePos (pos21);
-
-        FieldValue *valHx1_prev = curHx->getFieldValuePreviousAfterShiftByAbsolutePos (pos31);
-        FieldValue *valHx2_prev = curHx->getFieldValuePreviousAfterShiftByAbsolutePos (pos41);
-
-        ASSERT (valHy1 != NULLPTR && valHy2 != NULLPTR && valHx1 != NULLPTR && valHx2 != NULLPTR
-                && valHy1_prev != NULLPTR && valHy2_prev != NULLPTR && valHx1_prev != NULLPTR && valHx2_prev != NULLPTR);
-
-        Hy1 = (*valHy1 + *valHy1_prev) / FPValue (2);
-        Hy2 = (*valHy2 + *valHy2_prev) / FPValue (2);
-        Hx1 = (*valHx1 + *valHx1_prev) / FPValue (2);
-        Hx2 = (*valHx2 + *valHx2_prev) / FPValue (2);
-      }
-      else if (layout_type == H_CENTERED)
-      {
-        GridCoordinateFP3D pos1 = GRID_COORDINATE_FP_3D (coordX, coordY - 0.5, z0, ct1, ct2, ct3);
-        GridCoordinateFP3D pos2 = GRID_COORDINATE_FP_3D (coordX, coordY - 0.5, z0, ct1, ct2, ct3);
-        GridCoordinateFP3D pos3 = GRID_COORDINATE_FP_3D (coordX - 0.5, coordY, z0, ct1, ct2, ct3);
-        GridCoordinateFP3D pos4 = GRID_COORDINATE_FP_3D (coordX + 0.5, coordY, z0, ct1, ct2, ct3);
-
-        pos1 = pos1 - yeeLayout->getMinHyCoordFP ();
-        pos2 = pos2 - yeeLayout->getMinHyCoordFP ();
-
-        pos3 = pos3 - yeeLayout->getMinHxCoordFP ();
-        pos4 = pos4 - yeeLayout->getMinHxCoordFP ();
-
-        GridCoordinate3D pos11 = convertCoord (pos1 - GRID_COORDINATE_FP_3D (0, 0, 0.5, ct1, ct2, ct3));
-        GridCoordinate3D pos12 = convertCoord (pos1 + GRID_COORDINATE_FP_3D (0, 0, 0.5, ct1, ct2, ct3));
-        GridCoordinate3D pos21 = convertCoord (pos2 - GRID_COORDINATE_FP_3D (0, 0, 0.5, ct1, ct2, ct3));
-        GridCoordinate3D pos22 = convertCoord (pos2 + GRID_COORDINATE_FP_3D (0, 0, 0.5, ct1, ct2, ct3));
-
-        GridCoordinate3D pos31 = convertCoord (pos3 - GRID_COORDINATE_FP_3D (0, 0, 0.5, ct1, ct2, ct3));
-        GridCoordinate3D pos32 = convertCoord (pos3 + GRID_COORDINATE_FP_3D (0, 0, 0.5, ct1, ct2, ct3));
-        GridCoordinate3D pos41 = convertCoord (pos4 - GRID_COORDINATE_FP_3D (0, 0, 0.5, ct1, ct2, ct3));
-        GridCoordinate3D pos42 = convertCoord (pos4 + GRID_COORDINATE_FP_3D (0, 0, 0.5, ct1, ct2, ct3));
-
-        FieldValue *valHy11 = curHy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos11);
-        FieldValue *valHy12 = curHy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos12);
-        FieldValue *valHy21 = curHy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos21);
-        FieldValue *valHy22 = curHy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos22);
-
-        FieldValue *valHx11 = curHx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos31);
-        FieldValue *valHx12 = curHx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos32);
-        FieldValue *valHx21 = curHx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos41);
-        FieldValue *valHx22 = curHx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos42);
-
-#ifdef PARALLEL_GRID
-        if (valHy11 == NULLPTR || ((ParallelGrid*) curHy)->isBufferLeftPosition (pos11)
-            || valHy12 == NULLPTR || ((ParallelGrid*) curHy)->isBufferLeftPosition (pos11)
-            || valHy21 == NULLPTR || ((ParallelGrid*) curHy)->isBufferLeftPosition (pos21)
-            || valHy22 == NULLPTR || ((ParallelGrid*) curHy)->isBufferLeftPosition (pos22)
-            || valHx11 == NULLPTR || ((ParallelGrid*) curHx)->isBufferLeftPosition (pos31)
-            || valHx12 == NULLPTR || ((ParallelGrid*) curHx)->isBufferLeftPosition (pos32)
-            || valHx21 == NULLPTR || ((ParallelGrid*) curHx)->isBufferLeftPosition (pos41)
-            || valHx22 == NULLPTR || ((ParallelGrid*) curHx)->isBufferLeftPosition (pos42))
-        {
-          continue;
-        }
-#endif
-
-        FieldValue *valHy11_prev = curHy->getFieldValuePreviousAfterShiftByAbsolutePos (pos11);
-        FieldValue *valHy12_prev = curHy->getFieldValuePreviousAfterShiftByAbsolutePos (pos12);
-        FieldValue *valHy21_prev = curHy->getFieldValuePreviousAfterShiftByAbsolutePos (pos21);
-        FieldValue *valHy22_prev = curHy->getFieldValuePreviousAfterShiftByAbsolutePos (pos22);
-
-        FieldValue *valHx11_prev = curHx->getFieldValuePreviousAfterShiftByAbsolutePos (pos31);
-        FieldValue *valHx12_prev = curHx->getFieldValuePreviousAfterShiftByAbsolutePos (pos32);
-        FieldValue *valHx21_prev = curHx->getFieldValuePreviousAfterShiftByAbsolutePos (pos41);
-        FieldValue *valHx22_prev = curHx->getFieldValuePreviousAfterShiftByAbsolutePos (pos42);
-
-        ASSERT (valHy11 != NULLPTR && valHy12 != NULLPTR && valHy21 != NULLPTR && valHy22 != NULLPTR
-                && valHx11 != NULLPTR && valHx12 != NULLPTR && valHx21 != NULLPTR && valHx22 != NULLPTR
-                && valHy11_prev != NULLPTR && valHy12_prev != NULLPTR && valHy21_prev != NULLPTR && valHy22_prev != NULLPTR
-                && valHx11_prev != NULLPTR && valHx12_prev != NULLPTR && valHx21_prev != NULLPTR && valHx22_prev != NULLPTR);
-
-        Hy1 = (*valHy11 + *valHy12 + *valHy11_prev + *valHy12_prev) / FPValue(4.0);
-        Hy2 = (*valHy21 + *valHy22 + *valHy21_prev + *valHy22_prev) / FPValue(4.0);
-        Hx1 = (*valHx11 + *valHx12 + *valHx11_prev + *valHx12_prev) / FPValue(4.0);
-        Hx2 = (*valHx21 + *valHx22 + *valHx21_prev + *valHx22_prev) / FPValue(4.0);
-      }
-      else
-      {
-        UNREACHABLE;
-      }
-
-      FPValue arg = (coordX - diffx0) * sin(angleTeta)*cos(anglePhi) + (coordY - diffy0) * sin(angleTeta)*sin(anglePhi) + (z0 - diffz0) * cos (angleTeta);
-      arg *= gridStep;
-
-      FPValue k = 2*PhysicsConst::Pi / sourceWaveLength;
-
-      FieldValue exponent (cos(k*arg), sin(k*arg));
-
-      sum_teta += (-(Hy1 + Hy2)/FPValue(2.0) * FPValue (cos (angleTeta)) * FPValue (cos (anglePhi))
-                   + (Hx1 + Hx2)/FPValue(2.0) * FPValue (cos (angleTeta)) * FPValue (sin (anglePhi))) * exponent * SQR (gridStep) * (z0==rightNTFF.get3 ()?1:-1);
+      sum_teta = -val1 * FPValue (cos (angleTeta)) * FPValue (cos (anglePhi))
+                 + val2 * FPValue (cos (angleTeta)) * FPValue (sin (anglePhi));
+    }
+    else
+    {
+      sum_teta = val1 * FPValue (cos (angleTeta)) * FPValue (cos (anglePhi))
+                 - val2 * FPValue (cos (angleTeta)) * FPValue (sin (anglePhi));
+    }
+    sum_phi = val1 * FPValue (sin (anglePhi))
+              + val2 * FPValue (cos (anglePhi));
 
-      sum_phi += ((Hy1 + Hy2)/FPValue(2.0) * FPValue (sin (anglePhi))
-                  + (Hx1 + Hx2)/FPValue(2.0) * FPValue (cos (anglePhi))) * exponent * SQR (gridStep) * (z0==rightNTFF.get3 ()?1:-1);
+    if (!isH)
+    {
+      sum_phi = sum_phi * FPValue (-1);
     }
   }
+  else
+  {
+    UNREACHABLE;
+  }
 
   return NPair (sum_teta, sum_phi);
-#else
-  ASSERT_MESSAGE ("Solver is not compiled with support of complex values. Recompile it with -DCOMPLEX_FIELD_VALUES=ON.");
-  return NPair (FPValue (0), FPValue (0));
-#endif
 }
 
+/**
+ * Add tangential components of E and H on all faces of NTFF box, multiplied by phase of time step, to running DFT (or
+ * sample instantaneous values with unit phase to zero faces)
+ */
 template <LayoutType layout_type>
-NPair
-SchemeHelper::ntffL3D_x (grid_coord x0, FPValue angleTeta, FPValue anglePhi,
-                         GridCoordinate3D leftNTFF,
-                         GridCoordinate3D rightNTFF,
-                         YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *yeeLayout,
-                         FPValue gridStep,
-                         FPValue sourceWaveLength,
-                         Grid<GridCoordinate3D> *curEx,
-                         Grid<GridCoordinate3D> *curEy,
-                         Grid<GridCoordinate3D> *curEz,
-                         Grid<GridCoordinate3D> *curHx,
-                         Grid<GridCoordinate3D> *curHy,
-                         Grid<GridCoordinate3D> *curHz)
+void
+SchemeHelper::ntffAccumulate3D (GridCoordinate3D leftNTFF,
+                                GridCoordinate3D rightNTFF,
+                                YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *yeeLayout,
+                                FieldValue phase, /**< exp (i * omega * t) for current time step */
+                                Grid<GridCoordinate3D> *curEx,
+                                Grid<GridCoordinate3D> *curEy,
+                                Grid<GridCoordinate3D> *curEz,
+                                Grid<GridCoordinate3D> *curHx,
+                                Grid<GridCoordinate3D> *curHy,
+                                Grid<GridCoordinate3D> *curHz,
+                                NTFFFace *faces) /**< NTFF_FACES_COUNT faces of NTFF box */
 {
-#ifdef COMPLEX_FIELD_VALUES
-  ASSERT (yeeLayout->getSize ().get1 () % 2 == 0);
-  ASSERT (yeeLayout->getSize ().get2 () % 2 == 0);
-  ASSERT (yeeLayout->getSize ().get3 () % 2 == 0);
-  FPValue diffx0 = yeeLayout->getSize ().get1 () / 2;
-  FPValue diffy0 = yeeLayout->getSize ().get2 () / 2;
-  FPValue diffz0 = yeeLayout->getSize ().get3 () / 2;
-
   CoordinateType ct1, ct2, ct3;
 #ifdef DEBUG_INFO
   ct1 = leftNTFF.getType1 ();
@@ -1594,529 +1334,217 @@ SchemeHelper::ntffL3D_x (grid_coord x0, FPValue angleTeta, FPValue anglePhi,
   ct3 = leftNTFF.getType3 ();
 #endif
 
-  GridCoordinateFP3D coordStart = GRID_COORDINATE_FP_3D (x0, leftNTFF.get2 () + 0.5, leftNTFF.get3 () + 0.5, ct1, ct2, ct3);
-  GridCoordinateFP3D coordEnd = GRID_COORDINATE_FP_3D (x0, rightNTFF.get2 () - 0.5, rightNTFF.get3 () - 0.5, ct1, ct2, ct3);
-
-  FieldValue sum_teta (0.0, 0.0);
-  FieldValue sum_phi (0.0, 0.0);
+  grid_coord left[3] = {leftNTFF.get1 (), leftNTFF.get2 (), leftNTFF.get3 ()};
+  grid_coord right[3] = {rightNTFF.get1 (), rightNTFF.get2 (), rightNTFF.get3 ()};
 
-  for (FPValue coordY = coordStart.get2 (); coordY <= coordEnd.get2 (); ++coordY)
+  for (uint8_t face = 0; face < NTFF_FACES_COUNT; ++face)
   {
-    for (FPValue coordZ = coordStart.get3 (); coordZ <= coordEnd.get3 (); ++coordZ)
-    {
-      FieldValue Ey1;
-      FieldValue Ey2;
-      FieldValue Ez1;
-      FieldValue Ez2;
-
-      if (layout_type == E_CENTERED)
-      {
-        GridCoordinateFP3D pos1 = GRID_COORDINATE_FP_3D (x0, coordY - 0.5, coordZ, ct1, ct2, ct3);
-        GridCoordinateFP3D pos2 = GRID_COORDINATE_FP_3D (x0, coordY + 0.5, coordZ, ct1, ct2, ct3);
-        GridCoordinateFP3D pos3 = GRID_COORDINATE_FP_3D (x0, coordY, coordZ - 0.5, ct1, ct2, ct3);
-        GridCoordinateFP3D pos4 = GRID_COORDINATE_FP_3D (x0, coordY, coordZ + 0.5, ct1, ct2, ct3);
-
-        pos1 = pos1 - yeeLayout->getMinEyCoordFP ();
-        pos2 = pos2 - yeeLayout->getMinEyCoordFP ();
-
-        pos3 = pos3 - yeeLayout->getMinEzCoordFP ();
-        pos4 = pos4 - yeeLayout->getMinEzCoordFP ();
+    uint8_t n = face / 2;
+    uint8_t axis1 = n == 0 ? 1 : 0;
+    uint8_t axis2 = n == 2 ? 1 : 2;
 
-        GridCoordinate3D pos11 = convertCoord (pos1 - GRID_COORDINATE_FP_3D (0.5, 0, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos12 = convertCoord (pos1 + GRID_COORDINATE_FP_3D (0.5, 0, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos21 = convertCoord (pos2 - GRID_COORDINATE_FP_3D (0.5, 0, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos22 = convertCoord (pos2 + GRID_COORDINATE_FP_3D (0.5, 0, 0, ct1, ct2, ct3));
+    OrthogonalAxis normal = n == 0 ? OrthogonalAxis::X : (n == 1 ? OrthogonalAxis::Y : OrthogonalAxis::Z);
 
-        GridCoordinate3D pos31 = convertCoord (pos3 - GRID_COORDINATE_FP_3D (0.5, 0, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos32 = convertCoord (pos3 + GRID_COORDINATE_FP_3D (0.5, 0, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos41 = convertCoord (pos4 - GRID_COORDINATE_FP_3D (0.5, 0, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos42 = convertCoord (pos4 + GRID_COORDINATE_FP_3D (0.5, 0, 0, ct1, ct2, ct3));
+    NTFFFace &cur = faces[face];
 
-        FieldValue *valEy11 = curEy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos11);
-        FieldValue *valEy12 = curEy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos12);
-        FieldValue *valEy21 = curEy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos21);
-        FieldValue *valEy22 = curEy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos22);
+    if (cur.E1.empty ())
+    {
+      cur.sizeU = right[axis1] - left[axis1];
+      cur.sizeV = right[axis2] - left[axis2];
+
+      size_t count = cur.sizeU * cur.sizeV;
+      cur.E1.resize (count, FieldValue (0));
+      cur.E2.resize (count, FieldValue (0));
+      cur.H1.resize (count, FieldValue (0));
+      cur.H2.resize (count, FieldValue (0));
+    }
 
-        FieldValue *valEz11 = curEz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos31);
-        FieldValue *valEz12 = curEz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos32);
-        FieldValue *valEz21 = curEz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos41);
-        FieldValue *valEz22 = curEz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos42);
+    FPValue coord[3];
+    coord[n] = face % 2 == 0 ? left[n] : right[n];
 
-#ifdef PARALLEL_GRID
-        if (valEy11 == NULLPTR || ((ParallelGrid*) curEy)->isBufferLeftPosition (pos11)
-            || valEy12 == NULLPTR || ((ParallelGrid*) curEy)->isBufferLeftPosition (pos11)
-            || valEy21 == NULLPTR || ((ParallelGrid*) curEy)->isBufferLeftPosition (pos21)
-            || valEy22 == NULLPTR || ((ParallelGrid*) curEy)->isBufferLeftPosition (pos22)
-            || valEz11 == NULLPTR || ((ParallelGrid*) curEz)->isBufferLeftPosition (pos31)
-            || valEz12 == NULLPTR || ((ParallelGrid*) curEz)->isBufferLeftPosition (pos32)
-            || valEz21 == NULLPTR || ((ParallelGrid*) curEz)->isBufferLeftPosition (pos41)
-            || valEz22 == NULLPTR || ((ParallelGrid*) curEz)->isBufferLeftPosition (pos42))
-        {
-          continue;
-        }
-#endif
-
-        ASSERT (valEy11 != NULLPTR && valEy12 != NULLPTR && valEy21 != NULLPTR && valEy22 != NULLPTR
-                && valEz11 != NULLPTR && valEz12 != NULLPTR && valEz21 != NULLPTR && valEz22 != NULLPTR);
+    for (grid_coord i = 0; i < cur.sizeU; ++i)
+    {
+      coord[axis1] = left[axis1] + 0.5 + i;
 
-        Ey1 = (*valEy11 + *valEy12) / FPValue(2.0);
-        Ey2 = (*valEy21 + *valEy22) / FPValue(2.0);
-        Ez1 = (*valEz11 + *valEz12) / FPValue(2.0);
-        Ez2 = (*valEz21 + *valEz22) / FPValue(2.0);
-      }
-      else if (layout_type == H_CENTERED)
+      for (grid_coord j = 0; j < cur.sizeV; ++j)
       {
-        GridCoordinateFP3D pos1 = GRID_COORDINATE_FP_3D (x0, coordY, coordZ - 0.5, ct1, ct2, ct3);
-        GridCoordinateFP3D pos2 = GRID_COORDINATE_FP_3D (x0, coordY, coordZ + 0.5, ct1, ct2, ct3);
-        GridCoordinateFP3D pos3 = GRID_COORDINATE_FP_3D (x0, coordY - 0.5, coordZ, ct1, ct2, ct3);
-        GridCoordinateFP3D pos4 = GRID_COORDINATE_FP_3D (x0, coordY + 0.5, coordZ, ct1, ct2, ct3);
-
-        pos1 = pos1 - yeeLayout->getMinEyCoordFP ();
-        pos2 = pos2 - yeeLayout->getMinEyCoordFP ();
-
-        pos3 = pos3 - yeeLayout->getMinEzCoordFP ();
-        pos4 = pos4 - yeeLayout->getMinEzCoordFP ();
-
-        GridCoordinate3D pos11 = convertCoord (pos1);
-        GridCoordinate3D pos21 = convertCoord (pos2);
-
-        GridCoordinate3D pos31 = convertCoord (pos3);
-        GridCoordinate3D pos41 = convertCoord (pos4);
+        coord[axis2] = left[axis2] + 0.5 + j;
 
-        FieldValue *valEy11 = curEy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos11);
-        FieldValue *valEy21 = curEy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos21);
+        GridCoordinateFP3D pos = GRID_COORDINATE_FP_3D (coord[0], coord[1], coord[2], ct1, ct2, ct3);
+        grid_coord index = i * cur.sizeV + j;
 
-        FieldValue *valEz11 = curEz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos31);
-        FieldValue *valEz21 = curEz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos41);
+        FieldValue val1;
+        FieldValue val2;
 
-#ifdef PARALLEL_GRID
-        if (valEy11 == NULLPTR || ((ParallelGrid*) curEy)->isBufferLeftPosition (pos11)
-            || valEy21 == NULLPTR || ((ParallelGrid*) curEy)->isBufferLeftPosition (pos21)
-            || valEz11 == NULLPTR || ((ParallelGrid*) curEz)->isBufferLeftPosition (pos31)
-            || valEz21 == NULLPTR || ((ParallelGrid*) curEz)->isBufferLeftPosition (pos41))
+        if (ntffSampleFace3D (normal, pos, false, yeeLayout, curEx, curEy, curEz, curHx, curHy, curHz, val1, val2))
         {
-          continue;
+          cur.E1[index] += val1 * phase;
+          cur.E2[index] += val2 * phase;
         }
-#endif
-
-        ASSERT (valEy11 != NULLPTR && valEy21 != NULLPTR && valEz11 != NULLPTR && valEz21 != NULLPTR);
 
-        Ey1 = (*valEy11);
-        Ey2 = (*valEy21);
-        Ez1 = (*valEz11);
-        Ez2 = (*valEz21);
-      }
-      else
-      {
-        UNREACHABLE;
+        if (ntffSampleFace3D (normal, pos, true, yeeLayout, curEx, curEy, curEz, curHx, curHy, curHz, val1, val2))
+        {
+          cur.H1[index] += val1 * phase;
+          cur.H2[index] += val2 * phase;
+        }
       }
-
-      FPValue arg = (x0 - diffx0) * sin(angleTeta)*cos(anglePhi) + (coordY - diffy0) * sin(angleTeta)*sin(anglePhi) + (coordZ - diffz0) * cos (angleTeta);
-      arg *= gridStep;
-
-      FPValue k = 2*PhysicsConst::Pi / sourceWaveLength;
-
-      FieldValue exponent (cos(k*arg), sin(k*arg));
-
-      sum_teta += ((Ez1 + Ez2)/FPValue(2.0) * FPValue (cos (angleTeta)) * FPValue (sin (anglePhi))
-                   + (Ey1 + Ey2)/FPValue(2.0) * FPValue (sin (angleTeta))) * exponent * SQR (gridStep) * (x0==rightNTFF.get1 ()?1:-1);
-
-      sum_phi += ((Ez1 + Ez2)/FPValue(2.0) * FPValue (cos (anglePhi))) * exponent * SQR (gridStep) * (x0==rightNTFF.get1 ()?1:-1);
     }
   }
-
-  return NPair (sum_teta, sum_phi);
-#else
-  ASSERT_MESSAGE ("Solver is not compiled with support of complex values. Recompile it with -DCOMPLEX_FIELD_VALUES=ON.");
-  return NPair (FPValue (0), FPValue (0));
-#endif
 }
 
+/**
+ * Compute N and L for NTFF box for all specified angles from tangential fields on its faces (either instantaneous or
+ * running DFT).
+ *
+ * Exponent of each point of face is a product of factors for each axis, so tables of these factors are computed once
+ * for each angle, and no grids are accessed. Angles are processed in blocks of NTFF_ANGLES_BLOCK, and each row of face
+ * is used for all angles of block, while it is still in cache.
+ */
 template <LayoutType layout_type>
-NPair
-SchemeHelper::ntffL3D_y (grid_coord y0, FPValue angleTeta, FPValue anglePhi,
-                         GridCoordinate3D leftNTFF,
-                         GridCoordinate3D rightNTFF,
-                         YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *yeeLayout,
-                         FPValue gridStep,
-                         FPValue sourceWaveLength,
-                         Grid<GridCoordinate3D> *curEx,
-                         Grid<GridCoordinate3D> *curEy,
-                         Grid<GridCoordinate3D> *curEz,
-                         Grid<GridCoordinate3D> *curHx,
-                         Grid<GridCoordinate3D> *curHy,
-                         Grid<GridCoordinate3D> *curHz)
+void
+SchemeHelper::ntffFarField3D (const std::vector<FPValue> &anglesTeta,
+                              const std::vector<FPValue> &anglesPhi,
+                              GridCoordinate3D leftNTFF,
+                              GridCoordinate3D rightNTFF,
+                              YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *yeeLayout,
+                              FPValue gridStep,
+                              FPValue sourceWaveLength,
+                              const NTFFFace *faces, /**< NTFF_FACES_COUNT faces of NTFF box */
+                              FPValue norm, /**< normalization of values on faces */
+                              std::vector<NPair> &N, /**< out: N for each angle */
+                              std::vector<NPair> &L) /**< out: L for each angle */
 {
 #ifdef COMPLEX_FIELD_VALUES
+  ASSERT (anglesTeta.size () == anglesPhi.size ());
   ASSERT (yeeLayout->getSize ().get1 () % 2 == 0);
   ASSERT (yeeLayout->getSize ().get2 () % 2 == 0);
   ASSERT (yeeLayout->getSize ().get3 () % 2 == 0);
-  FPValue diffx0 = yeeLayout->getSize ().get1 () / 2;
-  FPValue diffy0 = yeeLayout->getSize ().get2 () / 2;
-  FPValue diffz0 = yeeLayout->getSize ().get3 () / 2;
-
-  CoordinateType ct1, ct2, ct3;
-#ifdef DEBUG_INFO
-  ct1 = leftNTFF.getType1 ();
-  ct2 = leftNTFF.getType2 ();
-  ct3 = leftNTFF.getType3 ();
-#endif
+  FPValue diff[3] = {FPValue (yeeLayout->getSize ().get1 () / 2),
+                     FPValue (yeeLayout->getSize ().get2 () / 2),
+                     FPValue (yeeLayout->getSize ().get3 () / 2)};
 
-  GridCoordinateFP3D coordStart = GRID_COORDINATE_FP_3D (leftNTFF.get1 () + 0.5, y0, leftNTFF.get3 () + 0.5, ct1, ct2, ct3);
-  GridCoordinateFP3D coordEnd = GRID_COORDINATE_FP_3D (rightNTFF.get1 () - 0.5, y0, rightNTFF.get3 () - 0.5, ct1, ct2, ct3);
+  grid_coord left[3] = {leftNTFF.get1 (), leftNTFF.get2 (), leftNTFF.get3 ()};
+  grid_coord right[3] = {rightNTFF.get1 (), rightNTFF.get2 (), rightNTFF.get3 ()};
+  grid_coord size[3] = {right[0] - left[0], right[1] - left[1], right[2] - left[2]};
 
-  FieldValue sum_teta (0.0, 0.0);
-  FieldValue sum_phi (0.0, 0.0);
-
-  for (FPValue coordX = coordStart.get1 (); coordX <= coordEnd.get1 (); ++coordX)
-  {
-    for (FPValue coordZ = coordStart.get3 (); coordZ <= coordEnd.get3 (); ++coordZ)
-    {
-      FieldValue Ex1;
-      FieldValue Ex2;
-      FieldValue Ez1;
-      FieldValue Ez2;
-
-      if (layout_type == E_CENTERED)
-      {
-        GridCoordinateFP3D pos1 = GRID_COORDINATE_FP_3D (coordX - 0.5, y0, coordZ, ct1, ct2, ct3);
-        GridCoordinateFP3D pos2 = GRID_COORDINATE_FP_3D (coordX + 0.5, y0, coordZ, ct1, ct2, ct3);
-        GridCoordinateFP3D pos3 = GRID_COORDINATE_FP_3D (coordX, y0, coordZ - 0.5, ct1, ct2, ct3);
-        GridCoordinateFP3D pos4 = GRID_COORDINATE_FP_3D (coordX, y0, coordZ + 0.5, ct1, ct2, ct3);
+  FPValue k = 2*PhysicsConst::Pi / sourceWaveLength;
 
-        pos1 = pos1 - yeeLayout->getMinExCoordFP ();
-        pos2 = pos2 - yeeLayout->getMinExCoordFP ();
+  size_t count = anglesTeta.size ();
 
-        pos3 = pos3 - yeeLayout->getMinEzCoordFP ();
-        pos4 = pos4 - yeeLayout->getMinEzCoordFP ();
+  N.assign (count, NPair ());
+  L.assign (count, NPair ());
 
-        GridCoordinate3D pos11 = convertCoord (pos1 - GRID_COORDINATE_FP_3D (0, 0.5, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos12 = convertCoord (pos1 + GRID_COORDINATE_FP_3D (0, 0.5, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos21 = convertCoord (pos2 - GRID_COORDINATE_FP_3D (0, 0.5, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos22 = convertCoord (pos2 + GRID_COORDINATE_FP_3D (0, 0.5, 0, ct1, ct2, ct3));
+  std::vector<FieldValue> factors[3];
+  std::vector<FieldValue> sums (4 * NTFF_ANGLES_BLOCK);
 
-        GridCoordinate3D pos31 = convertCoord (pos3 - GRID_COORDINATE_FP_3D (0, 0.5, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos32 = convertCoord (pos3 + GRID_COORDINATE_FP_3D (0, 0.5, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos41 = convertCoord (pos4 - GRID_COORDINATE_FP_3D (0, 0.5, 0, ct1, ct2, ct3));
-        GridCoordinate3D pos42 = convertCoord (pos4 + GRID_COORDINATE_FP_3D (0, 0.5, 0, ct1, ct2, ct3));
-
-        FieldValue *valEx11 = curEx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos11);
-        FieldValue *valEx12 = curEx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos12);
-        FieldValue *valEx21 = curEx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos21);
-        FieldValue *valEx22 = curEx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos22);
+  for (size_t start = 0; start < count; start += NTFF_ANGLES_BLOCK)
+  {
+    size_t block = count - start < NTFF_ANGLES_BLOCK ? count - start : NTFF_ANGLES_BLOCK;
 
-        FieldValue *valEz11 = curEz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos31);
-        FieldValue *valEz12 = curEz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos32);
-        FieldValue *valEz21 = curEz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos41);
-        FieldValue *valEz22 = curEz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos42);
+    /*
+     * Factors of exponent for middles of face cells by each axis, for each angle of block
+     */
+    for (uint8_t axis = 0; axis < 3; ++axis)
+    {
+      factors[axis].resize (block * size[axis]);
+    }
 
-#ifdef PARALLEL_GRID
-        if (valEx11 == NULLPTR || ((ParallelGrid*) curEx)->isBufferLeftPosition (pos11)
-            || valEx12 == NULLPTR || ((ParallelGrid*) curEx)->isBufferLeftPosition (pos12)
-            || valEx21 == NULLPTR || ((ParallelGrid*) curEx)->isBufferLeftPosition (pos21)
-            || valEx22 == NULLPTR || ((ParallelGrid*) curEx)->isBufferLeftPosition (pos22)
-            || valEz11 == NULLPTR || ((ParallelGrid*) curEz)->isBufferLeftPosition (pos31)
-            || valEz12 == NULLPTR || ((ParallelGrid*) curEz)->isBufferLeftPosition (pos32)
-            || valEz21 == NULLPTR || ((ParallelGrid*) curEz)->isBufferLeftPosition (pos41)
-            || valEz22 == NULLPTR || ((ParallelGrid*) curEz)->isBufferLeftPosition (pos42))
-        {
-          continue;
-        }
-#endif
+    for (size_t a = 0; a < block; ++a)
+    {
+      FPValue angleTeta = anglesTeta[start + a];
+      FPValue anglePhi = anglesPhi[start + a];
 
-        ASSERT (valEx11 != NULLPTR && valEx12 != NULLPTR && valEx21 != NULLPTR && valEx22 != NULLPTR
-                && valEz11 != NULLPTR && valEz12 != NULLPTR && valEz21 != NULLPTR && valEz22 != NULLPTR);
+      FPValue direction[3] = {sin (angleTeta) * cos (anglePhi),
+                              sin (angleTeta) * sin (anglePhi),
+                              cos (angleTeta)};
 
-        Ex1 = (*valEx11 + *valEx12) / FPValue(2.0);
-        Ex2 = (*valEx21 + *valEx22) / FPValue(2.0);
-        Ez1 = (*valEz11 + *valEz12) / FPValue(2.0);
-        Ez2 = (*valEz21 + *valEz22) / FPValue(2.0);
-      }
-      else if (layout_type == H_CENTERED)
+      for (uint8_t axis = 0; axis < 3; ++axis)
       {
-        GridCoordinateFP3D pos1 = GRID_COORDINATE_FP_3D (coordX, y0, coordZ - 0.5, ct1, ct2, ct3);
-        GridCoordinateFP3D pos2 = GRID_COORDINATE_FP_3D (coordX, y0, coordZ + 0.5, ct1, ct2, ct3);
-        GridCoordinateFP3D pos3 = GRID_COORDINATE_FP_3D (coordX - 0.5, y0, coordZ, ct1, ct2, ct3);
-        GridCoordinateFP3D pos4 = GRID_COORDINATE_FP_3D (coordX + 0.5, y0, coordZ, ct1, ct2, ct3);
-
-        pos1 = pos1 - yeeLayout->getMinExCoordFP ();
-        pos2 = pos2 - yeeLayout->getMinExCoordFP ();
-
-        pos3 = pos3 - yeeLayout->getMinEzCoordFP ();
-        pos4 = pos4 - yeeLayout->getMinEzCoordFP ();
-
-        GridCoordinate3D pos11 = convertCoord (pos1);
-        GridCoordinate3D pos21 = convertCoord (pos2);
-
-        GridCoordinate3D pos31 = convertCoord (pos3);
-        GridCoordinate3D pos41 = convertCoord (pos4);
-
-        FieldValue *valEx11 = curEx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos11);
-        FieldValue *valEx21 = curEx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos21);
-
-        FieldValue *valEz11 = curEz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos31);
-        FieldValue *valEz21 = curEz->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos41);
-
-#ifdef PARALLEL_GRID
-        if (valEx11 == NULLPTR || ((ParallelGrid*) curEx)->isBufferLeftPosition (pos11)
-            || valEx21 == NULLPTR || ((ParallelGrid*) curEx)->isBufferLeftPosition (pos21)
-            || valEz11 == NULLPTR || ((ParallelGrid*) curEz)->isBufferLeftPosition (pos31)
-            || valEz21 == NULLPTR || ((ParallelGrid*) curEz)->isBufferLeftPosition (pos41))
+        for (grid_coord i = 0; i < size[axis]; ++i)
         {
-          continue;
+          FPValue arg = (left[axis] + 0.5 + i - diff[axis]) * direction[axis] * gridStep;
+          factors[axis][a * size[axis] + i] = FieldValue (cos (k * arg), sin (k * arg));
         }
-#endif
-
-        ASSERT (valEx11 != NULLPTR && valEx21 != NULLPTR && valEz11 != NULLPTR && valEz21 != NULLPTR);
-
-        Ex1 = (*valEx11);
-        Ex2 = (*valEx21);
-        Ez1 = (*valEz11);
-        Ez2 = (*valEz21);
-      }
-      else
-      {
-        UNREACHABLE;
       }
-
-      FPValue arg = (coordX - diffx0) * sin(angleTeta)*cos(anglePhi) + (y0 - diffy0) * sin(angleTeta)*sin(anglePhi) + (coordZ - diffz0) * cos (angleTeta);
-      arg *= gridStep;
-
-      FPValue k = 2*PhysicsConst::Pi / sourceWaveLength;
-
-      FieldValue exponent (cos(k*arg), sin(k*arg));
-
-      sum_teta += ((Ez1 + Ez2)/FPValue(2.0) * FPValue (cos (angleTeta)) * FPValue (cos (anglePhi))
-                   + (Ex1 + Ex2)/FPValue(2.0) * FPValue (sin (angleTeta))) * exponent * SQR (gridStep) * (-1) * (y0==rightNTFF.get2 ()?1:-1);
-
-      sum_phi += ((Ez1 + Ez2)/FPValue(2.0) * FPValue (sin (anglePhi))) * exponent * SQR (gridStep) * (y0==rightNTFF.get2 ()?1:-1);
     }
-  }
-
-  return NPair (sum_teta, sum_phi);
-#else
-  ASSERT_MESSAGE ("Solver is not compiled with support of complex values. Recompile it with -DCOMPLEX_FIELD_VALUES=ON.");
-  return NPair (FPValue (0), FPValue (0));
-#endif
-}
-
-template <LayoutType layout_type>
-NPair
-SchemeHelper::ntffL3D_z (grid_coord z0, FPValue angleTeta, FPValue anglePhi,
-                         GridCoordinate3D leftNTFF,
-                         GridCoordinate3D rightNTFF,
-                         YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *yeeLayout,
-                         FPValue gridStep,
-                         FPValue sourceWaveLength,
-                         Grid<GridCoordinate3D> *curEx,
-                         Grid<GridCoordinate3D> *curEy,
-                         Grid<GridCoordinate3D> *curEz,
-                         Grid<GridCoordinate3D> *curHx,
-                         Grid<GridCoordinate3D> *curHy,
-                         Grid<GridCoordinate3D> *curHz)
-{
-#ifdef COMPLEX_FIELD_VALUES
-  ASSERT (yeeLayout->getSize ().get1 () % 2 == 0);
-  ASSERT (yeeLayout->getSize ().get2 () % 2 == 0);
-  ASSERT (yeeLayout->getSize ().get3 () % 2 == 0);
-  FPValue diffx0 = yeeLayout->getSize ().get1 () / 2;
-  FPValue diffy0 = yeeLayout->getSize ().get2 () / 2;
-  FPValue diffz0 = yeeLayout->getSize ().get3 () / 2;
-
-  CoordinateType ct1, ct2, ct3;
-#ifdef DEBUG_INFO
-  ct1 = leftNTFF.getType1 ();
-  ct2 = leftNTFF.getType2 ();
-  ct3 = leftNTFF.getType3 ();
-#endif
 
-  GridCoordinateFP3D coordStart = GRID_COORDINATE_FP_3D (leftNTFF.get1 () + 0.5, leftNTFF.get2 () + 0.5, z0, ct1, ct2, ct3);
-  GridCoordinateFP3D coordEnd = GRID_COORDINATE_FP_3D (rightNTFF.get1 () - 0.5, rightNTFF.get2 () - 0.5, z0, ct1, ct2, ct3);
-
-  FieldValue sum_teta (0.0, 0.0);
-  FieldValue sum_phi (0.0, 0.0);
-
-  for (FPValue coordX = coordStart.get1 (); coordX <= coordEnd.get1 (); ++coordX)
-  {
-    for (FPValue coordY = coordStart.get2 (); coordY <= coordEnd.get2 (); ++coordY)
+    for (uint8_t face = 0; face < NTFF_FACES_COUNT; ++face)
     {
-      FieldValue Ex1;
-      FieldValue Ex2;
-      FieldValue Ey1;
-      FieldValue Ey2;
+      const NTFFFace &cur = faces[face];
 
-      if (layout_type == E_CENTERED)
+      if (cur.E1.empty ())
       {
-        GridCoordinateFP3D pos1 = GRID_COORDINATE_FP_3D (coordX - 0.5, coordY, z0, ct1, ct2, ct3);
-        GridCoordinateFP3D pos2 = GRID_COORDINATE_FP_3D (coordX + 0.5, coordY, z0, ct1, ct2, ct3);
-        GridCoordinateFP3D pos3 = GRID_COORDINATE_FP_3D (coordX, coordY - 0.5, z0, ct1, ct2, ct3);
-        GridCoordinateFP3D pos4 = GRID_COORDINATE_FP_3D (coordX, coordY + 0.5, z0, ct1, ct2, ct3);
-
-        pos1 = pos1 - yeeLayout->getMinExCoordFP ();
-        pos2 = pos2 - yeeLayout->getMinExCoordFP ();
+        continue;
+      }
 
-        pos3 = pos3 - yeeLayout->getMinEyCoordFP ();
-        pos4 = pos4 - yeeLayout->getMinEyCoordFP ();
+      uint8_t n = face / 2;
+      uint8_t axis1 = n == 0 ? 1 : 0;
+      uint8_t axis2 = n == 2 ? 1 : 2;
 
-        GridCoordinate3D pos11 = convertCoord (pos1 - GRID_COORDINATE_FP_3D (0, 0, 0.5, ct1, ct2, ct3));
-        GridCoordinate3D pos12 = convertCoord (pos1 + GRID_COORDINATE_FP_3D (0, 0, 0.5, ct1, ct2, ct3));
-        GridCoordinate3D pos21 = convertCoord (pos2 - GRID_COORDINATE_FP_3D (0, 0, 0.5, ct1, ct2, ct3));
-        GridCoordinate3D pos22 = convertCoord (pos2 + GRID_COORDINATE_FP_3D (0, 0, 0.5, ct1, ct2, ct3));
+      ASSERT (cur.sizeU == size[axis1] && cur.sizeV == size[axis2]);
 
-        GridCoordinate3D pos31 = convertCoord (pos3 - GRID_COORDINATE_FP_3D (0, 0, 0.5, ct1, ct2, ct3));
-        GridCoordinate3D pos32 = convertCoord (pos3 + GRID_COORDINATE_FP_3D (0, 0, 0.5, ct1, ct2, ct3));
-        GridCoordinate3D pos41 = convertCoord (pos4 - GRID_COORDINATE_FP_3D (0, 0, 0.5, ct1, ct2, ct3));
-        GridCoordinate3D pos42 = convertCoord (pos4 + GRID_COORDINATE_FP_3D (0, 0, 0.5, ct1, ct2, ct3));
+      OrthogonalAxis normal = n == 0 ? OrthogonalAxis::X : (n == 1 ? OrthogonalAxis::Y : OrthogonalAxis::Z);
 
-        FieldValue *valEx11 = curEx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos11);
-        FieldValue *valEx12 = curEx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos12);
-        FieldValue *valEx21 = curEx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos21);
-        FieldValue *valEx22 = curEx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos22);
+      grid_coord coord0 = face % 2 == 0 ? left[n] : right[n];
+      FPValue sign = face % 2 == 0 ? -1 : 1;
 
-        FieldValue *valEy11 = curEy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos31);
-        FieldValue *valEy12 = curEy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos32);
-        FieldValue *valEy21 = curEy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos41);
-        FieldValue *valEy22 = curEy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos42);
+      std::fill (sums.begin (), sums.end (), FieldValue (0.0, 0.0));
 
-#ifdef PARALLEL_GRID
-        if (valEx11 == NULLPTR || ((ParallelGrid*) curEx)->isBufferLeftPosition (pos11)
-            || valEx12 == NULLPTR || ((ParallelGrid*) curEx)->isBufferLeftPosition (pos12)
-            || valEx21 == NULLPTR || ((ParallelGrid*) curEx)->isBufferLeftPosition (pos21)
-            || valEx22 == NULLPTR || ((ParallelGrid*) curEx)->isBufferLeftPosition (pos22)
-            || valEy11 == NULLPTR || ((ParallelGrid*) curEy)->isBufferLeftPosition (pos31)
-            || valEy12 == NULLPTR || ((ParallelGrid*) curEy)->isBufferLeftPosition (pos32)
-            || valEy21 == NULLPTR || ((ParallelGrid*) curEy)->isBufferLeftPosition (pos41)
-            || valEy22 == NULLPTR || ((ParallelGrid*) curEy)->isBufferLeftPosition (pos42))
-        {
-          continue;
-        }
-#endif
-
-        ASSERT (valEx11 != NULLPTR && valEx12 != NULLPTR && valEx21 != NULLPTR && valEx22 != NULLPTR
-                && valEy11 != NULLPTR && valEy12 != NULLPTR && valEy21 != NULLPTR && valEy22 != NULLPTR);
-
-        Ex1 = (*valEx11 + *valEx12) / FPValue(2.0);
-        Ex2 = (*valEx21 + *valEx22) / FPValue(2.0);
-        Ey1 = (*valEy11 + *valEy12) / FPValue(2.0);
-        Ey2 = (*valEy21 + *valEy22) / FPValue(2.0);
-      }
-      else if (layout_type == H_CENTERED)
+      for (grid_coord i = 0; i < cur.sizeU; ++i)
       {
-        GridCoordinateFP3D pos1 = GRID_COORDINATE_FP_3D (coordX, coordY - 0.5, z0, ct1, ct2, ct3);
-        GridCoordinateFP3D pos2 = GRID_COORDINATE_FP_3D (coordX, coordY - 0.5, z0, ct1, ct2, ct3);
-        GridCoordinateFP3D pos3 = GRID_COORDINATE_FP_3D (coordX - 0.5, coordY, z0, ct1, ct2, ct3);
-        GridCoordinateFP3D pos4 = GRID_COORDINATE_FP_3D (coordX + 0.5, coordY, z0, ct1, ct2, ct3);
-
-        pos1 = pos1 - yeeLayout->getMinExCoordFP ();
-        pos2 = pos2 - yeeLayout->getMinExCoordFP ();
+        const FieldValue *E1 = &cur.E1[i * cur.sizeV];
+        const FieldValue *E2 = &cur.E2[i * cur.sizeV];
+        const FieldValue *H1 = &cur.H1[i * cur.sizeV];
+        const FieldValue *H2 = &cur.H2[i * cur.sizeV];
 
-        pos3 = pos3 - yeeLayout->getMinEyCoordFP ();
-        pos4 = pos4 - yeeLayout->getMinEyCoordFP ();
-
-        GridCoordinate3D pos11 = convertCoord (pos1);
-        GridCoordinate3D pos21 = convertCoord (pos2);
+        for (size_t a = 0; a < block; ++a)
+        {
+          FieldValue rowE1 (0.0, 0.0);
+          FieldValue rowE2 (0.0, 0.0);
+          FieldValue rowH1 (0.0, 0.0);
+          FieldValue rowH2 (0.0, 0.0);
 
-        GridCoordinate3D pos31 = convertCoord (pos3);
-        GridCoordinate3D pos41 = convertCoord (pos4);
+          const FieldValue *factorsV = &factors[axis2][a * cur.sizeV];
 
-        FieldValue *valEx11 = curEx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos11);
-        FieldValue *valEx21 = curEx->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos21);
+          for (grid_coord j = 0; j < cur.sizeV; ++j)
+          {
+            rowE1 += E1[j] * factorsV[j];
+            rowE2 += E2[j] * factorsV[j];
+            rowH1 += H1[j] * factorsV[j];
+            rowH2 += H2[j] * factorsV[j];
+          }
 
-        FieldValue *valEy11 = curEy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos31);
-        FieldValue *valEy21 = curEy->getFieldValueOrNullCurrentAfterShiftByAbsolutePos (pos41);
+          FieldValue factorU = factors[axis1][a * cur.sizeU + i];
 
-#ifdef PARALLEL_GRID
-        if (valEx11 == NULLPTR || ((ParallelGrid*) curEx)->isBufferLeftPosition (pos11)
-            || valEx21 == NULLPTR || ((ParallelGrid*) curEx)->isBufferLeftPosition (pos21)
-            || valEy11 == NULLPTR || ((ParallelGrid*) curEy)->isBufferLeftPosition (pos31)
-            || valEy21 == NULLPTR || ((ParallelGrid*) curEy)->isBufferLeftPosition (pos41))
-        {
-          continue;
+          sums[4 * a] += rowE1 * factorU;
+          sums[4 * a + 1] += rowE2 * factorU;
+          sums[4 * a + 2] += rowH1 * factorU;
+          sums[4 * a + 3] += rowH2 * factorU;
         }
-#endif
-
-        ASSERT (valEx11 != NULLPTR && valEx21 != NULLPTR && valEy11 != NULLPTR && valEy21 != NULLPTR);
-
-        Ex1 = (*valEx11);
-        Ex2 = (*valEx21);
-        Ey1 = (*valEy11);
-        Ey2 = (*valEy21);
-      }
-      else
-      {
-        UNREACHABLE;
       }
 
-      FPValue arg = (coordX - diffx0) * sin(angleTeta)*cos(anglePhi) + (coordY - diffy0) * sin(angleTeta)*sin(anglePhi) + (z0 - diffz0) * cos (angleTeta);
-      arg *= gridStep;
+      for (size_t a = 0; a < block; ++a)
+      {
+        FPValue angleTeta = anglesTeta[start + a];
+        FPValue anglePhi = anglesPhi[start + a];
 
-      FPValue k = 2*PhysicsConst::Pi / sourceWaveLength;
+        FPValue direction0 = n == 0 ? sin (angleTeta) * cos (anglePhi)
+                                    : (n == 1 ? sin (angleTeta) * sin (anglePhi) : cos (angleTeta));
 
-      FieldValue exponent (cos(k*arg), sin(k*arg));
+        FPValue arg0 = (coord0 - diff[n]) * direction0 * gridStep;
+        FieldValue factor = FieldValue (cos (k * arg0), sin (k * arg0)) * (SQR (gridStep) * sign * norm);
 
-      sum_teta += ((Ey1 + Ey2)/FPValue(2.0) * FPValue (cos (angleTeta)) * FPValue (cos (anglePhi))
-                   - (Ex1 + Ex2)/FPValue(2.0) * FPValue (cos (angleTeta)) * FPValue (sin (anglePhi))) * exponent * SQR (gridStep) * (z0==rightNTFF.get3 ()?1:-1);
+        NPair termN = ntffTerm3D (normal, true, angleTeta, anglePhi, sums[4 * a + 2], sums[4 * a + 3]);
+        NPair termL = ntffTerm3D (normal, false, angleTeta, anglePhi, sums[4 * a], sums[4 * a + 1]);
 
-      sum_phi += ((Ey1 + Ey2)/FPValue(2.0) * FPValue (sin (anglePhi))
-                  + (Ex1 + Ex2)/FPValue(2.0) * FPValue (cos (anglePhi))) * exponent * SQR (gridStep) * (-1) * (z0==rightNTFF.get3 ()?1:-1);
+        N[start + a] = N[start + a] + NPair (termN.nTeta * factor, termN.nPhi * factor);
+        L[start + a] = L[start + a] + NPair (termL.nTeta * factor, termL.nPhi * factor);
+      }
     }
   }
-
-  return NPair (sum_teta, sum_phi);
 #else
   ASSERT_MESSAGE ("Solver is not compiled with support of complex values. Recompile it with -DCOMPLEX_FIELD_VALUES=ON.");
-  return NPair (FPValue (0), FPValue (0));
 #endif
 }
 
-template <LayoutType layout_type>
-NPair
-SchemeHelper::ntffN3D (FPValue angleTeta, FPValue anglePhi,
-                       GridCoordinate3D leftNTFF,
-                       GridCoordinate3D rightNTFF,
-                       YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *yeeLayout,
-                       FPValue gridStep,
-                       FPValue sourceWaveLength, // TODO: check sourceWaveLengthNumerical
-                       Grid<GridCoordinate3D> *curEx,
-                       Grid<GridCoordinate3D> *curEy,
-                       Grid<GridCoordinate3D> *curEz,
-                       Grid<GridCoordinate3D> *curHx,
-                       Grid<GridCoordinate3D> *curHy,
-                       Grid<GridCoordinate3D> *curHz)
-{
-  NPair nx = ntffN3D_x (leftNTFF.get1 (), angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, gridStep, sourceWaveLength, curEx, curEy, curEz, curHx, curHy, curHz)
-                     + ntffN3D_x (rightNTFF.get1 (), angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, gridStep, sourceWaveLength, curEx, curEy, curEz, curHx, curHy, curHz);
-  NPair ny = ntffN3D_y (leftNTFF.get2 (), angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, gridStep, sourceWaveLength, curEx, curEy, curEz, curHx, curHy, curHz)
-                     + ntffN3D_y (rightNTFF.get2 (), angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, gridStep, sourceWaveLength, curEx, curEy, curEz, curHx, curHy, curHz);
-  NPair nz = ntffN3D_z (leftNTFF.get3 (), angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, gridStep, sourceWaveLength, curEx, curEy, curEz, curHx, curHy, curHz)
-                     + ntffN3D_z (rightNTFF.get3 (), angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, gridStep, sourceWaveLength, curEx, curEy, curEz, curHx, curHy, curHz);
-
-  return nx + ny + nz;
-}
-
-template <LayoutType layout_type>
-NPair
-SchemeHelper::ntffL3D (FPValue angleTeta, FPValue anglePhi,
-                       GridCoordinate3D leftNTFF,
-                       GridCoordinate3D rightNTFF,
-                       YeeGridLayout<(static_cast<SchemeType_t> (SchemeType::Dim3)), GridCoordinate3DTemplate, layout_type> *yeeLayout,
-                       FPValue gridStep,
-                       FPValue sourceWaveLength, // TODO: check sourceWaveLengthNumerical
-                       Grid<GridCoordinate3D> *curEx,
-                       Grid<GridCoordinate3D> *curEy,
-                       Grid<GridCoordinate3D> *curEz,
-                       Grid<GridCoordinate3D> *curHx,
-                       Grid<GridCoordinate3D> *curHy,
-                       Grid<GridCoordinate3D> *curHz)
-{
-  NPair lx = ntffL3D_x (leftNTFF.get1 (), angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, gridStep, sourceWaveLength, curEx, curEy, curEz, curHx, curHy, curHz)
-                     + ntffL3D_x (rightNTFF.get1 (), angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, gridStep, sourceWaveLength, curEx, curEy, curEz, curHx, curHy, curHz);
-  NPair ly = ntffL3D_y (leftNTFF.get2 (), angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, gridStep, sourceWaveLength, curEx, curEy, curEz, curHx, curHy, curHz)
-                     + ntffL3D_y (rightNTFF.get2 (), angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, gridStep, sourceWaveLength, curEx, curEy, curEz, curHx, curHy, curHz);
-  NPair lz = ntffL3D_z (leftNTFF.get3 (), angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, gridStep, sourceWaveLength, curEx, curEy, curEz, curHx, curHy, curHz)
-                     + ntffL3D_z (rightNTFF.get3 (), angleTeta, anglePhi, leftNTFF, rightNTFF, yeeLayout, gridStep, sourceWaveLength, curEx, curEy, curEz, curHx, curHy, curHz);
-
-  return lx + ly + lz;
-}
-
 #endif /* !SCHEME_HELPER_H */
@@ -90,6 +90,11 @@ SETTINGS_ELEM_FIELD_TYPE_INT(numTimeSteps, getNumTimeSteps, time_step, 100, "--t
 SETTINGS_ELEM_FIELD_TYPE_FLOAT(incidentWaveAngle1, getIncidentWaveAngle1, FPValue, 90.0, "--angle-teta", "Incident wave angle teta (degrees)")
 SETTINGS_ELEM_FIELD_TYPE_FLOAT(incidentWaveAngle2, getIncidentWaveAngle2, FPValue, 0.0, "--angle-phi", "Incident wave angle phi (degrees)")
 SETTINGS_ELEM_FIELD_TYPE_FLOAT(incidentWaveAngle3, getIncidentWaveAngle3, FPValue, 90.0, "--angle-psi", "Incident wave angle psi (degrees)")
+SETTINGS_ELEM_FIELD_TYPE_INT(incidentWavesCount, getIncidentWavesCount, int, 1, "--incident-waves-count", "Number of incident waves, which are launched simultaneously through TF/SF border (angles of wave k are angles of the first wave plus k angle steps)")
+SETTINGS_ELEM_FIELD_TYPE_FLOAT(incidentWaveAngle1Step, getIncidentWaveAngle1Step, FPValue, 0.0, "--angle-teta-step", "Step of teta angle between consecutive incident waves (degrees)")
+SETTINGS_ELEM_FIELD_TYPE_FLOAT(incidentWaveAngle2Step, getIncidentWaveAngle2Step, FPValue, 0.0, "--angle-phi-step", "Step of phi angle between consecutive incident waves (degrees)")
+SETTINGS_ELEM_FIELD_TYPE_FLOAT(incidentWaveAngle3Step, getIncidentWaveAngle3Step, FPValue, 0.0, "--angle-psi-step", "Step of psi angle between consecutive incident waves (degrees)")
+SETTINGS_ELEM_FIELD_TYPE_NONE(doUseBatchedIncidentWaves, getDoUseBatchedIncidentWaves, bool, false, "--use-batched-incident-waves", "Compute separate simulation for each incident wave instead of sum of all incident waves (field grids store value for each incident wave in each point, and all simulations are advanced by single sweep over grid)")
 
 /*
  * Concurrency
@@ -100,6 +105,15 @@ SETTINGS_ELEM_FIELD_TYPE_INT(topologySizeX, getTopologySizeX, int, 1, "--topolog
 SETTINGS_ELEM_FIELD_TYPE_INT(topologySizeY, getTopologySizeY, int, 1, "--topology-sizey", "Size by y coordinate of virtual topology")
 SETTINGS_ELEM_FIELD_TYPE_INT(topologySizeZ, getTopologySizeZ, int, 1, "--topology-sizez", "Size by z coordinate of virtual topology")
 SETTINGS_ELEM_OPTION_TYPE_NONE("--same-size-topology", "Use size of topology by x coordinate for y and z coordinates too")
+SETTINGS_ELEM_FIELD_TYPE_FLOAT(topologyPointTime, getTopologyPointTime, FPValue, 5e-8, "--topology-point-time", "Time of computations for single grid point on single thread (seconds), used to choose optimal virtual topology")
+SETTINGS_ELEM_FIELD_TYPE_FLOAT(topologyLatencyIntraNode, getTopologyLatencyIntraNode, FPValue, 1e-6, "--topology-latency-intra-node", "Latency of share operations between processes on the same node (seconds), used to choose optimal virtual topology")
+SETTINGS_ELEM_FIELD_TYPE_FLOAT(topologyBandwidthIntraNode, getTopologyBandwidthIntraNode, FPValue, 5e8, "--topology-bandwidth-intra-node", "Bandwidth of share operations between processes on the same node (grid points per second), used to choose optimal virtual topology")
+SETTINGS_ELEM_FIELD_TYPE_FLOAT(topologyLatencyInterNode, getTopologyLatencyInterNode, FPValue, 5e-6, "--topology-latency-inter-node", "Latency of share operations between processes on different nodes (seconds), used to choose optimal virtual topology")
+SETTINGS_ELEM_FIELD_TYPE_FLOAT(topologyBandwidthInterNode, getTopologyBandwidthInterNode, FPValue, 1e8, "--topology-bandwidth-inter-node", "Bandwidth of share operations between processes on different nodes (grid points per second), used to choose optimal virtual topology")
+SETTINGS_ELEM_FIELD_TYPE_NONE(doUseNeighborShareSync, getDoUseNeighborShareSync, bool, false, "--use-neighbor-share-sync", "Synchronize computational nodes after share operations only with neighbors (without global barrier)")
+SETTINGS_ELEM_FIELD_TYPE_NONE(doUseAsyncShare, getDoUseAsyncShare, bool, false, "--use-async-share", "Use non-blocking share operations for parallel grid, overlapped with computations of inner part of grid")
+SETTINGS_ELEM_FIELD_TYPE_NONE(doUseNodeSharedMaterials, getDoUseNodeSharedMaterials, bool, false, "--use-node-shared-materials", "Store single copy of material and coefficient grids for all processes on the same shared memory node (requires virtual topology split only along Ox axis)")
+SETTINGS_ELEM_FIELD_TYPE_INT(numThreads, getNumThreads, int, 0, "--num-threads", "Number of OpenMP threads for each computational node (0 to use OpenMP default)")
 
 /*
  * CUDA
@@ -185,6 +199,7 @@ SETTINGS_ELEM_FIELD_TYPE_STRING(fileNameNTFF, getFileNameNTFF, std::string, "ntf
 SETTINGS_ELEM_FIELD_TYPE_NONE(doSaveNTFFToStdout, getDoSaveNTFFToStdout, bool, false, "--ntff-to-stdout", "Save NTFF for standard output")
 SETTINGS_ELEM_FIELD_TYPE_FLOAT(angleStepNTFF, getAngleStepNTFF, FPValue, 10.0, "--ntff-step-angle", "NTFF angle step")
 SETTINGS_ELEM_FIELD_TYPE_INT(intermediateNTFFStep, getIntermediateNTFFStep, time_step, 100, "--interm-ntff-step", "Save step for intermediate ntff")
+SETTINGS_ELEM_FIELD_TYPE_NONE(doUseNTFFRunningDFT, getDoUseNTFFRunningDFT, bool, false, "--ntff-running-dft", "Accumulate running DFT of tangential fields on NTFF surface on each time step and compute NTFF from it (3D only)")
 
 /*
  * Physics
@@ -207,6 +222,9 @@ SETTINGS_ELEM_FIELD_TYPE_NONE(doSaveScatteredFieldRes, getDoSaveScatteredFieldRe
 SETTINGS_ELEM_FIELD_TYPE_NONE(doSaveScatteredFieldIntermediate, getDoSaveScatteredFieldIntermediate, bool, false, "--save-scattered--field-interm", "Save scattered field for intermediate")
 SETTINGS_ELEM_FIELD_TYPE_NONE(doSaveAsBMP, getDoSaveAsBMP, bool, false, "--save-as-bmp", "Save results to .bmp files")
 SETTINGS_ELEM_FIELD_TYPE_NONE(doSaveAsDAT, getDoSaveAsDAT, bool, false, "--save-as-dat", "Save results to .dat files")
+SETTINGS_ELEM_FIELD_TYPE_NONE(doSaveDATInBackground, getDoSaveDATInBackground, bool, false, "--save-dat-in-background", "Write .dat files in background thread, while computations continue (requires C++11)")
+SETTINGS_ELEM_FIELD_TYPE_NONE(doUseCollectiveDATIO, getDoUseCollectiveDATIO, bool, false, "--use-collective-dat-io", "Save/load .dat files of parallel grids with collective MPI-IO, where each process accesses only its own chunk, without gathering of full grid")
+SETTINGS_ELEM_FIELD_TYPE_NONE(doUseMmapDATIO, getDoUseMmapDATIO, bool, false, "--use-mmap-dat-io", "Load .dat files of materials through memory mapping: in sequential mode mapping is used as storage of material grid, in parallel mode each process copies values of its own chunk from mapping")
 SETTINGS_ELEM_FIELD_TYPE_NONE(doSaveAsTXT, getDoSaveAsTXT, bool, false, "--save-as-txt", "Save results to .txt files")
 SETTINGS_ELEM_FIELD_TYPE_NONE(doSaveTFSFEInc, getDoSaveTFSFEInc, bool, false, "--save-tfsf-e-incident", "Save TF/SF EInc")
 SETTINGS_ELEM_FIELD_TYPE_NONE(doSaveTFSFHInc, getDoSaveTFSFHInc, bool, false, "--save-tfsf-h-incident", "Save TF/SF HInc")
@@ -220,6 +238,13 @@ SETTINGS_ELEM_FIELD_TYPE_INT(saveEndCoordY, getSaveEndCoordY, int, 0, "--save-en
 SETTINGS_ELEM_FIELD_TYPE_INT(saveEndCoordZ, getSaveEndCoordZ, int, 0, "--save-end-coord-z", "End z coordinate to save from")
 SETTINGS_ELEM_FIELD_TYPE_NONE(doSaveWithoutPML, getDoSaveWithoutPML, bool, false, "--save-no-pml", "Save without PML")
 
+/*
+ * Checkpoint flags
+ */
+SETTINGS_ELEM_FIELD_TYPE_INT(checkpointStep, getCheckpointStep, time_step, 0, "--checkpoint-every", "Save checkpoint of time-dependent state of each process each N time steps (0 to disable)")
+SETTINGS_ELEM_FIELD_TYPE_STRING(checkpointDir, getCheckpointDir, std::string, ".", "--checkpoint-dir", "Directory to save checkpoints to")
+SETTINGS_ELEM_FIELD_TYPE_STRING(restartDir, getRestartDir, std::string, "", "--restart-from", "Directory with checkpoint to continue computations from")
+
 /*
  * Load flags
  */
@@ -233,7 +258,7 @@ SETTINGS_ELEM_FIELD_TYPE_STRING(gammaMFileName, getGammaMFileName, std::string,
 SETTINGS_ELEM_FIELD_TYPE_NONE(useEpsAllNorm, getUseEpsAllNorm, bool, false, "--eps-normed", "Permittivity of Eps material set to 1/eps0")
 SETTINGS_ELEM_FIELD_TYPE_NONE(useMuAllNorm, getUseMuAllNorm, bool, false, "--mu-normed", "Permittivity of Mu material set to 1/mu0")
 
-SETTINGS_ELEM_FIELD_TYPE_INT(sphereAccuracy, getSphereAccuracy, int, 100, "--sphere-accuracy", "Sphere approximation accuracy (number of points per grid step)")
+SETTINGS_ELEM_FIELD_TYPE_INT(sphereAccuracy, getSphereAccuracy, int, 100, "--sphere-accuracy", "Sphere approximation accuracy (number of points per grid step, used only for cells intersected by surface of sphere)")
 
 SETTINGS_ELEM_FIELD_TYPE_FLOAT(epsSphere, getEpsSphere, FPValue, 1.0, "--eps-sphere", "Permittivity of Eps material sphere")
 SETTINGS_ELEM_FIELD_TYPE_INT(epsSphereCenterX, getEpsSphereCenterX, int, 0, "--eps-sphere-center-x", "Center position by x coordinate of Eps material sphere")
@@ -330,6 +355,7 @@ SETTINGS_ELEM_FIELD_TYPE_NONE(doCheckEnablingConditions, getDoCheckEnablingCondi
  * FDTD helper grids
  */
 SETTINGS_ELEM_FIELD_TYPE_NONE(doUseCaCbGrids, getDoUseCaCbGrids, bool, false, "--use-ca-cb", "Use helper grids (Ca, Cb, Da, Db) with precomputed values for general FDTD computation")
+SETTINGS_ELEM_FIELD_TYPE_NONE(doUseCaCbMaterialIds, getDoUseCaCbMaterialIds, bool, false, "--use-ca-cb-material-ids", "Use grids of material identifiers with small tables of precomputed Ca, Cb, Da, Db instead of full helper grids (mutually exclusive with --use-ca-cb)")
 SETTINGS_ELEM_FIELD_TYPE_NONE(doUseCaCbPMLGrids, getDoUseCaCbPMLGrids, bool, false, "--use-ca-cb-pml", "Use helper grids (Ca, Cb, Cc, Da, Db, Dc) with precomputed values for PML FDTD computation")
 SETTINGS_ELEM_FIELD_TYPE_NONE(doUseCaCbPMLMetaGrids, getDoUseCaCbPMLMetaGrids, bool, false, "--use-ca-cb-pml-metamaterials", "Use helper grids (B0, B1, B2, A1, A2) with precomputed values for PML metamaterials FDTD computation")
 
@@ -342,6 +368,10 @@ SETTINGS_ELEM_FIELD_TYPE_INT(layoutType, getLayoutType, LayoutType, 0, "--layout
  * Steps in time
  */
 SETTINGS_ELEM_FIELD_TYPE_INT(storedSteps, getStoredSteps, time_step, 2, "--stored-steps", "Number of time steps in time, for which grid values are stored")
+SETTINGS_ELEM_FIELD_TYPE_NONE(doUseInPlaceUpdate, getDoUseInPlaceUpdate, bool, false, "--use-in-place-update", "Store single time step for E and H grids and update them in-place (ignored with NTFF and CUDA)")
+SETTINGS_ELEM_FIELD_TYPE_NONE(doUseTemporalBlocking, getDoUseTemporalBlocking, bool, false, "--use-temporal-blocking", "Perform several time steps for tile of grid before moving to next tile (sequential in-place mode without PML, TF/SF and callbacks)")
+SETTINGS_ELEM_FIELD_TYPE_INT(temporalBlockingSteps, getTemporalBlockingSteps, time_step, 4, "--temporal-blocking-steps", "Number of time steps performed for tile with temporal blocking")
+SETTINGS_ELEM_FIELD_TYPE_INT(temporalBlockingTileSize, getTemporalBlockingTileSize, grid_coord, 16, "--temporal-blocking-tile-size", "Size of tile by first axis of grid with temporal blocking")
 
 SETTINGS_ELEM_OPTION_TYPE_STRING("--cmd-from-file", "Load command line from file. Cmd file has the next format:\n"
                                                     "\t\t<cmd with arg>\n"
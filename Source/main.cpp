@@ -18,6 +18,10 @@
 #include "Settings.h"
 #include "Scheme.h"
 
+#ifdef OPENMP_ENABLED
+#include <omp.h>
+#endif /* OPENMP_ENABLED */
+
 #include "PhysicsConst.h"
 
 int cudaThreadsX = 8;
@@ -74,9 +78,24 @@ void initParallel (ParallelYeeGridLayout<Type, layout_type> **yeeLayout,
 #endif /* DEBUG_INFO */
                                    );
 
+  int threadsPerProcess = 1;
+#ifdef OPENMP_ENABLED
+  threadsPerProcess = solverSettings.getNumThreads () > 0 ? solverSettings.getNumThreads () : omp_get_max_threads ();
+#endif /* OPENMP_ENABLED */
+
+  TopologyCostModel costModel (solverSettings.getTopologyPointTime (),
+                               threadsPerProcess,
+                               solverSettings.getTopologyLatencyIntraNode (),
+                               solverSettings.getTopologyBandwidthIntraNode (),
+                               solverSettings.getTopologyLatencyInterNode (),
+                               solverSettings.getTopologyBandwidthInterNode (),
+                               solverSettings.getBufferSize ());
+
   *parallelGridCore = new ParallelGridCore (*rank, *numProcs, overallSize,
                                             solverSettings.getDoUseManualVirtualTopology (),
-                                            topology);
+                                            topology,
+                                            solverSettings.getDoUseNeighborShareSync (),
+                                            costModel);
   ParallelGrid::initializeParallelCore (*parallelGridCore);
 
   if (*rank >= (*parallelGridCore)->getTotalProcCount ())
@@ -1083,7 +1102,16 @@ int runMode (int argc, char** argv)
   bool isParallel = false;
 
 #if defined (PARALLEL_GRID)
+#ifdef OPENMP_ENABLED
+  /*
+   * Only main thread performs MPI calls
+   */
+  int threadSupport;
+  MPI_Init_thread (&argc, &argv, MPI_THREAD_FUNNELED, &threadSupport);
+  ALWAYS_ASSERT (threadSupport >= MPI_THREAD_FUNNELED);
+#else /* OPENMP_ENABLED */
   MPI_Init(&argc, &argv);
+#endif /* !OPENMP_ENABLED */
 
 #ifdef MPI_CLOCK
   DPRINTF (LOG_LEVEL_1, "MPI_Wtime resolution %.10f (seconds)\n", MPI_Wtick ());
@@ -1118,6 +1146,20 @@ int runMode (int argc, char** argv)
   if (!skipProcess)
 #endif
   {
+#ifdef OPENMP_ENABLED
+    if (SOLVER_SETTINGS.getNumThreads () > 0)
+    {
+      omp_set_num_threads (SOLVER_SETTINGS.getNumThreads ());
+    }
+
+    DPRINTF (LOG_LEVEL_STAGES, "Number of OpenMP threads: %d\n", omp_get_max_threads ());
+#else /* OPENMP_ENABLED */
+    if (SOLVER_SETTINGS.getNumThreads () > 1)
+    {
+      ALWAYS_ASSERT_MESSAGE ("Solver is not compiled with support of OpenMP. Recompile it with -DOPENMP_ENABLED=ON.");
+    }
+#endif /* !OPENMP_ENABLED */
+
 #ifdef CUDA_ENABLED
     if (SOLVER_SETTINGS.getDoUseCuda ())
     {
@@ -1191,6 +1233,7 @@ int runMode (int argc, char** argv)
     }
     else
     {
+      ParallelGrid::deleteGroups ();
       delete parallelGridCore;
 
       MPI_Barrier (MPI_COMM_WORLD);
@@ -93,13 +93,13 @@ int main (int argc, char** argv)
 #define ANGLES 0, 0, 0
 #endif
 
-  ParallelGridCore parallelGridCore (rank, numProcs, overallSize, true, topologySize);
-  ParallelGrid::initializeParallelCore (&parallelGridCore);
+  ParallelGridCore *parallelGridCore = new ParallelGridCore (rank, numProcs, overallSize, true, topologySize, false);
+  ParallelGrid::initializeParallelCore (parallelGridCore);
 
   bool isDoubleMaterialPrecision = false;
 
   ParallelYeeGridLayout<SCHEME_TYPE, E_CENTERED> yeeLayout (overallSize, pmlSize, tfsfSizeLeft, tfsfSizeRight, ANGLES, isDoubleMaterialPrecision);
-  yeeLayout.Initialize (&parallelGridCore);
+  yeeLayout.Initialize (parallelGridCore);
 
   ParallelGrid grid (overallSize, bufferSize, 0, yeeLayout.getSizeForCurNode ());
 
@@ -258,6 +258,9 @@ int main (int argc, char** argv)
 
   gettimeofday(&tv2, NULL);
 
+  ParallelGrid::deleteGroups ();
+  delete parallelGridCore;
+
   MPI_Finalize();
 
   printf ("Total time = %f seconds\n",
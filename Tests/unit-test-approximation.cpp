@@ -39,5 +39,63 @@ int main (int argc, char** argv)
     }
   }
 
+  /*
+   * Sum of volume fractions of all cells should be equal to volume (area) of sphere, and cells, which are not
+   * intersected by its surface, should be filled with eps or outsideEps exactly
+   */
+  FPValue radius = 5;
+  FieldValue eps = getFieldValueRealOnly (FPValue (2));
+  FieldValue outsideEps = getFieldValueRealOnly (FPValue (1));
+
+  GridCoordinateFP2D center2D (FPValue (10.5), FPValue (10.5), CoordinateType::X, CoordinateType::Y);
+  FPValue area = 0;
+  for (grid_coord i = 0; i < 21; ++i)
+  {
+    for (grid_coord j = 0; j < 21; ++j)
+    {
+      GridCoordinateFP2D midPos (FPValue (i + 0.5), FPValue (j + 0.5), CoordinateType::X, CoordinateType::Y);
+      GridCoordinateFP2D start (FPValue (i), FPValue (j), CoordinateType::X, CoordinateType::Y);
+      GridCoordinateFP2D end (FPValue (i + 1), FPValue (j + 1), CoordinateType::X, CoordinateType::Y);
+
+      FieldValue val = Approximation::approximateSphereAccurate (midPos, center2D, radius, eps, outsideEps);
+
+      CellIntersection intersection = Approximation::getSphereIntersection (start, end, center2D, radius);
+      ALWAYS_ASSERT (intersection != CellIntersection::INSIDE || val == eps);
+      ALWAYS_ASSERT (intersection != CellIntersection::OUTSIDE || val == outsideEps);
+
+      area += Approximation::getMaterial (val - outsideEps);
+    }
+  }
+  ALWAYS_ASSERT (fabs (area - PhysicsConst::Pi * SQR (radius)) < PhysicsConst::Pi * SQR (radius) / 100);
+
+  GridCoordinateFP3D center3D (FPValue (10.5), FPValue (10.5), FPValue (10.5),
+                               CoordinateType::X, CoordinateType::Y, CoordinateType::Z);
+  FPValue volume = 0;
+  for (grid_coord i = 0; i < 21; ++i)
+  {
+    for (grid_coord j = 0; j < 21; ++j)
+    {
+      for (grid_coord k = 0; k < 21; ++k)
+      {
+        GridCoordinateFP3D midPos (FPValue (i + 0.5), FPValue (j + 0.5), FPValue (k + 0.5),
+                                   CoordinateType::X, CoordinateType::Y, CoordinateType::Z);
+        GridCoordinateFP3D start (FPValue (i), FPValue (j), FPValue (k),
+                                  CoordinateType::X, CoordinateType::Y, CoordinateType::Z);
+        GridCoordinateFP3D end (FPValue (i + 1), FPValue (j + 1), FPValue (k + 1),
+                                CoordinateType::X, CoordinateType::Y, CoordinateType::Z);
+
+        FieldValue val = Approximation::approximateSphereAccurate (midPos, center3D, radius, eps, outsideEps);
+
+        CellIntersection intersection = Approximation::getSphereIntersection (start, end, center3D, radius);
+        ALWAYS_ASSERT (intersection != CellIntersection::INSIDE || val == eps);
+        ALWAYS_ASSERT (intersection != CellIntersection::OUTSIDE || val == outsideEps);
+
+        volume += Approximation::getMaterial (val - outsideEps);
+      }
+    }
+  }
+  FPValue sphereVolume = FPValue (4) / FPValue (3) * PhysicsConst::Pi * SQR (radius) * radius;
+  ALWAYS_ASSERT (fabs (volume - sphereVolume) < sphereVolume / 100);
+
   return 0;
 } /* main */
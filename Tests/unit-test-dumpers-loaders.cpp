@@ -14,6 +14,7 @@
 #include "DATLoader.h"
 #include "TXTDumper.h"
 #include "TXTLoader.h"
+#include "Checkpoint.h"
 
 #ifndef CXX11_ENABLED
 #include "cstdlib"
@@ -183,6 +184,206 @@ static void dat (Grid<GridCoordinate1D> *grid1D,
   checkIsTheSame (grid1D, grid2D, grid3D);
 }
 
+static void datBox (Grid<GridCoordinate3D> *grid3D)
+{
+  CoordinateType ct1 = grid3D->getSize ().getType1 ();
+  CoordinateType ct2 = grid3D->getSize ().getType2 ();
+  CoordinateType ct3 = grid3D->getSize ().getType3 ();
+
+  GridCoordinate3D start = GRID_COORDINATE_3D (3, 5, 7, ct1, ct2, ct3);
+  GridCoordinate3D end = GRID_COORDINATE_3D (20, 17, 30, ct1, ct2, ct3);
+
+  DATDumper<GridCoordinate3D> datDumper3D;
+  DATLoader<GridCoordinate3D> datLoader3D;
+
+  /*
+   * Dump single time step from box and load it to empty grid
+   */
+  datDumper3D.dumpGrid (grid3D, start, end, 0, 1, 0);
+
+  Grid<GridCoordinate3D> loaded (grid3D->getSize (), 3, "3D");
+  datLoader3D.loadGrid (&loaded, start, end, 0, 1, 0);
+
+  for (grid_coord i = 0; i < gridSizeX; ++i)
+  {
+    for (grid_coord j = 0; j < gridSizeY; ++j)
+    {
+      for (grid_coord k = 0; k < gridSizeZ; ++k)
+      {
+        GridCoordinate3D pos = GRID_COORDINATE_3D (i, j, k, ct1, ct2, ct3);
+        grid_coord coord = grid3D->calculateIndexFromPosition (pos);
+
+        if (pos >= start && pos < end)
+        {
+          ASSERT (*loaded.getFieldValue (coord, 1) == *grid3D->getFieldValue (coord, 1));
+        }
+        else
+        {
+          ASSERT (*loaded.getFieldValue (coord, 1) == FIELDVALUE (0, 0));
+        }
+        ASSERT (*loaded.getFieldValue (coord, 0) == FIELDVALUE (0, 0));
+      }
+    }
+  }
+}
+
+static void datMmap (Grid<GridCoordinate3D> *grid3D)
+{
+  CoordinateType ct1 = grid3D->getSize ().getType1 ();
+  CoordinateType ct2 = grid3D->getSize ().getType2 ();
+  CoordinateType ct3 = grid3D->getSize ().getType3 ();
+
+  GridCoordinate3D zero = GRID_COORDINATE_3D (0, 0, 0, ct1, ct2, ct3);
+  grid_coord total = grid3D->getSize ().calculateTotalCoord ();
+
+  DATDumper<GridCoordinate3D> datDumper3D;
+  DATLoader<GridCoordinate3D> datLoader3D;
+  datLoader3D.setUseMmap (true);
+
+  /*
+   * Grid with single stored time step, which is loaded as a whole, adopts mapping as its storage
+   */
+  Grid<GridCoordinate3D> single (grid3D->getSize (), 1, "3DSingle");
+  for (grid_coord i = 0; i < total; ++i)
+  {
+    single.setFieldValue (*grid3D->getFieldValue (i, 0), i, 0);
+  }
+  datDumper3D.dumpGrid (&single, zero, single.getSize (), 0, 0, 0);
+
+  Grid<GridCoordinate3D> mapped (grid3D->getSize (), 1, "3DSingle");
+  datLoader3D.loadGrid (&mapped, zero, mapped.getSize (), 0, 0, 0);
+
+  for (grid_coord i = 0; i < total; ++i)
+  {
+    ASSERT (*mapped.getFieldValue (i, 0) == *grid3D->getFieldValue (i, 0));
+  }
+
+  /*
+   * Mapping is private, so change of adopted values doesn't change file
+   */
+  mapped.setFieldValue (FIELDVALUE (-1, -1), 0, 0);
+
+  Grid<GridCoordinate3D> reloaded (grid3D->getSize (), 1, "3DSingle");
+  DATLoader<GridCoordinate3D> datLoaderStream3D;
+  datLoaderStream3D.loadGrid (&reloaded, zero, reloaded.getSize (), 0, 0, 0);
+
+  for (grid_coord i = 0; i < total; ++i)
+  {
+    ASSERT (*reloaded.getFieldValue (i, 0) == *grid3D->getFieldValue (i, 0));
+  }
+
+  /*
+   * Grid with several stored time steps copies values from mapping
+   */
+  datDumper3D.dumpGrid (grid3D, zero, grid3D->getSize (), 0, -1, 0);
+
+  Grid<GridCoordinate3D> copied (grid3D->getSize (), 3, "3D");
+  datLoader3D.loadGrid (&copied, zero, copied.getSize (), 0, -1, 0);
+
+  for (int t = 0; t < 3; ++t)
+  {
+    for (grid_coord i = 0; i < total; ++i)
+    {
+      ASSERT (*copied.getFieldValue (i, t) == *grid3D->getFieldValue (i, t));
+    }
+  }
+}
+
+#ifdef CXX11_ENABLED
+static void datBackground (Grid<GridCoordinate1D> *grid1D,
+                           Grid<GridCoordinate2D> *grid2D,
+                           Grid<GridCoordinate3D> *grid3D)
+{
+  DATDumper<GridCoordinate1D> datDumper1D;
+  DATDumper<GridCoordinate2D> datDumper2D;
+  DATDumper<GridCoordinate3D> datDumper3D;
+
+  datDumper1D.setWriteInBackground (true);
+  datDumper2D.setWriteInBackground (true);
+  datDumper3D.setWriteInBackground (true);
+
+  DATLoader<GridCoordinate1D> datLoader1D;
+  DATLoader<GridCoordinate2D> datLoader2D;
+  DATLoader<GridCoordinate3D> datLoader3D;
+
+  GridCoordinate1D pos1D = GRID_COORDINATE_1D (0, grid1D->getSize ().getType1 ());
+  datDumper1D.dumpGrid (grid1D, pos1D, grid1D->getSize (), 0, -1, 0);
+
+  GridCoordinate2D pos2D = GRID_COORDINATE_2D (0, 0, grid2D->getSize ().getType1 (), grid2D->getSize ().getType2 ());
+  datDumper2D.dumpGrid (grid2D, pos2D, grid2D->getSize (), 0, -1, 0);
+
+  GridCoordinate3D pos3D = GRID_COORDINATE_3D (0, 0, 0,
+                                               grid3D->getSize ().getType1 (),
+                                               grid3D->getSize ().getType2 (),
+                                               grid3D->getSize ().getType3 ());
+  datDumper3D.dumpGrid (grid3D, pos3D, grid3D->getSize (), 0, -1, 0);
+
+  datDumper1D.waitForWriter ();
+  datDumper2D.waitForWriter ();
+  datDumper3D.waitForWriter ();
+
+  datLoader1D.loadGrid (grid1D, pos1D, grid1D->getSize (), 0, -1, 0);
+  datLoader2D.loadGrid (grid2D, pos2D, grid2D->getSize (), 0, -1, 0);
+  datLoader3D.loadGrid (grid3D, pos3D, grid3D->getSize (), 0, -1, 0);
+
+  checkIsTheSame (grid1D, grid2D, grid3D);
+}
+#endif /* CXX11_ENABLED */
+
+static void checkpoint (Grid<GridCoordinate1D> *grid1D,
+                        Grid<GridCoordinate3D> *grid3D)
+{
+  CheckpointWriter writer;
+#ifdef CXX11_ENABLED
+  writer.setWriteInBackground (true);
+#endif /* CXX11_ENABLED */
+
+  /*
+   * Save all time steps of grids as separate blocks
+   */
+  writer.begin (17);
+  for (int t = 0; t < 3; ++t)
+  {
+    writer.addBlock (std::string ("1D_") + int64_to_string (t), grid1D->getRaw (t),
+                     grid1D->getSize ().calculateTotalCoord () * sizeof (FieldValue));
+    writer.addBlock (std::string ("3D_") + int64_to_string (t), grid3D->getRaw (t),
+                     grid3D->getSize ().calculateTotalCoord () * sizeof (FieldValue));
+  }
+  writer.write (CheckpointWriter::getFileName (".", 17, 0));
+  writer.waitForWriter ();
+
+  Grid<GridCoordinate1D> loaded1D (grid1D->getSize (), 3, "1D");
+  Grid<GridCoordinate3D> loaded3D (grid3D->getSize (), 3, "3D");
+
+  CheckpointReader reader (CheckpointWriter::getFileName (".", 17, 0));
+  ASSERT (reader.getTimeStep () == 17);
+  ASSERT (!reader.hasBlock ("2D_0"));
+  ASSERT (reader.getBlockSize ("3D_2") == grid3D->getSize ().calculateTotalCoord () * sizeof (FieldValue));
+
+  for (int t = 2; t >= 0; --t)
+  {
+    reader.readBlock (std::string ("3D_") + int64_to_string (t), loaded3D.getRaw (t),
+                      grid3D->getSize ().calculateTotalCoord () * sizeof (FieldValue));
+    reader.readBlock (std::string ("1D_") + int64_to_string (t), loaded1D.getRaw (t),
+                      grid1D->getSize ().calculateTotalCoord () * sizeof (FieldValue));
+  }
+
+  for (int t = 0; t < 3; ++t)
+  {
+    for (grid_coord i = 0; i < grid1D->getSize ().calculateTotalCoord (); ++i)
+    {
+      ASSERT (*loaded1D.getFieldValue (i, t) == *grid1D->getFieldValue (i, t));
+    }
+    for (grid_coord i = 0; i < grid3D->getSize ().calculateTotalCoord (); ++i)
+    {
+      ASSERT (*loaded3D.getFieldValue (i, t) == *grid3D->getFieldValue (i, t));
+    }
+  }
+
+  CheckpointWriter::writeIndex (".", 17);
+  ASSERT (CheckpointReader::readIndex (".") == 17);
+}
+
 static void txt (Grid<GridCoordinate1D> *grid1D,
                  Grid<GridCoordinate2D> *grid2D,
                  Grid<GridCoordinate3D> *grid3D)
@@ -282,8 +483,14 @@ int main (int argc, char** argv)
   }
 
   dat (&grid1D, &grid2D, &grid3D);
+  datBox (&grid3D);
+  datMmap (&grid3D);
+#ifdef CXX11_ENABLED
+  datBackground (&grid1D, &grid2D, &grid3D);
+#endif /* CXX11_ENABLED */
   txt (&grid1D, &grid2D, &grid3D);
   bmp (&grid1D, &grid2D, &grid3D);
+  checkpoint (&grid1D, &grid3D);
 
   return 0;
 } /* main */
@@ -7,6 +7,7 @@
 #include "Assert.h"
 #include "GridCoordinate3D.h"
 #include "Grid.h"
+#include "MaterialIdGrid.h"
 
 #ifndef CXX11_ENABLED
 #include "cstdlib"
@@ -24,6 +25,14 @@ void testFunc (TCoord overallSize, int storedSteps, CoordinateType ct1, Coordina
 
   Grid<TCoord> grid (overallSize, storedSteps);
 
+  for (int i = 0; i < storedSteps; ++i)
+  {
+    ASSERT (*grid.getFieldValue (test_coord, i) == FIELDVALUE (0, 0));
+#ifdef ALIGNED_GRID_VALUES
+    ASSERT (((uintptr_t) grid.getRaw (i)) % GRID_VALUES_ALIGNMENT == 0);
+#endif /* ALIGNED_GRID_VALUES */
+  }
+
   ASSERT (grid.getSize () == overallSize);
   ASSERT (grid.getTotalSize () == overallSize);
 
@@ -71,10 +80,106 @@ void testFunc (TCoord overallSize, int storedSteps, CoordinateType ct1, Coordina
   }
 
   ASSERT (grid.getRaw (0) == grid.getFieldValue (zero, 0));
+
+  if (storedSteps == 1)
+  {
+    /*
+     * Grid with single time step is updated in-place, i.e. all time steps are the same
+     */
+    grid.setFieldValue (FIELDVALUE (17, 71), test_coord, 0);
+    grid.shiftInTime ();
+    ASSERT (*grid.getFieldValue (test_coord, 1) == FIELDVALUE (17, 71));
+    ASSERT (*grid.getFieldValueCurrentAfterShiftByAbsolutePos (test_coord) == FIELDVALUE (17, 71));
+    ASSERT (*grid.getFieldValuePreviousAfterShiftByAbsolutePos (test_coord) == FIELDVALUE (17, 71));
+    ASSERT (grid.getRaw (2) == grid.getRaw (0));
+  }
+}
+
+#ifdef BATCHED_GRID_VALUES
+void testBatchedGrid ()
+{
+  grid_coord size = 100;
+  int lanes = 3;
+  Grid<GridCoordinate1D> grid (GridCoordinate1D (size, CoordinateType::X), 2, "grid");
+
+  grid.setBatchSize (lanes);
+  ASSERT (grid.getBatchSize () == lanes);
+  ASSERT (grid.getActiveLane () == 0);
+
+  for (int lane = 0; lane < lanes; ++lane)
+  {
+    grid.setActiveLane (lane);
+    for (grid_coord i = 0; i < size; ++i)
+    {
+      grid.setFieldValue (FIELDVALUE (i, lane), GridCoordinate1D (i, CoordinateType::X), 0);
+    }
+  }
+
+  /*
+   * Values of all lanes of point are stored one after another
+   */
+  for (grid_coord i = 0; i < size; ++i)
+  {
+    for (int lane = 0; lane < lanes; ++lane)
+    {
+      ASSERT (grid.getRaw (0)[i * lanes + lane] == FIELDVALUE (i, lane));
+    }
+  }
+
+  grid.setActiveLane (1);
+  ASSERT (std::string (grid.getName ()) == std::string ("grid_lane1"));
+  ASSERT (*grid.getFieldValue (GridCoordinate1D (7, CoordinateType::X), 0) == FIELDVALUE (7, 1));
+}
+#endif /* BATCHED_GRID_VALUES */
+
+void testMaterialIdGrid ()
+{
+  grid_coord size = 1000;
+  MaterialIdGrid materialIds (size);
+
+  ASSERT (materialIds.getSize () == size);
+  ASSERT (materialIds.getMaterialsCount () == 1);
+
+  for (grid_coord i = 0; i < size; ++i)
+  {
+    if (i % 10 == 0)
+    {
+      continue;
+    }
+
+    materialIds.setCoefficients (i, FPValue (1), FPValue (i % 3 + 1));
+  }
+
+  /*
+   * Zero coefficients and three distinct materials
+   */
+  ASSERT (materialIds.getMaterialsCount () == 4);
+
+  for (grid_coord i = 0; i < size; ++i)
+  {
+    material_id id = materialIds.getRawIds ()[i];
+
+    if (i % 10 == 0)
+    {
+      ASSERT (id == 0);
+      ASSERT (materialIds.getRawCa ()[id] == FIELDCOMPUTEVALUE (0, 0));
+      ASSERT (materialIds.getRawCb ()[id] == FIELDCOMPUTEVALUE (0, 0));
+    }
+    else
+    {
+      ASSERT (materialIds.getRawCa ()[id] == FIELDCOMPUTEVALUE (1, 0));
+      ASSERT (materialIds.getRawCb ()[id] == FIELDCOMPUTEVALUE (FPValue (i % 3 + 1), 0));
+    }
+  }
 }
 
 int main (int argc, char** argv)
 {
+  testMaterialIdGrid ();
+#ifdef BATCHED_GRID_VALUES
+  testBatchedGrid ();
+#endif /* BATCHED_GRID_VALUES */
+
   int gridSizeX = 32;
   int gridSizeY = 32;
   int gridSizeZ = 32;
@@ -19,6 +19,266 @@
 
 #define ACCURACY 0.000018
 
+/*
+ * Compare update of grid by chunk kernel (calculateFieldStepIterationChunk) with per-point update
+ * (calculateFieldStepIteration). Both read only previous time step of grids and write current one, so they are
+ * performed on the same state of grids, and values should match exactly.
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type, uint8_t grid_type>
+void testChunkKernel (InternalScheme<Type, TCoord, layout_type> *intScheme,
+                      Grid< TCoord<grid_coord, true> > *grid,
+                      TCoord<grid_coord, true> startDiff,
+                      TCoord<grid_coord, true> endDiff,
+                      Grid< TCoord<grid_coord, true> > *oppositeGrid1,
+                      Grid< TCoord<grid_coord, true> > *oppositeGrid2,
+                      Grid< TCoord<grid_coord, true> > *Ca,
+                      Grid< TCoord<grid_coord, true> > *Cb,
+                      bool usePML,
+                      GridType gridType,
+                      Grid< TCoord<grid_coord, true> > *materialGrid,
+                      GridType materialGridType,
+                      FPValue materialModifier,
+                      CoordinateType ct1,
+                      CoordinateType ct2,
+                      CoordinateType ct3)
+{
+  /*
+   * With in-place update current and previous time steps are the same layer
+   */
+  if (grid->getCountStoredSteps () < 2)
+  {
+    return;
+  }
+
+  TCoord<grid_coord, false> diff11;
+  TCoord<grid_coord, false> diff12;
+  TCoord<grid_coord, false> diff21;
+  TCoord<grid_coord, false> diff22;
+
+  TCoord<FPValue, true> coordFP;
+
+  intScheme->template calculateFieldStepInitDiff<grid_type> (&diff11, &diff12, &diff21, &diff22);
+
+  GridCoordinate3D start3D;
+  GridCoordinate3D end3D;
+
+  expandTo3DStartEnd (grid->getComputationStart (startDiff), grid->getComputationEnd (endDiff), start3D, end3D,
+                      ct1, ct2, ct3);
+
+  grid_coord total = grid->getSize ().calculateTotalCoord ();
+  std::vector<FieldValue> values (total);
+
+  for (grid_coord i = 0; i < total; ++i)
+  {
+    grid->setFieldValue (FIELDVALUE (0, 0), i, 0);
+  }
+
+  for (grid_coord i = start3D.get1 (); i < end3D.get1 (); ++i)
+  {
+    for (grid_coord j = start3D.get2 (); j < end3D.get2 (); ++j)
+    {
+      for (grid_coord k = start3D.get3 (); k < end3D.get3 (); ++k)
+      {
+        TCoord<grid_coord, true> pos = TCoord<grid_coord, true>::initAxesCoordinate (i, j, k, ct1, ct2, ct3);
+        TCoord<grid_coord, true> posAbs = grid->getTotalPosition (pos);
+
+        if (SOLVER_SETTINGS.getDoUseCaCbGrids ())
+        {
+          intScheme->template calculateFieldStepIteration<grid_type, true> (0, pos, posAbs, diff11, diff12, diff21, diff22,
+                                                                            grid, coordFP, oppositeGrid1, oppositeGrid2,
+                                                                            NULLPTR, Ca, Cb, usePML, gridType,
+                                                                            materialGrid, materialGridType,
+                                                                            materialModifier);
+        }
+        else
+        {
+          intScheme->template calculateFieldStepIteration<grid_type, false> (0, pos, posAbs, diff11, diff12, diff21, diff22,
+                                                                             grid, coordFP, oppositeGrid1, oppositeGrid2,
+                                                                             NULLPTR, NULLPTR, NULLPTR, usePML, gridType,
+                                                                             materialGrid, materialGridType,
+                                                                             materialModifier);
+        }
+      }
+    }
+  }
+
+  for (grid_coord i = 0; i < total; ++i)
+  {
+    values[i] = *grid->getFieldValue (i, 0);
+    grid->setFieldValue (FIELDVALUE (0, 0), i, 0);
+  }
+
+  intScheme->template calculateFieldStepIterationChunk<grid_type> (start3D, end3D, diff11, diff12, diff21, diff22,
+                                                                   grid, oppositeGrid1, oppositeGrid2,
+                                                                   SOLVER_SETTINGS.getDoUseCaCbGrids () ? Ca : NULLPTR,
+                                                                   SOLVER_SETTINGS.getDoUseCaCbGrids () ? Cb : NULLPTR,
+                                                                   usePML, gridType, materialGrid, materialGridType,
+                                                                   materialModifier);
+
+  for (grid_coord i = 0; i < total; ++i)
+  {
+    ASSERT (*grid->getFieldValue (i, 0) == values[i]);
+  }
+}
+
+/*
+ * Check whether position is at TF/SF border (closer than one grid step to it by some axis, and not further than one
+ * grid step from TF/SF box by all axes)
+ */
+bool isAtBorderTFSF (GridCoordinateFP3D pos,
+                     GridCoordinate3D left,
+                     GridCoordinate3D right,
+                     CoordinateType ct1,
+                     CoordinateType ct2,
+                     CoordinateType ct3)
+{
+  FPValue coord[3] = { pos.get1 (), pos.get2 (), pos.get3 () };
+  FPValue borderL[3] = { FPValue (left.get1 ()), FPValue (left.get2 ()), FPValue (left.get3 ()) };
+  FPValue borderR[3] = { FPValue (right.get1 ()), FPValue (right.get2 ()), FPValue (right.get3 ()) };
+  bool hasAxis[3] =
+  {
+    ct1 == CoordinateType::X || ct2 == CoordinateType::X || ct3 == CoordinateType::X,
+    ct1 == CoordinateType::Y || ct2 == CoordinateType::Y || ct3 == CoordinateType::Y,
+    ct1 == CoordinateType::Z || ct2 == CoordinateType::Z || ct3 == CoordinateType::Z
+  };
+
+  bool isNear = false;
+
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    if (!hasAxis[axis])
+    {
+      continue;
+    }
+
+    if (coord[axis] < borderL[axis] - 1 || coord[axis] > borderR[axis] + 1)
+    {
+      return false;
+    }
+
+    if (coord[axis] <= borderL[axis] + 1 || coord[axis] >= borderR[axis] - 1)
+    {
+      isNear = true;
+    }
+  }
+
+  return isNear;
+}
+
+/*
+ * Compare incident wave, which is obtained from precomputed projection tables, with incident wave, which is
+ * interpolated directly from auxiliary grid, at points of TF/SF border
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void testIncidentWaveTables (InternalScheme<Type, TCoord, layout_type> *intScheme,
+                             CoordinateType ct1,
+                             CoordinateType ct2,
+                             CoordinateType ct3)
+{
+  YeeGridLayout<Type, TCoord, layout_type> *layout = intScheme->getYeeLayout ();
+
+  GridCoordinate3D left = expandTo3D (layout->getLeftBorderTFSF (), ct1, ct2, ct3);
+  GridCoordinate3D right = expandTo3D (layout->getRightBorderTFSF (), ct1, ct2, ct3);
+
+#define TEST_INCIDENT_WAVE_TABLE(NAME, FIELD) \
+  if (intScheme->getDoNeed ## NAME ()) \
+  { \
+    for (grid_coord i = 0; i < intScheme->get ## NAME ()->getSize ().calculateTotalCoord (); ++i) \
+    { \
+      TCoord<grid_coord, true> pos = intScheme->get ## NAME ()->calculatePositionFromIndex (i); \
+      TCoord<FPValue, true> realCoord = layout->get ## NAME ## CoordFP (pos); \
+      if (!isAtBorderTFSF (expandTo3D (realCoord, ct1, ct2, ct3), left, right, ct1, ct2, ct3)) \
+      { \
+        continue; \
+      } \
+      FieldValue cmp = layout->get ## NAME ## FromIncident ## FIELD (intScheme->approximateIncidentWave ## FIELD (realCoord)); \
+      FieldValue val = intScheme->getIncident ## NAME (pos, ALL_INCIDENT_WAVES); \
+      ASSERT (IS_FP_EXACT (getRealOnlyFromFieldValue (val), getRealOnlyFromFieldValue (cmp))); \
+      TEST_INCIDENT_WAVE_TABLE_IMAG \
+    } \
+  }
+
+#ifdef COMPLEX_FIELD_VALUES
+#define TEST_INCIDENT_WAVE_TABLE_IMAG ASSERT (IS_FP_EXACT (val.imag (), cmp.imag ()));
+#else /* COMPLEX_FIELD_VALUES */
+#define TEST_INCIDENT_WAVE_TABLE_IMAG
+#endif /* !COMPLEX_FIELD_VALUES */
+
+  TEST_INCIDENT_WAVE_TABLE (Ex, E)
+  TEST_INCIDENT_WAVE_TABLE (Ey, E)
+  TEST_INCIDENT_WAVE_TABLE (Ez, E)
+  TEST_INCIDENT_WAVE_TABLE (Hx, H)
+  TEST_INCIDENT_WAVE_TABLE (Hy, H)
+  TEST_INCIDENT_WAVE_TABLE (Hz, H)
+
+#undef TEST_INCIDENT_WAVE_TABLE_IMAG
+#undef TEST_INCIDENT_WAVE_TABLE
+}
+
+/*
+ * Compare chunk kernels with per-point updates for all field components: with coefficients, which are computed from
+ * materials, and with PML coefficients, which are constant outside PML (sigma is non-zero only inside PML).
+ */
+template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
+void testChunkKernels (InternalScheme<Type, TCoord, layout_type> *intScheme,
+                       CoordinateType ct1,
+                       CoordinateType ct2,
+                       CoordinateType ct3)
+{
+  YeeGridLayout<Type, TCoord, layout_type> *layout = intScheme->getYeeLayout ();
+
+  Grid< TCoord<grid_coord, true> > sigma (intScheme->getEps ()->getSize (), 1);
+
+  GridCoordinate3D left = expandTo3D (layout->getLeftBorderPML (), ct1, ct2, ct3);
+  GridCoordinate3D right = expandTo3D (layout->getRightBorderPML (), ct1, ct2, ct3);
+  bool hasAxis[3] =
+  {
+    ct1 == CoordinateType::X || ct2 == CoordinateType::X || ct3 == CoordinateType::X,
+    ct1 == CoordinateType::Y || ct2 == CoordinateType::Y || ct3 == CoordinateType::Y,
+    ct1 == CoordinateType::Z || ct2 == CoordinateType::Z || ct3 == CoordinateType::Z
+  };
+
+  for (grid_coord i = 0; i < sigma.getSize ().calculateTotalCoord (); ++i)
+  {
+    GridCoordinate3D pos = expandTo3D (sigma.calculatePositionFromIndex (i), ct1, ct2, ct3);
+
+    bool isPML = (hasAxis[0] && (pos.get1 () < left.get1 () || pos.get1 () >= right.get1 ()))
+                 || (hasAxis[1] && (pos.get2 () < left.get2 () || pos.get2 () >= right.get2 ()))
+                 || (hasAxis[2] && (pos.get3 () < left.get3 () || pos.get3 () >= right.get3 ()));
+
+    sigma.setFieldValue (FIELDVALUE (isPML ? FPValue (1) : FPValue (0), 0), i, 0);
+  }
+
+#define TEST_CHUNK_KERNEL(NAME, GRID_TYPE, OPPOSITE1, OPPOSITE2, CA, CB, MATERIAL, MATERIAL_TYPE, MODIFIER) \
+  if (intScheme->getDoNeed ## NAME ()) \
+  { \
+    testChunkKernel<Type, TCoord, layout_type, static_cast<uint8_t> (GRID_TYPE)> \
+      (intScheme, intScheme->get ## NAME (), layout->get ## NAME ## StartDiff (), layout->get ## NAME ## EndDiff (), \
+       intScheme->getDoNeed ## OPPOSITE1 () ? intScheme->get ## OPPOSITE1 () : NULLPTR, \
+       intScheme->getDoNeed ## OPPOSITE2 () ? intScheme->get ## OPPOSITE2 () : NULLPTR, \
+       SOLVER_SETTINGS.getDoUseCaCbGrids () ? intScheme->get ## CA ## NAME () : NULLPTR, \
+       SOLVER_SETTINGS.getDoUseCaCbGrids () ? intScheme->get ## CB ## NAME () : NULLPTR, \
+       false, GRID_TYPE, intScheme->get ## MATERIAL (), MATERIAL_TYPE, MODIFIER, ct1, ct2, ct3); \
+    if (!SOLVER_SETTINGS.getDoUseCaCbGrids ()) \
+    { \
+      testChunkKernel<Type, TCoord, layout_type, static_cast<uint8_t> (GRID_TYPE)> \
+        (intScheme, intScheme->get ## NAME (), layout->get ## NAME ## StartDiff (), layout->get ## NAME ## EndDiff (), \
+         intScheme->getDoNeed ## OPPOSITE1 () ? intScheme->get ## OPPOSITE1 () : NULLPTR, \
+         intScheme->getDoNeed ## OPPOSITE2 () ? intScheme->get ## OPPOSITE2 () : NULLPTR, \
+         NULLPTR, NULLPTR, true, GRID_TYPE, &sigma, MATERIAL_TYPE, MODIFIER, ct1, ct2, ct3); \
+    } \
+  }
+
+  TEST_CHUNK_KERNEL (Ex, GridType::EX, Hz, Hy, Ca, Cb, Eps, GridType::EPS, PhysicsConst::Eps0)
+  TEST_CHUNK_KERNEL (Ey, GridType::EY, Hx, Hz, Ca, Cb, Eps, GridType::EPS, PhysicsConst::Eps0)
+  TEST_CHUNK_KERNEL (Ez, GridType::EZ, Hy, Hx, Ca, Cb, Eps, GridType::EPS, PhysicsConst::Eps0)
+  TEST_CHUNK_KERNEL (Hx, GridType::HX, Ey, Ez, Da, Db, Mu, GridType::MU, PhysicsConst::Mu0)
+  TEST_CHUNK_KERNEL (Hy, GridType::HY, Ez, Ex, Da, Db, Mu, GridType::MU, PhysicsConst::Mu0)
+  TEST_CHUNK_KERNEL (Hz, GridType::HZ, Ex, Ey, Da, Db, Mu, GridType::MU, PhysicsConst::Mu0)
+
+#undef TEST_CHUNK_KERNEL
+}
+
 template <SchemeType_t Type, template <typename, bool> class TCoord, LayoutType layout_type>
 void test (InternalScheme<Type, TCoord, layout_type> *intScheme,
            TCoord<grid_coord, true> overallSize,
@@ -810,6 +1070,16 @@ void test (InternalScheme<Type, TCoord, layout_type> *intScheme,
     }
   }
 
+  if (!SOLVER_SETTINGS.getDoUseCuda ())
+  {
+    testChunkKernels (intScheme, ct1, ct2, ct3);
+
+    if (SOLVER_SETTINGS.getDoUseTFSF ())
+    {
+      testIncidentWaveTables (intScheme, ct1, ct2, ct3);
+    }
+  }
+
 #ifdef CUDA_ENABLED
   if (SOLVER_SETTINGS.getDoUseCuda ())
   {
@@ -13,6 +13,7 @@
  */
 
 #include <iostream>
+#include <cstdio>
 
 #include "Assert.h"
 #include "Settings.h"
@@ -158,6 +159,49 @@ ParallelGrid * initGrid (ParallelGridCoordinate overallSize,
   return grid;
 }
 
+#ifdef DYNAMIC_GRID
+/**
+ * Value of point, which does not depend on the owner of point
+ */
+FPValue absVal (ParallelGridCoordinate posAbs, ParallelGridCoordinate overallSize)
+{
+  grid_coord index = posAbs.get1 ();
+#if defined (GRID_2D) || defined (GRID_3D)
+  index = index * overallSize.get2 () + posAbs.get2 ();
+#endif /* GRID_2D || GRID_3D */
+#if defined (GRID_3D)
+  index = index * overallSize.get3 () + posAbs.get3 ();
+#endif /* GRID_3D */
+
+  return FPValue (1 + index);
+}
+
+/**
+ * Uneven size of chunk of node by axis: even nodes get more points than odd ones
+ */
+grid_coord unevenChunk (grid_coord totalSize, int nodesCount, int node)
+{
+  grid_coord chunk = totalSize / nodesCount;
+  grid_coord diff = chunk / 4;
+
+  if (nodesCount % 2 == 1 && node == nodesCount - 1)
+  {
+    return chunk;
+  }
+
+  return node % 2 == 0 ? chunk + diff : chunk - diff;
+}
+
+void checkAbsVal (ParallelGrid *grid, grid_coord index, ParallelGridCoordinate overallSize)
+{
+  FPValue fpval = absVal (grid->getTotalPosition (grid->calculatePositionFromIndex (index)), overallSize);
+
+  ASSERT (*grid->getFieldValue (index, 0) == FIELDVALUE (fpval, fpval * imagMult));
+  ASSERT (*grid->getFieldValue (index, 1) == FIELDVALUE (fpval * prevMult, fpval * prevMult * imagMult));
+  ASSERT (*grid->getFieldValue (index, 2) == FIELDVALUE (fpval * prevPrevMult, fpval * prevPrevMult * imagMult));
+}
+#endif /* DYNAMIC_GRID */
+
 int main (int argc, char** argv)
 {
 #if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
@@ -236,13 +280,13 @@ int main (int argc, char** argv)
 #define ANGLES 0, 0, 0
 #endif /* GRID_3D */
 
-  ParallelGridCore parallelGridCore (rank, numProcs, overallSize, false, topologySize);
-  ParallelGrid::initializeParallelCore (&parallelGridCore);
+  ParallelGridCore *parallelGridCore = new ParallelGridCore (rank, numProcs, overallSize, false, topologySize, false);
+  ParallelGrid::initializeParallelCore (parallelGridCore);
 
   bool isDoubleMaterialPrecision = false;
 
   ParallelYeeGridLayout<SCHEME_TYPE, E_CENTERED> yeeLayout (overallSize, pmlSize, tfsfSizeLeft, tfsfSizeRight, ANGLES, isDoubleMaterialPrecision);
-  yeeLayout.Initialize (&parallelGridCore);
+  yeeLayout.Initialize (parallelGridCore);
 
   ParallelGrid *grid = initGrid (overallSize, bufferSize, yeeLayout.getSizeForCurNode (), false);
 
@@ -444,6 +488,44 @@ int main (int argc, char** argv)
         GridCoordinate2D pos (i, j, CoordinateType::X, CoordinateType::Y);
 #endif /* GRID_2D */
 
+#ifdef GRID_3D
+        GridCoordinate3D pos (i, j, k, CoordinateType::X, CoordinateType::Y, CoordinateType::Z);
+#endif /* GRID_3D */
+
+        checkVal (grid, pos);
+      }
+    }
+  }
+
+  /*
+   * Check that buffers are initialized in the same way by non-blocking share operations
+   */
+  delete grid;
+  grid = initGrid (overallSize, bufferSize, yeeLayout.getSizeForCurNode (), false);
+
+  grid->startShare ();
+  grid->finishShare ();
+
+#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
+  for (grid_coord i = 0; i < grid->getSize ().get1 (); ++i)
+#endif /* GRID_1D || GRID_2D || GRID_3D */
+  {
+#if defined (GRID_2D) || defined (GRID_3D)
+    for (grid_coord j = 0; j < grid->getSize ().get2 (); ++j)
+#endif /* GRID_2D || GRID_3D */
+    {
+#if defined (GRID_3D)
+      for (grid_coord k = 0; k < grid->getSize ().get3 (); ++k)
+#endif /* GRID_3D */
+      {
+#ifdef GRID_1D
+        GridCoordinate1D pos (i, CoordinateType::X);
+#endif /* GRID_1D */
+
+#ifdef GRID_2D
+        GridCoordinate2D pos (i, j, CoordinateType::X, CoordinateType::Y);
+#endif /* GRID_2D */
+
 #ifdef GRID_3D
         GridCoordinate3D pos (i, j, k, CoordinateType::X, CoordinateType::Y, CoordinateType::Z);
 #endif /* GRID_3D */
@@ -580,8 +662,147 @@ int main (int argc, char** argv)
     }
   }
 
+  /*
+   * Save grid to file with collective MPI-IO and load it to another grid, including buffers
+   */
+  std::string fileName ("unit-test-parallel-grid-collective.dat");
+  ParallelGridCoordinate zero = overallSize - overallSize;
+
+  grid->dumpCollective (fileName, zero, overallSize, 1);
+
+  ParallelGrid *gridLoaded = new ParallelGrid (overallSize, bufferSize, 1, yeeLayout.getSizeForCurNode (), 3, 0);
+  gridLoaded->loadCollective (fileName, zero, overallSize, 0);
+
+  for (grid_coord index = 0; index < gridLoaded->getSize ().calculateTotalCoord (); ++index)
+  {
+    ParallelGridCoordinate pos = gridLoaded->calculatePositionFromIndex (index);
+    ParallelGridCoordinate posAbs = gridLoaded->getTotalPosition (pos);
+
+    ASSERT (*gridLoaded->getFieldValue (index, 0) == *gridTotal->getFieldValue (posAbs, 1));
+  }
+
+  delete gridLoaded;
+
+  MPI_Barrier (ParallelGrid::getParallelCore ()->getCommunicator ());
+  if (ParallelGrid::getParallelCore ()->getProcessId () == 0)
+  {
+    remove (fileName.c_str ());
+  }
+
+#ifdef PARALLEL_BUFFER_DIMENSION_1D_X
+  /*
+   * Move grid with single stored time step to window shared between processes on node. Each process fills its local
+   * grid (including buffers) with its own values, and after move buffers, which belong to chunks of processes on the
+   * same node, should contain values of these processes.
+   */
+  ParallelGrid *gridShared = new ParallelGrid (overallSize, bufferSize, 1, yeeLayout.getSizeForCurNode (), 1, 0);
+
+  for (grid_coord index = 0; index < gridShared->getSize ().calculateTotalCoord (); ++index)
+  {
+    ParallelGridCoordinate posAbs = gridShared->getTotalPosition (gridShared->calculatePositionFromIndex (index));
+
+    FPValue fpval = ParallelGrid::getParallelCore ()->getProcessId ();
+#if defined (GRID_1D) || defined (GRID_2D) || defined (GRID_3D)
+    fpval *= posAbs.get1 ();
+#endif /* GRID_1D || GRID_2D || GRID_3D */
+#if defined (GRID_2D) || defined (GRID_3D)
+    fpval *= posAbs.get2 ();
+#endif /* GRID_2D || GRID_3D */
+#if defined (GRID_3D)
+    fpval *= posAbs.get3 ();
+#endif /* GRID_3D */
+
+    gridShared->setFieldValue (FIELDVALUE (fpval, fpval * imagMult), index, 0);
+  }
+
+  gridShared->shareValuesOnNode ();
+
+  int nodeSize;
+  MPI_Comm_size (ParallelGrid::getParallelCore ()->getNodeCommunicator (), &nodeSize);
+
+  for (grid_coord index = 0; index < gridShared->getSize ().calculateTotalCoord (); ++index)
+  {
+    ParallelGridCoordinate pos = gridShared->calculatePositionFromIndex (index);
+    ParallelGridCoordinate posAbs = gridShared->getTotalPosition (pos);
+
+    /*
+     * Values of chunk are always the ones of this process, and all buffers are shared if all processes are on the same
+     * node
+     */
+    if (gridShared->getBufferForPosition (pos) == BUFFER_NONE
+        || nodeSize == ParallelGrid::getParallelCore ()->getTotalProcCount ())
+    {
+      ASSERT (*gridShared->getFieldValue (index, 0) == *gridTotal->getFieldValue (posAbs, 0));
+    }
+  }
+
+  delete gridShared;
+#endif /* PARALLEL_BUFFER_DIMENSION_1D_X */
+
+#ifdef DYNAMIC_GRID
+  /*
+   * Resize chunks of all processes to uneven sizes. Values of each point should be migrated to its new owner, and
+   * buffers should be filled from new neighbors. Only chunks are filled before resize, so values in buffers are
+   * received only by share operation after resize.
+   */
+  ParallelGrid *gridDynamic = new ParallelGrid (overallSize, bufferSize, 1, yeeLayout.getSizeForCurNode (), 3, 0);
+
+  for (grid_coord index = 0; index < gridDynamic->getSize ().calculateTotalCoord (); ++index)
+  {
+    ParallelGridCoordinate pos = gridDynamic->calculatePositionFromIndex (index);
+
+    if (gridDynamic->getBufferForPosition (pos) == BUFFER_NONE)
+    {
+      FPValue fpval = absVal (gridDynamic->getTotalPosition (pos), overallSize);
+
+      gridDynamic->setFieldValue (FIELDVALUE (fpval, fpval * imagMult), index, 0);
+      gridDynamic->setFieldValue (FIELDVALUE (fpval * prevMult, fpval * prevMult * imagMult), index, 1);
+      gridDynamic->setFieldValue (FIELDVALUE (fpval * prevPrevMult, fpval * prevPrevMult * imagMult), index, 2);
+    }
+  }
+
+  ParallelGridCoordinate newSize = yeeLayout.getSizeForCurNode ();
+#if defined (PARALLEL_BUFFER_DIMENSION_1D_X) || defined (PARALLEL_BUFFER_DIMENSION_2D_XY) \
+    || defined (PARALLEL_BUFFER_DIMENSION_2D_XZ) || defined (PARALLEL_BUFFER_DIMENSION_3D_XYZ)
+  newSize.set1 (unevenChunk (gridSizeX, parallelGridCore->getNodeGridSizeX (), parallelGridCore->getNodeGridX ()));
+#endif
+#if defined (PARALLEL_BUFFER_DIMENSION_1D_Y) || defined (PARALLEL_BUFFER_DIMENSION_2D_XY) \
+    || defined (PARALLEL_BUFFER_DIMENSION_2D_YZ) || defined (PARALLEL_BUFFER_DIMENSION_3D_XYZ)
+  newSize.set2 (unevenChunk (gridSizeY, parallelGridCore->getNodeGridSizeY (), parallelGridCore->getNodeGridY ()));
+#endif
+#if defined (PARALLEL_BUFFER_DIMENSION_1D_Z) || defined (PARALLEL_BUFFER_DIMENSION_2D_YZ) \
+    || defined (PARALLEL_BUFFER_DIMENSION_2D_XZ) || defined (PARALLEL_BUFFER_DIMENSION_3D_XYZ)
+  newSize.set3 (unevenChunk (gridSizeZ, parallelGridCore->getNodeGridSizeZ (), parallelGridCore->getNodeGridZ ()));
+#endif
+
+  gridDynamic->Resize (newSize);
+
+  ASSERT (gridDynamic->getSize () == newSize + gridDynamic->getGroupConst ()->getBufferSizeLeft ()
+                                     + gridDynamic->getGroupConst ()->getBufferSizeRight ());
+
+  for (grid_coord index = 0; index < gridDynamic->getSize ().calculateTotalCoord (); ++index)
+  {
+    ParallelGridCoordinate pos = gridDynamic->calculatePositionFromIndex (index);
+    BufferPosition dir = gridDynamic->getBufferForPosition (pos);
+
+    /*
+     * Buffers at borders of the whole grid have no neighbors, and are not filled
+     */
+    if (dir == BUFFER_NONE
+        || ParallelGrid::getParallelCore ()->getNodeForDirection (dir) != PID_NONE)
+    {
+      checkAbsVal (gridDynamic, index, overallSize);
+    }
+  }
+
+  delete gridDynamic;
+#endif /* DYNAMIC_GRID */
+
   delete gridTotal;
 
+  ParallelGrid::deleteGroups ();
+  delete parallelGridCore;
+
   MPI_Finalize();
 
   return 0;
@@ -0,0 +1,40 @@
+#!/bin/bash
+
+set -e
+
+BASE_DIR=$1
+SOURCE_DIR=$2
+
+USED_MODE=$3
+
+if [[ "$USED_MODE" -ne "0" ]]; then
+  echo "Comparison of precisions is performed only in sequential mode, skipping"
+  exit 0
+fi
+
+MODE="-DSOLVER_DIM_MODES=DIM3,TMZ -DCMAKE_BUILD_TYPE=RelWithDebInfo"
+
+TEST_DIR=$(dirname $(readlink -f $0))
+BUILD_DIR=$TEST_DIR/build
+
+function build ()
+{
+  local binary_suffix=$1
+  local value_type=$2
+  local mixed_precision=$3
+
+  rm -rf $BUILD_DIR
+
+  BUILD_SCRIPT="cmake $SOURCE_DIR $MODE -DVALUE_TYPE=$value_type -DMIXED_PRECISION_VALUES=$mixed_precision -DCOMPLEX_FIELD_VALUES=OFF -DPRINT_MESSAGE=ON -DCXX11_ENABLED=ON; make fdtd3d"
+  $BASE_DIR/build-base.sh "$TEST_DIR" "$BUILD_DIR" "$BUILD_SCRIPT"
+  if [ $? -ne 0 ]; then
+    exit 1
+  fi
+  mv $TEST_DIR/fdtd3d $TEST_DIR/fdtd3d_$binary_suffix
+}
+
+build double d OFF
+build float f OFF
+build mixed f ON
+
+exit 0
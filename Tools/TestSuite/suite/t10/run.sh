@@ -0,0 +1,72 @@
+#!/bin/bash
+
+set -e
+
+BASE_DIR=$1
+SOURCE_DIR=$2
+
+USED_MODE=$3
+
+if [[ "$USED_MODE" -ne "0" ]]; then
+  echo "Comparison of precisions is performed only in sequential mode, skipping"
+  exit 0
+fi
+
+timestep="1000"
+
+function launch ()
+{
+  local binary_suffix=$1
+
+  output_file=$(mktemp /tmp/fdtd3d.precision.XXXXXXXX)
+
+  mkdir -p previous-$binary_suffix
+  cd previous-$binary_suffix
+  ../fdtd3d_$binary_suffix --cmd-from-file $TEST_DIR/sphere2D_pointsource_TMz.txt &> $output_file
+  local ret=$?
+  cd $TEST_DIR
+
+  return $ret
+}
+
+# Relative L2 norm of difference between float values of grid and double values of the same grid
+function diff_norm ()
+{
+  local filename_double="$1"
+  local filename_float="$2"
+
+  paste <(od -An -v -t f8 -w8 "$filename_double") <(od -An -v -t f4 -w4 "$filename_float") \
+    | awk '{norm += $1 * $1; diff += ($2 - $1) * ($2 - $1)} END {printf "%.20f", sqrt (diff / norm)}'
+}
+
+CUR_DIR=`pwd`
+TEST_DIR=$(dirname $(readlink -f $0))
+cd $TEST_DIR
+
+retval=$((0))
+
+for binary_suffix in double float mixed; do
+  launch $binary_suffix
+  if [ $? -ne 0 ]; then
+    retval=$((1))
+  fi
+done
+
+for field in Ez Hx Hy; do
+  filename="previous-1_[timestep=$timestep]_[pid=0]_[name=$field].dat"
+
+  norm_float=$(diff_norm "previous-double/$filename" "previous-float/$filename")
+  norm_mixed=$(diff_norm "previous-double/$filename" "previous-mixed/$filename")
+
+  echo "$field: diff norm with double: float $norm_float, mixed $norm_mixed"
+
+  is_ok=$(echo $norm_mixed $norm_float | awk '{if ($1 > 0 && 2 * $1 < $2) {print "OK"} else {print "FAIL"}}')
+  if [[ "$is_ok" != "OK" ]]; then
+    echo "Mixed precision mode is not more precise than float mode: $field"
+    retval=$((2))
+  fi
+done
+
+cd $CUR_DIR
+
+exit $retval
@@ -0,0 +1,18 @@
+#!/bin/bash
+
+set -e
+
+BASE_DIR=$1
+SOURCE_DIR=$2
+
+CUR_DIR=`pwd`
+TEST_DIR=$(dirname $(readlink -f $0))
+cd $TEST_DIR
+
+rm -f fdtd3d
+rm -rf build
+rm -rf previous-*
+
+cd $CUR_DIR
+
+exit 0
@@ -0,0 +1,91 @@
+#!/bin/bash
+
+set -e
+
+BASE_DIR=$1
+SOURCE_DIR=$2
+
+USED_MODE=$3
+
+if [[ "$USED_MODE" -ne "0" ]]; then
+  echo "Batched incident waves are supported only in sequential mode, skipping"
+  exit 0
+fi
+
+ANGLE_PHI_STEP=30
+WAVES_COUNT=2
+
+function launch ()
+{
+  local output_dir=$1
+  local running_dft=$2
+  local wave=$3
+
+  output_file=$(mktemp /tmp/fdtd3d.batched-ntff.XXXXXXXX)
+
+  tmp_test_file=$(mktemp /tmp/batched-ntff.XXXXXXXX.txt)
+  cp $TEST_DIR/sphere3D_ntff.txt $tmp_test_file
+  if [[ "$running_dft" -eq "1" ]]; then
+    echo "--ntff-running-dft" >> $tmp_test_file
+  fi
+  if [[ "$wave" -lt "0" ]]; then
+    echo "--angle-phi 0" >> $tmp_test_file
+    echo "--incident-waves-count $WAVES_COUNT" >> $tmp_test_file
+    echo "--angle-phi-step $ANGLE_PHI_STEP" >> $tmp_test_file
+    echo "--use-batched-incident-waves" >> $tmp_test_file
+  else
+    echo "--angle-phi $((wave * ANGLE_PHI_STEP))" >> $tmp_test_file
+  fi
+
+  mkdir -p $output_dir
+  cd $output_dir
+  ../fdtd3d --cmd-from-file $tmp_test_file &> $output_file
+  local ret=$?
+  cd $TEST_DIR
+
+  return $ret
+}
+
+CUR_DIR=`pwd`
+TEST_DIR=$(dirname $(readlink -f $0))
+cd $TEST_DIR
+
+retval=$((0))
+
+for running_dft in 0 1; do
+  rm -rf previous-*
+
+  launch previous-batched $running_dft -1
+  if [ $? -ne 0 ]; then
+    retval=$((1))
+  fi
+
+  for wave in $(seq 0 $((WAVES_COUNT - 1))); do
+    launch previous-wave$wave $running_dft $wave
+    if [ $? -ne 0 ]; then
+      retval=$((1))
+    fi
+
+    count=$((0))
+    for filename in previous-wave$wave/ntff-res_*.txt; do
+      if [ ! -f "$filename" ]; then
+        continue
+      fi
+      count=$((count + 1))
+      lane_filename=previous-batched/$(basename "$filename" | sed "s/^ntff-res_/ntff-res_lane${wave}_/")
+      if ! cmp -s "$filename" "$lane_filename"; then
+        echo "Mismatch of NTFF of lane $wave (running DFT $running_dft): $(basename "$filename")"
+        retval=$((2))
+      fi
+    done
+
+    if [[ "$count" -eq "0" ]]; then
+      echo "No NTFF in previous-wave$wave"
+      retval=$((2))
+    fi
+  done
+done
+
+cd $CUR_DIR
+
+exit $retval
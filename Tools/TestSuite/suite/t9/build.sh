@@ -0,0 +1,26 @@
+#!/bin/bash
+
+set -e
+
+BASE_DIR=$1
+SOURCE_DIR=$2
+
+USED_MODE=$3
+
+if [[ "$USED_MODE" -ne "0" ]]; then
+  echo "Temporal blocking is supported only in sequential mode, skipping"
+  exit 0
+fi
+
+MODE="-DSOLVER_DIM_MODES=DIM3,TMZ -DCMAKE_BUILD_TYPE=RelWithDebInfo"
+
+TEST_DIR=$(dirname $(readlink -f $0))
+BUILD_DIR=$TEST_DIR/build
+
+BUILD_SCRIPT="cmake $SOURCE_DIR $MODE -DVALUE_TYPE=d -DCOMPLEX_FIELD_VALUES=OFF -DPRINT_MESSAGE=ON -DCXX11_ENABLED=ON; make fdtd3d"
+$BASE_DIR/build-base.sh "$TEST_DIR" "$BUILD_DIR" "$BUILD_SCRIPT"
+if [ $? -ne 0 ]; then
+  exit 1
+fi
+
+exit 0
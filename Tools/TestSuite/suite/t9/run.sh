@@ -0,0 +1,84 @@
+#!/bin/bash
+
+set -e
+
+BASE_DIR=$1
+SOURCE_DIR=$2
+
+USED_MODE=$3
+
+if [[ "$USED_MODE" -ne "0" ]]; then
+  echo "Temporal blocking is supported only in sequential mode, skipping"
+  exit 0
+fi
+
+function launch ()
+{
+  local test_file=$1
+  local output_dir=$2
+  local temporal_blocking=$3
+
+  output_file=$(mktemp /tmp/fdtd3d.temporal-blocking.XXXXXXXX)
+
+  tmp_test_file=$(mktemp /tmp/temporal-blocking.XXXXXXXX.txt)
+  cp $test_file $tmp_test_file
+  if [[ "$temporal_blocking" -eq "1" ]]; then
+    echo "--use-temporal-blocking" >> $tmp_test_file
+    echo "--temporal-blocking-steps 4" >> $tmp_test_file
+    echo "--temporal-blocking-tile-size 8" >> $tmp_test_file
+  fi
+
+  mkdir -p $output_dir
+  cd $output_dir
+  ../fdtd3d --cmd-from-file $tmp_test_file &> $output_file
+  local ret=$?
+  cd $TEST_DIR
+
+  return $ret
+}
+
+function compare ()
+{
+  local dir_ref="$1"
+  local dir_tb="$2"
+
+  local count=$((0))
+  for filename in $dir_ref/*.dat; do
+    count=$((count + 1))
+    if ! cmp -s "$filename" "$dir_tb/$(basename "$filename")"; then
+      echo "Mismatch with temporal blocking: $(basename "$filename")"
+      retval=$((2))
+    fi
+  done
+
+  if [[ "$count" -eq "0" ]]; then
+    echo "No dumps in $dir_ref"
+    retval=$((2))
+  fi
+}
+
+CUR_DIR=`pwd`
+TEST_DIR=$(dirname $(readlink -f $0))
+cd $TEST_DIR
+
+retval=$((0))
+
+for test_file in vacuum2D_pointsource_TMz.txt vacuum3D_pointsource.txt; do
+  rm -rf previous-ref previous-tb
+
+  launch $TEST_DIR/$test_file previous-ref 0
+  if [ $? -ne 0 ]; then
+    retval=$((1))
+  fi
+
+  launch $TEST_DIR/$test_file previous-tb 1
+  if [ $? -ne 0 ]; then
+    retval=$((1))
+  fi
+
+  compare previous-ref previous-tb
+done
+
+cd $CUR_DIR
+
+exit $retval
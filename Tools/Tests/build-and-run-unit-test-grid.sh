@@ -24,49 +24,55 @@ function build
   for VALUE_TYPE in f d ld; do
     for COMPLEX_FIELD_VALUES in ON OFF; do
       for LARGE_COORDINATES in ON OFF; do
-
-        if [ "${VALUE_TYPE}" == "ld" ] && [ "${COMPLEX_FIELD_VALUES}" == "ON" ]; then
-          continue
-        fi
-
-        cmake ${HOME_DIR} -DCMAKE_BUILD_TYPE=RelWithDebInfo \
-          -DVALUE_TYPE=${VALUE_TYPE} \
-          -DCOMPLEX_FIELD_VALUES=${COMPLEX_FIELD_VALUES} \
-          -DPARALLEL_GRID_DIMENSION=3 \
-          -DPRINT_MESSAGE=OFF \
-          -DPARALLEL_GRID=OFF \
-          -DPARALLEL_BUFFER_DIMENSION=x \
-          -DCXX11_ENABLED=${CXX11_ENABLED} \
-          -DCUDA_ENABLED=OFF \
-          -DCUDA_ARCH_SM_TYPE=sm_50 \
-          -DLARGE_COORDINATES=${LARGE_COORDINATES} \
-          -DCMAKE_CXX_COMPILER=${CXX_COMPILER} \
-          -DCMAKE_C_COMPILER=${C_COMPILER} \
-          -DDYNAMIC_GRID=OFF \
-          -DCOMBINED_SENDRECV=OFF \
-          -DMPI_CLOCK=OFF
-
-        res=$(echo $?)
-
-        if [[ res -ne 0 ]]; then
-          exit 1
-        fi
-
-        make unit-test-grid
-
-        res=$(echo $?)
-
-        if [[ res -ne 0 ]]; then
-          exit 1
-        fi
-
-        ./Tests/unit-test-grid
-
-        res=$(echo $?)
-
-        if [[ res -ne 0 ]]; then
-          exit 1
-        fi
+        for ALIGNED_GRID_VALUES in ON OFF; do
+          for BATCHED_GRID_VALUES in ON OFF; do
+
+            if [ "${VALUE_TYPE}" == "ld" ] && [ "${COMPLEX_FIELD_VALUES}" == "ON" ]; then
+              continue
+            fi
+
+            cmake ${HOME_DIR} -DCMAKE_BUILD_TYPE=RelWithDebInfo \
+              -DVALUE_TYPE=${VALUE_TYPE} \
+              -DCOMPLEX_FIELD_VALUES=${COMPLEX_FIELD_VALUES} \
+              -DPARALLEL_GRID_DIMENSION=3 \
+              -DPRINT_MESSAGE=OFF \
+              -DPARALLEL_GRID=OFF \
+              -DPARALLEL_BUFFER_DIMENSION=x \
+              -DCXX11_ENABLED=${CXX11_ENABLED} \
+              -DCUDA_ENABLED=OFF \
+              -DCUDA_ARCH_SM_TYPE=sm_50 \
+              -DLARGE_COORDINATES=${LARGE_COORDINATES} \
+              -DCMAKE_CXX_COMPILER=${CXX_COMPILER} \
+              -DCMAKE_C_COMPILER=${C_COMPILER} \
+              -DDYNAMIC_GRID=OFF \
+              -DCOMBINED_SENDRECV=OFF \
+              -DMPI_CLOCK=OFF \
+              -DALIGNED_GRID_VALUES=${ALIGNED_GRID_VALUES} \
+              -DBATCHED_GRID_VALUES=${BATCHED_GRID_VALUES}
+
+            res=$(echo $?)
+
+            if [[ res -ne 0 ]]; then
+              exit 1
+            fi
+
+            make unit-test-grid
+
+            res=$(echo $?)
+
+            if [[ res -ne 0 ]]; then
+              exit 1
+            fi
+
+            ./Tests/unit-test-grid
+
+            res=$(echo $?)
+
+            if [[ res -ne 0 ]]; then
+              exit 1
+            fi
+          done
+        done
       done
     done
   done
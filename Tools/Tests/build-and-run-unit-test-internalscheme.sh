@@ -16,6 +16,9 @@ C_COMPILER=$4
 
 CXX11_ENABLED=$5
 
+# Number of threads for configuration with OpenMP
+export OMP_NUM_THREADS=4
+
 mkdir -p ${BUILD_DIR}
 cd ${BUILD_DIR}
 
@@ -24,66 +27,86 @@ function build
   for VALUE_TYPE in f d ld; do
     for COMPLEX_FIELD_VALUES in ON OFF; do
       for LARGE_COORDINATES in ON OFF; do
-
-        if [ "${VALUE_TYPE}" == "ld" ] && [ "${COMPLEX_FIELD_VALUES}" == "ON" ]; then
-          continue
-        fi
-
-        cmake ${HOME_DIR} -DCMAKE_BUILD_TYPE=RelWithDebInfo \
-          -DVALUE_TYPE=${VALUE_TYPE} \
-          -DCOMPLEX_FIELD_VALUES=${COMPLEX_FIELD_VALUES} \
-          -DPARALLEL_GRID_DIMENSION=3 \
-          -DPRINT_MESSAGE=OFF \
-          -DPARALLEL_GRID=OFF \
-          -DPARALLEL_BUFFER_DIMENSION=x \
-          -DCXX11_ENABLED=${CXX11_ENABLED} \
-          -DCUDA_ENABLED=OFF \
-          -DCUDA_ARCH_SM_TYPE=sm_50 \
-          -DLARGE_COORDINATES=${LARGE_COORDINATES} \
-          -DCMAKE_CXX_COMPILER=${CXX_COMPILER} \
-          -DCMAKE_C_COMPILER=${C_COMPILER} \
-          -DDYNAMIC_GRID=OFF \
-          -DCOMBINED_SENDRECV=OFF \
-          -DMPI_CLOCK=OFF
-
-        res=$(echo $?)
-
-        if [[ res -ne 0 ]]; then
-          exit 1
-        fi
-
-        make unit-test-internalscheme
-
-        res=$(echo $?)
-
-        if [[ res -ne 0 ]]; then
-          exit 1
-        fi
-
-        ./Tests/unit-test-internalscheme --time-steps 10 --point-source-pos-x 10 --point-source-pos-y 10 --point-source-pos-z 10 --point-source-ex
-
-        if [[ "$?" -ne "0" ]]; then
-          exit 1
-        fi
-
-        ./Tests/unit-test-internalscheme --time-steps 10 --point-source-pos-x 10 --point-source-pos-y 10 --point-source-pos-z 10 --point-source-ex --use-ca-cb
-
-        if [[ "$?" -ne "0" ]]; then
-          exit 1
-        fi
-
-        ./Tests/unit-test-internalscheme --time-steps 200 --use-tfsf
-
-        if [[ "$?" -ne "0" ]]; then
-          exit 1
-        fi
-
-        ./Tests/unit-test-internalscheme --time-steps 200 --use-tfsf --use-ca-cb
-
-        if [[ "$?" -ne "0" ]]; then
-          exit 1
-        fi
-
+        for MIXED_PRECISION_VALUES in OFF ON; do
+          for OPENMP_ENABLED in OFF ON; do
+
+            if [ "${VALUE_TYPE}" == "ld" ] && [ "${COMPLEX_FIELD_VALUES}" == "ON" ]; then
+              continue
+            fi
+
+            # Single configuration with OpenMP threads is enough to check that loops split between threads give the same
+            # results as sequential ones
+            if [ "${OPENMP_ENABLED}" == "ON" ]; then
+              if [ "${VALUE_TYPE}" != "d" ] || [ "${COMPLEX_FIELD_VALUES}" != "OFF" ] || [ "${LARGE_COORDINATES}" != "OFF" ] \
+                 || [ "${MIXED_PRECISION_VALUES}" == "ON" ]; then
+                continue
+              fi
+            fi
+
+            # Mixed precision mode is supported only with float values
+            if [ "${MIXED_PRECISION_VALUES}" == "ON" ] && [ "${VALUE_TYPE}" != "f" ]; then
+              continue
+            fi
+
+            cmake ${HOME_DIR} -DCMAKE_BUILD_TYPE=RelWithDebInfo \
+              -DVALUE_TYPE=${VALUE_TYPE} \
+              -DCOMPLEX_FIELD_VALUES=${COMPLEX_FIELD_VALUES} \
+              -DPARALLEL_GRID_DIMENSION=3 \
+              -DPRINT_MESSAGE=OFF \
+              -DPARALLEL_GRID=OFF \
+              -DPARALLEL_BUFFER_DIMENSION=x \
+              -DCXX11_ENABLED=${CXX11_ENABLED} \
+              -DCUDA_ENABLED=OFF \
+              -DCUDA_ARCH_SM_TYPE=sm_50 \
+              -DLARGE_COORDINATES=${LARGE_COORDINATES} \
+              -DCMAKE_CXX_COMPILER=${CXX_COMPILER} \
+              -DCMAKE_C_COMPILER=${C_COMPILER} \
+              -DDYNAMIC_GRID=OFF \
+              -DCOMBINED_SENDRECV=OFF \
+              -DMPI_CLOCK=OFF \
+              -DOPENMP_ENABLED=${OPENMP_ENABLED} \
+              -DMIXED_PRECISION_VALUES=${MIXED_PRECISION_VALUES}
+
+            res=$(echo $?)
+
+            if [[ res -ne 0 ]]; then
+              exit 1
+            fi
+
+            make unit-test-internalscheme
+
+            res=$(echo $?)
+
+            if [[ res -ne 0 ]]; then
+              exit 1
+            fi
+
+            ./Tests/unit-test-internalscheme --time-steps 10 --point-source-pos-x 10 --point-source-pos-y 10 --point-source-pos-z 10 --point-source-ex
+
+            if [[ "$?" -ne "0" ]]; then
+              exit 1
+            fi
+
+            ./Tests/unit-test-internalscheme --time-steps 10 --point-source-pos-x 10 --point-source-pos-y 10 --point-source-pos-z 10 --point-source-ex --use-ca-cb
+
+            if [[ "$?" -ne "0" ]]; then
+              exit 1
+            fi
+
+            ./Tests/unit-test-internalscheme --time-steps 200 --use-tfsf
+
+            if [[ "$?" -ne "0" ]]; then
+              exit 1
+            fi
+
+            ./Tests/unit-test-internalscheme --time-steps 200 --use-tfsf --use-ca-cb
+
+            if [[ "$?" -ne "0" ]]; then
+              exit 1
+            fi
+
+          done
+        done
       done
     done
   done
@@ -31,83 +31,86 @@ function build
   for VALUE_TYPE in f d ld; do
     for PARALLEL_BUFFER in `echo $LIST_OF_BUFFERS`; do
       for COMBINED_SENDRECV in ON OFF; do
-
-        if [ "${VALUE_TYPE}" == "ld" ] && [ "${COMPLEX_FIELD_VALUES}" == "ON" ]; then
-          continue
-        fi
-
-        cmake ${HOME_DIR} -DCMAKE_BUILD_TYPE=RelWithDebInfo \
-          -DVALUE_TYPE=${VALUE_TYPE} \
-          -DCOMPLEX_FIELD_VALUES=${COMPLEX_FIELD_VALUES} \
-          -DPARALLEL_GRID_DIMENSION=${PARALLEL_GRID_DIM} \
-          -DPRINT_MESSAGE=ON \
-          -DPARALLEL_GRID=ON \
-          -DPARALLEL_BUFFER_DIMENSION=${PARALLEL_BUFFER} \
-          -DCXX11_ENABLED=${CXX11_ENABLED} \
-          -DCUDA_ENABLED=OFF \
-          -DCUDA_ARCH_SM_TYPE=sm_50 \
-          -DLARGE_COORDINATES=${LARGE_COORDINATES} \
-          -DCMAKE_CXX_COMPILER=${CXX_COMPILER} \
-          -DCMAKE_C_COMPILER=${C_COMPILER} \
-          -DDYNAMIC_GRID=OFF \
-          -DCOMBINED_SENDRECV=${COMBINED_SENDRECV} \
-          -DMPI_CLOCK=OFF
-
-        res=$(echo $?)
-
-        if [[ res -ne 0 ]]; then
-          exit 1
-        fi
-
-        make unit-test-parallel-grid
-
-        res=$(echo $?)
-
-        if [[ res -ne 0 ]]; then
-          exit 1
-        fi
-
-        if [[ "$PARALLEL_BUFFER" = "x" ]]; then
-          mpirun -n 2 ./Tests/unit-test-parallel-grid
-        elif [[ "$PARALLEL_BUFFER" = "y" ]]; then
-          mpirun -n 2 ./Tests/unit-test-parallel-grid
-        elif [[ "$PARALLEL_BUFFER" = "z" ]]; then
-          mpirun -n 2 ./Tests/unit-test-parallel-grid
-        elif [[ "$PARALLEL_BUFFER" = "xy" ]]; then
-          mpirun -n 4 ./Tests/unit-test-parallel-grid
-        elif [[ "$PARALLEL_BUFFER" = "yz" ]]; then
-          mpirun -n 4 ./Tests/unit-test-parallel-grid
-        elif [[ "$PARALLEL_BUFFER" = "xz" ]]; then
-          mpirun -n 4 ./Tests/unit-test-parallel-grid
-        fi
-
-        res=$(echo $?)
-
-        if [[ res -ne 0 ]]; then
-          exit 1
-        fi
-
-        if [[ "$PARALLEL_BUFFER" = "x" ]]; then
-          mpirun -n 4 ./Tests/unit-test-parallel-grid
-        elif [[ "$PARALLEL_BUFFER" = "y" ]]; then
-          mpirun -n 4 ./Tests/unit-test-parallel-grid
-        elif [[ "$PARALLEL_BUFFER" = "z" ]]; then
-          mpirun -n 4 ./Tests/unit-test-parallel-grid
-        elif [[ "$PARALLEL_BUFFER" = "xy" ]]; then
-          mpirun -n 16 ./Tests/unit-test-parallel-grid
-        elif [[ "$PARALLEL_BUFFER" = "yz" ]]; then
-          mpirun -n 16 ./Tests/unit-test-parallel-grid
-        elif [[ "$PARALLEL_BUFFER" = "xz" ]]; then
-          mpirun -n 16 ./Tests/unit-test-parallel-grid
-        elif [[ "$PARALLEL_BUFFER" = "xyz" ]]; then
-          mpirun -n 8 ./Tests/unit-test-parallel-grid
-        fi
-
-        res=$(echo $?)
-
-        if [[ res -ne 0 ]]; then
-          exit 1
-        fi
+        for ZERO_COPY_SHARE in ON OFF; do
+
+          if [ "${VALUE_TYPE}" == "ld" ] && [ "${COMPLEX_FIELD_VALUES}" == "ON" ]; then
+            continue
+          fi
+
+          cmake ${HOME_DIR} -DCMAKE_BUILD_TYPE=RelWithDebInfo \
+            -DVALUE_TYPE=${VALUE_TYPE} \
+            -DCOMPLEX_FIELD_VALUES=${COMPLEX_FIELD_VALUES} \
+            -DPARALLEL_GRID_DIMENSION=${PARALLEL_GRID_DIM} \
+            -DPRINT_MESSAGE=ON \
+            -DPARALLEL_GRID=ON \
+            -DPARALLEL_BUFFER_DIMENSION=${PARALLEL_BUFFER} \
+            -DCXX11_ENABLED=${CXX11_ENABLED} \
+            -DCUDA_ENABLED=OFF \
+            -DCUDA_ARCH_SM_TYPE=sm_50 \
+            -DLARGE_COORDINATES=${LARGE_COORDINATES} \
+            -DCMAKE_CXX_COMPILER=${CXX_COMPILER} \
+            -DCMAKE_C_COMPILER=${C_COMPILER} \
+            -DDYNAMIC_GRID=OFF \
+            -DCOMBINED_SENDRECV=${COMBINED_SENDRECV} \
+            -DZERO_COPY_SHARE=${ZERO_COPY_SHARE} \
+            -DMPI_CLOCK=OFF
+
+          res=$(echo $?)
+
+          if [[ res -ne 0 ]]; then
+            exit 1
+          fi
+
+          make unit-test-parallel-grid
+
+          res=$(echo $?)
+
+          if [[ res -ne 0 ]]; then
+            exit 1
+          fi
+
+          if [[ "$PARALLEL_BUFFER" = "x" ]]; then
+            mpirun -n 2 ./Tests/unit-test-parallel-grid
+          elif [[ "$PARALLEL_BUFFER" = "y" ]]; then
+            mpirun -n 2 ./Tests/unit-test-parallel-grid
+          elif [[ "$PARALLEL_BUFFER" = "z" ]]; then
+            mpirun -n 2 ./Tests/unit-test-parallel-grid
+          elif [[ "$PARALLEL_BUFFER" = "xy" ]]; then
+            mpirun -n 4 ./Tests/unit-test-parallel-grid
+          elif [[ "$PARALLEL_BUFFER" = "yz" ]]; then
+            mpirun -n 4 ./Tests/unit-test-parallel-grid
+          elif [[ "$PARALLEL_BUFFER" = "xz" ]]; then
+            mpirun -n 4 ./Tests/unit-test-parallel-grid
+          fi
+
+          res=$(echo $?)
+
+          if [[ res -ne 0 ]]; then
+            exit 1
+          fi
+
+          if [[ "$PARALLEL_BUFFER" = "x" ]]; then
+            mpirun -n 4 ./Tests/unit-test-parallel-grid
+          elif [[ "$PARALLEL_BUFFER" = "y" ]]; then
+            mpirun -n 4 ./Tests/unit-test-parallel-grid
+          elif [[ "$PARALLEL_BUFFER" = "z" ]]; then
+            mpirun -n 4 ./Tests/unit-test-parallel-grid
+          elif [[ "$PARALLEL_BUFFER" = "xy" ]]; then
+            mpirun -n 16 ./Tests/unit-test-parallel-grid
+          elif [[ "$PARALLEL_BUFFER" = "yz" ]]; then
+            mpirun -n 16 ./Tests/unit-test-parallel-grid
+          elif [[ "$PARALLEL_BUFFER" = "xz" ]]; then
+            mpirun -n 16 ./Tests/unit-test-parallel-grid
+          elif [[ "$PARALLEL_BUFFER" = "xyz" ]]; then
+            mpirun -n 8 ./Tests/unit-test-parallel-grid
+          fi
+
+          res=$(echo $?)
+
+          if [[ res -ne 0 ]]; then
+            exit 1
+          fi
+        done
       done
     done
   done